@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+int CompileAntenna(char *OutFilePath, char *InFilePath[], int n, int silent) {
+
+	/*
+	  CompileAntenna() - Compiles one or more antenna files into a single compiled antenna file. Any file
+			that ReadAntennaPatterns() can read may be an input, including another compiled antenna file.
+			The frequencies of all the inputs are merged and sorted so a set of single frequency type 13 files,
+			such as those in Data/Antenna/T13 Files, becomes one multi-frequency antenna. The compiled antenna
+			file is then given as the TXAntFilePath or RXAntFilePath in the input file in place of the text files.
+
+			INPUT
+				char *OutFilePath - Compiled antenna file to create
+				char *InFilePath[] - Antenna files to compile
+				int n - Number of antenna files
+				int silent
+
+			OUTPUT
+				The compiled antenna file
+				Returns RTN_COMPILEANTENNAOK or RTN_ERRCOMPILEANTENNA
+
+			SUBROUTINES
+				ReadAntennaFile()
+				dllAllocateAntennaMemory()
+				dllWriteAntennaBinFunc()
+				dllFreeAntennaMemory()
+	*/
+
+	struct Antenna *in;		// The input antennas
+	struct Antenna out;		// The compiled antenna
+
+	double *freqs;			// Temp for sorting
+	double **pattern;		// Temp for sorting
+	double f;
+
+	int azin = 360;			// Fixed number of azimuths at 1-degree intervals
+	int elen = 91;			// Fixed number of elevations at 1-degree intervals
+	int freqn;				// Total number of frequencies
+	int i, j, k, m;			// Loop counters
+	int retval;
+
+	if(n < 1) {
+		printf("CompileAntenna: Error %d No antenna files to compile\n", RTN_ERRCOMPILEANTENNA);
+		return RTN_ERRCOMPILEANTENNA;
+	};
+
+	in = (struct Antenna *) malloc(n * sizeof(struct Antenna));
+	if(in == NULL) {
+		return RTN_ERRCOMPILEANTENNA;
+	};
+
+	// Read all the antennas and count the frequencies.
+	freqn = 0;
+	for(i=0; i<n; i++) {
+		in[i].pattern = NULL;
+		in[i].map = NULL;
+		retval = ReadAntennaFile(&in[i], InFilePath[i], "", 0.0, silent);
+		if(retval != RTN_READANTENNAPATTERNSOK) {
+			printf("CompileAntenna: Error %d reading antenna file %.65s\n", retval, InFilePath[i]);
+			for(j=0; j<=i; j++) dllFreeAntennaMemory(&in[j]);
+			free(in);
+			return RTN_ERRCOMPILEANTENNA;
+		};
+		freqn += in[i].freqn;
+	};
+
+	retval = dllAllocateAntennaMemory(&out, freqn, azin, elen);
+	if(retval != RTN_ALLOCATEP533OK) {
+		for(i=0; i<n; i++) dllFreeAntennaMemory(&in[i]);
+		free(in);
+		return RTN_ERRCOMPILEANTENNA;
+	};
+
+	// The name of the compiled antenna is that of the first file.
+	strcpy(out.Name, in[0].Name);
+
+	// Copy the patterns in the order they were given.
+	k = 0;
+	for(i=0; i<n; i++) {
+		for(m=0; m<in[i].freqn; m++) {
+			out.freqs[k] = in[i].freqs[m];
+			for(j=0; j<azin; j++) {
+				memcpy(out.pattern[k][j], in[i].pattern[m][j], elen*sizeof(double));
+			};
+			k++;
+		};
+		dllFreeAntennaMemory(&in[i]);
+	};
+	free(in);
+
+	// Sort by frequency. Only the azimuth row pointers need to move.
+	freqs = out.freqs;
+	for(i=1; i<freqn; i++) {
+		f = freqs[i];
+		pattern = out.pattern[i];
+		for(j=i-1; (j >= 0) && (freqs[j] > f); j--) {
+			freqs[j+1] = freqs[j];
+			out.pattern[j+1] = out.pattern[j];
+		};
+		freqs[j+1] = f;
+		out.pattern[j+1] = pattern;
+	};
+
+	for(i=1; i<freqn; i++) {
+		if((freqs[i] == freqs[i-1]) && (silent != TRUE)) {
+			printf("CompileAntenna: Warning more than one pattern at %.3lf MHz\n", freqs[i]);
+		};
+	};
+
+	retval = dllWriteAntennaBinFunc(&out, OutFilePath, silent);
+	dllFreeAntennaMemory(&out);
+	if(retval != RTN_WRITEANTENNABINOK) {
+		printf("CompileAntenna: Error %d writing compiled antenna file %.65s\n", retval, OutFilePath);
+		return RTN_ERRCOMPILEANTENNA;
+	};
+
+	return RTN_COMPILEANTENNAOK;
+
+};
@@ -0,0 +1,878 @@
+#if __linux__
+	#define _GNU_SOURCE		// F_SETPIPE_SZ
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#ifdef _WIN32
+	#include <io.h>
+#elif __linux__ || __APPLE__
+	#include <pthread.h>
+	#include <unistd.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local #define
+#define GZWSIZE			32768			// Deflate window
+#define GZWMASK			(GZWSIZE - 1)
+#define GZHASHBITS		15
+#define GZHASHSIZE		(1 << GZHASHBITS)
+#define GZNIL			-1				// End of a hash chain
+#define GZMINMATCH		3
+#define GZMAXMATCH		258
+#define GZLOOKAHEAD		(GZMAXMATCH + GZMINMATCH + 1)	// Input kept ahead of the match position until the end
+#define GZMAXCHAIN		32				// Positions searched for a match
+#define GZGOOD			8				// The search is shortened after a match this long
+#define GZLAZY			16				// A match this long is taken without trying the next position
+#define GZNICE			128				// A match this long ends the search
+#define GZTOOFAR		4096			// A match of GZMINMATCH further away than this isn't worth its distance code
+#define GZBLOCKSYMS		32768			// Literals and matches in a deflate block
+#define GZOUTSIZE		65536			// Output buffer
+#define GZLLCODES		286				// Literal/length codes
+#define GZDCODES		30				// Distance codes
+#define GZCLCODES		19				// Code length codes
+#define GZMAXBITS		15				// Longest literal/length or distance code
+#define GZMAXCLBITS		7				// Longest code length code
+
+#ifdef _WIN32
+	#define readpipe		_read
+	#define closepipe		_close
+#else
+	#define readpipe		read
+	#define closepipe		close
+#endif
+// End local #define
+
+// Local structures
+// The deflate stream. The input is read into win and matched against the previous GZWSIZE bytes with hash
+// chains. A literal or match waits one position in case a longer match starts at the next byte. The
+// literals and matches of a block are kept until the block is written with its own Huffman codes.
+struct Deflate {
+	FILE *fp;						// The compressed file
+	int err;						// A write to fp failed
+	unsigned char *win;				// 2*GZWSIZE of input
+	int *head;						// Most recent position of each hash
+	int *prev;						// Previous position with the same hash, by position & GZWMASK
+	int pos;						// Next position to match
+	int end;						// End of the input in win
+	int prevlen;					// Match at pos - 1 that is waiting
+	int prevdist;
+	int avail;						// The literal at pos - 1 is waiting
+	unsigned char *lc;				// Literal or match length - GZMINMATCH of each symbol in the block
+	unsigned short *dist;			// Match distance of each symbol or 0 for a literal
+	int nsym;
+	unsigned int llfreq[GZLLCODES];
+	unsigned int dfreq[GZDCODES];
+	unsigned long long bits;		// Bits waiting to be written
+	int nbits;
+	unsigned char *out;				// Output buffer
+	int nout;
+	unsigned long crc;				// CRC-32 of the input
+	unsigned long isize;			// Size of the input modulo 2^32
+};
+
+// The report is written to one end of a pipe and the thread compresses what it reads from the other
+struct Compress {
+	struct Deflate z;
+	FILE *in;						// Write end of the pipe
+	int fd;							// Read end of the pipe
+	int started;					// The thread is running
+#ifdef _WIN32
+	HANDLE th;
+#elif __linux__ || __APPLE__
+	pthread_t th;
+#endif
+};
+// End local structures
+
+// Local prototypes
+#ifdef _WIN32
+DWORD WINAPI CompressThreadProc(LPVOID arg);
+#elif __linux__ || __APPLE__
+void* CompressThreadProc(void* arg);
+#endif
+void CompressTables(void);
+void CompressStream(struct Compress *c);
+void DeflateInput(struct Deflate *z, int finish);
+int LongestMatch(struct Deflate *z, int pos, int cur, int *dist);
+void FlushBlock(struct Deflate *z, int last);
+void HuffmanLengths(const unsigned int *freq, int n, int limit, unsigned char *len);
+void HuffmanCodes(const unsigned char *len, int n, unsigned short *code);
+void PutBits(struct Deflate *z, unsigned int val, int n);
+void PutByte(struct Deflate *z, int b);
+void WriteOut(struct Deflate *z);
+void FreeDeflate(struct Deflate *z);
+// End local prototypes
+
+// Local globals
+// Base and extra bits of the length codes 257 to 285 and the distance codes
+static const int LBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+	67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const int LExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+	4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const int DBase[GZDCODES] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+	513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const int DExtra[GZDCODES] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+	8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// Order the code length code lengths are written in
+static const int CLOrder[GZCLCODES] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+static unsigned char LCode[256];		// Length code of length - GZMINMATCH
+static unsigned char DCode[512];		// Distance code of distance - 1 < 256 and of 256 + ((distance - 1) >> 7)
+static unsigned long CRCTable[256];
+
+static struct Compress Stream;
+// End local globals
+
+FILE *OpenCompressed(const char *filename) {
+
+	/*
+	 * OpenCompressed() - Opens a gzip file that the report is written to. The FILE * that is returned is the
+	 *		write end of a pipe. A thread reads the other end and deflates it into the file, so the calculation
+	 *		goes on while the report is compressed. The file is finished by CloseCompressed(). Only one
+	 *		compressed file can be open at a time.
+	 *
+	 *			INPUT
+	 *				const char *filename
+	 *
+	 *			OUTPUT
+	 *				The gzip header is written to the file
+	 *
+	 *				Returns
+	 *					The FILE * to write the report to or NULL if the file, pipe or thread can't be made
+	 *
+	 *			SUBROUTINES
+	 *				CompressTables()
+	 *				CompressThreadProc()
+	 *				FreeDeflate()
+	 */
+
+	struct Deflate *z = &Stream.z;
+
+	unsigned long mtime;
+
+	int fds[2];
+	int i;
+
+	CompressTables();
+
+	memset(&Stream, 0, sizeof(Stream));
+	Stream.fd = -1;
+
+	z->win = malloc(2*GZWSIZE);
+	z->head = malloc(GZHASHSIZE*sizeof(int));
+	z->prev = malloc(GZWSIZE*sizeof(int));
+	z->lc = malloc(GZBLOCKSYMS);
+	z->dist = malloc(GZBLOCKSYMS*sizeof(unsigned short));
+	z->out = malloc(GZOUTSIZE);
+	if((z->win == NULL) || (z->head == NULL) || (z->prev == NULL) || (z->lc == NULL) || (z->dist == NULL) || (z->out == NULL)) {
+		FreeDeflate(z);
+		return NULL;
+	};
+	for(i=0; i<GZHASHSIZE; i++) z->head[i] = GZNIL;
+	z->crc = 0xFFFFFFFFUL;
+
+	z->fp = fopen(filename, "wb");
+	if(z->fp == NULL) {
+		FreeDeflate(z);
+		return NULL;
+	};
+
+	// gzip header (RFC 1952) with the modification time and the OS unknown
+	mtime = (unsigned long)time(NULL);
+	PutByte(z, 0x1F);
+	PutByte(z, 0x8B);
+	PutByte(z, 8);			// Deflate
+	PutByte(z, 0);			// No flags
+	for(i=0; i<4; i++) PutByte(z, (int)((mtime >> 8*i) & 0xFF));
+	PutByte(z, 0);
+	PutByte(z, 255);
+
+#ifdef _WIN32
+	if(_pipe(fds, RPTFILEBUFFER, _O_BINARY) != 0) {
+#elif __linux__ || __APPLE__
+	if(pipe(fds) != 0) {
+#endif
+		fclose(z->fp);
+		FreeDeflate(z);
+		return NULL;
+	};
+#ifdef F_SETPIPE_SZ
+	// The pipe holds as much as the report file buffer. If it can't it stays at the system size.
+	fcntl(fds[1], F_SETPIPE_SZ, RPTFILEBUFFER);
+#endif
+
+	Stream.fd = fds[0];
+#ifdef _WIN32
+	Stream.in = _fdopen(fds[1], "wb");
+#elif __linux__ || __APPLE__
+	Stream.in = fdopen(fds[1], "wb");
+#endif
+
+	if(Stream.in != NULL) {
+#ifdef _WIN32
+		Stream.th = CreateThread(NULL, 0, CompressThreadProc, &Stream, 0, NULL);
+		Stream.started = (Stream.th != NULL);
+#elif __linux__ || __APPLE__
+		Stream.started = (pthread_create(&Stream.th, NULL, CompressThreadProc, &Stream) == 0);
+#endif
+	};
+
+	if(Stream.started != TRUE) {
+		if(Stream.in != NULL) {
+			fclose(Stream.in);
+		}
+		else {
+			closepipe(fds[1]);
+		};
+		closepipe(fds[0]);
+		fclose(z->fp);
+		FreeDeflate(z);
+		return NULL;
+	};
+
+	return Stream.in;
+
+};
+
+int CloseCompressed(FILE *fp) {
+
+	/*
+	 * CloseCompressed() - Closes the report that was opened by OpenCompressed(). Closing the write end of the
+	 *		pipe ends the input, then the thread writes what is left of the deflate stream and the gzip trailer.
+	 *
+	 *			INPUT
+	 *				FILE *fp	From OpenCompressed()
+	 *
+	 *			OUTPUT
+	 *				The gzip file is complete
+	 *
+	 *				Returns
+	 *					RTN_COMPRESSOK
+	 *					RTN_ERRCOMPRESS if the gzip file couldn't be written
+	 *
+	 *			SUBROUTINES
+	 *				FreeDeflate()
+	 */
+
+	int err;
+
+	err = FALSE;
+	if(fclose(fp) != 0) err = TRUE;
+
+#ifdef _WIN32
+	WaitForSingleObject(Stream.th, INFINITE);
+	CloseHandle(Stream.th);
+#elif __linux__ || __APPLE__
+	pthread_join(Stream.th, NULL);
+#endif
+	closepipe(Stream.fd);
+
+	if(Stream.z.err == TRUE) err = TRUE;
+	if(fclose(Stream.z.fp) != 0) err = TRUE;
+
+	FreeDeflate(&Stream.z);
+
+	if(err == TRUE) {
+		return RTN_ERRCOMPRESS;
+	};
+
+	return RTN_COMPRESSOK;
+
+};
+
+#ifdef _WIN32
+DWORD WINAPI CompressThreadProc(LPVOID arg) {
+#elif __linux__ || __APPLE__
+void* CompressThreadProc(void* arg) {
+#endif
+
+	/*
+		CompressThreadProc - Thread entry point that compresses the pipe of a struct Compress
+	*/
+
+	CompressStream((struct Compress*) arg);
+
+	return 0;
+
+};
+
+void CompressStream(struct Compress *c) {
+
+	/*
+	 * CompressStream() - Reads the pipe until it is closed and deflates it. When the window is full the older
+	 *		half is dropped. At the end the last block and the gzip trailer are written. If the file can't be
+	 *		written the rest of the pipe is still read so the report writer never blocks.
+	 *
+	 *			INPUT
+	 *				struct Compress *c
+	 *
+	 *			OUTPUT
+	 *				c->z.fp
+	 *
+	 *			SUBROUTINES
+	 *				DeflateInput()
+	 *				FlushBlock()
+	 *				PutByte()
+	 *				WriteOut()
+	 */
+
+	struct Deflate *z = &c->z;
+
+	unsigned long crc;
+
+	int n;
+	int i;
+
+	for(;;) {
+		// Slide the window
+		if(z->end == 2*GZWSIZE) {
+			memmove(z->win, z->win + GZWSIZE, GZWSIZE);
+			z->pos -= GZWSIZE;
+			z->end -= GZWSIZE;
+			for(i=0; i<GZHASHSIZE; i++) z->head[i] = (z->head[i] >= GZWSIZE) ? z->head[i] - GZWSIZE : GZNIL;
+			for(i=0; i<GZWSIZE; i++) z->prev[i] = (z->prev[i] >= GZWSIZE) ? z->prev[i] - GZWSIZE : GZNIL;
+		};
+
+		n = (int)readpipe(c->fd, z->win + z->end, 2*GZWSIZE - z->end);
+		if(n <= 0) break;
+
+		crc = z->crc;
+		for(i=z->end; i<z->end+n; i++) {
+			crc = CRCTable[(crc ^ z->win[i]) & 0xFF] ^ (crc >> 8);
+		};
+		z->crc = crc;
+		z->isize += n;
+		z->end += n;
+
+		DeflateInput(z, FALSE);
+	};
+
+	DeflateInput(z, TRUE);
+	FlushBlock(z, TRUE);
+
+	// Fill the last byte and write the CRC-32 and size
+	if(z->nbits > 0) PutBits(z, 0, 8 - z->nbits);
+	for(i=0; i<4; i++) PutByte(z, (int)(((z->crc ^ 0xFFFFFFFFUL) >> 8*i) & 0xFF));
+	for(i=0; i<4; i++) PutByte(z, (int)((z->isize >> 8*i) & 0xFF));
+	WriteOut(z);
+
+	return;
+
+};
+
+void DeflateInput(struct Deflate *z, int finish) {
+
+	/*
+	 * DeflateInput() - Finds the literals and matches of the input. Unless it is the end of the input
+	 *		GZLOOKAHEAD bytes are left so every match can be as long as GZMAXMATCH. A match found at a position
+	 *		is only taken if the next position doesn't have a longer one. Each full block is written.
+	 *
+	 *			INPUT
+	 *				struct Deflate *z
+	 *				int finish		TRUE at the end of the input
+	 *
+	 *			OUTPUT
+	 *				z
+	 *
+	 *			SUBROUTINES
+	 *				LongestMatch()
+	 *				FlushBlock()
+	 */
+
+	unsigned int h;
+
+	int limit;
+	int pos;
+	int cur;
+	int curlen, curdist;
+	int last;
+	int k;
+
+	limit = (finish == TRUE) ? z->end : z->end - GZLOOKAHEAD;
+
+	while(z->pos < limit) {
+		pos = z->pos;
+
+		curlen = 0;
+		curdist = 0;
+		if(pos + GZMINMATCH <= z->end) {
+			h = (((unsigned int)z->win[pos] << 16 | (unsigned int)z->win[pos+1] << 8 | z->win[pos+2])*2654435761U) >> (32 - GZHASHBITS);
+			cur = z->head[h];
+			z->prev[pos & GZWMASK] = cur;
+			z->head[h] = pos;
+			if((cur != GZNIL) && (z->prevlen < GZLAZY)) {
+				curlen = LongestMatch(z, pos, cur, &curdist);
+				if((curlen == GZMINMATCH) && (curdist > GZTOOFAR)) curlen = 0;
+			};
+		};
+
+		if((z->prevlen >= GZMINMATCH) && (curlen <= z->prevlen)) {
+			// The match at pos - 1 is taken. The positions it covers go in the hash chains.
+			z->lc[z->nsym] = (unsigned char)(z->prevlen - GZMINMATCH);
+			z->dist[z->nsym++] = (unsigned short)z->prevdist;
+			z->llfreq[257 + LCode[z->prevlen - GZMINMATCH]]++;
+			z->dfreq[(z->prevdist <= 256) ? DCode[z->prevdist - 1] : DCode[256 + ((z->prevdist - 1) >> 7)]]++;
+
+			last = pos - 1 + z->prevlen;
+			for(k=pos+1; (k<last) && (k + GZMINMATCH <= z->end); k++) {
+				h = (((unsigned int)z->win[k] << 16 | (unsigned int)z->win[k+1] << 8 | z->win[k+2])*2654435761U) >> (32 - GZHASHBITS);
+				z->prev[k & GZWMASK] = z->head[h];
+				z->head[h] = k;
+			};
+			z->pos = last;
+			z->avail = FALSE;
+			z->prevlen = 0;
+		}
+		else {
+			if(z->avail == TRUE) {
+				z->lc[z->nsym] = z->win[pos-1];
+				z->dist[z->nsym++] = 0;
+				z->llfreq[z->win[pos-1]]++;
+			};
+			z->avail = TRUE;
+			z->prevlen = curlen;
+			z->prevdist = curdist;
+			z->pos = pos + 1;
+		};
+
+		if(z->nsym >= GZBLOCKSYMS - 1) {
+			FlushBlock(z, FALSE);
+		};
+	};
+
+	if((finish == TRUE) && (z->avail == TRUE)) {
+		z->lc[z->nsym] = z->win[z->pos-1];
+		z->dist[z->nsym++] = 0;
+		z->llfreq[z->win[z->pos-1]]++;
+		z->avail = FALSE;
+	};
+
+	return;
+
+};
+
+int LongestMatch(struct Deflate *z, int pos, int cur, int *dist) {
+
+	/*
+	 * LongestMatch() - Follows the hash chain from cur for the longest match at pos that is longer than the
+	 *		match that is waiting at pos - 1.
+	 *
+	 *			INPUT
+	 *				struct Deflate *z
+	 *				int pos		Position to match
+	 *				int cur		Most recent earlier position with the same hash
+	 *
+	 *			OUTPUT
+	 *				int *dist	Distance of the match
+	 *
+	 *				Returns
+	 *					Length of the match or 0 if there is no longer match
+	 */
+
+	unsigned char *p = z->win + pos;
+	unsigned char *q;
+
+	int best, found;
+	int maxlen;
+	int chain;
+	int stop;
+	int len;
+
+	maxlen = z->end - pos;
+	if(maxlen > GZMAXMATCH) maxlen = GZMAXMATCH;
+	best = (z->prevlen >= GZMINMATCH) ? z->prevlen : GZMINMATCH - 1;
+	if(best >= maxlen) return 0;
+
+	chain = (z->prevlen >= GZGOOD) ? GZMAXCHAIN/4 : GZMAXCHAIN;
+	stop = pos - GZWSIZE;
+	found = FALSE;
+
+	while((cur != GZNIL) && (cur > stop) && (chain-- > 0)) {
+		q = z->win + cur;
+		if((q[best] == p[best]) && (q[0] == p[0]) && (q[1] == p[1])) {
+			len = 2;
+			while((len < maxlen) && (q[len] == p[len])) len++;
+			if(len > best) {
+				best = len;
+				*dist = pos - cur;
+				found = TRUE;
+				if((len >= GZNICE) || (len >= maxlen)) break;
+			};
+		};
+		cur = z->prev[cur & GZWMASK];
+	};
+
+	return (found == TRUE) ? best : 0;
+
+};
+
+void FlushBlock(struct Deflate *z, int last) {
+
+	/*
+	 * FlushBlock() - Writes the literals and matches as a deflate block with dynamic Huffman codes (RFC 1951
+	 *		3.2.7). The code lengths are run length coded.
+	 *
+	 *			INPUT
+	 *				struct Deflate *z
+	 *				int last		TRUE for the final block
+	 *
+	 *			OUTPUT
+	 *				z->out
+	 *
+	 *			SUBROUTINES
+	 *				HuffmanLengths()
+	 *				HuffmanCodes()
+	 *				PutBits()
+	 */
+
+	unsigned char lllen[GZLLCODES], dlen[GZDCODES], cllen[GZCLCODES];
+	unsigned short llcode[GZLLCODES], dcode[GZDCODES], clcode[GZCLCODES];
+	unsigned char lens[GZLLCODES + GZDCODES];
+	unsigned char clsym[GZLLCODES + GZDCODES];
+	unsigned char clextra[GZLLCODES + GZDCODES];
+	unsigned int clfreq[GZCLCODES];
+
+	int hlit, hdist, hclen;
+	int n, ncl;
+	int i, run, r;
+	int c, d, len;
+
+	z->llfreq[256] = 1;	// End of block
+	HuffmanLengths(z->llfreq, GZLLCODES, GZMAXBITS, lllen);
+	HuffmanLengths(z->dfreq, GZDCODES, GZMAXBITS, dlen);
+	HuffmanCodes(lllen, GZLLCODES, llcode);
+	HuffmanCodes(dlen, GZDCODES, dcode);
+
+	hlit = GZLLCODES;
+	while((hlit > 257) && (lllen[hlit-1] == 0)) hlit--;
+	hdist = GZDCODES;
+	while((hdist > 1) && (dlen[hdist-1] == 0)) hdist--;
+
+	// Run length code the code lengths with 16 (repeat the last 3 to 6 times), 17 (3 to 10 zeros) and 18 (11 to 138 zeros)
+	memcpy(lens, lllen, hlit);
+	memcpy(lens + hlit, dlen, hdist);
+	n = hlit + hdist;
+	memset(clfreq, 0, sizeof(clfreq));
+	ncl = 0;
+	i = 0;
+	while(i < n) {
+		len = lens[i];
+		run = 1;
+		while((i + run < n) && (lens[i+run] == len)) run++;
+		i += run;
+		if(len == 0) {
+			while(run >= 11) {
+				r = (run > 138) ? 138 : run;
+				clsym[ncl] = 18; clextra[ncl++] = (unsigned char)(r - 11);
+				run -= r;
+			};
+			if(run >= 3) {
+				clsym[ncl] = 17; clextra[ncl++] = (unsigned char)(run - 3);
+				run = 0;
+			};
+		}
+		else {
+			clsym[ncl] = (unsigned char)len; clextra[ncl++] = 0;
+			run--;
+			while(run >= 3) {
+				r = (run > 6) ? 6 : run;
+				clsym[ncl] = 16; clextra[ncl++] = (unsigned char)(r - 3);
+				run -= r;
+			};
+		};
+		while(run > 0) {
+			clsym[ncl] = (unsigned char)len; clextra[ncl++] = 0;
+			run--;
+		};
+	};
+	for(i=0; i<ncl; i++) clfreq[clsym[i]]++;
+
+	HuffmanLengths(clfreq, GZCLCODES, GZMAXCLBITS, cllen);
+	HuffmanCodes(cllen, GZCLCODES, clcode);
+	hclen = GZCLCODES;
+	while((hclen > 4) && (cllen[CLOrder[hclen-1]] == 0)) hclen--;
+
+	// Block header
+	PutBits(z, (last == TRUE) ? 1 : 0, 1);
+	PutBits(z, 2, 2);
+	PutBits(z, hlit - 257, 5);
+	PutBits(z, hdist - 1, 5);
+	PutBits(z, hclen - 4, 4);
+	for(i=0; i<hclen; i++) PutBits(z, cllen[CLOrder[i]], 3);
+	for(i=0; i<ncl; i++) {
+		PutBits(z, clcode[clsym[i]], cllen[clsym[i]]);
+		if(clsym[i] == 16) PutBits(z, clextra[i], 2);
+		else if(clsym[i] == 17) PutBits(z, clextra[i], 3);
+		else if(clsym[i] == 18) PutBits(z, clextra[i], 7);
+	};
+
+	// The literals and matches
+	for(i=0; i<z->nsym; i++) {
+		d = z->dist[i];
+		if(d == 0) {
+			PutBits(z, llcode[z->lc[i]], lllen[z->lc[i]]);
+		}
+		else {
+			c = LCode[z->lc[i]];
+			PutBits(z, llcode[257 + c], lllen[257 + c]);
+			PutBits(z, z->lc[i] + GZMINMATCH - LBase[c], LExtra[c]);
+			c = (d <= 256) ? DCode[d - 1] : DCode[256 + ((d - 1) >> 7)];
+			PutBits(z, dcode[c], dlen[c]);
+			PutBits(z, d - DBase[c], DExtra[c]);
+		};
+	};
+	PutBits(z, llcode[256], lllen[256]);
+
+	z->nsym = 0;
+	memset(z->llfreq, 0, sizeof(z->llfreq));
+	memset(z->dfreq, 0, sizeof(z->dfreq));
+
+	return;
+
+};
+
+void HuffmanLengths(const unsigned int *freq, int n, int limit, unsigned char *len) {
+
+	/*
+	 * HuffmanLengths() - Finds the Huffman code lengths of the symbols. The tree is built by merging the two
+	 *		lightest of the sorted leaves and the internal nodes, which are made in order of weight. If a code
+	 *		is longer than limit the frequencies are halved and the tree is built again. At least two symbols
+	 *		get a code so the code is complete.
+	 *
+	 *			INPUT
+	 *				const unsigned int *freq	Frequency of each symbol
+	 *				int n						Number of symbols <= GZLLCODES
+	 *				int limit					Longest code
+	 *
+	 *			OUTPUT
+	 *				unsigned char *len			Code length of each symbol, 0 if it isn't used
+	 */
+
+	unsigned int f[GZLLCODES];
+	unsigned int w[2*GZLLCODES];
+
+	int sym[GZLLCODES];
+	int parent[2*GZLLCODES];
+	int depth[2*GZLLCODES];
+	int nsym;
+	int i, j, k, s;
+	int a, b;
+	int leaf, node;
+	int maxdepth;
+
+	nsym = 0;
+	for(i=0; i<n; i++) {
+		f[i] = freq[i];
+		len[i] = 0;
+		if(f[i] > 0) nsym++;
+	};
+	for(i=0; (i<n) && (nsym<2); i++) {
+		if(f[i] == 0) {
+			f[i] = 1;
+			nsym++;
+		};
+	};
+
+	for(;;) {
+		// Sort the used symbols by frequency
+		nsym = 0;
+		for(i=0; i<n; i++) {
+			if(f[i] == 0) continue;
+			s = i;
+			for(j=nsym; (j>0) && (f[sym[j-1]] > f[s]); j--) sym[j] = sym[j-1];
+			sym[j] = s;
+			nsym++;
+		};
+		for(k=0; k<nsym; k++) w[k] = f[sym[k]];
+
+		leaf = 0;
+		node = nsym;
+		for(k=nsym; k<2*nsym-1; k++) {
+			a = ((leaf < nsym) && ((node >= k) || (w[leaf] <= w[node]))) ? leaf++ : node++;
+			b = ((leaf < nsym) && ((node >= k) || (w[leaf] <= w[node]))) ? leaf++ : node++;
+			parent[a] = k;
+			parent[b] = k;
+			w[k] = w[a] + w[b];
+		};
+
+		depth[2*nsym-2] = 0;
+		maxdepth = 0;
+		for(k=2*nsym-3; k>=0; k--) {
+			depth[k] = depth[parent[k]] + 1;
+			if((k < nsym) && (depth[k] > maxdepth)) maxdepth = depth[k];
+		};
+
+		if(maxdepth <= limit) {
+			for(k=0; k<nsym; k++) len[sym[k]] = (unsigned char)depth[k];
+			return;
+		};
+
+		for(i=0; i<n; i++) {
+			if(f[i] > 0) f[i] = (f[i] >> 1) | 1;
+		};
+	};
+
+};
+
+void HuffmanCodes(const unsigned char *len, int n, unsigned short *code) {
+
+	/*
+	 * HuffmanCodes() - Makes the canonical Huffman codes from the code lengths (RFC 1951 3.2.2). The codes are
+	 *		bit reversed because they are written starting with their most significant bit.
+	 *
+	 *			INPUT
+	 *				const unsigned char *len
+	 *				int n
+	 *
+	 *			OUTPUT
+	 *				unsigned short *code
+	 */
+
+	unsigned int count[GZMAXBITS + 1];
+	unsigned int next[GZMAXBITS + 1];
+	unsigned int c, r;
+
+	int i, b;
+
+	memset(count, 0, sizeof(count));
+	for(i=0; i<n; i++) count[len[i]]++;
+	count[0] = 0;
+
+	c = 0;
+	for(b=1; b<=GZMAXBITS; b++) {
+		c = (c + count[b-1]) << 1;
+		next[b] = c;
+	};
+
+	for(i=0; i<n; i++) {
+		code[i] = 0;
+		if(len[i] == 0) continue;
+		c = next[len[i]]++;
+		r = 0;
+		for(b=0; b<len[i]; b++) {
+			r = (r << 1) | (c & 1);
+			c >>= 1;
+		};
+		code[i] = (unsigned short)r;
+	};
+
+	return;
+
+};
+
+void PutBits(struct Deflate *z, unsigned int val, int n) {
+
+	/*
+	 * PutBits() - Adds n <= 16 bits to the output starting with the least significant bit
+	 */
+
+	z->bits |= (unsigned long long)val << z->nbits;
+	z->nbits += n;
+	while(z->nbits >= 8) {
+		PutByte(z, (int)(z->bits & 0xFF));
+		z->bits >>= 8;
+		z->nbits -= 8;
+	};
+
+	return;
+
+};
+
+void PutByte(struct Deflate *z, int b) {
+
+	/*
+	 * PutByte() - Adds a byte to the output buffer and writes the buffer when it is full
+	 */
+
+	z->out[z->nout++] = (unsigned char)b;
+	if(z->nout == GZOUTSIZE) {
+		WriteOut(z);
+	};
+
+	return;
+
+};
+
+void WriteOut(struct Deflate *z) {
+
+	/*
+	 * WriteOut() - Writes the output buffer to the file. After an error nothing more is written.
+	 */
+
+	if((z->err != TRUE) && (z->nout > 0)) {
+		if(fwrite(z->out, 1, z->nout, z->fp) != (size_t)z->nout) {
+			z->err = TRUE;
+		};
+	};
+	z->nout = 0;
+
+	return;
+
+};
+
+void CompressTables(void) {
+
+	/*
+	 * CompressTables() - Makes the length and distance code tables and the CRC-32 table
+	 */
+
+	unsigned long c;
+
+	int i, k, l, d;
+
+	for(i=0; i<28; i++) {
+		for(l=LBase[i]; l<LBase[i] + (1 << LExtra[i]); l++) {
+			LCode[l - GZMINMATCH] = (unsigned char)i;
+		};
+	};
+	LCode[GZMAXMATCH - GZMINMATCH] = 28;
+
+	for(i=0; i<GZDCODES; i++) {
+		for(d=DBase[i]; d<DBase[i] + (1 << DExtra[i]); d++) {
+			if(d <= 256) DCode[d - 1] = (unsigned char)i;
+			else DCode[256 + ((d - 1) >> 7)] = (unsigned char)i;
+		};
+	};
+
+	for(i=0; i<256; i++) {
+		c = (unsigned long)i;
+		for(k=0; k<8; k++) {
+			c = (c & 1) ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+		};
+		CRCTable[i] = c;
+	};
+
+	return;
+
+};
+
+void FreeDeflate(struct Deflate *z) {
+
+	/*
+	 * FreeDeflate() - Frees the buffers of the deflate stream
+	 */
+
+	free(z->win);
+	free(z->head);
+	free(z->prev);
+	free(z->lc);
+	free(z->dist);
+	free(z->out);
+	z->win = NULL;
+	z->head = NULL;
+	z->prev = NULL;
+	z->lc = NULL;
+	z->dist = NULL;
+	z->out = NULL;
+
+	return;
+
+};
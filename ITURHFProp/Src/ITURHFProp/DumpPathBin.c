@@ -0,0 +1,435 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local #define
+// A field of struct PathData or struct ITURHFProp. The name is the member as it is written in C.
+#define PDDPATH(type, m)	{#m, type, PDD_SRCPATH, offsetof(struct PathData, m)}
+#define PDDLOOP(m)			{"ITURHFP." #m, PDD_INT, PDD_SRCITURHFP, offsetof(struct ITURHFProp, m)}
+
+// The fields of a control point
+#define PDDCP(i)	\
+	PDDPATH(PDD_DOUBLE, CP[i].L.lat), PDDPATH(PDD_DOUBLE, CP[i].L.lng), PDDPATH(PDD_DOUBLE, CP[i].distance), \
+	PDDPATH(PDD_DOUBLE, CP[i].foE), PDDPATH(PDD_DOUBLE, CP[i].foF2), PDDPATH(PDD_DOUBLE, CP[i].M3kF2), \
+	PDDPATH(PDD_DOUBLE, CP[i].dip[0]), PDDPATH(PDD_DOUBLE, CP[i].dip[1]), PDDPATH(PDD_DOUBLE, CP[i].fH[0]), \
+	PDDPATH(PDD_DOUBLE, CP[i].fH[1]), PDDPATH(PDD_DOUBLE, CP[i].ltime), PDDPATH(PDD_DOUBLE, CP[i].hr), \
+	PDDPATH(PDD_DOUBLE, CP[i].x), PDDPATH(PDD_DOUBLE, CP[i].Sun.ha), PDDPATH(PDD_DOUBLE, CP[i].Sun.sha), \
+	PDDPATH(PDD_DOUBLE, CP[i].Sun.sza), PDDPATH(PDD_DOUBLE, CP[i].Sun.decl), PDDPATH(PDD_DOUBLE, CP[i].Sun.eot), \
+	PDDPATH(PDD_DOUBLE, CP[i].Sun.lsr), PDDPATH(PDD_DOUBLE, CP[i].Sun.lsn), PDDPATH(PDD_DOUBLE, CP[i].Sun.lss)
+
+// The fields of a mode
+#define PDDMODE(md, i)	\
+	PDDPATH(PDD_DOUBLE, md[i].BMUF), PDDPATH(PDD_DOUBLE, md[i].MUF90), PDDPATH(PDD_DOUBLE, md[i].MUF50), \
+	PDDPATH(PDD_DOUBLE, md[i].MUF10), PDDPATH(PDD_DOUBLE, md[i].OPMUF), PDDPATH(PDD_DOUBLE, md[i].OPMUF10), \
+	PDDPATH(PDD_DOUBLE, md[i].OPMUF90), PDDPATH(PDD_DOUBLE, md[i].Fprob), PDDPATH(PDD_DOUBLE, md[i].deltal), \
+	PDDPATH(PDD_DOUBLE, md[i].deltau), PDDPATH(PDD_DOUBLE, md[i].hr), PDDPATH(PDD_DOUBLE, md[i].fs), \
+	PDDPATH(PDD_DOUBLE, md[i].Lb), PDDPATH(PDD_DOUBLE, md[i].Ew), PDDPATH(PDD_DOUBLE, md[i].ele), \
+	PDDPATH(PDD_DOUBLE, md[i].Prw), PDDPATH(PDD_DOUBLE, md[i].Grw), PDDPATH(PDD_DOUBLE, md[i].tau), \
+	PDDPATH(PDD_INT, md[i].MC)
+
+// Where the value of a field is kept
+#define PDD_SRCPATH			0
+#define PDD_SRCITURHFP		1
+// End local #define
+
+// Local structures
+struct PddSource {
+	const char *name;
+	int type;			// PDD_DOUBLE or PDD_INT
+	int src;			// PDD_SRCPATH or PDD_SRCITURHFP
+	size_t offset;		// Offset of the member in its structure
+};
+// End local structures
+
+// Local prototypes
+void PddFieldOffsets(int *offset, int *recsize);
+void PddCopyString(char *dst, const char *src, int size);
+// End local prototypes
+
+// Local globals
+// The fields of a record. This is the schema of the file so fields are only added to the end.
+static const struct PddSource PddFields[] = {
+	// Loop indices
+	PDDLOOP(imnth), PDDLOOP(ihr), PDDLOOP(ifrq), PDDLOOP(ilat), PDDLOOP(ilng),
+	// Input parameters
+	PDDPATH(PDD_INT, year), PDDPATH(PDD_INT, month), PDDPATH(PDD_INT, hour), PDDPATH(PDD_INT, SSN),
+	PDDPATH(PDD_INT, Modulation), PDDPATH(PDD_INT, SorL), PDDPATH(PDD_DOUBLE, frequency), PDDPATH(PDD_DOUBLE, BW),
+	PDDPATH(PDD_DOUBLE, txpower), PDDPATH(PDD_INT, SNRXXp), PDDPATH(PDD_DOUBLE, SNRr), PDDPATH(PDD_DOUBLE, SIRr),
+	PDDPATH(PDD_DOUBLE, F0), PDDPATH(PDD_DOUBLE, T0), PDDPATH(PDD_DOUBLE, A), PDDPATH(PDD_DOUBLE, TW),
+	PDDPATH(PDD_DOUBLE, FW), PDDPATH(PDD_DOUBLE, L_tx.lat), PDDPATH(PDD_DOUBLE, L_tx.lng), PDDPATH(PDD_DOUBLE, L_rx.lat),
+	PDDPATH(PDD_DOUBLE, L_rx.lng),
+	// Path parameters
+	PDDPATH(PDD_INT, season), PDDPATH(PDD_DOUBLE, distance), PDDPATH(PDD_DOUBLE, ptick), PDDPATH(PDD_DOUBLE, dmax),
+	PDDPATH(PDD_DOUBLE, B), PDDPATH(PDD_DOUBLE, ele),
+	// MUFs
+	PDDPATH(PDD_DOUBLE, BMUF), PDDPATH(PDD_DOUBLE, MUF50), PDDPATH(PDD_DOUBLE, MUF90), PDDPATH(PDD_DOUBLE, MUF10),
+	PDDPATH(PDD_DOUBLE, OPMUF), PDDPATH(PDD_DOUBLE, OPMUF90), PDDPATH(PDD_DOUBLE, OPMUF10),
+	PDDPATH(PDD_INT, n0_F2), PDDPATH(PDD_INT, n0_E),
+	// Field strength and power
+	PDDPATH(PDD_DOUBLE, Es), PDDPATH(PDD_DOUBLE, El), PDDPATH(PDD_DOUBLE, Ei), PDDPATH(PDD_DOUBLE, Ep),
+	PDDPATH(PDD_DOUBLE, Pr), PDDPATH(PDD_DOUBLE, Lz), PDDPATH(PDD_DOUBLE, E0), PDDPATH(PDD_DOUBLE, Gap),
+	PDDPATH(PDD_DOUBLE, Ly), PDDPATH(PDD_DOUBLE, fM), PDDPATH(PDD_DOUBLE, fL), PDDPATH(PDD_DOUBLE, F),
+	PDDPATH(PDD_DOUBLE, fH), PDDPATH(PDD_DOUBLE, Gtl), PDDPATH(PDD_DOUBLE, K[0]), PDDPATH(PDD_DOUBLE, K[1]),
+	// Signal-to-noise, signal-to-interference and reliability
+	PDDPATH(PDD_DOUBLE, SNR), PDDPATH(PDD_DOUBLE, DuSN), PDDPATH(PDD_DOUBLE, DlSN), PDDPATH(PDD_DOUBLE, SNRXX),
+	PDDPATH(PDD_DOUBLE, SIR), PDDPATH(PDD_DOUBLE, DuSI), PDDPATH(PDD_DOUBLE, DlSI), PDDPATH(PDD_DOUBLE, RSN),
+	PDDPATH(PDD_DOUBLE, RT), PDDPATH(PDD_DOUBLE, RF), PDDPATH(PDD_DOUBLE, BCR), PDDPATH(PDD_DOUBLE, OCR),
+	PDDPATH(PDD_DOUBLE, OCRs), PDDPATH(PDD_DOUBLE, MIR), PDDPATH(PDD_DOUBLE, probocc), PDDPATH(PDD_DOUBLE, Grw),
+	PDDPATH(PDD_DOUBLE, EIRP), PDDPATH(PDD_INT, DMidx),
+	// Noise
+	PDDPATH(PDD_DOUBLE, noiseP.FaA), PDDPATH(PDD_DOUBLE, noiseP.DuA), PDDPATH(PDD_DOUBLE, noiseP.DlA),
+	PDDPATH(PDD_DOUBLE, noiseP.FaM), PDDPATH(PDD_DOUBLE, noiseP.DuM), PDDPATH(PDD_DOUBLE, noiseP.DlM),
+	PDDPATH(PDD_DOUBLE, noiseP.FaG), PDDPATH(PDD_DOUBLE, noiseP.DuG), PDDPATH(PDD_DOUBLE, noiseP.DlG),
+	PDDPATH(PDD_DOUBLE, noiseP.DuT), PDDPATH(PDD_DOUBLE, noiseP.DlT), PDDPATH(PDD_DOUBLE, noiseP.FamT),
+	PDDPATH(PDD_DOUBLE, noiseP.ManMadeNoise),
+	// Control points
+	PDDCP(0), PDDCP(1), PDDCP(2), PDDCP(3), PDDCP(4),
+	// Modes
+	PDDMODE(Md_E, 0), PDDMODE(Md_E, 1), PDDMODE(Md_E, 2),
+	PDDMODE(Md_F2, 0), PDDMODE(Md_F2, 1), PDDMODE(Md_F2, 2), PDDMODE(Md_F2, 3), PDDMODE(Md_F2, 4), PDDMODE(Md_F2, 5)
+};
+
+#define PDDNFIELDS	((int)(sizeof(PddFields)/sizeof(PddFields[0])))
+
+// The state of the file being written
+static struct {
+	int started;				// The header has been written
+	int recsize;
+	int offset[PDDNFIELDS];
+	unsigned char rec[PDDNFIELDS*sizeof(double)];
+} Pdd;
+// End local globals
+
+void DumpPathBin(struct PathData path, struct ITURHFProp ITURHFP) {
+
+	/*
+	 * DumpPathBin() - Writes the structure PathData path to the path data dump as a binary record. This is the
+	 *		path data dump with the -b option. The header and field table are written with the first record. The
+	 *		record is every number that DumpPathData() prints, and the rest of the numbers in the structure,
+	 *		so the text of the dump can be made from the file by DecodePathDump(). A record is about a fifth of
+	 *		the size of the text and nothing is formatted while P533() runs.
+	 *
+	 *		INPUT
+	 *			struct PathData path
+	 *			struct ITURHFProp ITURHFP
+	 *
+	 *		OUTPUT
+	 *			The record written to the file ITURHFP.rptfp
+	 *
+	 *		SUBROUTINES
+	 *			PddFieldOffsets()
+	 *			PddCopyString()
+	 */
+
+	struct PddHeader hdr;
+	struct PddField fld;
+	struct tm *t;
+
+	const char *src;
+	int i;
+
+	if(Pdd.started != TRUE) {
+		PddFieldOffsets(Pdd.offset, &Pdd.recsize);
+
+		memset(&hdr, 0, sizeof(hdr));
+		memcpy(hdr.magic, PDDMAGIC, strlen(PDDMAGIC));
+		hdr.byteorder = PDDBYTEORDER;
+		hdr.version = PDDVERSION;
+		hdr.hdrsize = sizeof(struct PddHeader) + PDDNFIELDS*sizeof(struct PddField);
+		hdr.nfields = PDDNFIELDS;
+		hdr.recsize = Pdd.recsize;
+		hdr.AntennaOrientation = ITURHFP.AntennaOrientation;
+		hdr.TXBearing = ITURHFP.TXBearing;
+		hdr.TXGOS = ITURHFP.TXGOS;
+		hdr.RXBearing = ITURHFP.RXBearing;
+		hdr.RXGOS = ITURHFP.RXGOS;
+		t = ITURHFP.time;
+		hdr.time[0] = t->tm_sec;
+		hdr.time[1] = t->tm_min;
+		hdr.time[2] = t->tm_hour;
+		hdr.time[3] = t->tm_mday;
+		hdr.time[4] = t->tm_mon;
+		hdr.time[5] = t->tm_year;
+		hdr.time[6] = t->tm_wday;
+		hdr.time[7] = t->tm_yday;
+		PddCopyString(hdr.name, path.name, sizeof(hdr.name));
+		PddCopyString(hdr.txname, path.txname, sizeof(hdr.txname));
+		PddCopyString(hdr.rxname, path.rxname, sizeof(hdr.rxname));
+		PddCopyString(hdr.txantname, path.A_tx.Name, sizeof(hdr.txantname));
+		PddCopyString(hdr.rxantname, path.A_rx.Name, sizeof(hdr.rxantname));
+		PddCopyString(hdr.P533ver, ITURHFP.P533ver, sizeof(hdr.P533ver));
+		PddCopyString(hdr.P533compt, ITURHFP.P533compt, sizeof(hdr.P533compt));
+		PddCopyString(hdr.P372ver, path.P372ver, sizeof(hdr.P372ver));
+		PddCopyString(hdr.P372compt, path.P372compt, sizeof(hdr.P372compt));
+		fwrite(&hdr, sizeof(hdr), 1, ITURHFP.rptfp);
+
+		for(i=0; i<PDDNFIELDS; i++) {
+			memset(&fld, 0, sizeof(fld));
+			PddCopyString(fld.name, PddFields[i].name, sizeof(fld.name));
+			fld.type = PddFields[i].type;
+			fld.offset = Pdd.offset[i];
+			fwrite(&fld, sizeof(fld), 1, ITURHFP.rptfp);
+		};
+
+		memset(Pdd.rec, 0, sizeof(Pdd.rec));
+		Pdd.started = TRUE;
+	};
+
+	for(i=0; i<PDDNFIELDS; i++) {
+		if(PddFields[i].src == PDD_SRCPATH) {
+			src = (const char *)&path + PddFields[i].offset;
+		}
+		else {
+			src = (const char *)&ITURHFP + PddFields[i].offset;
+		};
+		memcpy(Pdd.rec + Pdd.offset[i], src, (PddFields[i].type == PDD_DOUBLE) ? sizeof(double) : sizeof(int));
+	};
+
+	fwrite(Pdd.rec, Pdd.recsize, 1, ITURHFP.rptfp);
+
+	return;
+
+};
+
+int DecodePathDump(char *InFilePath, char *OutFilePath, int silent) {
+
+	/*
+	  DecodePathDump() - Writes the text path data dump for a binary path data dump that was made with the -b
+			option. The fields of the file are matched to those of this version by name. Fields that this
+			version doesn't know are skipped and those missing from the file are zero. Each record is put back
+			into a struct PathData and given to DumpPathData() so the text is the same as the dump would have
+			been without -b.
+
+			INPUT
+				char *InFilePath - Binary path data dump
+				char *OutFilePath - Text file to create or NULL for stdout
+				int silent
+
+			OUTPUT
+				The text path data dump
+				Returns RTN_DECODEPATHDUMPOK or RTN_ERRDECODEPATHDUMP
+
+			SUBROUTINES
+				DumpPathData()
+	*/
+
+	struct PddHeader hdr;
+	struct PddField fld;
+	struct PathData *path;
+	struct ITURHFProp *ITURHFP;
+	struct tm t;
+
+	FILE *in;
+	FILE *out;
+
+	unsigned char *rec;
+	int *map;			// The field of this version for each field in the file or -1
+	int *off;			// The offset in the record of each field in the file
+	char *dst;
+	int i, j;
+	long long n;
+
+	in = fopen(InFilePath, "rb");
+	if(in == NULL) {
+		printf("DecodePathDump: Error %d Can't open binary path data dump %s\n", RTN_ERRDECODEPATHDUMP, InFilePath);
+		return RTN_ERRDECODEPATHDUMP;
+	};
+
+	if((fread(&hdr, sizeof(hdr), 1, in) != 1) || (memcmp(hdr.magic, PDDMAGIC, sizeof(hdr.magic)) != 0)) {
+		printf("DecodePathDump: Error %d %s is not a binary path data dump\n", RTN_ERRDECODEPATHDUMP, InFilePath);
+		fclose(in);
+		return RTN_ERRDECODEPATHDUMP;
+	};
+	if(hdr.byteorder != PDDBYTEORDER) {
+		printf("DecodePathDump: Error %d %s was written on a machine with a different byte order\n", RTN_ERRDECODEPATHDUMP, InFilePath);
+		fclose(in);
+		return RTN_ERRDECODEPATHDUMP;
+	};
+	if(hdr.version > PDDVERSION) {
+		printf("DecodePathDump: Error %d %s is version %u which is newer than this program (%d)\n", RTN_ERRDECODEPATHDUMP, InFilePath, hdr.version, PDDVERSION);
+		fclose(in);
+		return RTN_ERRDECODEPATHDUMP;
+	};
+
+	path = calloc(1, sizeof(struct PathData));
+	ITURHFP = calloc(1, sizeof(struct ITURHFProp));
+	map = malloc((hdr.nfields + 1)*sizeof(int));
+	off = malloc((hdr.nfields + 1)*sizeof(int));
+	rec = malloc(hdr.recsize + 1);
+	if((path == NULL) || (ITURHFP == NULL) || (map == NULL) || (off == NULL) || (rec == NULL)) {
+		printf("DecodePathDump: Error %d Can't allocate memory\n", RTN_ERRDECODEPATHDUMP);
+		free(path); free(ITURHFP); free(map); free(off); free(rec);
+		fclose(in);
+		return RTN_ERRDECODEPATHDUMP;
+	};
+
+	// Match the fields of the file to this version
+	for(i=0; i<(int)hdr.nfields; i++) {
+		map[i] = -1;
+		if(fread(&fld, sizeof(fld), 1, in) != 1) {
+			printf("DecodePathDump: Error %d %s is truncated\n", RTN_ERRDECODEPATHDUMP, InFilePath);
+			free(path); free(ITURHFP); free(map); free(off); free(rec);
+			fclose(in);
+			return RTN_ERRDECODEPATHDUMP;
+		};
+		fld.name[PDDNAMESIZE-1] = '\0';
+		for(j=0; j<PDDNFIELDS; j++) {
+			if(strcmp(fld.name, PddFields[j].name) == 0) {
+				break;
+			};
+		};
+		if((j < PDDNFIELDS) && (fld.type == PddFields[j].type) && (fld.offset >= 0) &&
+		   (fld.offset + (int)((fld.type == PDD_DOUBLE) ? sizeof(double) : sizeof(int)) <= (int)hdr.recsize)) {
+			map[i] = j;
+			off[i] = fld.offset;
+		};
+	};
+
+	if(OutFilePath != NULL) {
+		out = fopen(OutFilePath, "w");
+		if(out == NULL) {
+			printf("DecodePathDump: Error %d Can't open output file %s\n", RTN_ERRDECODEPATHDUMP, OutFilePath);
+			free(path); free(ITURHFP); free(map); free(off); free(rec);
+			fclose(in);
+			return RTN_ERRDECODEPATHDUMP;
+		};
+	}
+	else {
+		out = stdout;
+	};
+
+	// What is the same for all the records is in the header
+	hdr.name[sizeof(hdr.name)-1] = '\0';
+	hdr.txname[sizeof(hdr.txname)-1] = '\0';
+	hdr.rxname[sizeof(hdr.rxname)-1] = '\0';
+	hdr.txantname[sizeof(hdr.txantname)-1] = '\0';
+	hdr.rxantname[sizeof(hdr.rxantname)-1] = '\0';
+	hdr.P533ver[sizeof(hdr.P533ver)-1] = '\0';
+	hdr.P533compt[sizeof(hdr.P533compt)-1] = '\0';
+	hdr.P372ver[sizeof(hdr.P372ver)-1] = '\0';
+	hdr.P372compt[sizeof(hdr.P372compt)-1] = '\0';
+
+	strcpy(path->name, hdr.name);
+	strcpy(path->txname, hdr.txname);
+	strcpy(path->rxname, hdr.rxname);
+	strcpy(path->A_tx.Name, hdr.txantname);
+	strcpy(path->A_rx.Name, hdr.rxantname);
+	path->P372ver = hdr.P372ver;
+	path->P372compt = hdr.P372compt;
+
+	memset(&t, 0, sizeof(t));
+	t.tm_sec = hdr.time[0];
+	t.tm_min = hdr.time[1];
+	t.tm_hour = hdr.time[2];
+	t.tm_mday = hdr.time[3];
+	t.tm_mon = hdr.time[4];
+	t.tm_year = hdr.time[5];
+	t.tm_wday = hdr.time[6];
+	t.tm_yday = hdr.time[7];
+
+	ITURHFP->rptfp = out;
+	ITURHFP->RptFileFormat = RPT_DUMPPATH;
+	ITURHFP->AntennaOrientation = hdr.AntennaOrientation;
+	ITURHFP->TXBearing = hdr.TXBearing;
+	ITURHFP->TXGOS = hdr.TXGOS;
+	ITURHFP->RXBearing = hdr.RXBearing;
+	ITURHFP->RXGOS = hdr.RXGOS;
+	ITURHFP->time = &t;
+	ITURHFP->P533ver = hdr.P533ver;
+	ITURHFP->P533compt = hdr.P533compt;
+	ITURHFP->silent = silent;
+	ITURHFP->binary = FALSE;
+
+	fseek(in, hdr.hdrsize, SEEK_SET);
+
+	n = 0;
+	while(fread(rec, hdr.recsize, 1, in) == 1) {
+		for(i=0; i<(int)hdr.nfields; i++) {
+			j = map[i];
+			if(j < 0) {
+				continue;
+			};
+			if(PddFields[j].src == PDD_SRCPATH) {
+				dst = (char *)path + PddFields[j].offset;
+			}
+			else {
+				dst = (char *)ITURHFP + PddFields[j].offset;
+			};
+			memcpy(dst, rec + off[i], (PddFields[j].type == PDD_DOUBLE) ? sizeof(double) : sizeof(int));
+		};
+
+		DumpPathData(*path, *ITURHFP);
+		n++;
+	};
+
+	if(silent != TRUE) {
+		printf("DecodePathDump: %lld records from %s\n", n, InFilePath);
+	};
+
+	if(out != stdout) {
+		fclose(out);
+	};
+	fclose(in);
+
+	free(path);
+	free(ITURHFP);
+	free(map);
+	free(off);
+	free(rec);
+
+	return RTN_DECODEPATHDUMPOK;
+
+};
+
+void PddFieldOffsets(int *offset, int *recsize) {
+
+	/*
+	 * PddFieldOffsets() - Places the fields in a record. The doubles are first so they are aligned in the
+	 *		record and the ints follow. The record size is a multiple of 8 bytes so the records are aligned too.
+	 */
+
+	int i;
+	int size;
+
+	size = 0;
+	for(i=0; i<PDDNFIELDS; i++) {
+		if(PddFields[i].type == PDD_DOUBLE) {
+			offset[i] = size;
+			size += sizeof(double);
+		};
+	};
+	for(i=0; i<PDDNFIELDS; i++) {
+		if(PddFields[i].type == PDD_INT) {
+			offset[i] = size;
+			size += sizeof(int);
+		};
+	};
+
+	*recsize = (size + 7) & ~7;
+
+	return;
+
+};
+
+void PddCopyString(char *dst, const char *src, int size) {
+
+	/*
+	 * PddCopyString() - Copies a string into a fixed size null filled field of the file
+	 */
+
+	memset(dst, 0, size);
+	if(src != NULL) {
+		strncpy(dst, src, size-1);
+	};
+
+	return;
+
+};
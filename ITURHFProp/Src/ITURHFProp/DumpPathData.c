@@ -10,7 +10,15 @@
 #include "ITURHFProp.h"
 // End local includes
 
+// Local #define
+#define DPDFMTS		4			// Values that can be formatted for one fprintf()
+#define DPDFMTSIZE	360			// Longest formatted value, which is the largest double
+// End local #define
+
 // Local prototypes
+char *Fmt3(double v);
+char *Fmt6(double v);
+char *FmtBuffer(void);
 // End local prototypes
 
 void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
@@ -64,6 +72,12 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 
 	FILE *fp;
 
+	// The binary path data dump is written by DumpPathBin()
+	if(ITURHFP.binary == TRUE) {
+		DumpPathBin(path, ITURHFP);
+		return;
+	};
+
 	// Alias the output file for readability
 	fp = ITURHFP.rptfp;
 
@@ -83,17 +97,17 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 	fprintf(fp, "\tMonth = %s\n", months[path.month]); 
 	fprintf(fp, "\tHour  = %d (hour UTC)\n", path.hour + 1);
 	fprintf(fp, "\tSSN (R12) = %d\n", path.SSN);
-	fprintf(fp, "\tTx power = % 5.3lf (dB(1kW))\n", path.txpower);
+	fprintf(fp, "\tTx power = %s (dB(1kW))\n", Fmt3(path.txpower));
 	fprintf(fp, "\tTx Location %s\n", path.txname);
-	fprintf(fp, "\tTx latitude  = % 5.3lf (% 5.3lf) [% d %d %d]\n", path.L_tx.lat, path.L_tx.lat*R2D, degrees(path.L_tx.lat*R2D), minutes(path.L_tx.lat*R2D), seconds(path.L_tx.lat*R2D));
-	fprintf(fp, "\tTx longitude = % 5.3lf (% 5.3lf) [% d %d %d]\n", path.L_tx.lng, path.L_tx.lng*R2D, degrees(path.L_tx.lng*R2D), minutes(path.L_tx.lng*R2D), seconds(path.L_tx.lng*R2D));
+	fprintf(fp, "\tTx latitude  = %s (%s) [% d %d %d]\n", Fmt3(path.L_tx.lat), Fmt3(path.L_tx.lat*R2D), degrees(path.L_tx.lat*R2D), minutes(path.L_tx.lat*R2D), seconds(path.L_tx.lat*R2D));
+	fprintf(fp, "\tTx longitude = %s (%s) [% d %d %d]\n", Fmt3(path.L_tx.lng), Fmt3(path.L_tx.lng*R2D), degrees(path.L_tx.lng*R2D), minutes(path.L_tx.lng*R2D), seconds(path.L_tx.lng*R2D));
 	fprintf(fp, "\tRx Location %s\n", path.rxname);
-	fprintf(fp, "\tRx latitude  = % 5.3lf (% 5.3lf) [% d %d %d]\n", path.L_rx.lat, path.L_rx.lat*R2D, degrees(path.L_rx.lat*R2D), minutes(path.L_rx.lat*R2D), seconds(path.L_rx.lat*R2D));
-	fprintf(fp, "\tRx longitude = % 5.3lf (% 5.3lf) [% d %d %d]\n", path.L_rx.lng, path.L_rx.lng*R2D, degrees(path.L_rx.lng*R2D), minutes(path.L_rx.lng*R2D), seconds(path.L_rx.lng*R2D));
+	fprintf(fp, "\tRx latitude  = %s (%s) [% d %d %d]\n", Fmt3(path.L_rx.lat), Fmt3(path.L_rx.lat*R2D), degrees(path.L_rx.lat*R2D), minutes(path.L_rx.lat*R2D), seconds(path.L_rx.lat*R2D));
+	fprintf(fp, "\tRx longitude = %s (%s) [% d %d %d]\n", Fmt3(path.L_rx.lng), Fmt3(path.L_rx.lng*R2D), degrees(path.L_rx.lng*R2D), minutes(path.L_rx.lng*R2D), seconds(path.L_rx.lng*R2D));
 	fprintf(fp, "\tlocal time Rx   = % 02d \n", path.hour + 1 + (int)(path.L_rx.lng/(15.0*D2R)));
 	fprintf(fp, "\tlocal time Tx   = % 02d \n", path.hour + 1 + (int)(path.L_tx.lng/(15.0*D2R)));
-	fprintf(fp, "\tFrequency = % 5.3lf (MHz)\n", path.frequency);
-	fprintf(fp, "\tBandwidth = % 5.3lf (Hz)\n", path.BW);
+	fprintf(fp, "\tFrequency = %s (MHz)\n", Fmt3(path.frequency));
+	fprintf(fp, "\tBandwidth = %s (Hz)\n", Fmt3(path.BW));
 	fprintf(fp, "\tShort or Long Path = %s\n", SorL[path.SorL]);
 	
 	if(path.Modulation == ANALOG) {
@@ -105,9 +119,9 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 		fprintf(fp, "\tModulation = %s\n", outstr); 
 	};
 
-	fprintf(fp, "\tRequired signal-to-noise ratio = % 5.3lf\n", path.SNRr);
+	fprintf(fp, "\tRequired signal-to-noise ratio = %s\n", Fmt3(path.SNRr));
 	fprintf(fp, "\tRequired Reliability (%%) = % d\n", path.SNRXXp);
-	fprintf(fp, "\tRequired signal-to-interference ratio = % 5.3lf\n", path.SIRr);		
+	fprintf(fp, "\tRequired signal-to-interference ratio = %s\n", Fmt3(path.SIRr));		
 
 	if(path.noiseP.ManMadeNoise == CITY) {
 		strcpy(outstr, "CITY");
@@ -134,15 +148,15 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 		fprintf(fp, "\tMan-made noise = %s\n", outstr);
 	}
 	else {
-		fprintf(fp, "\tMan-made noise = % 5.3lf (dB)\n", path.noiseP.ManMadeNoise);
+		fprintf(fp, "\tMan-made noise = %s (dB)\n", Fmt3(path.noiseP.ManMadeNoise));
 	}
 
 	if(path.Modulation == DIGITAL) {
-		fprintf(fp, "\tFrequency dispersion for simple BCR (F0) = % 5.3lf (Hz)\n", path.F0);			// Frequency dispersion at a level -10 dB relative to the peak signal amplitude
-		fprintf(fp, "\tTime spread for simple BCR (T0)          = % 5.3lf (mS)\n", path.T0);
-		fprintf(fp, "\tRequired Amplitude ratio (A)             = % 5.3lf (dB)\n", path.A);
-		fprintf(fp, "\tTime window                              = % 5.3lf (mS)\n", path.TW);	 
-		fprintf(fp, "\tFrequency window                         = % 5.3lf (Hz)\n", path.FW);			
+		fprintf(fp, "\tFrequency dispersion for simple BCR (F0) = %s (Hz)\n", Fmt3(path.F0));			// Frequency dispersion at a level -10 dB relative to the peak signal amplitude
+		fprintf(fp, "\tTime spread for simple BCR (T0)          = %s (mS)\n", Fmt3(path.T0));
+		fprintf(fp, "\tRequired Amplitude ratio (A)             = %s (dB)\n", Fmt3(path.A));
+		fprintf(fp, "\tTime window                              = %s (mS)\n", Fmt3(path.TW));	 
+		fprintf(fp, "\tFrequency window                         = %s (Hz)\n", Fmt3(path.FW));			
 	};
 
 	if(ITURHFP.AntennaOrientation == TX2RX) {
@@ -156,27 +170,27 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 	};
 
 	fprintf(fp, "\tTransmit antenna %.40s\n", path.A_tx.Name);
-	fprintf(fp, "\tTransmit antenna bearing = %lf\n", ITURHFP.TXBearing*R2D);
-	fprintf(fp, "\tTransmit antenna gain offset = %lf\n", ITURHFP.TXGOS);
+	fprintf(fp, "\tTransmit antenna bearing = %s\n", Fmt6(ITURHFP.TXBearing*R2D));
+	fprintf(fp, "\tTransmit antenna gain offset = %s\n", Fmt6(ITURHFP.TXGOS));
 	fprintf(fp, "\tReceive antenna  %.40s\n", path.A_rx.Name);
-	fprintf(fp, "\tReceive antenna bearing = %lf\n", ITURHFP.RXBearing*R2D);
-	fprintf(fp, "\tReceive antenna gain offset = %lf\n", ITURHFP.RXGOS);
+	fprintf(fp, "\tReceive antenna bearing = %s\n", Fmt6(ITURHFP.RXBearing*R2D));
+	fprintf(fp, "\tReceive antenna gain offset = %s\n", Fmt6(ITURHFP.RXGOS));
 
 	fprintf(fp, "**********************************************************\n");
 	fprintf(fp, "*                 Calculated Parameters                  *\n");
 	fprintf(fp, "**********************************************************\n");
 	fprintf(fp, "****************** Distances (km) ************************\n");
-	fprintf(fp, "\tdistance = % 5.3lf\n", path.distance);
-	fprintf(fp, "\tslant range = % 5.3lf\n", path.ptick);
-	fprintf(fp, "\tdmax     = % 5.3lf\n", path.dmax);
+	fprintf(fp, "\tdistance = %s\n", Fmt3(path.distance));
+	fprintf(fp, "\tslant range = %s\n", Fmt3(path.ptick));
+	fprintf(fp, "\tdmax     = %s\n", Fmt3(path.dmax));
 	fprintf(fp, "************ Maximum Usable Frequencies (MHz) ************\n");
-	fprintf(fp, "\tbasic MUF       = % 5.3lf\n", path.BMUF);
-	fprintf(fp, "\t10%% MUF         = % 5.3lf\n", path.MUF10);
-	fprintf(fp, "\t50%% MUF         = % 5.3lf\n", path.MUF50);
-	fprintf(fp, "\t90%% MUF         = % 5.3lf\n", path.MUF90);
-	fprintf(fp, "\tOperational MUF = % 5.3lf\n", path.OPMUF);
-	fprintf(fp, "\t10%% OPMUF       = % 5.3lf\n", path.OPMUF10);
-	fprintf(fp, "\t90%% OPMUF       = % 5.3lf\n", path.OPMUF90);
+	fprintf(fp, "\tbasic MUF       = %s\n", Fmt3(path.BMUF));
+	fprintf(fp, "\t10%% MUF         = %s\n", Fmt3(path.MUF10));
+	fprintf(fp, "\t50%% MUF         = %s\n", Fmt3(path.MUF50));
+	fprintf(fp, "\t90%% MUF         = %s\n", Fmt3(path.MUF90));
+	fprintf(fp, "\tOperational MUF = %s\n", Fmt3(path.OPMUF));
+	fprintf(fp, "\t10%% OPMUF       = %s\n", Fmt3(path.OPMUF10));
+	fprintf(fp, "\t90%% OPMUF       = %s\n", Fmt3(path.OPMUF90));
 	fprintf(fp, "********* Lowest Order and Dominant Mode *****************\n");
 	if(path.n0_F2 != 99) 
 		sprintf(outstr, "%2d", path.n0_F2+1);
@@ -207,118 +221,118 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 	fprintf(fp, "\tseason = %s\n", season[2 - path.season]);
 
 	fprintf(fp, "****** Field Strength (dB(1 uV/m)) and Rx Power (dBW) *****\n");
-	fprintf(fp, "\tField Strength (7000 km > D)           = % 5.3lf\n", path.Es);
-	fprintf(fp, "\tField Strength (7000 km < D < 9000 km) = % 5.3lf\n", path.Ei);
-	fprintf(fp, "\tField Strength           (D > 9000 km) = % 5.3lf\n", path.El);
-	fprintf(fp, "\tMedian Rx power = % 5.3lf\n", path.Pr);
+	fprintf(fp, "\tField Strength (7000 km > D)           = %s\n", Fmt3(path.Es));
+	fprintf(fp, "\tField Strength (7000 km < D < 9000 km) = %s\n", Fmt3(path.Ei));
+	fprintf(fp, "\tField Strength           (D > 9000 km) = %s\n", Fmt3(path.El));
+	fprintf(fp, "\tMedian Rx power = %s\n", Fmt3(path.Pr));
 	fprintf(fp, "**************** Rx Elevation Angle (degs)****************\n");
-	fprintf(fp, "\tRx Elevation angle = % 5.3lf\n", path.ele*R2D);
+	fprintf(fp, "\tRx Elevation angle = %s\n", Fmt3(path.ele*R2D));
 
 		
 	// Print the short path parameters if the distance is less than 9000
 	if(path.distance < 9000.0) {
 		fprintf(fp, "***************** Short Path Parameters *******************\n");
-		fprintf(fp, "\t\"Not otherwise included loss\" (dB) = % 5.3lf\n", path.Lz);
+		fprintf(fp, "\t\"Not otherwise included loss\" (dB) = %s\n", Fmt3(path.Lz));
 	};
 	
 	// Print the long path parameters if the distance is greater than 7000
 	if(path.distance > 7000.0) {
 		fprintf(fp, "***************** Long Path Parameters *******************\n");
-		fprintf(fp, "\tFree-space Field Strength 3 MW e.i.r.p. (dB(1uV/m) = % 5.3lf\n", path.E0);
-		fprintf(fp, "\tIncreased Long Distance Field Strength due to Focusing (dB) = % 5.3lf\n", path.Gap);
-		fprintf(fp, "\t\"Not otherwise included loss\" (dB) = % 5.3lf\n", path.Ly);
-		fprintf(fp, "\tUpper Reference Frequency (MHz)      = % 5.3lf\n", path.fM);
-		fprintf(fp, "\tLower Reference Frequency (MHz)      = % 5.3lf\n", path.fL);
-		fprintf(fp, "\tCorrection Factor at T + dM/2        = % 5.3lf\n", path.K[0]);
-		fprintf(fp, "\tCorrection Factor at R - dM/2        = % 5.3lf\n", path.K[1]);
-		fprintf(fp, "\tMax Antenna Gain G_tl (0 to 8 deg)   = % 5.3lf\n", path.Gtl);
-		fprintf(fp, "\tMax Antenna Gain G_w (0 to 8 deg)    = % 5.3lf\n", path.Grw);
-		fprintf(fp, "\tMean gyrofrequency (T + dM/2 & R - dM/2) = % 5.3lf\n", path.fH);
-		fprintf(fp, "\tScale factor f(f ,fL, fM, fH)        = % 5.3lf\n", path.F);
+		fprintf(fp, "\tFree-space Field Strength 3 MW e.i.r.p. (dB(1uV/m) = %s\n", Fmt3(path.E0));
+		fprintf(fp, "\tIncreased Long Distance Field Strength due to Focusing (dB) = %s\n", Fmt3(path.Gap));
+		fprintf(fp, "\t\"Not otherwise included loss\" (dB) = %s\n", Fmt3(path.Ly));
+		fprintf(fp, "\tUpper Reference Frequency (MHz)      = %s\n", Fmt3(path.fM));
+		fprintf(fp, "\tLower Reference Frequency (MHz)      = %s\n", Fmt3(path.fL));
+		fprintf(fp, "\tCorrection Factor at T + dM/2        = %s\n", Fmt3(path.K[0]));
+		fprintf(fp, "\tCorrection Factor at R - dM/2        = %s\n", Fmt3(path.K[1]));
+		fprintf(fp, "\tMax Antenna Gain G_tl (0 to 8 deg)   = %s\n", Fmt3(path.Gtl));
+		fprintf(fp, "\tMax Antenna Gain G_w (0 to 8 deg)    = %s\n", Fmt3(path.Grw));
+		fprintf(fp, "\tMean gyrofrequency (T + dM/2 & R - dM/2) = %s\n", Fmt3(path.fH));
+		fprintf(fp, "\tScale factor f(f ,fL, fM, fH)        = %s\n", Fmt3(path.F));
 	};
 
 	// Noise
 	fprintf(fp, "***************** Noise Parameters (dB) *******************\n");
-	fprintf(fp, "\tAtmospheric noise upper decile = % 5.3lf\n", path.noiseP.DuA); 
-	fprintf(fp, "\tAtmospheric noise lower decile = % 5.3lf\n", path.noiseP.DlA);  // 
-	fprintf(fp, "\tAtmospheric noise              = % 5.3lf\n", path.noiseP.FaA);	 // 
-	fprintf(fp, "\tMan made noise upper decile    = % 5.3lf\n", path.noiseP.DuM);  
-	fprintf(fp, "\tMan made noise lower decile    = % 5.3lf\n", path.noiseP.DlM); 
-	fprintf(fp, "\tMan made noise                 = % 5.3lf\n", path.noiseP.FaM); 
-	fprintf(fp, "\tGalactic noise upper decile    = % 5.3lf\n", path.noiseP.DuG); 
-	fprintf(fp, "\tGalactic noise lower decile    = % 5.3lf\n", path.noiseP.DlG); 
-	fprintf(fp, "\tGalactic noise                 = % 5.3lf\n", path.noiseP.FaG);
-	fprintf(fp, "\tTotal noise upper decile       = % 5.3lf\n", path.noiseP.DuT); 
-	fprintf(fp, "\tTotal noise lower decile       = % 5.3lf\n", path.noiseP.DlT); 
-	fprintf(fp, "\tTotal noise                    = % 5.3lf\n", path.noiseP.FamT);
+	fprintf(fp, "\tAtmospheric noise upper decile = %s\n", Fmt3(path.noiseP.DuA)); 
+	fprintf(fp, "\tAtmospheric noise lower decile = %s\n", Fmt3(path.noiseP.DlA));  // 
+	fprintf(fp, "\tAtmospheric noise              = %s\n", Fmt3(path.noiseP.FaA));	 // 
+	fprintf(fp, "\tMan made noise upper decile    = %s\n", Fmt3(path.noiseP.DuM));  
+	fprintf(fp, "\tMan made noise lower decile    = %s\n", Fmt3(path.noiseP.DlM)); 
+	fprintf(fp, "\tMan made noise                 = %s\n", Fmt3(path.noiseP.FaM)); 
+	fprintf(fp, "\tGalactic noise upper decile    = %s\n", Fmt3(path.noiseP.DuG)); 
+	fprintf(fp, "\tGalactic noise lower decile    = %s\n", Fmt3(path.noiseP.DlG)); 
+	fprintf(fp, "\tGalactic noise                 = %s\n", Fmt3(path.noiseP.FaG));
+	fprintf(fp, "\tTotal noise upper decile       = %s\n", Fmt3(path.noiseP.DuT)); 
+	fprintf(fp, "\tTotal noise lower decile       = %s\n", Fmt3(path.noiseP.DlT)); 
+	fprintf(fp, "\tTotal noise                    = %s\n", Fmt3(path.noiseP.FamT));
 
 	fprintf(fp, "********************** SNR Parameters (dB) *************************************\n");
-	fprintf(fp, "\tMonthly median resultant signal-to-noise ratio = % 5.3lf\n", path.SNR);	
-	fprintf(fp, "\tUpper decile deviation signal-to-noise ratio   = % 5.3lf\n", path.DuSN);
-	fprintf(fp, "\tLower decile deviation signal-to-noise ratio   = % 5.3lf\n", path.DlSN); 
-	fprintf(fp, "\tSignal-to-noise exceeded for %d%% of the month  = % 5.3lf\n", path.SNRXXp, path.SNRXX);
+	fprintf(fp, "\tMonthly median resultant signal-to-noise ratio = %s\n", Fmt3(path.SNR));	
+	fprintf(fp, "\tUpper decile deviation signal-to-noise ratio   = %s\n", Fmt3(path.DuSN));
+	fprintf(fp, "\tLower decile deviation signal-to-noise ratio   = %s\n", Fmt3(path.DlSN)); 
+	fprintf(fp, "\tSignal-to-noise exceeded for %d%% of the month  = %s\n", path.SNRXXp, Fmt3(path.SNRXX));
 
 	fprintf(fp, "********************** SIR Parameters (dB) *************************************\n");
-	fprintf(fp, "\tSignal-to-interference ratio = % 5.3lf\n", path.SIR);
-	fprintf(fp, "\tUpper decile deviation of the signal-to-interference ratio = % 5.3lf\n", path.DuSI);
-	fprintf(fp, "\tLower decile deviation of the signal-to-interference ratio = % 5.3lf\n", path.DlSI);
+	fprintf(fp, "\tSignal-to-interference ratio = %s\n", Fmt3(path.SIR));
+	fprintf(fp, "\tUpper decile deviation of the signal-to-interference ratio = %s\n", Fmt3(path.DuSI));
+	fprintf(fp, "\tLower decile deviation of the signal-to-interference ratio = %s\n", Fmt3(path.DlSI));
 
 	fprintf(fp, "******************** Reliability Parameters (%%) *******************************\n");
-	fprintf(fp, "\tBasic Circuit Reliability                      = % 5.3lf\n", path.BCR);  // 
-	fprintf(fp, "\tMultimode Interference                         = % 5.3lf\n", path.MIR);  //
-	fprintf(fp, "\tOverall Circuit Reliability without scattering = % 5.3lf\n", path.OCR);  // 
-	fprintf(fp, "\tOverall Circuit Reliability with scattering    = % 5.3lf\n", path.OCRs); // 
-	fprintf(fp, "\tProbability of scattering                      = % 5.3lf\n", path.probocc);
-	fprintf(fp, "\tProbability required SNR is achieved                      = % 5.3lf\n", path.RSN); 
-	fprintf(fp, "\tProbability required time spread T0 is not exceeded       = % 5.3lf\n", path.RT);	 
-	fprintf(fp, "\tProbability required frequency spread f0 is not exceeded  = % 5.3lf\n", path.RF);
+	fprintf(fp, "\tBasic Circuit Reliability                      = %s\n", Fmt3(path.BCR));  // 
+	fprintf(fp, "\tMultimode Interference                         = %s\n", Fmt3(path.MIR));  //
+	fprintf(fp, "\tOverall Circuit Reliability without scattering = %s\n", Fmt3(path.OCR));  // 
+	fprintf(fp, "\tOverall Circuit Reliability with scattering    = %s\n", Fmt3(path.OCRs)); // 
+	fprintf(fp, "\tProbability of scattering                      = %s\n", Fmt3(path.probocc));
+	fprintf(fp, "\tProbability required SNR is achieved                      = %s\n", Fmt3(path.RSN)); 
+	fprintf(fp, "\tProbability required time spread T0 is not exceeded       = %s\n", Fmt3(path.RT));	 
+	fprintf(fp, "\tProbability required frequency spread f0 is not exceeded  = %s\n", Fmt3(path.RF));
 
 	if(path.distance < 9000) { // Don't print the modes out if they are not calculated
 		for(i=0; i<MAXF2MDS; i++) {
 			fprintf(fp, "**********************************************************\n");
 			fprintf(fp, "*                      F2 Mode %d                         *\n", i+1);
 			fprintf(fp, "**********************************************************\n");
-			fprintf(fp, "\tbasic MUF  = % 5.3lf (MHz)\n", path.Md_F2[i].BMUF);
-			fprintf(fp, "\t10%% MUF    = % 5.3lf (MHz)\n",path.Md_F2[i].MUF10);
-			fprintf(fp, "\t50%% MUF    = % 5.3lf (MHz)\n",path.Md_F2[i].MUF50); 
-			fprintf(fp, "\t90%% MUF    = % 5.3lf (MHz)\n",path.Md_F2[i].MUF90); 
-			fprintf(fp, "\tOPMUF      = % 5.3lf (MHz)\n",path.Md_F2[i].OPMUF); 
-			fprintf(fp, "\t10%% OPMUF  = % 5.3lf (MHz)\n",path.Md_F2[i].OPMUF10); 
-			fprintf(fp, "\t90%% OPMUF  = % 5.3lf (MHz)\n",path.Md_F2[i].OPMUF90); 
-			fprintf(fp, "\tFprob        = % 5.3lf (%%)\n",path.Md_F2[i].Fprob); 
-			fprintf(fp, "\tLower decile = % 5.3lf\n",path.Md_F2[i].deltal);
-			fprintf(fp, "\tUpper decile = % 5.3lf\n",path.Md_F2[i].deltau); 
-			fprintf(fp, "\tE Layer Screen Frequency  = % 5.3lf (MHz)\n", path.Md_F2[i].fs);
-			fprintf(fp, "\tBasic Loss (< 7000 km)    = % 5.3lf (dB)\n", path.Md_F2[i].Lb);
-			fprintf(fp, "\tMedian Field Strength     = % 5.3lf (dB(1 uV/m))\n", path.Md_F2[i].Ew);
-			fprintf(fp, "\tReceiver Power            = % 5.3lf (dBW)\n", path.Md_F2[i].Prw);
-			fprintf(fp, "\tDelay                     = % 5.3lf (mS)\n", path.Md_F2[i].tau*1000.0);
-			fprintf(fp, "\tElevation angle   = % 5.3lf (degs)\n", path.Md_F2[i].ele*R2D);
-			fprintf(fp, "\tReflection height = % 5.3lf (km)\n", path.Md_F2[i].hr);
-			fprintf(fp, "\tReceiver Gain = % 5.3lf (dBi)\n", path.Md_F2[i].Grw);
+			fprintf(fp, "\tbasic MUF  = %s (MHz)\n", Fmt3(path.Md_F2[i].BMUF));
+			fprintf(fp, "\t10%% MUF    = %s (MHz)\n", Fmt3(path.Md_F2[i].MUF10));
+			fprintf(fp, "\t50%% MUF    = %s (MHz)\n", Fmt3(path.Md_F2[i].MUF50)); 
+			fprintf(fp, "\t90%% MUF    = %s (MHz)\n", Fmt3(path.Md_F2[i].MUF90)); 
+			fprintf(fp, "\tOPMUF      = %s (MHz)\n", Fmt3(path.Md_F2[i].OPMUF)); 
+			fprintf(fp, "\t10%% OPMUF  = %s (MHz)\n", Fmt3(path.Md_F2[i].OPMUF10)); 
+			fprintf(fp, "\t90%% OPMUF  = %s (MHz)\n", Fmt3(path.Md_F2[i].OPMUF90)); 
+			fprintf(fp, "\tFprob        = %s (%%)\n", Fmt3(path.Md_F2[i].Fprob)); 
+			fprintf(fp, "\tLower decile = %s\n", Fmt3(path.Md_F2[i].deltal));
+			fprintf(fp, "\tUpper decile = %s\n", Fmt3(path.Md_F2[i].deltau)); 
+			fprintf(fp, "\tE Layer Screen Frequency  = %s (MHz)\n", Fmt3(path.Md_F2[i].fs));
+			fprintf(fp, "\tBasic Loss (< 7000 km)    = %s (dB)\n", Fmt3(path.Md_F2[i].Lb));
+			fprintf(fp, "\tMedian Field Strength     = %s (dB(1 uV/m))\n", Fmt3(path.Md_F2[i].Ew));
+			fprintf(fp, "\tReceiver Power            = %s (dBW)\n", Fmt3(path.Md_F2[i].Prw));
+			fprintf(fp, "\tDelay                     = %s (mS)\n", Fmt3(path.Md_F2[i].tau*1000.0));
+			fprintf(fp, "\tElevation angle   = %s (degs)\n", Fmt3(path.Md_F2[i].ele*R2D));
+			fprintf(fp, "\tReflection height = %s (km)\n", Fmt3(path.Md_F2[i].hr));
+			fprintf(fp, "\tReceiver Gain = %s (dBi)\n", Fmt3(path.Md_F2[i].Grw));
 		};
 
 			for(i=0; i<MAXEMDS; i++) {
 			fprintf(fp, "**********************************************************\n");
 			fprintf(fp, "*                       E Mode %d                         *\n", i+1);
 			fprintf(fp, "**********************************************************\n");
-			fprintf(fp, "\tbasic MUF  = % 5.3lf (MHz)\n", path.Md_E[i].BMUF);
-			fprintf(fp, "\t10%% MUF    = % 5.3lf (MHz)\n",path.Md_E[i].MUF10);
-			fprintf(fp, "\t50%% MUF    = % 5.3lf (MHz)\n",path.Md_E[i].MUF50); 
-			fprintf(fp, "\t90%% MUF    = % 5.3lf (MHz)\n",path.Md_E[i].MUF90);  
-			fprintf(fp, "\tOPMUF      = % 5.3lf (MHz)\n",path.Md_E[i].OPMUF); 
-			fprintf(fp, "\t10%% OPMUF  = % 5.3lf (MHz)\n",path.Md_E[i].OPMUF10); 
-			fprintf(fp, "\t90%% OPMUF  = % 5.3lf (MHz)\n",path.Md_E[i].OPMUF90); 
-			fprintf(fp, "\tFprob        = % 5.3lf (%%)\n",path.Md_E[i].Fprob); 
-			fprintf(fp, "\tLower decile = % 5.3lf\n",path.Md_E[i].deltal);
-			fprintf(fp, "\tUpper decile = % 5.3lf\n",path.Md_E[i].deltau);  
-			fprintf(fp, "\tBasic Loss (< 7000 km)    = % 5.3lf (dB)\n", path.Md_E[i].Lb);
-			fprintf(fp, "\tMedian Field Strength     = % 5.3lf (dB(1 uV/m))\n", path.Md_E[i].Ew);
-			fprintf(fp, "\tReceiver Power            = % 5.3lf (dBW)\n", path.Md_E[i].Prw);
-			fprintf(fp, "\tDelay                     = % 5.3lf (mS)\n", path.Md_E[i].tau*1000.0);
-			fprintf(fp, "\tElevation angle   = % 5.3lf (degs)\n", path.Md_E[i].ele*R2D);
-			fprintf(fp, "\tReflection height = % 5.3lf (km)\n", path.Md_E[i].hr);
-			fprintf(fp, "\tReceiver Gain = % 5.3lf (dBi)\n", path.Md_E[i].Grw);
+			fprintf(fp, "\tbasic MUF  = %s (MHz)\n", Fmt3(path.Md_E[i].BMUF));
+			fprintf(fp, "\t10%% MUF    = %s (MHz)\n", Fmt3(path.Md_E[i].MUF10));
+			fprintf(fp, "\t50%% MUF    = %s (MHz)\n", Fmt3(path.Md_E[i].MUF50)); 
+			fprintf(fp, "\t90%% MUF    = %s (MHz)\n", Fmt3(path.Md_E[i].MUF90));  
+			fprintf(fp, "\tOPMUF      = %s (MHz)\n", Fmt3(path.Md_E[i].OPMUF)); 
+			fprintf(fp, "\t10%% OPMUF  = %s (MHz)\n", Fmt3(path.Md_E[i].OPMUF10)); 
+			fprintf(fp, "\t90%% OPMUF  = %s (MHz)\n", Fmt3(path.Md_E[i].OPMUF90)); 
+			fprintf(fp, "\tFprob        = %s (%%)\n", Fmt3(path.Md_E[i].Fprob)); 
+			fprintf(fp, "\tLower decile = %s\n", Fmt3(path.Md_E[i].deltal));
+			fprintf(fp, "\tUpper decile = %s\n", Fmt3(path.Md_E[i].deltau));  
+			fprintf(fp, "\tBasic Loss (< 7000 km)    = %s (dB)\n", Fmt3(path.Md_E[i].Lb));
+			fprintf(fp, "\tMedian Field Strength     = %s (dB(1 uV/m))\n", Fmt3(path.Md_E[i].Ew));
+			fprintf(fp, "\tReceiver Power            = %s (dBW)\n", Fmt3(path.Md_E[i].Prw));
+			fprintf(fp, "\tDelay                     = %s (mS)\n", Fmt3(path.Md_E[i].tau*1000.0));
+			fprintf(fp, "\tElevation angle   = %s (degs)\n", Fmt3(path.Md_E[i].ele*R2D));
+			fprintf(fp, "\tReflection height = %s (km)\n", Fmt3(path.Md_E[i].hr));
+			fprintf(fp, "\tReceiver Gain = %s (dBi)\n", Fmt3(path.Md_E[i].Grw));
 		};
 	};
 	
@@ -332,22 +346,22 @@ void DumpPathData(struct PathData path, struct ITURHFProp ITURHFP) {
 		fprintf(fp, "**********************************************************\n");
 		fprintf(fp, "*          %s - %s       *\n", cpt[i+cpk], cp[i+cpk]);
 		fprintf(fp, "**********************************************************\n");
-		fprintf(fp, "\tLatitude\t=\t% 5.3lf\t(% 5.3lf)\t[%d %d %d]\n", path.CP[i].L.lat, path.CP[i].L.lat*R2D, degrees(path.CP[i].L.lat*R2D), minutes(path.CP[i].L.lat*R2D), seconds(path.CP[i].L.lat*R2D));
-		fprintf(fp, "\tLongitude\t=\t% 5.3lf\t(% 5.3lf)\t[%d %d %d]\n", path.CP[i].L.lng, path.CP[i].L.lng*R2D, degrees(path.CP[i].L.lng*R2D), minutes(path.CP[i].L.lng*R2D), seconds(path.CP[i].L.lng*R2D));
-		fprintf(fp, "\tdistance = % 5.3lf\n", path.CP[i].distance);
-		fprintf(fp, "\tMagnetic dip (100 km)  = % 5.3lf (deg)\n", path.CP[i].dip[HR100km]*R2D); 
-		fprintf(fp, "\tGyrofrequency (100 km) = % 5.3lf (MHz)\n", path.CP[i].fH[HR100km]);
-		fprintf(fp, "\tMagnetic dip (300 km)  = % 5.3lf (deg)\n", path.CP[i].dip[HR300km]*R2D); 
-		fprintf(fp, "\tGyrofrequency (300 km) = % 5.3lf (MHz)\n", path.CP[i].fH[HR300km]); 
-		fprintf(fp, "\tM(3000)F2 = % 5.3lf\n", path.CP[i].M3kF2);
-		fprintf(fp, "\tfoE   = % 5.3lf (MHz)\n", path.CP[i].foE);
-		fprintf(fp, "\tfoF2  = % 5.3lf (MHz)\n", path.CP[i].foF2);
+		fprintf(fp, "\tLatitude\t=\t%s\t(%s)\t[%d %d %d]\n", Fmt3(path.CP[i].L.lat), Fmt3(path.CP[i].L.lat*R2D), degrees(path.CP[i].L.lat*R2D), minutes(path.CP[i].L.lat*R2D), seconds(path.CP[i].L.lat*R2D));
+		fprintf(fp, "\tLongitude\t=\t%s\t(%s)\t[%d %d %d]\n", Fmt3(path.CP[i].L.lng), Fmt3(path.CP[i].L.lng*R2D), degrees(path.CP[i].L.lng*R2D), minutes(path.CP[i].L.lng*R2D), seconds(path.CP[i].L.lng*R2D));
+		fprintf(fp, "\tdistance = %s\n", Fmt3(path.CP[i].distance));
+		fprintf(fp, "\tMagnetic dip (100 km)  = %s (deg)\n", Fmt3(path.CP[i].dip[HR100km]*R2D)); 
+		fprintf(fp, "\tGyrofrequency (100 km) = %s (MHz)\n", Fmt3(path.CP[i].fH[HR100km]));
+		fprintf(fp, "\tMagnetic dip (300 km)  = %s (deg)\n", Fmt3(path.CP[i].dip[HR300km]*R2D)); 
+		fprintf(fp, "\tGyrofrequency (300 km) = %s (MHz)\n", Fmt3(path.CP[i].fH[HR300km])); 
+		fprintf(fp, "\tM(3000)F2 = %s\n", Fmt3(path.CP[i].M3kF2));
+		fprintf(fp, "\tfoE   = %s (MHz)\n", Fmt3(path.CP[i].foE));
+		fprintf(fp, "\tfoF2  = %s (MHz)\n", Fmt3(path.CP[i].foF2));
 		// The reflection height is calculated at the mid path point so print it
-		if(i == MP) fprintf(fp, "\treflection height  = % 5.3lf (km)\n", path.CP[i].hr);
-		fprintf(fp, "\tsolar zenith angle = % 5.3lf (deg)\n", path.CP[i].Sun.sza*R2D); 
-		fprintf(fp, "\tsolar declination  = % 5.3lf (deg)\n", path.CP[i].Sun.decl*R2D); 
-		fprintf(fp, "\tsolar hour angle   = % 5.3lf (deg)\n", path.CP[i].Sun.ha*R2D); 
-		fprintf(fp, "\tequation of time   = % 5.3lf (minutes)\n", path.CP[i].Sun.eot); 
+		if(i == MP) fprintf(fp, "\treflection height  = %s (km)\n", Fmt3(path.CP[i].hr));
+		fprintf(fp, "\tsolar zenith angle = %s (deg)\n", Fmt3(path.CP[i].Sun.sza*R2D)); 
+		fprintf(fp, "\tsolar declination  = %s (deg)\n", Fmt3(path.CP[i].Sun.decl*R2D)); 
+		fprintf(fp, "\tsolar hour angle   = %s (deg)\n", Fmt3(path.CP[i].Sun.ha*R2D)); 
+		fprintf(fp, "\tequation of time   = %s (minutes)\n", Fmt3(path.CP[i].Sun.eot)); 
 		// Determine the tz of the control point
 		tz = (int)(path.CP[i].L.lng/(15.0*D2R));
 		ltime = fmod(path.CP[i].Sun.lsr+tz, 24);
@@ -401,4 +415,52 @@ void PrintITUHeader(FILE *fp, char * time, char const * P533Version, const char
 	fprintf(fp, "\n");
 };
 
+char *Fmt3(double v) {
+
+	/*
+	 * Fmt3() - Returns the text of v as printf() gives with "% 5.3lf". The values are formatted by PutFixed()
+	 *		since printf() is slow and depends on the locale.
+	 */
+
+	char *s;
+
+	s = FmtBuffer();
+	s[PutFixed(s, v, 5, 3, TRUE)] = '\0';
+
+	return s;
+
+};
+
+char *Fmt6(double v) {
+
+	/*
+	 * Fmt6() - Returns the text of v as printf() gives with "%lf"
+	 */
 
+	char *s;
+
+	s = FmtBuffer();
+	s[PutFixed(s, v, 0, 6, FALSE)] = '\0';
+
+	return s;
+
+};
+
+char *FmtBuffer(void) {
+
+	/*
+	 * FmtBuffer() - Returns the next of DPDFMTS buffers so the values of one fprintf() don't overwrite each
+	 *		other. DumpPathData() is only run by one thread.
+	 */
+
+	static char buf[DPDFMTS][DPDFMTSIZE];
+	static int next = 0;
+
+	char *s;
+
+	s = buf[next];
+	next = (next + 1) % DPDFMTS;
+
+	return s;
+
+};
@@ -0,0 +1,935 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local #define
+#define FMTLIMBS		48			// 32 bit limbs of a big number, enough for 2^1076 * 10^FMTMAXPREC
+#define FMTMAXPREC		40			// Largest precision of PutFixed()
+#define FMTMAXDIGITS	17			// Digits that always identify a double
+#define GRISUPOWERS		87			// Cached powers of ten, 10^-348 to 10^340 in steps of 8
+// End local #define
+
+// Local structures
+// An unsigned integer of up to FMTLIMBS*32 bits, least significant limb first
+struct BigNum {
+	int n;
+	unsigned int d[FMTLIMBS];
+};
+
+// f*2^e with a 64 bit f
+struct DiyFp {
+	unsigned long long f;
+	int e;
+};
+
+// 10^k as f*2^e with f rounded to 64 bits
+struct CachedPower {
+	unsigned long long f;
+	short e;
+	short k;
+};
+// End local structures
+
+// Local prototypes
+int PutSpecial(char *s, double v, int width, int space);
+int PutFixedExact(char *s, double v, int width, int prec, int space);
+int ShortestDigits(double v, char *digits, int *exp10);
+int Grisu3(double v, char *digits, int *exp10);
+int DigitGen(struct DiyFp low, struct DiyFp w, struct DiyFp high, char *digits, int *kappa);
+int RoundWeed(char *digits, int n, unsigned long long distance, unsigned long long unsafe, unsigned long long rest,
+			  unsigned long long tenkappa, unsigned long long unit);
+struct DiyFp DiyMultiply(struct DiyFp a, struct DiyFp b);
+struct DiyFp DiyNormalize(struct DiyFp a);
+void Decompose(double v, unsigned long long *f, int *e);
+void BigSet(struct BigNum *b, unsigned long long v);
+void BigMulSmall(struct BigNum *b, unsigned int m);
+void BigMulPow10(struct BigNum *b, int k);
+void BigShl(struct BigNum *b, int bits);
+int BigShrRound(struct BigNum *b, int bits);
+void BigAdd(struct BigNum *r, const struct BigNum *a, const struct BigNum *b);
+void BigSub(struct BigNum *a, const struct BigNum *b);
+int BigCmp(const struct BigNum *a, const struct BigNum *b);
+unsigned int BigDivSmall(struct BigNum *b, unsigned int m);
+// End local prototypes
+
+// Local globals
+static const struct CachedPower Powers[GRISUPOWERS] = {
+	{0xfa8fd5a0081c0288ULL, -1220, -348},
+	{0xbaaee17fa23ebf76ULL, -1193, -340},
+	{0x8b16fb203055ac76ULL, -1166, -332},
+	{0xcf42894a5dce35eaULL, -1140, -324},
+	{0x9a6bb0aa55653b2dULL, -1113, -316},
+	{0xe61acf033d1a45dfULL, -1087, -308},
+	{0xab70fe17c79ac6caULL, -1060, -300},
+	{0xff77b1fcbebcdc4fULL, -1034, -292},
+	{0xbe5691ef416bd60cULL, -1007, -284},
+	{0x8dd01fad907ffc3cULL,  -980, -276},
+	{0xd3515c2831559a83ULL,  -954, -268},
+	{0x9d71ac8fada6c9b5ULL,  -927, -260},
+	{0xea9c227723ee8bcbULL,  -901, -252},
+	{0xaecc49914078536dULL,  -874, -244},
+	{0x823c12795db6ce57ULL,  -847, -236},
+	{0xc21094364dfb5637ULL,  -821, -228},
+	{0x9096ea6f3848984fULL,  -794, -220},
+	{0xd77485cb25823ac7ULL,  -768, -212},
+	{0xa086cfcd97bf97f4ULL,  -741, -204},
+	{0xef340a98172aace5ULL,  -715, -196},
+	{0xb23867fb2a35b28eULL,  -688, -188},
+	{0x84c8d4dfd2c63f3bULL,  -661, -180},
+	{0xc5dd44271ad3cdbaULL,  -635, -172},
+	{0x936b9fcebb25c996ULL,  -608, -164},
+	{0xdbac6c247d62a584ULL,  -582, -156},
+	{0xa3ab66580d5fdaf6ULL,  -555, -148},
+	{0xf3e2f893dec3f126ULL,  -529, -140},
+	{0xb5b5ada8aaff80b8ULL,  -502, -132},
+	{0x87625f056c7c4a8bULL,  -475, -124},
+	{0xc9bcff6034c13053ULL,  -449, -116},
+	{0x964e858c91ba2655ULL,  -422, -108},
+	{0xdff9772470297ebdULL,  -396, -100},
+	{0xa6dfbd9fb8e5b88fULL,  -369,  -92},
+	{0xf8a95fcf88747d94ULL,  -343,  -84},
+	{0xb94470938fa89bcfULL,  -316,  -76},
+	{0x8a08f0f8bf0f156bULL,  -289,  -68},
+	{0xcdb02555653131b6ULL,  -263,  -60},
+	{0x993fe2c6d07b7facULL,  -236,  -52},
+	{0xe45c10c42a2b3b06ULL,  -210,  -44},
+	{0xaa242499697392d3ULL,  -183,  -36},
+	{0xfd87b5f28300ca0eULL,  -157,  -28},
+	{0xbce5086492111aebULL,  -130,  -20},
+	{0x8cbccc096f5088ccULL,  -103,  -12},
+	{0xd1b71758e219652cULL,   -77,   -4},
+	{0x9c40000000000000ULL,   -50,    4},
+	{0xe8d4a51000000000ULL,   -24,   12},
+	{0xad78ebc5ac620000ULL,     3,   20},
+	{0x813f3978f8940984ULL,    30,   28},
+	{0xc097ce7bc90715b3ULL,    56,   36},
+	{0x8f7e32ce7bea5c70ULL,    83,   44},
+	{0xd5d238a4abe98068ULL,   109,   52},
+	{0x9f4f2726179a2245ULL,   136,   60},
+	{0xed63a231d4c4fb27ULL,   162,   68},
+	{0xb0de65388cc8ada8ULL,   189,   76},
+	{0x83c7088e1aab65dbULL,   216,   84},
+	{0xc45d1df942711d9aULL,   242,   92},
+	{0x924d692ca61be758ULL,   269,  100},
+	{0xda01ee641a708deaULL,   295,  108},
+	{0xa26da3999aef774aULL,   322,  116},
+	{0xf209787bb47d6b85ULL,   348,  124},
+	{0xb454e4a179dd1877ULL,   375,  132},
+	{0x865b86925b9bc5c2ULL,   402,  140},
+	{0xc83553c5c8965d3dULL,   428,  148},
+	{0x952ab45cfa97a0b3ULL,   455,  156},
+	{0xde469fbd99a05fe3ULL,   481,  164},
+	{0xa59bc234db398c25ULL,   508,  172},
+	{0xf6c69a72a3989f5cULL,   534,  180},
+	{0xb7dcbf5354e9beceULL,   561,  188},
+	{0x88fcf317f22241e2ULL,   588,  196},
+	{0xcc20ce9bd35c78a5ULL,   614,  204},
+	{0x98165af37b2153dfULL,   641,  212},
+	{0xe2a0b5dc971f303aULL,   667,  220},
+	{0xa8d9d1535ce3b396ULL,   694,  228},
+	{0xfb9b7cd9a4a7443cULL,   720,  236},
+	{0xbb764c4ca7a44410ULL,   747,  244},
+	{0x8bab8eefb6409c1aULL,   774,  252},
+	{0xd01fef10a657842cULL,   800,  260},
+	{0x9b10a4e5e9913129ULL,   827,  268},
+	{0xe7109bfba19c0c9dULL,   853,  276},
+	{0xac2820d9623bf429ULL,   880,  284},
+	{0x80444b5e7aa7cf85ULL,   907,  292},
+	{0xbf21e44003acdd2dULL,   933,  300},
+	{0x8e679c2f5e44ff8fULL,   960,  308},
+	{0xd433179d9c8cb841ULL,   986,  316},
+	{0x9e19db92b4e31ba9ULL,  1013,  324},
+	{0xeb96bf6ebadf77d9ULL,  1039,  332},
+	{0xaf87023b9bf0ee6bULL,  1066,  340}
+};
+// End local globals
+
+int PutFixed(char *s, double v, int width, int prec, int space) {
+
+	/*
+	 * PutFixed() - Writes v as printf() does with "%<width>.<prec>f", or "% <width>.<prec>f" if space is TRUE,
+	 *		and returns the number of characters. Nothing is terminated. The decimal point is always '.'
+	 *		whatever the locale.
+	 *
+	 *		printf() rounds the exact binary value to the precision, with ties to even. Here v*10^prec is found
+	 *		exactly as the sum hi + lo with fma(). rint() rounds hi, and lo only decides the few cases where hi
+	 *		falls on a tie. Values that are too large for this are rounded exactly by PutFixedExact().
+	 *
+	 *			INPUT
+	 *				char *s - At least max(width, 330 + prec) characters
+	 *				double v
+	 *				int width - Minimum field width
+	 *				int prec - Decimals, 0 to FMTMAXPREC
+	 *				int space - TRUE if a positive value is given a leading space
+	 *
+	 *			OUTPUT
+	 *				Returns the number of characters written to s
+	 *
+	 *			SUBROUTINES
+	 *				PutSpecial()
+	 *				PutFixedExact()
+	 */
+
+	static const double p10[10] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+	char digits[32];
+	char *d;
+
+	double a, p, hi, lo, n;
+
+	unsigned long long u;
+
+	int len;
+	int k;
+
+	if(isnan(v) || isinf(v)) {
+		return PutSpecial(s, v, width, space);
+	};
+
+	a = fabs(v);
+	if((prec > 9) || !(a < 4503599627370496.0/p10[prec])) { // 2^52
+		return PutFixedExact(s, v, width, prec, space);
+	};
+
+	p = p10[prec];
+	hi = a*p;
+	lo = fma(a, p, -hi);
+	n = rint(hi);
+	if((hi - n == 0.5) && (lo > 0.0)) n += 1.0;
+	else if((hi - n == -0.5) && (lo < 0.0)) n -= 1.0;
+	u = (unsigned long long)n;
+
+	// The digits are made backwards from the last decimal.
+	d = digits + sizeof(digits);
+	for(k=0; k<prec; k++) {
+		*--d = (char)('0' + u%10);
+		u /= 10;
+	};
+	if(prec > 0) *--d = '.';
+	do {
+		*--d = (char)('0' + u%10);
+		u /= 10;
+	} while(u != 0);
+	if(signbit(v)) *--d = '-';
+	else if(space == TRUE) *--d = ' ';
+
+	len = (int)(digits + sizeof(digits) - d);
+	for(k=len; k<width; k++) *s++ = ' ';
+	memcpy(s, d, len);
+
+	return max(len, width);
+};
+
+int PutShortest(char *s, double v) {
+
+	/*
+	 * PutShortest() - Writes the shortest decimal that reads back as v and returns the number of characters.
+	 *		Nothing is terminated. Of the decimals with the fewest digits the nearest to v is written. The
+	 *		layout is that of printf() "%.17g": the decimal exponent X is written as "e+XX" when X < -4 or
+	 *		X >= 17 and otherwise the number is written without one. Trailing zeros of the decimals are not
+	 *		written. The decimal point is always '.' whatever the locale.
+	 *
+	 *			INPUT
+	 *				char *s - At least 32 characters
+	 *				double v
+	 *
+	 *			OUTPUT
+	 *				Returns the number of characters written to s
+	 *
+	 *			SUBROUTINES
+	 *				PutSpecial()
+	 *				ShortestDigits()
+	 *				PutInt()
+	 */
+
+	char digits[FMTMAXDIGITS+1];
+	char *p;
+
+	int n;		// Digits
+	int x;		// Decimal exponent of the first digit
+	int k;
+
+	if(isnan(v) || isinf(v)) {
+		return PutSpecial(s, v, 0, FALSE);
+	};
+
+	p = s;
+	if(signbit(v)) *p++ = '-';
+	if(v == 0.0) {
+		*p++ = '0';
+		return (int)(p - s);
+	};
+
+	n = ShortestDigits(fabs(v), digits, &x);
+
+	if((x < -4) || (x >= FMTMAXDIGITS)) {
+		*p++ = digits[0];
+		if(n > 1) {
+			*p++ = '.';
+			memcpy(p, digits + 1, n - 1);
+			p += n - 1;
+		};
+		*p++ = 'e';
+		*p++ = (x < 0) ? '-' : '+';
+		p += PutInt(p, abs(x), 2);
+	}
+	else if(x < 0) {
+		*p++ = '0';
+		*p++ = '.';
+		for(k=x+1; k<0; k++) *p++ = '0';
+		memcpy(p, digits, n);
+		p += n;
+	}
+	else {
+		for(k=0; k<=x; k++) *p++ = (k < n) ? digits[k] : '0';
+		if(n > x + 1) {
+			*p++ = '.';
+			memcpy(p, digits + x + 1, n - x - 1);
+			p += n - x - 1;
+		};
+	};
+
+	return (int)(p - s);
+};
+
+int PutInt(char *s, int v, int digits) {
+
+	/*
+	 * PutInt() - Writes v with at least digits digits as %0<digits>d does and returns the number of characters.
+	 */
+
+	char buf[16];
+	char *d;
+	unsigned int u;
+	int len;
+
+	u = (v < 0) ? 0u - (unsigned int)v : (unsigned int)v;
+
+	d = buf + sizeof(buf);
+	do {
+		*--d = (char)('0' + u%10);
+		u /= 10;
+		digits--;
+	} while((u != 0) || (digits > 0));
+	if(v < 0) *--d = '-';
+
+	len = (int)(buf + sizeof(buf) - d);
+	memcpy(s, d, len);
+
+	return len;
+};
+
+int PutSpecial(char *s, double v, int width, int space) {
+
+	/*
+	 * PutSpecial() - Writes NaN or infinity as printf() does
+	 */
+
+	char buf[8];
+	int len;
+	int k;
+
+	len = 0;
+	if(signbit(v)) buf[len++] = '-';
+	else if(space == TRUE) buf[len++] = ' ';
+	memcpy(buf + len, isnan(v) ? "nan" : "inf", 3);
+	len += 3;
+
+	for(k=len; k<width; k++) *s++ = ' ';
+	memcpy(s, buf, len);
+
+	return max(len, width);
+};
+
+int PutFixedExact(char *s, double v, int width, int prec, int space) {
+
+	/*
+	 * PutFixedExact() - Writes v as PutFixed() does by finding round(f*2^e*10^prec) as a big number, where
+	 *		v = f*2^e. This is exact for any finite v and is only needed for large values.
+	 *
+	 *			SUBROUTINES
+	 *				Decompose()
+	 *				BigSet(), BigMulPow10(), BigShl(), BigShrRound(), BigDivSmall()
+	 */
+
+	struct BigNum b;
+
+	unsigned long long f;
+	unsigned int r;
+
+	// The largest double has 309 integer digits, made nine at a time, then the point and sign
+	char digits[315 + FMTMAXPREC + 2];
+	char *d;
+
+	int e;
+	int len;
+	int k;
+
+	if(prec > FMTMAXPREC) prec = FMTMAXPREC;
+
+	Decompose(fabs(v), &f, &e);
+	BigSet(&b, f);
+	BigMulPow10(&b, prec);
+	if(e >= 0) BigShl(&b, e);
+	else BigShrRound(&b, -e);
+
+	// The digits are made backwards from the last decimal, nine at a time.
+	d = digits + sizeof(digits);
+	k = 0;
+	do {
+		r = BigDivSmall(&b, 1000000000u);
+		for(len=0; len<9; len++) {
+			*--d = (char)('0' + r%10);
+			r /= 10;
+			if(++k == prec) *--d = '.';
+		};
+	} while((b.n > 0) || (k <= prec));
+	// Remove the leading zeros up to the one before the point.
+	while((d + 1 < digits + sizeof(digits)) && (*d == '0') && (d[1] != '.')) d++;
+	if(signbit(v)) *--d = '-';
+	else if(space == TRUE) *--d = ' ';
+
+	len = (int)(digits + sizeof(digits) - d);
+	for(k=len; k<width; k++) *s++ = ' ';
+	memcpy(s, d, len);
+
+	return max(len, width);
+};
+
+int ShortestDigits(double v, char *digits, int *exp10) {
+
+	/*
+	 * ShortestDigits() - Finds the fewest digits that read back as v, which is positive, and returns how
+	 *		many. The first digit is at 10^*exp10. This is the free-format algorithm of Burger and Dybvig,
+	 *		"Printing Floating-Point Numbers Quickly and Accurately" (1996), where v is the ratio r/s of big
+	 *		numbers and half the distance to the neighbouring doubles is m+/s above and m-/s below. Digits are
+	 *		made until the decimal is within the interval, which is closed when the mantissa is even because
+	 *		reading rounds ties to even.
+	 *
+	 *		The big numbers are only needed for the few values that Grisu3() can't decide.
+	 *
+	 *			SUBROUTINES
+	 *				Grisu3()
+	 *				Decompose()
+	 *				BigSet(), BigMulSmall(), BigMulPow10(), BigShl(), BigAdd(), BigSub(), BigCmp()
+	 */
+
+	struct BigNum r, s, mp, mm, t;
+
+	unsigned long long f;
+
+	int e;
+	int k;
+	int n;
+	int d;
+	int c;
+	int even;
+	int low, high;
+
+	n = Grisu3(v, digits, exp10);
+	if(n > 0) {
+		return n;
+	};
+
+	Decompose(v, &f, &e);
+	even = ((f & 1) == 0);
+
+	// v = r/s. The gap below is half the gap above at a power of two.
+	BigSet(&r, f);
+	BigSet(&s, 1);
+	BigSet(&mp, 1);
+	BigSet(&mm, 1);
+	if(e >= 0) {
+		if(f != (1ULL << 52)) {
+			BigShl(&r, e + 1);
+			BigShl(&s, 1);
+			BigShl(&mp, e);
+			BigShl(&mm, e);
+		}
+		else {
+			BigShl(&r, e + 2);
+			BigShl(&s, 2);
+			BigShl(&mp, e + 1);
+			BigShl(&mm, e);
+		};
+	}
+	else {
+		if((e == -1074) || (f != (1ULL << 52))) {
+			BigShl(&r, 1);
+			BigShl(&s, 1 - e);
+		}
+		else {
+			BigShl(&r, 2);
+			BigShl(&s, 2 - e);
+			BigShl(&mp, 1);
+		};
+	};
+
+	// k is an estimate of the exponent that is never too large, so r/s*10^-k < 1 unless it is one too small.
+	k = (int)ceil(log10(v) - 1e-10);
+	if(k >= 0) {
+		BigMulPow10(&s, k);
+	}
+	else {
+		BigMulPow10(&r, -k);
+		BigMulPow10(&mp, -k);
+		BigMulPow10(&mm, -k);
+	};
+	BigAdd(&t, &r, &mp);
+	d = BigCmp(&t, &s);
+	if((even && (d >= 0)) || (d > 0)) {
+		k++;
+	}
+	else {
+		BigMulSmall(&r, 10);
+		BigMulSmall(&mp, 10);
+		BigMulSmall(&mm, 10);
+	};
+	*exp10 = k - 1;
+
+	for(n=0; n<FMTMAXDIGITS; n++) {
+		d = 0;
+		while(BigCmp(&r, &s) >= 0) {
+			BigSub(&r, &s);
+			d++;
+		};
+		low = BigCmp(&r, &mm);
+		low = even ? (low <= 0) : (low < 0);
+		BigAdd(&t, &r, &mp);
+		high = BigCmp(&t, &s);
+		high = even ? (high >= 0) : (high > 0);
+		if(low && high) { // Both are within the interval so take the nearer, or the even one of a tie
+			t = r;
+			BigShl(&t, 1);
+			c = BigCmp(&t, &s);
+			if((c > 0) || ((c == 0) && (d & 1))) d++;
+		}
+		else if(high) {
+			d++;
+		};
+		digits[n] = (char)('0' + d);
+		if(low || high) break;
+		BigMulSmall(&r, 10);
+		BigMulSmall(&mp, 10);
+		BigMulSmall(&mm, 10);
+	};
+
+	return n + 1;
+};
+
+int Grisu3(double v, char *digits, int *exp10) {
+
+	/*
+	 * Grisu3() - Finds the fewest digits that read back as v, which is positive, with 64 bit integers and
+	 *		returns how many, or 0 if it can't be sure that they are the shortest and nearest. This is Grisu3 of
+	 *		Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers" (2010). v and the
+	 *		midpoints to its neighbours are scaled by a cached power of ten so that the digits can be made from
+	 *		64 bit fixed point numbers. The scaling is inexact by an ulp, so the digits are only kept if they
+	 *		are within the interval however the error falls. That is decided for about 99.5% of values.
+	 *
+	 *			SUBROUTINES
+	 *				Decompose()
+	 *				DiyNormalize()
+	 *				DiyMultiply()
+	 *				DigitGen()
+	 */
+
+	struct DiyFp w, mplus, mminus;
+	struct DiyFp c;
+
+	unsigned long long f;
+
+	int e;
+	int k;
+	int i;
+	int n;
+	int kappa;
+
+	Decompose(v, &f, &e);
+
+	// The midpoints to the neighbouring doubles with the exponent of the normalized v
+	mplus.f = (f << 1) + 1;
+	mplus.e = e - 1;
+	mplus = DiyNormalize(mplus);
+	if((f == (1ULL << 52)) && (e != -1074)) { // The lower neighbour is closer
+		mminus.f = (f << 2) - 1;
+		mminus.e = e - 2;
+	}
+	else {
+		mminus.f = (f << 1) - 1;
+		mminus.e = e - 1;
+	};
+	mminus.f <<= mminus.e - mplus.e;
+	mminus.e = mplus.e;
+	w.f = f;
+	w.e = e;
+	w = DiyNormalize(w);
+
+	// The power of ten that puts the binary exponent of the product between -60 and -32
+	k = (int)ceil((-60 - (w.e + 64) + 63)*0.30102999566398114);
+	i = (348 + k - 1)/8 + 1;
+	c.f = Powers[i].f;
+	c.e = Powers[i].e;
+
+	n = DigitGen(DiyMultiply(mminus, c), DiyMultiply(w, c), DiyMultiply(mplus, c), digits, &kappa);
+	if(n == 0) {
+		return 0;
+	};
+
+	*exp10 = kappa - Powers[i].k + n - 1;
+
+	return n;
+};
+
+int DigitGen(struct DiyFp low, struct DiyFp w, struct DiyFp high, char *digits, int *kappa) {
+
+	/*
+	 * DigitGen() - Makes the digits of the scaled value from the top of the interval, widened by an ulp for the
+	 *		error of the scaling, until the rest is within the interval. Returns how many or 0 if they can't be
+	 *		used. The value is digits*10^kappa.
+	 *
+	 *			SUBROUTINES
+	 *				RoundWeed()
+	 */
+
+	static const unsigned int p10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+	unsigned long long unit;
+	unsigned long long toolow, toohigh, unsafe;
+	unsigned long long one;
+	unsigned long long fractionals;
+	unsigned long long rest;
+
+	unsigned int integrals;
+	unsigned int divisor;
+
+	int shift;
+	int n;
+	int d;
+
+	unit = 1;
+	toolow = low.f - unit;
+	toohigh = high.f + unit;
+	unsafe = toohigh - toolow;
+	shift = -w.e;
+	one = 1ULL << shift;
+	integrals = (unsigned int)(toohigh >> shift);
+	fractionals = toohigh & (one - 1);
+
+	// The largest power of ten in the integral part
+	*kappa = 0;
+	while((*kappa < 10) && (p10[*kappa] <= integrals)) (*kappa)++;
+	divisor = (*kappa > 0) ? p10[*kappa - 1] : 0;
+
+	n = 0;
+	while(*kappa > 0) {
+		d = integrals/divisor;
+		digits[n++] = (char)('0' + d);
+		integrals %= divisor;
+		(*kappa)--;
+		rest = ((unsigned long long)integrals << shift) + fractionals;
+		if(rest < unsafe) {
+			return RoundWeed(digits, n, toohigh - w.f, unsafe, rest, (unsigned long long)divisor << shift, unit) ? n : 0;
+		};
+		divisor /= 10;
+	};
+
+	for(;;) {
+		fractionals *= 10;
+		unit *= 10;
+		unsafe *= 10;
+		d = (int)(fractionals >> shift);
+		digits[n++] = (char)('0' + d);
+		fractionals &= one - 1;
+		(*kappa)--;
+		if(fractionals < unsafe) {
+			return RoundWeed(digits, n, (toohigh - w.f)*unit, unsafe, fractionals, one, unit) ? n : 0;
+		};
+		if(n >= FMTMAXDIGITS) {
+			return 0;
+		};
+	};
+};
+
+int RoundWeed(char *digits, int n, unsigned long long distance, unsigned long long unsafe, unsigned long long rest,
+			  unsigned long long tenkappa, unsigned long long unit) {
+
+	/*
+	 * RoundWeed() - Lowers the last digit while that brings the digits nearer to the scaled value, which is
+	 *		distance below the top of the interval give or take unit. Returns TRUE if the digits are certainly
+	 *		the nearest and within the interval.
+	 */
+
+	unsigned long long small, big;
+
+	small = distance - unit;
+	big = distance + unit;
+
+	while((rest < small) && (unsafe - rest >= tenkappa) &&
+		  ((rest + tenkappa < small) || (small - rest >= rest + tenkappa - small))) {
+		digits[n-1]--;
+		rest += tenkappa;
+	};
+
+	// The digits might be nearer to the scaled value if they were lowered again
+	if((rest < big) && (unsafe - rest >= tenkappa) &&
+	   ((rest + tenkappa < big) || (big - rest > rest + tenkappa - big))) {
+		return FALSE;
+	};
+
+	return (2*unit <= rest) && (rest <= unsafe - 4*unit);
+};
+
+struct DiyFp DiyMultiply(struct DiyFp a, struct DiyFp b) {
+
+	/*
+	 * DiyMultiply() - Returns a*b with the product of the f rounded to its upper 64 bits
+	 */
+
+	struct DiyFp r;
+
+	unsigned long long ah, al, bh, bl;
+	unsigned long long ac, bc, ad, bd;
+	unsigned long long t;
+
+	ah = a.f >> 32;
+	al = a.f & 0xffffffffULL;
+	bh = b.f >> 32;
+	bl = b.f & 0xffffffffULL;
+	ac = ah*bh;
+	bc = al*bh;
+	ad = ah*bl;
+	bd = al*bl;
+	t = (bd >> 32) + (ad & 0xffffffffULL) + (bc & 0xffffffffULL);
+	t += 1ULL << 31; // Round
+
+	r.f = ac + (ad >> 32) + (bc >> 32) + (t >> 32);
+	r.e = a.e + b.e + 64;
+
+	return r;
+};
+
+struct DiyFp DiyNormalize(struct DiyFp a) {
+
+	/*
+	 * DiyNormalize() - Shifts f left until its top bit is set
+	 */
+
+	while((a.f & (1ULL << 63)) == 0) {
+		a.f <<= 1;
+		a.e--;
+	};
+
+	return a;
+};
+
+void Decompose(double v, unsigned long long *f, int *e) {
+
+	/*
+	 * Decompose() - Finds the integer mantissa f and exponent e of the finite v >= 0 where v = f*2^e
+	 */
+
+	unsigned long long bits;
+	int be;
+
+	memcpy(&bits, &v, sizeof(bits));
+	be = (int)((bits >> 52) & 0x7ff);
+	*f = bits & ((1ULL << 52) - 1);
+	if(be == 0) { // Subnormal
+		*e = -1074;
+	}
+	else {
+		*f |= 1ULL << 52;
+		*e = be - 1075;
+	};
+
+	return;
+};
+
+void BigSet(struct BigNum *b, unsigned long long v) {
+
+	b->n = 0;
+	while(v != 0) {
+		b->d[b->n++] = (unsigned int)v;
+		v >>= 32;
+	};
+
+	return;
+};
+
+void BigMulSmall(struct BigNum *b, unsigned int m) {
+
+	unsigned long long c;
+	int i;
+
+	c = 0;
+	for(i=0; i<b->n; i++) {
+		c += (unsigned long long)b->d[i]*m;
+		b->d[i] = (unsigned int)c;
+		c >>= 32;
+	};
+	if(c != 0) b->d[b->n++] = (unsigned int)c;
+
+	return;
+};
+
+void BigMulPow10(struct BigNum *b, int k) {
+
+	static const unsigned int p10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+	while(k >= 9) {
+		BigMulSmall(b, p10[9]);
+		k -= 9;
+	};
+	if(k > 0) BigMulSmall(b, p10[k]);
+
+	return;
+};
+
+void BigShl(struct BigNum *b, int bits) {
+
+	int w, s;
+	int i;
+
+	if(b->n == 0) return;
+
+	w = bits/32;
+	s = bits%32;
+	if(s != 0) {
+		b->d[b->n] = 0;
+		for(i=b->n; i>0; i--) {
+			b->d[i] = (b->d[i] << s) | (b->d[i-1] >> (32 - s));
+		};
+		b->d[0] <<= s;
+		if(b->d[b->n] != 0) b->n++;
+	};
+	if(w != 0) {
+		memmove(b->d + w, b->d, b->n*sizeof(unsigned int));
+		memset(b->d, 0, w*sizeof(unsigned int));
+		b->n += w;
+	};
+
+	return;
+};
+
+int BigShrRound(struct BigNum *b, int bits) {
+
+	/*
+	 * BigShrRound() - Divides b by 2^bits, bits > 0, rounding ties to even. Returns TRUE if it was rounded up.
+	 */
+
+	struct BigNum one;
+	int hw, hs;
+	int w, s;
+	int half, sticky;
+	int i;
+
+	// The bit worth one half and whether any bit below it is set
+	hw = (bits - 1)/32;
+	hs = (bits - 1)%32;
+	half = (hw < b->n) ? (b->d[hw] >> hs) & 1 : 0;
+	sticky = 0;
+	for(i=0; i<min(hw, b->n); i++) sticky |= (b->d[i] != 0);
+	if(hw < b->n) sticky |= ((b->d[hw] & ((1u << hs) - 1)) != 0);
+
+	w = bits/32;
+	s = bits%32;
+	if(w >= b->n) {
+		b->n = 0;
+	}
+	else {
+		for(i=0; i<b->n-w; i++) {
+			b->d[i] = b->d[i+w] >> s;
+			if((s != 0) && (i + w + 1 < b->n)) b->d[i] |= b->d[i+w+1] << (32 - s);
+		};
+		b->n -= w;
+		while((b->n > 0) && (b->d[b->n-1] == 0)) b->n--;
+	};
+
+	if(half && (sticky || ((b->n > 0) && (b->d[0] & 1)))) {
+		BigSet(&one, 1);
+		BigAdd(b, b, &one);
+		return TRUE;
+	};
+
+	return FALSE;
+};
+
+void BigAdd(struct BigNum *r, const struct BigNum *a, const struct BigNum *b) {
+
+	unsigned long long c;
+	int n;
+	int i;
+
+	n = max(a->n, b->n);
+	c = 0;
+	for(i=0; i<n; i++) {
+		c += (i < a->n) ? a->d[i] : 0;
+		c += (i < b->n) ? b->d[i] : 0;
+		r->d[i] = (unsigned int)c;
+		c >>= 32;
+	};
+	r->n = n;
+	if(c != 0) r->d[r->n++] = (unsigned int)c;
+
+	return;
+};
+
+void BigSub(struct BigNum *a, const struct BigNum *b) {
+
+	/*
+	 * BigSub() - a = a - b where a >= b
+	 */
+
+	long long c;
+	int i;
+
+	c = 0;
+	for(i=0; i<a->n; i++) {
+		c += (long long)a->d[i] - ((i < b->n) ? b->d[i] : 0);
+		a->d[i] = (unsigned int)c;
+		c = (c < 0) ? -1 : 0;
+	};
+	while((a->n > 0) && (a->d[a->n-1] == 0)) a->n--;
+
+	return;
+};
+
+int BigCmp(const struct BigNum *a, const struct BigNum *b) {
+
+	int i;
+
+	if(a->n != b->n) return (a->n > b->n) ? 1 : -1;
+	for(i=a->n-1; i>=0; i--) {
+		if(a->d[i] != b->d[i]) return (a->d[i] > b->d[i]) ? 1 : -1;
+	};
+
+	return 0;
+};
+
+unsigned int BigDivSmall(struct BigNum *b, unsigned int m) {
+
+	/*
+	 * BigDivSmall() - b = b/m and returns the remainder
+	 */
+
+	unsigned long long r;
+	int i;
+
+	r = 0;
+	for(i=b->n-1; i>=0; i--) {
+		r = (r << 32) | b->d[i];
+		b->d[i] = (unsigned int)(r/m);
+		r %= m;
+	};
+	while((b->n > 0) && (b->d[b->n-1] == 0)) b->n--;
+
+	return (unsigned int)r;
+};
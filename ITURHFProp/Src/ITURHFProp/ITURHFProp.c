@@ -13,7 +13,9 @@
 void TestPath(struct PathData *path, int n);
 void AntennaType(struct PathData *path, int n);
 void PathConfig(struct PathData *path, int n);
+#ifndef ITURHFPROP_LIB
 void help(void);
+#endif
 // End local prototypes
 
 // Local globals
@@ -28,6 +30,9 @@ char mod[512];
 	iPathMemory dllFreePathMemory;
 	dBearing dllBearing;
 	iInputDump dllInputDump;
+	iReadFamDud dllReadFamDud;
+	vFamCacheStats dllFamCacheStats;
+	iMakeNoiseGrid dllMakeNoiseGrid;
 #elif __linux__ || __APPLE__
 	#include <dlfcn.h>
 	void * hLib;
@@ -38,10 +43,15 @@ char mod[512];
 	int (*dllFreePathMemory)(struct PathData *);
 	double (*dllBearing)(struct Location,struct Location,int direction);
 	int (*dllInputDump)(struct PathData *);
+	int (*dllReadFamDud)(struct NoiseParams *, const char *, int);
+	void (*dllFamCacheStats)(struct NoiseParams *, long *, long *);
+	int (*dllMakeNoiseGrid)(struct NoiseParams *, int, double, double, double, double, double, double, double *, int);
 #endif
 
 // End local globals
 
+// A program that embeds the analysis compiles this file with ITURHFPROP_LIB and has its own main(). See Stream.c
+#ifndef ITURHFPROP_LIB
 int main(int argc, char *argv[]) {
 	/*
 	  ITURHFProp Demonstration Program - main() - This is a dummy program whose sole purpose to pass user-simulated data to the program ITURHFProp for testing.
@@ -89,82 +99,23 @@ int main(int argc, char *argv[]) {
 	ITURHFP.silent = FALSE;
 	ITURHFP.header = TRUE;
 	ITURHFP.csvRFC4180 = FALSE;
+	ITURHFP.shortest = FALSE;
+	ITURHFP.binary = FALSE;
+	ITURHFP.raster = RASTER_NONE;
+	ITURHFP.compress = FALSE;
+	ITURHFP.callback = NULL;
+	ITURHFP.user = NULL;
 	InFilePath[0] = EMPTY;
 	OutFileName[0] = EMPTY;
 	OutFilePath[0] = EMPTY;
 	// End Initialization
 
-	//******************************************************************************************
-	// Load P533 DLL ***************************************************************************
-	//******************************************************************************************
-
-#ifdef _WIN32
-	// Get the handle to the P533 DLL.
-	hLib=LoadLibrary("P533.dll");
-	if(hLib==NULL) {
-		printf("Main: Error %d p533.dll Not Found\n", RTN_ERRP533DLL);
-		return RTN_ERRP533DLL;
+	// Load P533 DLL
+	retval = LoadP533(&ITURHFP);
+	if(retval != RTN_LOADP533OK) {
+		return retval;
 	};
 
-	// Get the handle to the DLL library, hLib.
-	GetModuleFileName((HMODULE)hLib, (LPTSTR)mod, 50);
-	// Get the P533Version() process from the DLL.
-	dllP533Version = (cP533Info)GetProcAddress((HMODULE)hLib, "P533Version");
-	// Get the P533CompileTime() process from the DLL.
-	dllP533CompileTime = (cP533Info)GetProcAddress((HMODULE)hLib, "P533CompileTime");
-	// Get the function P533() from the DLL.
-	dllP533 = (iP533)GetProcAddress((HMODULE)hLib, "P533");
-	// Get the function AllocatePathMemory() from the DLL.
-	dllAllocatePathMemory = (iPathMemory)GetProcAddress((HMODULE)hLib, "AllocatePathMemory");
-	// Get the function FreePathMemory() from the DLL.
-	dllFreePathMemory = (iPathMemory)GetProcAddress((HMODULE)hLib, "FreePathMemory");
-	// Get the function Bearing() from the DLL.
-	dllBearing = (dBearing)GetProcAddress((HMODULE)hLib, "Bearing");
-	// Get the function InputDump() from the DLL.
-	dllInputDump = (iInputDump)GetProcAddress((HMODULE)hLib, "InputDump");
-	// Get functions that have been moved into DLL as utility for PMW integration
-	dllReadType11Func = (iReadType11Func)GetProcAddress((HMODULE)hLib,"ReadType11");
-	dllReadType13Func = (iReadType13Func)GetProcAddress((HMODULE)hLib,"ReadType13");
-	dllReadType14Func = (iReadType14Func)GetProcAddress((HMODULE)hLib,"ReadType14");
-	dllIsotropicPatternFunc = (vIsotropicPatternFunc)GetProcAddress((HMODULE)hLib,"IsotropicPattern");
-//	dllReadFamDudFunc = (ReadFamDudFunc)GetProcAddress((HMODULE)hLib,"ReadFamDud");
-	dllReadIonParametersBinFunc = (iReadIonParametersBinFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersBin");
-	dllReadIonParametersTxtFunc = (iReadIonParametersTxtFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersTxt");
-	dllReadP1239Func = (iReadP1239Func)GetProcAddress((HMODULE)hLib,"ReadP1239");
-
-#elif __linux__ || __APPLE__
-	void * hLib;
-	hLib = dlopen("libp533.so", RTLD_NOW);
-	if (!hLib) {
-		printf("Couldn't load libp533.so, exiting.\n");
-		exit(1);
-	}
-	dllP533Version = dlsym(hLib,"P533Version");
-	dllP533CompileTime = dlsym(hLib,"P533CompileTime");
-	dllP533 = dlsym(hLib,"P533");
-	dllAllocatePathMemory = dlsym(hLib,"AllocatePathMemory");
-	dllFreePathMemory = dlsym(hLib,"FreePathMemory");
-	dllInputDump = dlsym(hLib, "InputDump");
-	dllBearing = dlsym(hLib,"Bearing");
-	dllReadType11Func = dlsym(hLib,"ReadType11");
-	dllReadType13Func = dlsym(hLib,"ReadType13");
-	dllReadType14Func = dlsym(hLib,"ReadType14");
-	dllIsotropicPatternFunc = dlsym(hLib,"IsotropicPattern");
-	dllReadIonParametersBinFunc = dlsym(hLib,"ReadIonParametersBin");
-	dllReadIonParametersTxtFunc = dlsym(hLib,"ReadIonParametersTxt");
-	dllReadP1239Func = dlsym(hLib,"ReadP1239");
-	//printf("%s\n",dllP533Version());
-#endif
-
-	//********************************************************************************************
-	// End Load P533 DLL *************************************************************************
-	//********************************************************************************************
-
-	// Determine the P533() version of the DLL/SO.
-	ITURHFP.P533ver = dllP533Version();
-	// Determine the P533() compile time
-	ITURHFP.P533compt = dllP533CompileTime();
-
 	//********************************************************************************************
 	// Parse Command Line ************************************************************************
 	//********************************************************************************************
@@ -172,16 +123,63 @@ int main(int argc, char *argv[]) {
 	// Determine the desired user options on the command line
 	while ((argc > 1) && (argv[1][0] == '-')) {
 		switch (argv[1][1]) {
+			case 'a': // Compile antenna files - The remaining arguments are the output file and the antenna files
+				if(argc < 4) {
+					printf("Main: Error %d -a requires an output file and at least one antenna file\n", RTN_ERRCOMMANDLINEARG);
+					return RTN_ERRCOMMANDLINEARG;
+				};
+				retval = CompileAntenna(argv[2], &argv[3], argc-3, ITURHFP.silent);
+				if(retval != RTN_COMPILEANTENNAOK) {
+					return retval;
+				};
+				return RTN_MAINOK;
+				break;
+			case 'b': // Binary columnar output
+				ITURHFP.binary = TRUE;
+				ITURHFP.header = FALSE;
+				break;
+			case 'd': // Decode a binary path data dump - The next arguments are the dump and the text file
+				if(argc < 3) {
+					printf("Main: Error %d -d requires a binary path data dump\n", RTN_ERRCOMMANDLINEARG);
+					return RTN_ERRCOMMANDLINEARG;
+				};
+				retval = DecodePathDump(argv[2], (argc > 3) ? argv[3] : NULL, ITURHFP.silent);
+				if(retval != RTN_DECODEPATHDUMPOK) {
+					return retval;
+				};
+				return RTN_MAINOK;
+				break;
 			case 'c': //CSV OUTPUT
 				ITURHFP.csvRFC4180 = TRUE;
 				ITURHFP.header = FALSE;
 				break;
+			case 'p': // Full precision CSV output
+				ITURHFP.csvRFC4180 = TRUE;
+				ITURHFP.shortest = TRUE;
+				ITURHFP.header = FALSE;
+				break;
+			case 'r': // Raster output - The next argument is the format
+				if(argc > 2) {
+					if(strcmp(argv[2], "asc") == 0) ITURHFP.raster = RASTER_ASC;
+					else if(strcmp(argv[2], "tif") == 0) ITURHFP.raster = RASTER_TIFF;
+					else if(strcmp(argv[2], "nc") == 0) ITURHFP.raster = RASTER_NETCDF;
+				};
+				if(ITURHFP.raster == RASTER_NONE) {
+					printf("Main: Error %d -r requires the format asc, tif or nc\n", RTN_ERRCOMMANDLINEARG);
+					return RTN_ERRCOMMANDLINEARG;
+				};
+				++argv;
+				--argc;
+				break;
 			case 's': // Silent Mode
 				ITURHFP.silent = TRUE;
 				break;
 			case 't': // Remove the header Mode
 			  ITURHFP.header = FALSE;
 				break;
+			case 'z': // Compress the output file
+				ITURHFP.compress = TRUE;
+				break;
 			case 'v': // Version - Display version and Exit
 				printf("ITURHFProp Version: %s\n", ITURHFPropVER);
 				printf("P533 Version: %s\n", ITURHFP.P533ver);
@@ -215,6 +213,18 @@ int main(int argc, char *argv[]) {
 		return RTN_ERRCOMMANDLINEARG;
 	};
 
+	// The binary report and the NetCDF raster are finished by seeking back in the file so they can't be compressed.
+	if((ITURHFP.compress == TRUE) && ((ITURHFP.binary == TRUE) || (ITURHFP.raster != RASTER_NONE))) {
+		printf("Main: Error %d -z can't be used with -b or -r\n", RTN_ERRCOMMANDLINEARG);
+		return RTN_ERRCOMMANDLINEARG;
+	};
+
+	// The binary output has the columns of the CSV file but is a file of its own.
+	if((ITURHFP.binary == TRUE) && (ITURHFP.csvRFC4180 == TRUE)) {
+		printf("Main: Error %d -b can't be used with -c or -p\n", RTN_ERRCOMMANDLINEARG);
+		return RTN_ERRCOMMANDLINEARG;
+	};
+
 	//********************************************************************************************
 	// End Parse Command Line ********************************************************************
 	//********************************************************************************************
@@ -243,16 +253,10 @@ int main(int argc, char *argv[]) {
 		return retval;
 	};
 
-	// Now that the input has been loaded the location of the transmitter and receiver are known
-	// so the bearing of the antennas can be determined if necessary.
-	if(ITURHFP.AntennaOrientation == TX2RX) {
-		ITURHFP.TXBearing = dllBearing(path.L_tx, path.L_rx, path.SorL); // Point the transmitter at the receiver.
-		ITURHFP.RXBearing = dllBearing(path.L_rx, path.L_tx, path.SorL); // Point the receiver at the transmitter.
-	};
-
-	retval = ValidateITURHFP(ITURHFP);
+	// Now that the input has been loaded the analysis can be set up and validated.
+	retval = PrepareITURHFP(&path, &ITURHFP);
 	if(retval != RTN_VALIDATEITURHFPOK) {
-		printf("Main: Error %d from ValidateITURHFP\n", retval);
+		printf("Main: Error %d from PrepareITURHFP\n", retval);
 		return retval;
 	};
 
@@ -266,9 +270,11 @@ int main(int argc, char *argv[]) {
 	if(OutFilePath[0] == EMPTY) {
 		if(ITURHFP.RptFileFormat == RPT_DUMPPATH) { // All Path Data is desired
 			// The path data dump, PDD, file name is time stamped.
-			sprintf(OutFileName, "PDD%02d%02d%02d-%02d%02d%02d.txt",
+			sprintf(OutFileName, "PDD%02d%02d%02d-%02d%02d%02d.%s%s",
 				ITURHFP.time->tm_mday, ITURHFP.time->tm_mon+1, ITURHFP.time->tm_year-100,
-				ITURHFP.time->tm_hour, ITURHFP.time->tm_min, ITURHFP.time->tm_sec);
+				ITURHFP.time->tm_hour, ITURHFP.time->tm_min, ITURHFP.time->tm_sec,
+				(ITURHFP.binary == TRUE) ? "bin" : "txt",
+				(ITURHFP.compress == TRUE) ? ".gz" : "");
 			strcpy(OutFilePath, ITURHFP.RptFilePath);
 			strcat(OutFilePath, OutFileName);
 			// Store the output file
@@ -276,9 +282,11 @@ int main(int argc, char *argv[]) {
 		}
 		else { // Customized report is desired
 			// Open the report file and initialize the file pointer in ITURHFP
-			sprintf(OutFileName, "RPT%02d%02d%02d-%02d%02d%02d.txt",
+			sprintf(OutFileName, "RPT%02d%02d%02d-%02d%02d%02d.%s%s",
 				ITURHFP.time->tm_mday, ITURHFP.time->tm_mon+1, ITURHFP.time->tm_year-100,
-				ITURHFP.time->tm_hour, ITURHFP.time->tm_min, ITURHFP.time->tm_sec);
+				ITURHFP.time->tm_hour, ITURHFP.time->tm_min, ITURHFP.time->tm_sec,
+				(ITURHFP.raster == RASTER_NETCDF) ? "nc" : ((ITURHFP.binary == TRUE) ? "bin" : "txt"),
+				(ITURHFP.compress == TRUE) ? ".gz" : "");
 			strcpy(OutFilePath, ITURHFP.RptFilePath);
 			strcat(OutFilePath, OutFileName);
 			// Store the output file
@@ -291,11 +299,31 @@ int main(int argc, char *argv[]) {
 	};
 
 	// Open the output file and initialize the file pointer in ITURHFP
-	ITURHFP.rptfp = fopen(ITURHFP.RptFilePath, "w");
-	if(ITURHFP.rptfp == NULL) {
+	// The binary report is written and then its header is filled in, so it is opened as a binary file.
+	// So are the binary path data dump and the NetCDF raster file. The ESRI ASCII and GeoTIFF rasters are files of their own that are named
+	// after the output file. A compressed report is written to a pipe that is read by the thread that compresses it.
+	if(ITURHFP.compress == TRUE) {
+		ITURHFP.rptfp = OpenCompressed(ITURHFP.RptFilePath);
+	}
+	else if(ITURHFP.RptFileFormat == RPT_DUMPPATH) {
+		ITURHFP.rptfp = fopen(ITURHFP.RptFilePath, (ITURHFP.binary == TRUE) ? "wb" : "w");
+	}
+	else if((ITURHFP.raster == RASTER_ASC) || (ITURHFP.raster == RASTER_TIFF)) {
+		ITURHFP.rptfp = NULL;
+	}
+	else if((ITURHFP.binary == TRUE) || (ITURHFP.raster == RASTER_NETCDF)) {
+		ITURHFP.rptfp = fopen(ITURHFP.RptFilePath, "wb");
+	}
+	else {
+		ITURHFP.rptfp = fopen(ITURHFP.RptFilePath, "w");
+	};
+	if((ITURHFP.rptfp == NULL) && (ITURHFP.raster != RASTER_ASC) && (ITURHFP.raster != RASTER_TIFF)) {
 		printf("Main: Error %d Can't open output file %s\n", RTN_ERROPENOUTPUTFILE, ITURHFP.RptFilePath);
 		return RTN_ERROPENOUTPUTFILE;
 	};
+	if(ITURHFP.rptfp != NULL) {
+		setvbuf(ITURHFP.rptfp, NULL, _IOFBF, RPTFILEBUFFER);
+	};
 
 	// User feedback
 	if (ITURHFP.silent != TRUE)
@@ -304,8 +332,17 @@ int main(int argc, char *argv[]) {
 		printf("Main: Writing to file %s \n", OutFilePath);
 	};
 
+	// The report or path data dump is written by a thread while P533() runs. The raster grids are written as they are completed.
+	if((ITURHFP.raster == RASTER_NONE) && (StartWriter() != TRUE) && (ITURHFP.silent != TRUE)) {
+		printf("Main: The writer thread could not be started. The output will be written as it is calculated.\n");
+	};
+
 	// Run ITURHFProp now that the input file has been validated.
 	retval = ITURHFProp(&path, &ITURHFP);
+
+	// Wait for the output to be written
+	StopWriter();
+
 	if(retval != RTN_ITURHFPropOK) {
 		printf(" path hour %d\n", path.hour);
 		printf("Main: Error %d from ITURHFProp\n", retval);
@@ -316,7 +353,17 @@ int main(int argc, char *argv[]) {
 
 	// Clean up
 	// Close the output file
-	if(ITURHFP.rptfp != NULL) fclose(ITURHFP.rptfp); // Close report file
+	if(ITURHFP.compress == TRUE) {
+		// Wait for the rest of the report to be compressed
+		retval = CloseCompressed(ITURHFP.rptfp);
+		if(retval != RTN_COMPRESSOK) {
+			printf("Main: Error %d from CloseCompressed\n", retval);
+			return retval;
+		};
+	}
+	else if(ITURHFP.rptfp != NULL) {
+		fclose(ITURHFP.rptfp); // Close report file
+	};
 
 	// Free all the memory
 	retval = dllFreePathMemory(&path);
@@ -327,7 +374,7 @@ int main(int argc, char *argv[]) {
 
 	return RTN_MAINOK;
 };
-
+#endif
 
 int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 
@@ -347,7 +394,8 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 	  				struct ITURHFProp *ITURHFP
 
 	  			OUTPUT
-	  				Output files PDD or RPT that are time stamped with the data required.
+	  				Output files PDD or RPT that are time stamped with the data required, or each result is
+	  				given to ITURHFP->callback if there is one.
 
 				EXTERNAL DLL
 					This program requires P533.dll and P372.dll
@@ -358,9 +406,18 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 	int retval; // Return value
 	int count;
 
+	long famhits, fammisses; // Noise cache statistics for the month
+	long gridlookups, gridexact; // Noise grid statistics for the month
+
+	char IonFilePath[300];
+	FILE *fp;
+
 	// Initialize the output record counter.
 	count = 1;
 
+	// Discard the reduction of an earlier analysis that was stopped
+	StopReduce();
+
 	// Determine the maximum hour
 	ITURHFP->ihrend = 0;
 	for(i=0; i<NMBOFHOURS; i++) {
@@ -411,14 +468,18 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 	// Get the handle to the DLL library, hLib.
 	GetModuleFileName((HMODULE)hLib, (LPTSTR)mod, 50);
 	dllReadFamDud = (iReadFamDud)GetProcAddress((HMODULE)hLib, "ReadFamDud");
+	dllFamCacheStats = (vFamCacheStats)GetProcAddress((HMODULE)hLib, "FamCacheStats");
+	dllMakeNoiseGrid = (iMakeNoiseGrid)GetProcAddress((HMODULE)hLib, "MakeNoiseGrid");
 #elif __linux__ || __APPLE__
 	void * hLib;
 	hLib = dlopen("libp372.so", RTLD_NOW);
 	if (!hLib) {
-		printf("Couldn't load libp372.so, exiting.\n");
-		exit(1);
+		printf("ITURHFProp: Error %d Couldn't load libp372.so\n", RTN_ERRP372DLL);
+		return RTN_ERRP372DLL;
 	}
 	dllReadFamDud = dlsym(hLib, "ReadFamDud");
+	dllFamCacheStats = dlsym(hLib, "FamCacheStats");
+	dllMakeNoiseGrid = dlsym(hLib, "MakeNoiseGrid");
 #endif
 	// End P372.DLL Load ************************************************
 
@@ -429,7 +490,16 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 
 
 		// Read in the ionospheric parameters for the particular month for the call to P533.
-		retval = dllReadIonParametersBinFunc(path->month, path->foF2, path->M3kF2, ITURHFP->DataFilePath, ITURHFP->silent);
+		// If only the text atlas is available it is used instead. It is cached after the first read.
+		sprintf(IonFilePath, "%sionos%02d.bin", ITURHFP->DataFilePath, path->month+1);
+		fp = fopen(IonFilePath, "rb");
+		if(fp != NULL) {
+			fclose(fp);
+			retval = dllReadIonParametersBinFunc(path->month, path->foF2, path->M3kF2, ITURHFP->DataFilePath, ITURHFP->silent);
+		}
+		else {
+			retval = dllReadIonParametersTxtFunc(path, ITURHFP->DataFilePath, ITURHFP->silent);
+		};
 		if(retval != RTN_READIONPARAOK) {
 			return retval;
 		};
@@ -446,10 +516,28 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 			printf("\nCounting P533() Runs:\n");
 		};
 
+		gridlookups = 0;
+		gridexact = 0;
+
 		// ******************* Hours loop ******************************************************
 		for(ITURHFP->ihr=0; ITURHFP->ihr<ITURHFP->ihrend; ITURHFP->ihr++) { // hours
 			path->hour = ITURHFP->hrs[ITURHFP->ihr];
 
+			// For an area the noise at the receivers may be interpolated from a grid made for this hour.
+			if(((path->Outputs & (OUT_NOISE | OUT_RELIABILITY)) != 0) && (ITURHFP->NoiseGridInc > 0.0) && (ITURHFP->ilatend*ITURHFP->ilngend > 1) && (dllMakeNoiseGrid != NULL)) {
+				retval = dllMakeNoiseGrid(&path->noiseP, path->hour,
+					ITURHFP->L_LL.lat, ITURHFP->L_LL.lat + (ITURHFP->ilatend-1)*ITURHFP->latinc, ITURHFP->NoiseGridInc,
+					ITURHFP->L_LL.lng, ITURHFP->L_LL.lng + (ITURHFP->ilngend-1)*ITURHFP->lnginc, ITURHFP->NoiseGridInc,
+					ITURHFP->frqs, ITURHFP->ifrqend);
+				if(retval != RTN_MAKENOISEGRIDOK) {
+					return retval;
+				};
+				if((ITURHFP->silent != TRUE) && (path->noiseP.NoiseG != NULL)) {
+					printf("\rITURHFProp: Noise grid %d x %d x %d for hour %d (largest error %.3f dB)\n", path->noiseP.NoiseG->nlat,
+						path->noiseP.NoiseG->nlng, path->noiseP.NoiseG->nfreq, path->hour + 1, path->noiseP.NoiseG->maxerr);
+				};
+			};
+
 			// **************** Frequency loop *************************************************
 			for(ITURHFP->ifrq=0; ITURHFP->ifrq<ITURHFP->ifrqend; ITURHFP->ifrq++) { // freqs
 				path->frequency = ITURHFP->frqs[ITURHFP->ifrq];
@@ -476,11 +564,26 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 						};
 
 						// Write the output
-						if((ITURHFP->RptFileFormat & RPT_DUMPPATH) == RPT_DUMPPATH) {
-							DumpPathData(*path, *ITURHFP);
+						if((ITURHFP->reducefreq != REDUCE_NONE) || (ITURHFP->reducehours != REDUCE_NONE)) {
+							retval = Reduce(path, ITURHFP);
+							if(retval != RTN_REDUCEOK) {
+								return retval;
+							};
+						}
+						else if(ITURHFP->callback != NULL) {
+							retval = StreamResult(path, ITURHFP);
+							if(retval != RTN_STREAMOK) {
+								return retval;
+							};
+						}
+						else if(ITURHFP->raster != RASTER_NONE) {
+							retval = Raster(*path, *ITURHFP);
+							if(retval != RTN_RASTEROK) {
+								return retval;
+							};
 						}
 						else {
-							Report(*path, *ITURHFP);
+							QueueOutput(path, ITURHFP);
 						};
 					}; // ************* End Longitude loop ***************************************
 
@@ -488,32 +591,214 @@ int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP) {
 
 			}; // ********************* End Frequency loop ***************************************
 
+			if(path->noiseP.NoiseG != NULL) {
+				gridlookups += path->noiseP.NoiseG->lookups;
+				gridexact += path->noiseP.NoiseG->exact;
+			};
+
 		}; // ************************* End Hours loop *******************************************
 
 		// Reset the counter for the next month.
 		count = 1;
 
 		if(ITURHFP->silent != TRUE) {
-			printf("\n\n");
+			printf("\n");
+			// The atmospheric noise at 1 MHz is cached by timeblock and receiver location for the month.
+			if(dllFamCacheStats != NULL) {
+				dllFamCacheStats(&path->noiseP, &famhits, &fammisses);
+				if(famhits + fammisses > 0) {
+					printf("ITURHFProp: Noise cache hits %ld of %ld (%.1f%%)\n", famhits, famhits + fammisses,
+						100.0*famhits/(famhits + fammisses));
+				};
+			};
+			if(gridlookups + gridexact > 0) {
+				printf("ITURHFProp: Noise grid lookups %ld, calculated %ld\n", gridlookups, gridexact);
+			};
+			printf("\n");
 		};
 
 
 	}; // ***************************** End Months loop ******************************************
 
+	StopReduce();
+
 	return RTN_ITURHFPropOK;
 };
 
+int LoadP533(struct ITURHFProp *ITURHFP) {
+
+	/*
+	   LoadP533() - Loads the P533 DLL and gets the functions of it that ITURHFProp() and its subroutines use.
+
+	  			INPUT
+	  				struct ITURHFProp *ITURHFP
+
+	  			OUTPUT
+	  				ITURHFP->P533ver and ITURHFP->P533compt are the version and compile time of the DLL
+	  				Returns RTN_LOADP533OK or RTN_ERRP533DLL
+
+	 */
+
+	//******************************************************************************************
+	// Load P533 DLL ***************************************************************************
+	//******************************************************************************************
+
+#ifdef _WIN32
+	// Get the handle to the P533 DLL.
+	hLib=LoadLibrary("P533.dll");
+	if(hLib==NULL) {
+		printf("LoadP533: Error %d p533.dll Not Found\n", RTN_ERRP533DLL);
+		return RTN_ERRP533DLL;
+	};
+
+	// Get the handle to the DLL library, hLib.
+	GetModuleFileName((HMODULE)hLib, (LPTSTR)mod, 50);
+	// Get the P533Version() process from the DLL.
+	dllP533Version = (cP533Info)GetProcAddress((HMODULE)hLib, "P533Version");
+	// Get the P533CompileTime() process from the DLL.
+	dllP533CompileTime = (cP533Info)GetProcAddress((HMODULE)hLib, "P533CompileTime");
+	// Get the function P533() from the DLL.
+	dllP533 = (iP533)GetProcAddress((HMODULE)hLib, "P533");
+	// Get the function AllocatePathMemory() from the DLL.
+	dllAllocatePathMemory = (iPathMemory)GetProcAddress((HMODULE)hLib, "AllocatePathMemory");
+	// Get the function FreePathMemory() from the DLL.
+	dllFreePathMemory = (iPathMemory)GetProcAddress((HMODULE)hLib, "FreePathMemory");
+	// Get the function Bearing() from the DLL.
+	dllBearing = (dBearing)GetProcAddress((HMODULE)hLib, "Bearing");
+	// Get the function InputDump() from the DLL.
+	dllInputDump = (iInputDump)GetProcAddress((HMODULE)hLib, "InputDump");
+	// Get functions that have been moved into DLL as utility for PMW integration
+	dllReadType11Func = (iReadType11Func)GetProcAddress((HMODULE)hLib,"ReadType11");
+	dllReadType13Func = (iReadType13Func)GetProcAddress((HMODULE)hLib,"ReadType13");
+	dllReadType14Func = (iReadType14Func)GetProcAddress((HMODULE)hLib,"ReadType14");
+	dllIsotropicPatternFunc = (vIsotropicPatternFunc)GetProcAddress((HMODULE)hLib,"IsotropicPattern");
+	dllReadAntennaBinFunc = (iReadAntennaBinFunc)GetProcAddress((HMODULE)hLib,"ReadAntennaBin");
+	dllWriteAntennaBinFunc = (iWriteAntennaBinFunc)GetProcAddress((HMODULE)hLib,"WriteAntennaBin");
+	dllReadNECFunc = (iReadNECFunc)GetProcAddress((HMODULE)hLib,"ReadNEC");
+	dllAllocateAntennaMemory = (iAllocateAntennaMemory)GetProcAddress((HMODULE)hLib,"AllocateAntennaMemory");
+	dllFreeAntennaMemory = (vFreeAntennaMemory)GetProcAddress((HMODULE)hLib,"FreeAntennaMemory");
+//	dllReadFamDudFunc = (ReadFamDudFunc)GetProcAddress((HMODULE)hLib,"ReadFamDud");
+	dllReadIonParametersBinFunc = (iReadIonParametersBinFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersBin");
+	dllReadIonParametersTxtFunc = (iReadIonParametersTxtFunc)GetProcAddress((HMODULE)hLib,"ReadIonParametersTxt");
+	dllReadP1239Func = (iReadP1239Func)GetProcAddress((HMODULE)hLib,"ReadP1239");
+
+#elif __linux__ || __APPLE__
+	hLib = dlopen("libp533.so", RTLD_NOW);
+	if (!hLib) {
+		printf("LoadP533: Error %d Couldn't load libp533.so\n", RTN_ERRP533DLL);
+		return RTN_ERRP533DLL;
+	}
+	dllP533Version = dlsym(hLib,"P533Version");
+	dllP533CompileTime = dlsym(hLib,"P533CompileTime");
+	dllP533 = dlsym(hLib,"P533");
+	dllAllocatePathMemory = dlsym(hLib,"AllocatePathMemory");
+	dllFreePathMemory = dlsym(hLib,"FreePathMemory");
+	dllInputDump = dlsym(hLib, "InputDump");
+	dllBearing = dlsym(hLib,"Bearing");
+	dllReadType11Func = dlsym(hLib,"ReadType11");
+	dllReadType13Func = dlsym(hLib,"ReadType13");
+	dllReadType14Func = dlsym(hLib,"ReadType14");
+	dllIsotropicPatternFunc = dlsym(hLib,"IsotropicPattern");
+	dllReadAntennaBinFunc = dlsym(hLib,"ReadAntennaBin");
+	dllWriteAntennaBinFunc = dlsym(hLib,"WriteAntennaBin");
+	dllReadNECFunc = dlsym(hLib,"ReadNEC");
+	dllAllocateAntennaMemory = dlsym(hLib,"AllocateAntennaMemory");
+	dllFreeAntennaMemory = dlsym(hLib,"FreeAntennaMemory");
+	dllReadIonParametersBinFunc = dlsym(hLib,"ReadIonParametersBin");
+	dllReadIonParametersTxtFunc = dlsym(hLib,"ReadIonParametersTxt");
+	dllReadP1239Func = dlsym(hLib,"ReadP1239");
+	//printf("%s\n",dllP533Version());
+#endif
+
+	//********************************************************************************************
+	// End Load P533 DLL *************************************************************************
+	//********************************************************************************************
+
+	// Determine the P533() version of the DLL/SO.
+	ITURHFP->P533ver = dllP533Version();
+	// Determine the P533() compile time
+	ITURHFP->P533compt = dllP533CompileTime();
+
+	return RTN_LOADP533OK;
+};
+
+int PrepareITURHFP(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	   PrepareITURHFP() - Sets up the analysis once the input has been read and validates it. The outputs that
+	  		P533() calculates are chosen and the antennas are pointed.
+
+	  			INPUT
+	  				struct PathData *path
+	  				struct ITURHFProp *ITURHFP
+
+	  			OUTPUT
+	  				path->Outputs, ITURHFP->TXBearing and ITURHFP->RXBearing
+	  				Returns RTN_VALIDATEITURHFPOK or the error from ValidateITURHFP()
+
+				SUBROUTINES
+					ReportOutputs()
+					ValidateITURHFP()
+
+	 */
+
+	// The path data dump is written in place of the raster grids and has every result.
+	if(ITURHFP->RptFileFormat == RPT_DUMPPATH) {
+		ITURHFP->raster = RASTER_NONE;
+		ITURHFP->reducefreq = REDUCE_NONE;
+		ITURHFP->reducehours = REDUCE_NONE;
+	};
+
+	// P533() skips the stages whose results are not in the report
+	path->Outputs = ReportOutputs(*ITURHFP);
+	// The best frequency is chosen by the BCR or SNR whether or not they are reported
+	if(ITURHFP->reducefreq != REDUCE_NONE) {
+		path->Outputs |= OUT_RELIABILITY;
+	};
+
+	// The location of the transmitter and receiver are known
+	// so the bearing of the antennas can be determined if necessary.
+	if(ITURHFP->AntennaOrientation == TX2RX) {
+		ITURHFP->TXBearing = dllBearing(path->L_tx, path->L_rx, path->SorL); // Point the transmitter at the receiver.
+		ITURHFP->RXBearing = dllBearing(path->L_rx, path->L_tx, path->SorL); // Point the receiver at the transmitter.
+	};
+
+	return ValidateITURHFP(*ITURHFP);
+};
+
+#ifndef ITURHFPROP_LIB
 void help(void)
 {
 	printf("\n");
 	printf("ITUFHProp [Options] [Input File] [Output File]\n");
+	printf("ITUFHProp [-s] -a [Compiled Antenna File] [Antenna File] ...\n");
+	printf("ITUFHProp [-s] -d [Binary Path Data Dump] [Output File]\n");
 	printf("\tOptions\n");
+	printf("\t\t-a Antenna: Compile one or more antenna files into a single\n");
+	printf("\t\t   compiled antenna file that can be used in place of them.\n");
+	printf("\t\t   Patterns from several files are merged by frequency.\n");
+	printf("\t\t-b Binary: Create a binary columnar output file with the\n");
+	printf("\t\t   columns of the CSV file. See ReadRptBin. With the\n");
+	printf("\t\t   RptFileFormat RPT_DUMPPATH the path data dump is written\n");
+	printf("\t\t   as binary records that -d decodes. It can't be used\n");
+	printf("\t\t   with -c or -p.\n");
 	printf("\t\t-c CSV: Create an RFC4180 compliant CSV output file.\n");
+	printf("\t\t-d Decode: Write the text of a binary path data dump to\n");
+	printf("\t\t   the output file or, if there is none, the display.\n");
 	printf("\t\t-h Help: Displays help\n");
+	printf("\t\t-p Precision: Create the CSV output file of -c with each value\n");
+	printf("\t\t   written in the fewest digits that read back as the same\n");
+	printf("\t\t   double rather than with fixed decimals.\n");
+	printf("\t\t-r Raster: Write each column as a latitude by longitude grid\n");
+	printf("\t\t   for each month, hour and frequency. The next argument\n");
+	printf("\t\t   is the format: asc (ESRI ASCII grids), tif (GeoTIFF)\n");
+	printf("\t\t   or nc (one NetCDF file).\n");
 	printf("\t\t-s Silent Mode: Supresses display output except for error\n");
 	printf("\t\t   messages\n");
 	printf("\t\t-t Table: Print only the CSV table to the output file.\n");
 	printf("\t\t-v Version: Displays the version of ITURHFProp and P533\n");
+	printf("\t\t-z Compress: Write the output file gzip compressed. It is\n");
+	printf("\t\t   compressed by a thread while the calculation runs.\n");
 	printf("\n");
 	printf("\tInput File\n");
 	printf("\t\tFull path name of the input file. If no path is given the\n");
@@ -527,4 +812,4 @@ void help(void)
 	printf("\t\tthe .\\Report file directory\n");
 	printf("\n");
 };
-
+#endif
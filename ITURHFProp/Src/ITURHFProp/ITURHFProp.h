@@ -11,6 +11,11 @@
 	typedef int(__cdecl* iReadType13Func)(struct Antenna* Ant, FILE* DataFilePath, double bearing, int silent);
 	typedef int(__cdecl* iReadType14Func)(struct Antenna* Ant, FILE* DataFilePath, int silent);
 	typedef void(__cdecl * vIsotropicPatternFunc)(struct Antenna *Ant, double G, int silent);
+	typedef int(__cdecl * iAllocateAntennaMemory)(struct Antenna *Ant, int freqn, int azin, int elen);
+	typedef void(__cdecl * vFreeAntennaMemory)(struct Antenna *Ant);
+	typedef int(__cdecl * iReadAntennaBinFunc)(struct Antenna *Ant, const char *FilePath, double bearing, int silent);
+	typedef int(__cdecl * iWriteAntennaBinFunc)(struct Antenna *Ant, const char *FilePath, int silent);
+	typedef int(__cdecl * iReadNECFunc)(struct Antenna *Ant, FILE *fp, const char *CachePath, double bearing, int silent);
 	typedef int(__cdecl * iReadFamDudFunc)(struct PathData *path, char * DataFilePath);
 	typedef int(__cdecl * iReadIonParametersBinFunc)(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
 	typedef int(__cdecl * iReadIonParametersTxtFunc)(struct PathData *path, char DataFilePath[256], int silent);
@@ -37,12 +42,16 @@
 	iP533 dllP533;
 	iPathMemory dllAllocatePathMemory;
 	iPathMemory dllFreePathMemory;
-	iPathMemory dllAllocateAntennaMemory;
+	iAllocateAntennaMemory dllAllocateAntennaMemory;
+	vFreeAntennaMemory dllFreeAntennaMemory;
 	dBearing dllBearing;
 	iReadType11Func dllReadType11Func;
 	iReadType13Func dllReadType13Func;
 	iReadType14Func dllReadType14Func;
 	vIsotropicPatternFunc dllIsotropicPatternFunc;
+	iReadAntennaBinFunc dllReadAntennaBinFunc;
+	iWriteAntennaBinFunc dllWriteAntennaBinFunc;
+	iReadNECFunc dllReadNECFunc;
 	iReadIonParametersBinFunc dllReadIonParametersBinFunc;
 	iReadIonParametersTxtFunc dllReadIonParametersTxtFunc;
 	iReadP1239Func dllReadP1239Func;
@@ -55,11 +64,15 @@
 	int (*dllAllocatePathMemory)(struct PathData *);
 	int (*dllFreePathMemory)(struct PathData *);
 	int (*dllAllocateAntennaMemory)(struct Antenna *Ant, int freqn, int azin, int elen);
+	void (*dllFreeAntennaMemory)(struct Antenna *Ant);
 	double (*dllBearing)(struct Location,struct Location,int direction);
 	int  (*dllReadType11Func)(struct Antenna *Ant, FILE *fp, int silent);
 	int  (*dllReadType13Func)(struct Antenna *Ant, FILE *fp, double bearing, int silent);
 	int  (*dllReadType14Func)(struct Antenna *Ant, FILE *fp, int silent);
 	void (*dllIsotropicPatternFunc)(struct Antenna *Ant, double G, int silent);
+	int  (*dllReadAntennaBinFunc)(struct Antenna *Ant, const char *FilePath, double bearing, int silent);
+	int  (*dllWriteAntennaBinFunc)(struct Antenna *Ant, const char *FilePath, int silent);
+	int  (*dllReadNECFunc)(struct Antenna *Ant, FILE *fp, const char *CachePath, double bearing, int silent);
 	int  (*dllReadIonParametersTxtFunc)(struct PathData *path, char DataFilePath[256], int silent);
         int  (*dllReadIonParametersBinFunc)(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent);
 	int  (*dllReadP1239Func)(struct PathData *path, const char * DataFilePath);
@@ -125,6 +138,13 @@
 //				nn = minute
 //				ss = seconds
 #define	RPT_DUMPPATH		4294967295
+
+// Size of the stdio buffer of the report file. The records are written in blocks of this size.
+#define RPTFILEBUFFER		1048576
+
+// Results in each of the two buffers of the writer thread. The calculation runs at most this many results
+// ahead of the report.
+#define RPTQUEUEROWS		256
 // End Report output options **********************************************************************
 
 // Return values **********************************************************************************
@@ -170,10 +190,35 @@
 #define RTN_ERRCOMMANDLINEARG		75 // ERROR: Invalid Command Line
 #define RTN_ERRNOINPUTFILE			76// ERROR: Missing Input File
 
+// Returns ERROR for CompileAntenna()
+#define RTN_ERRCOMPILEANTENNA		77 // ERROR: Can Not Compile Antenna File
+
+// Returns ERROR for Raster()
+#define RTN_ERRRASTER				78 // ERROR: Can Not Write Raster File
+
+// Returns ERROR for CloseCompressed()
+#define RTN_ERRCOMPRESS				79 // ERROR: Can Not Write Compressed Report File
+
+// Returns ERROR for DecodePathDump()
+#define RTN_ERRDECODEPATHDUMP		80 // ERROR: Can Not Decode Binary Path Data Dump
+
+// Returns ERROR for ValidateITURHFP() and Reduce()
+#define RTN_ERRREDUCE				81 // ERROR: Invalid Reduction Or Can Not Reduce The Results
+
+// Returns ERROR for StreamRun()
+#define RTN_ERRSTREAM				82 // ERROR: The Callback Stopped The Analysis
+
 // Returns OKAY numbers Returns > 30 and <= 40
 #define RTN_ITURHFPropOK			32 // ITURHFProp()
 #define RTN_VALIDATEITURHFPOK		32 // ValidateITURHFP()
 #define RTN_RICOK					33 // ReadInputConfiguration()
+#define RTN_COMPILEANTENNAOK		34 // CompileAntenna()
+#define RTN_RASTEROK				35 // Raster()
+#define RTN_COMPRESSOK				36 // CloseCompressed()
+#define RTN_DECODEPATHDUMPOK		37 // DecodePathDump()
+#define RTN_REDUCEOK				38 // Reduce()
+#define RTN_LOADP533OK				39 // LoadP533()
+#define RTN_STREAMOK				40 // StreamOpen(), StreamRun() and StreamClose()
 
 // Return from ITURHFProp
 #define RTN_MAINOK					0  // Okay Calculation Completed
@@ -198,6 +243,132 @@
 #define MANUAL			11
 // End antenna orientation ************************************************************************
 
+// Binary report file ****************************************************************************
+// The -b option writes the report as a binary columnar file rather than text. The file has the same
+// columns as the RFC 4180 CSV file for the RptFileFormat. It is
+//		struct RptBinHeader
+//		struct RptBinColumn for each column
+//		The report header, with the input configuration, as text (textoffset, textsize)
+//		The RFC 4180 header line, which is the comma separated column names (nameoffset, namesize)
+//		Zero fill to hdrsize
+//		The row groups
+// Each row group holds grouprows rows. The values of each column are together in the row group at the
+// offset of the column, so a row group is a record of fixed size groupsize with an array for each
+// column. The last row group is shorter. It holds lastrows = nrows - (ngroups - 1)*grouprows rows, 
+// rounded up to an even number with a row of zeros so that the doubles stay aligned, and everything in 
+// it is lastrows/grouprows the size, the offset of each column included. Everything is in native byte 
+// order. The month and hour are 1 based as in the text. The columns of the lowest order F2 and E modes
+// and the dominant mode hold n0_F2, n0_E and DMidx from struct PathData.
+#define RPTBINMAGIC			"P533RPT"	// 7 characters and the null fill magic[8]
+#define RPTBINVERSION		2			// 2 has the short last row group
+#define RPTBINBYTEORDER		0x01020304	// Written natively so a file from a machine with a different byte order is detected
+#define RPTBINGROUPROWS		4096		// Rows in a row group
+#define RPTBINALIGN			64			// The row groups start on a multiple of this
+
+// Column types
+#define RPTBIN_DOUBLE		0			// 8 byte double
+#define RPTBIN_INT			1			// 4 byte int
+
+struct RptBinHeader {
+	char magic[8];
+	unsigned int byteorder;
+	unsigned int version;
+	unsigned int hdrsize;		// Offset of the first row group
+	unsigned int ncols;			// Number of columns
+	unsigned int grouprows;		// Rows in a row group
+	unsigned int groupsize;		// Size of a row group (bytes)
+	long long nrows;			// Number of rows
+	long long ngroups;			// Number of row groups
+	long long format;			// RptFileFormat
+	unsigned int textoffset;	// Report header
+	unsigned int textsize;
+	unsigned int nameoffset;	// Column names
+	unsigned int namesize;
+};
+
+struct RptBinColumn {
+	int type;					// RPTBIN_DOUBLE or RPTBIN_INT
+	int size;					// Size of a value (bytes)
+	long long offset;			// Offset of the values from the start of the row group
+};
+// End binary report file ************************************************************************
+
+// Binary path data dump *************************************************************************
+// The -b option with the RptFileFormat RPT_DUMPPATH writes the path data dump as binary records that
+// ITURHFProp -d decodes to the text of the path data dump. The file is
+//		struct PddHeader
+//		struct PddField for each field
+//		The records, each recsize bytes, from hdrsize to the end of the file
+// A field is named for the member of struct PathData that it holds, such as "CP[2].foF2" or 
+// "Md_F2[0].BMUF", or the loop index of struct ITURHFProp, such as "ITURHFP.ihr". A reader finds the 
+// fields by name and skips those it doesn't know so fields can be added without a new version. The 
+// version changes only if the meaning of a field changes. Everything is in native byte order.
+#define PDDMAGIC			"P533PDD"	// 7 characters and the null fill magic[8]
+#define PDDVERSION			1
+#define PDDBYTEORDER		0x01020304	// Written natively so a file from a machine with a different byte order is detected
+#define PDDNAMESIZE			32			// Size of the field name in struct PddField
+
+// Field types
+#define PDD_DOUBLE			0			// 8 byte double
+#define PDD_INT				1			// 4 byte int
+
+struct PddHeader {
+	char magic[8];
+	unsigned int byteorder;
+	unsigned int version;
+	unsigned int hdrsize;		// Offset of the first record
+	unsigned int nfields;		// Number of fields
+	unsigned int recsize;		// Size of a record (bytes)
+	int AntennaOrientation;
+	double TXBearing;
+	double TXGOS;
+	double RXBearing;
+	double RXGOS;
+	int time[8];				// struct tm of the run: sec, min, hour, mday, mon, year, wday and yday
+	char name[256];				// Path name
+	char txname[256];
+	char rxname[256];
+	char txantname[256];
+	char rxantname[256];
+	char P533ver[64];
+	char P533compt[64];
+	char P372ver[64];
+	char P372compt[64];
+};
+
+struct PddField {
+	char name[PDDNAMESIZE];
+	int type;					// PDD_DOUBLE or PDD_INT
+	int offset;					// Offset of the value from the start of the record
+};
+// End binary path data dump *********************************************************************
+
+// Raster report files ***************************************************************************
+// The -r option writes each column of the RFC 4180 CSV file, other than the frequency and receiver
+// location, as a latitude by longitude grid for each month, hour and frequency of an area.
+#define RASTER_NONE			0
+#define RASTER_ASC			1			// ESRI ASCII grid <output file>_<column>_Mmm_Hhh_Ffff.fff.asc for each grid
+#define RASTER_TIFF			2			// GeoTIFF <output file>_<column>_Mmm_Hhh_Ffff.fff.tif for each grid
+#define RASTER_NETCDF		3			// NetCDF classic <output file> with a (month, hour, frequency, latitude, longitude) variable for each column
+// End raster report files ************************************************************************
+
+// Reductions *********************************************************************************
+// The results of an area may be reduced before they are written so only the reduced maps are in the
+// output. ReduceFrequency in the input file keeps, for each month, hour and receiver, the result of the
+// frequency with the largest BCR or SNR. ReduceHours replaces the results of the hours of each month,
+// frequency and receiver with their minimum, maximum, mean or a percentile. Both may be given, in which
+// case the hours of the best frequencies are reduced. A dimension that is reduced has one index whose 
+// hour, in the output, is 0 and whose frequency, in the raster files, is 0.0.
+#define REDUCE_NONE			0
+#define REDUCE_BCR			1			// ReduceFrequency "BCR"
+#define REDUCE_SNR			2			// ReduceFrequency "SNR"
+#define REDUCE_MIN			3			// ReduceHours "MIN"
+#define REDUCE_MAX			4			// ReduceHours "MAX"
+#define REDUCE_MEAN			5			// ReduceHours "MEAN"
+#define REDUCE_PERCENTILE	6			// ReduceHours "Pxx" for the xx percentile
+#define REDUCE_INVALID		-1			// The reduction in the input file is not known
+// End reductions ****************************************************************************
+
 // Casting to an (int) sometimes needs a little help to push it to the next int.
 #define INTTWEEK		1e-8
 
@@ -263,11 +434,14 @@ struct ITURHFProp {
 	double latinc;
 	double lnginc;
 
+	double NoiseGridInc;	// Increment of the noise grid for an area (rad). The grid is not made if it is 0.0
+
 	int AntennaOrientation;
 
 	struct tm *time;
 
 	char DataFilePath[256];
+	char AntCachePath[256];		// Directory of the NEC antenna pattern cache
 
 	char const *P533ver;		// P533() Version number
 	char const *P533compt;		// P533() Compile time
@@ -275,6 +449,19 @@ struct ITURHFProp {
 	int silent;				// Silent flag
 	int header;					// Print header flag
 	int csvRFC4180;			// Create an RFC4180 formatted output csv file.
+	int shortest;			// Write the csv values with the fewest digits that read back the same.
+	int binary;				// Create a binary columnar output file.
+	int raster;				// RASTER_ format of the raster output files or RASTER_NONE
+	int compress;			// Write the report file gzip compressed.
+
+	int reducefreq;			// REDUCE_ of the frequencies
+	int reducehours;		// REDUCE_ of the hours
+	double percentile;		// Percentile (%) of the hours for REDUCE_PERCENTILE
+
+	// A program that embeds the analysis is given each result by the callback in place of the output file. See StreamRun().
+	// The callback returns TRUE to go on or FALSE to stop the analysis.
+	int (*callback)(const struct PathData *path, const struct ITURHFProp *ITURHFP, void *user);
+	void *user;				// Passed to the callback
 };
 
 // End structures *********************************************************************************
@@ -292,6 +479,14 @@ struct ITURHFProp {
 
 // ITURHFProp.c Prototype
 int ITURHFProp(struct PathData *path, struct ITURHFProp *ITURHFP);
+int LoadP533(struct ITURHFProp *ITURHFP);
+int PrepareITURHFP(struct PathData *path, struct ITURHFProp *ITURHFP);
+
+// Stream.c Prototype
+int StreamOpen(struct PathData *path, struct ITURHFProp *ITURHFP);
+int StreamRun(struct PathData *path, struct ITURHFProp *ITURHFP, int (*callback)(const struct PathData *path, const struct ITURHFProp *ITURHFP, void *user), void *user);
+int StreamClose(struct PathData *path);
+int StreamResult(struct PathData *path, struct ITURHFProp *ITURHFP);
 
 // P533.c Prototype for the P533 propagation model engine
 int P533(struct PathData *path);
@@ -305,17 +500,53 @@ int hrs(double time);
 int mns(double time);
 void PrintITUHeader(FILE * fp, char * time, char const * P533Version, char const * P533CompT, char const * P372Version, char const * P372CompT);
 
+// DumpPathBin.c Prototype
+void DumpPathBin(struct PathData path, struct ITURHFProp ITURHFP);
+int DecodePathDump(char *InFilePath, char *OutFilePath, int silent);
+
 // Report.c Prototype
 void Report(struct PathData path, struct ITURHFProp ITURHFP);
+int ReportColumns(struct PathData path, struct ITURHFProp ITURHFP, char *names, int size);
+void ReportValues(struct PathData *path, double *v);
+int ReportOutputs(struct ITURHFProp ITURHFP);
+void ReportRawValues(struct PathData *path, double *v);
+void ReportSetValues(struct PathData *path, double *v);
+int ReportLabelColumn(int i);
+
+// Format.c Prototype
+int PutFixed(char *s, double v, int width, int prec, int space);
+int PutShortest(char *s, double v);
+int PutInt(char *s, int v, int digits);
+
+// Reduce.c Prototype
+int Reduce(struct PathData *path, struct ITURHFProp *ITURHFP);
+void StopReduce(void);
+
+// Raster.c Prototype
+int Raster(struct PathData path, struct ITURHFProp ITURHFP);
+
+// Writer.c Prototype
+int StartWriter(void);
+void QueueOutput(struct PathData *path, struct ITURHFProp *ITURHFP);
+void StopWriter(void);
+
+// Compress.c Prototype
+FILE *OpenCompressed(const char *filename);
+int CloseCompressed(FILE *fp);
 
 // ReadAntennaPatterns.c Prototype
 int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP);
+int ReadAntennaFile(struct Antenna *Ant, char *FilePath, char *CachePath, double bearing, int silent);
+
+// CompileAntenna.c Prototype
+int CompileAntenna(char *OutFilePath, char *InFilePath[], int n, int silent);
 
 // ValidateITURHFP.c Prototype
 int ValidateITURHFP(struct ITURHFProp ITURHFP);
 
 // ReadInputConfiguration.c PRototype
 int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, struct PathData *path);
+void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path);
 
 // End prototypes *********************************************************************************
 
@@ -90,6 +90,15 @@
 // Return ERROR from ReadIonParametersTxt()
 #define RTN_ERRREADIONPARAMETERS		141 // ERROR: Can Not Open Ionospheric Parameters File
 
+// Return ERROR from ReadAntennaBin() and WriteAntennaBin()
+#define RTN_ERRANTENNABIN				142 // ERROR: Invalid Compiled Antenna File
+#define RTN_ERRANTENNABINCHECKSUM		143 // ERROR: Compiled Antenna File Checksum Failed
+#define RTN_ERRWRITEANTENNABIN			144 // ERROR: Can Not Write Compiled Antenna File
+
+// Return ERROR from ReadNEC()
+#define RTN_ERRNECDECK					145 // ERROR: Invalid Or Unsupported NEC Deck
+#define RTN_ERRNECSOLVE					146 // ERROR: NEC Deck Can Not Be Solved
+
 
 // Return OKAY > 10 and <= 20
 #define RTN_ALLOCATEP533OK				11 // AllocatePathMemory()
@@ -99,6 +108,7 @@
 #define RTN_READP1239OK					15 // ReadP1239()
 #define RTN_READANTENNAPATTERNSOK		16 // ReadAntennaPatterns()
 #define	RTN_VALIDDATAOK					17 // ValidPath()
+#define RTN_WRITEANTENNABINOK			18 // WriteAntennaBin()
 
 #define	RTN_P533OK						10 // P533()
 
@@ -187,6 +197,17 @@
 #define TXTORX	1
 #define RXTOTX  2
 
+// Results that are needed from P533() for PathData Outputs
+// The stages of P533() that only find results that are not needed are skipped and those results are
+// left as InitializePath() sets them. The MUFs, modes and control points of Part 1 are always found. Part 2
+// is always run for a path of 7000 km or more since it finds the MUFs of the path.
+// Outputs of 0 is taken as OUT_ALL.
+#define OUT_MUF			1	// Part 1 MUFs, modes and control points
+#define OUT_FIELD		2	// Part 2 field strength, received power, elevation and the dominant mode
+#define OUT_NOISE		4	// Noise from P372
+#define OUT_RELIABILITY	8	// CircuitReliability() SNR, SIR, the reliabilities and MIR. This needs the field strength and noise
+#define OUT_ALL			(OUT_MUF | OUT_FIELD | OUT_NOISE | OUT_RELIABILITY)
+
 // Testing
 // E Layer Screening switch
 #define NOELAYERSCREENING TRUE
@@ -289,9 +310,62 @@ struct Antenna {
 	// The following is assumed about the antenna pattern when the program is run:
 	//		i) The orientation is correct. The antenna pattern is in the orientation as it would be on the Earth.
 	//		ii) The data is valid. It is the responsibility of the calling program to ensure this.
+	// The azimuth index is relative to the main beam of the antenna. The bearing below is applied 
+	// in AntennaGain() when the pattern is looked up so that the pattern does not need to be reread
+	// when the orientation of the antenna changes.
 	double ***pattern;
+
+	// Bearing of the main beam of the antenna (radians from true north)
+	double bearing;
+
+	// When the pattern has been loaded from a compiled antenna file by ReadAntennaBin() freqs and 
+	// the pattern rows point into the file mapping which starts at map and is mapsize bytes long.
+	// map is NULL when the pattern has been allocated by AllocateAntennaMemory().
+	void *map;
+	size_t mapsize;
 };
 
+// Compiled antenna file **************************************************************************
+// A compiled antenna file is the struct AntennaBinHeader followed by freqn frequencies (MHz)
+// and then freqn x azin x elen gain values (dBi), all as native doubles in the same 
+// [freq][azimuth][elevation] order as struct Antenna. The file is written by WriteAntennaBin()
+// and mapped directly into memory by ReadAntennaBin().
+#define ANTBINMAGIC			"P533ANT"	// 7 characters and the null fill magic[8]
+#define ANTBINVERSION		1
+#define ANTBINBYTEORDER		0x01020304	// Written natively so a file from a machine with a different byte order is detected
+
+struct AntennaBinHeader {
+	char magic[8];
+	unsigned int byteorder;
+	unsigned int version;
+	int freqn;					// Number of frequencies
+	int azin;					// Number of azimuths (360)
+	int elen;					// Number of elevations (91)
+	unsigned int checksum;		// CRC-32 of everything that follows the header
+	char Name[256];				// Name of the antenna
+};
+// End compiled antenna file **********************************************************************
+
+// Ionospheric parameter cache ********************************************************************
+// ReadIonParametersTxt() keeps the parsed ionosXX.txt next to it as ionosXX.txt.cache. The cache is the 
+// struct IonCacheHeader followed by the foF2 and then the M3kF2 values as native floats in the order of 
+// the text file, [SSN][longitude][latitude][hour]. It is used only while the size and modification time
+// of the text file are those recorded in the header.
+#define IONCACHEMAGIC		"P533ION"	// 7 characters and the null fill magic[8]
+#define IONCACHEVERSION		1
+
+struct IonCacheHeader {
+	char magic[8];
+	unsigned int byteorder;		// ANTBINBYTEORDER
+	unsigned int version;
+	long long txtsize;			// Size of the text file (bytes)
+	long long txtmtime;			// Modification time of the text file
+	int hrs, lng, lat, ssn;		// Dimensions of the atlas
+	unsigned int checksum;		// CRC-32 of the values
+	unsigned int spare;
+};
+// End ionospheric parameter cache ****************************************************************
+
 // Any "adjustment" to the contents of the structure PathData to make indices out of some of the variables, such as month and hour
 // are done in InitializePath()
 
@@ -457,6 +531,13 @@ struct PathData {
 	char const *P372compt;		// P372() Compile time
 
 	// End Calculated Parameters *****************************************************************************
+
+	// OUT_ results that are needed. It and NoCache are last so that the members above are where they were
+	// before they were added. AllocatePathMemory() sets it to 0, which is OUT_ALL.
+	int Outputs;
+	// TRUE so that no cache file, ionosXX.txt.cache or an NEC pattern cache, is written. Caches that are 
+	// already there are still read. AllocatePathMemory() sets it to FALSE.
+	int NoCache;
 };
 
 // End Structures *********************************************************************************
@@ -542,6 +623,18 @@ void CircuitReliability(struct PathData *path);
 DLLEXPORT int AllocatePathMemory(struct PathData *path);
 DLLEXPORT int FreePathMemory(struct PathData *path);
 DLLEXPORT int AllocateAntennaMemory(struct Antenna *ant, int freqn, int azin, int elen);
+DLLEXPORT void FreeAntennaMemory(struct Antenna *ant);
+float ****AllocateIonMap(int hrs, int lng, int lat, int ssn);
+void FreeIonMap(float ****map);
+
+// AntennaBin.c Prototypes
+DLLEXPORT int ReadAntennaBin(struct Antenna *Ant, const char *FilePath, double bearing, int silent);
+DLLEXPORT int WriteAntennaBin(struct Antenna *Ant, const char *FilePath, int silent);
+void UnmapAntennaFile(void *map, size_t mapsize);
+unsigned int AntennaChecksum(unsigned int crc, const unsigned char *buf, size_t len);
+
+// ReadNEC.c Prototypes
+DLLEXPORT int ReadNEC(struct Antenna *Ant, FILE *fp, const char *CachePath, double bearing, int silent);
 
 // InputDump. c Prototype
 DLLEXPORT int InputDump(struct PathData *path);
@@ -555,6 +648,7 @@ DLLEXPORT int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, c
 DLLEXPORT int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int silent) ;
 DLLEXPORT int ReadP1239(struct PathData *path, const char * DataFilePath);
 DLLEXPORT void SetAntennaPatternVal(struct PathData * path, int TXorRX, int azimuth, int elevation, double value);
+DLLEXPORT void SetAntennaBearing(struct PathData * path, int TXorRX, double bearing);
 
 //Testing Routines
 DLLEXPORT int sizeofPathDataStruct();
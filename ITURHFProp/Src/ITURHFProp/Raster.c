@@ -0,0 +1,801 @@
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local #define
+#ifdef _WIN32
+	#define fseek64		_fseeki64
+#else
+	#define fseek64		fseeko
+#endif
+
+#define RASTERMAXCOLS	96			// More than all the RPT_ columns
+#define RASTERNODATA	-9999.0		// NODATA value of the grids and _FillValue of the NetCDF quantities
+#define RASTERFLTMAX	3.402823466e+38	// Largest float of a grid
+
+// NetCDF classic header tags and types
+#define NC_DIMENSION	0x0A
+#define NC_VARIABLE		0x0B
+#define NC_ATTRIBUTE	0x0C
+#define NC_CHAR			2
+#define NC_INT			4
+#define NC_FLOAT		5
+#define NC_DOUBLE		6
+#define NCDIMS			5			// month, hour, frequency, latitude and longitude
+#define NCCOORDS		5			// A coordinate variable for each dimension
+
+// TIFF field types
+#define TIFF_ASCII		2
+#define TIFF_SHORT		3
+#define TIFF_LONG		4
+#define TIFF_DOUBLE		12
+// End local #define
+
+// Local structures
+// The grid of an area for one month, hour and frequency is collected from the records in the order of
+// the latitude and longitude loops of ITURHFProp(). When it is complete each quantity is written.
+struct RasterGrid {
+	int format;						// RASTER_
+	int ncols;						// Columns from ReportColumns()
+	int nq;							// Number of quantities
+	int col[RASTERMAXCOLS];			// Column of each quantity
+	char name[RASTERMAXCOLS][32];	// Name of each quantity, made unique
+	char names[2048];				// Names of the columns
+	char base[256];					// Output file without its extension for RASTER_ASC and RASTER_TIFF
+	int nlat;
+	int nlng;
+	double latmin;					// Latitude of the first row (degrees)
+	double lngmin;					// Longitude of the first column (degrees)
+	double latinc;					// (degrees)
+	double lnginc;					// (degrees)
+	double *v;						// Values of a record
+	float *grid;					// nq grids of nlat x nlng, the first row is latmin
+	unsigned char *buf;				// A grid in the byte order of the file
+	long long *begin;				// Offset of each quantity in the NetCDF file
+};
+
+// The NetCDF header is made twice, once to find its size
+struct NCHeader {
+	unsigned char *p;				// Header or NULL to only count
+	long long n;					// Size of the header
+	int offset64;					// 64-bit offset format (CDF-2)
+};
+// End local structures
+
+// Local prototypes
+int OpenRaster(struct PathData path, struct ITURHFProp ITURHFP);
+int WriteRasterGrids(struct ITURHFProp ITURHFP);
+void CloseRaster(void);
+int WriteRasterASC(const char *filename, const float *data);
+int WriteRasterTIFF(const char *filename, const float *data);
+int OpenRasterNetCDF(struct PathData path, struct ITURHFProp ITURHFP);
+int WriteRasterNetCDF(struct ITURHFProp ITURHFP);
+void NCHeader(struct NCHeader *h, struct PathData path, struct ITURHFProp ITURHFP, long long hdrsize);
+void NCHeaderInt(struct NCHeader *h, unsigned int val);
+void NCHeaderOffset(struct NCHeader *h, long long val);
+void NCHeaderName(struct NCHeader *h, const char *name);
+void NCHeaderVar(struct NCHeader *h, const char *name, int type, int dimid, const char *units, long long vsize, long long begin);
+void NCHeaderAtt(struct NCHeader *h, const char *name, const char *value);
+void NCHeaderFill(struct NCHeader *h);
+void PutBigEndian(unsigned char *out, const void *in, int size, long long n);
+void TIFFEntry(unsigned char *p, int tag, int type, unsigned int count, unsigned int value);
+// End local prototypes
+
+// Local globals
+static struct RasterGrid Grid = {RASTER_NONE};
+// End local globals
+
+int Raster(struct PathData path, struct ITURHFProp ITURHFP) {
+
+	/*
+	 * Raster() - Writes the report of an area as raster grids rather than as text. Each column of the RFC 4180 CSV
+	 *		file, other than the frequency and receiver location, is a quantity that has a latitude by longitude
+	 *		grid for each month, hour and frequency. Depending on ITURHFP.raster each grid is an ESRI ASCII grid
+	 *		or a GeoTIFF file, or all the grids are in one NetCDF classic file. The grids are georeferenced by the
+	 *		centres of their cells, which are the receiver locations. Raster() is called after each P533() run in
+	 *		place of Report() and keeps the grid that is being filled.
+	 *
+	 *			INPUT
+	 *				struct PathData path
+	 *				struct ITURHFProp ITURHFP
+	 *
+	 *			OUTPUT
+	 *				The raster files
+	 *
+	 *				Returns
+	 *					RTN_RASTEROK
+	 *					RTN_ERRRASTER
+	 *
+	 *			SUBROUTINES
+	 *				OpenRaster()
+	 *				ReportValues()
+	 *				WriteRasterGrids()
+	 *				CloseRaster()
+	 */
+
+	float *g;
+
+	double v;
+
+	int retval;
+	int q;
+
+	// The first record starts the raster output.
+	if(Grid.format == RASTER_NONE) {
+		retval = OpenRaster(path, ITURHFP);
+		if(retval != RTN_RASTEROK) {
+			CloseRaster();
+			return retval;
+		};
+	};
+
+	ReportValues(&path, Grid.v);
+
+	g = Grid.grid + (size_t)ITURHFP.ilat*Grid.nlng + ITURHFP.ilng;
+	for(q=0; q<Grid.nq; q++) {
+		v = Grid.v[Grid.col[q]];
+		// A result that wasn't found, which is TOOBIG, or one that isn't a float is NODATA
+		if(isnan(v) || (fabs(v) > RASTERFLTMAX)) {
+			v = RASTERNODATA;
+		};
+		g[(size_t)q*Grid.nlat*Grid.nlng] = (float)v;
+	};
+
+	// Write the grids once the area is complete.
+	if((ITURHFP.ilat == ITURHFP.ilatend - 1) && (ITURHFP.ilng == ITURHFP.ilngend - 1)) {
+		retval = WriteRasterGrids(ITURHFP);
+		if(retval != RTN_RASTEROK) {
+			CloseRaster();
+			return retval;
+		};
+
+		// Last grid of the report
+		if((ITURHFP.ihr == ITURHFP.ihrend - 1) &&
+			(ITURHFP.ifrq == ITURHFP.ifrqend - 1) &&
+			(ITURHFP.imnth == ITURHFP.imnthend - 1)) {
+			CloseRaster();
+		};
+	};
+
+	return RTN_RASTEROK;
+};
+
+int OpenRaster(struct PathData path, struct ITURHFProp ITURHFP) {
+
+	/*
+	 * OpenRaster() - Finds the quantities and the grid of the area and allocates the grids. For NetCDF the
+	 *		header and the coordinate variables are written.
+	 */
+
+	char *s;
+	char *name;
+	char *ext;
+
+	int i, q;
+
+	memset(&Grid, 0, sizeof(struct RasterGrid));
+
+	Grid.ncols = ReportColumns(path, ITURHFP, Grid.names, sizeof(Grid.names));
+	if((Grid.ncols == 0) || (Grid.ncols > RASTERMAXCOLS)) {
+		printf("Raster: Error %d Too many columns\n", RTN_ERRRASTER);
+		return RTN_ERRRASTER;
+	};
+
+	// The frequency and receiver location are the coordinates of the grids rather than quantities. The best
+	// frequency of a ReduceFrequency run differs across the grid so it is the quantity bestfreq.
+	// A name that is repeated in the CSV header (Grw) is followed by the index of its CSV column as in ReadRptBin.txt.
+	s = Grid.names;
+	for(i=0; i<Grid.ncols; i++) {
+		name = s;
+		s += strcspn(s, ",");
+		if(*s == ',') *s++ = '\0';
+		if(((strcmp(name, "frequency") == 0) && (ITURHFP.reducefreq == REDUCE_NONE)) ||
+		   (strcmp(name, "rxlat") == 0) || (strcmp(name, "rxlng") == 0)) {
+			continue;
+		};
+		if(strcmp(name, "frequency") == 0) {
+			name = "bestfreq";
+		};
+		sprintf(Grid.name[Grid.nq], "%.24s", name);
+		for(q=0; q<Grid.nq; q++) {
+			if(strcmp(Grid.name[q], Grid.name[Grid.nq]) == 0) {
+				sprintf(Grid.name[Grid.nq], "%.24s_%d", name, i + 2);
+				break;
+			};
+		};
+		Grid.col[Grid.nq++] = i;
+	};
+
+	Grid.format = ITURHFP.raster;
+	Grid.nlat = ITURHFP.ilatend;
+	Grid.nlng = ITURHFP.ilngend;
+	// The area is given in degrees, so the round trip through radians is taken out.
+	Grid.latmin = floor(ITURHFP.L_LL.lat*R2D*1e7 + 0.5)/1e7;
+	Grid.lngmin = floor(ITURHFP.L_LL.lng*R2D*1e7 + 0.5)/1e7;
+	Grid.latinc = floor(ITURHFP.latinc*R2D*1e7 + 0.5)/1e7;
+	Grid.lnginc = floor(ITURHFP.lnginc*R2D*1e7 + 0.5)/1e7;
+
+	Grid.v = (double *)malloc(Grid.ncols*sizeof(double));
+	Grid.grid = (float *)malloc((size_t)Grid.nq*Grid.nlat*Grid.nlng*sizeof(float));
+	Grid.buf = (unsigned char *)malloc((size_t)Grid.nlat*Grid.nlng*sizeof(float));
+	Grid.begin = (long long *)malloc(Grid.nq*sizeof(long long));
+	if((Grid.v == NULL) || (Grid.grid == NULL) || (Grid.buf == NULL) || (Grid.begin == NULL)) {
+		printf("Raster: Error %d Can't allocate the %d x %d grids\n", RTN_ERRRASTER, Grid.nlat, Grid.nlng);
+		return RTN_ERRRASTER;
+	};
+
+	// The ESRI ASCII and GeoTIFF file names start with the output file name without its extension.
+	strcpy(Grid.base, ITURHFP.RptFilePath);
+	ext = strrchr(Grid.base, '.');
+	if((ext != NULL) && (strpbrk(ext, "/\\") == NULL)) {
+		*ext = '\0';
+	};
+
+	// User feedback
+	if(ITURHFP.silent != TRUE) {
+		printf("Raster: Writing %d quantities as %d x %d grids\n", Grid.nq, Grid.nlat, Grid.nlng);
+	};
+
+	if(Grid.format == RASTER_NETCDF) {
+		return OpenRasterNetCDF(path, ITURHFP);
+	};
+
+	return RTN_RASTEROK;
+};
+
+int WriteRasterGrids(struct ITURHFProp ITURHFP) {
+
+	/*
+	 * WriteRasterGrids() - Writes the grid of each quantity for the month, hour and frequency.
+	 */
+
+	char filename[512];
+
+	int q;
+
+	if(Grid.format == RASTER_NETCDF) {
+		return WriteRasterNetCDF(ITURHFP);
+	};
+
+	for(q=0; q<Grid.nq; q++) {
+		sprintf(filename, "%s_%s_M%02d_H%02d_F%.3f.%s", Grid.base, Grid.name[q], ITURHFP.months[ITURHFP.imnth] + 1,
+			ITURHFP.hrs[ITURHFP.ihr] + 1, ITURHFP.frqs[ITURHFP.ifrq], (Grid.format == RASTER_ASC) ? "asc" : "tif");
+		if(((Grid.format == RASTER_ASC) && (WriteRasterASC(filename, Grid.grid + (size_t)q*Grid.nlat*Grid.nlng) != TRUE)) ||
+			((Grid.format == RASTER_TIFF) && (WriteRasterTIFF(filename, Grid.grid + (size_t)q*Grid.nlat*Grid.nlng) != TRUE))) {
+			printf("Raster: Error %d Can't write %s\n", RTN_ERRRASTER, filename);
+			return RTN_ERRRASTER;
+		};
+	};
+
+	return RTN_RASTEROK;
+};
+
+void CloseRaster(void) {
+
+	/*
+	 * CloseRaster() - Frees the grids. The NetCDF file is closed with the report file.
+	 */
+
+	free(Grid.v);
+	free(Grid.grid);
+	free(Grid.buf);
+	free(Grid.begin);
+
+	memset(&Grid, 0, sizeof(struct RasterGrid));
+	Grid.format = RASTER_NONE;
+
+	return;
+};
+
+int WriteRasterASC(const char *filename, const float *data) {
+
+	/*
+	 * WriteRasterASC() - Writes one grid as an ESRI ASCII grid. The rows are written from north to south and
+	 *		the corner is given as the centre of the south west cell. When the latitude and longitude increments
+	 *		differ the cell size is given as dx and dy. Returns TRUE or FALSE if the file can't be written.
+	 */
+
+	FILE *fp;
+
+	int i, j;
+	int err = FALSE;
+
+	fp = fopen(filename, "w");
+	if(fp == NULL) {
+		return FALSE;
+	};
+
+	fprintf(fp, "ncols %d\n", Grid.nlng);
+	fprintf(fp, "nrows %d\n", Grid.nlat);
+	fprintf(fp, "xllcenter %.10g\n", Grid.lngmin);
+	fprintf(fp, "yllcenter %.10g\n", Grid.latmin);
+	if(fabs(Grid.latinc - Grid.lnginc) < 1e-9) {
+		fprintf(fp, "cellsize %.10g\n", Grid.lnginc);
+	}
+	else {
+		fprintf(fp, "dx %.10g\n", Grid.lnginc);
+		fprintf(fp, "dy %.10g\n", Grid.latinc);
+	};
+	fprintf(fp, "NODATA_value %g\n", RASTERNODATA);
+
+	for(i=Grid.nlat-1; i>=0; i--) {
+		for(j=0; j<Grid.nlng; j++) {
+			fprintf(fp, (j == 0) ? "%.7g" : " %.7g", data[(size_t)i*Grid.nlng + j]);
+		};
+		fprintf(fp, "\n");
+	};
+
+	if(ferror(fp)) err = TRUE;
+	if(fclose(fp) != 0) err = TRUE;
+
+	return (err == TRUE) ? FALSE : TRUE;
+};
+
+int WriteRasterTIFF(const char *filename, const float *data) {
+
+	/*
+	 * WriteRasterTIFF() - Writes one grid as an uncompressed 32-bit float GeoTIFF in one strip. The rows are
+	 *		written from north to south. The GeoKeys give WGS 84 latitude and longitude with the tie point at the
+	 *		centre of the north west cell (PixelIsPoint). The file is in native byte order, which TIFF allows.
+	 *		Returns TRUE or FALSE if the file can't be written.
+	 */
+
+	// GeoKeyDirectory: version, 3 keys, GTModelTypeGeoKey geographic, GTRasterTypeGeoKey PixelIsPoint,
+	// GeographicTypeGeoKey WGS 84
+	static const unsigned short geokeys[16] = {1, 1, 0, 3, 1024, 0, 1, 2, 1025, 0, 1, 2, 2048, 0, 1, 4326};
+
+	FILE *fp;
+
+	unsigned char ifd[2 + 15*12 + 4];
+	unsigned char *p;
+
+	double scale[3];
+	double tie[6];
+
+	unsigned int imagesize;
+	unsigned int ifdoffset;
+	unsigned int extra;			// Offset of the values that don't fit in the IFD
+	unsigned short us;
+
+	int i;
+	int err = FALSE;
+
+	fp = fopen(filename, "wb");
+	if(fp == NULL) {
+		return FALSE;
+	};
+
+	imagesize = (unsigned int)(Grid.nlat*Grid.nlng*sizeof(float));
+	ifdoffset = 8 + imagesize;
+	extra = ifdoffset + sizeof(ifd);
+
+	// Header in native byte order
+	us = 1;
+	fwrite((*(unsigned char *)&us == 1) ? "II" : "MM", 1, 2, fp);
+	us = 42;
+	fwrite(&us, 2, 1, fp);
+	fwrite(&ifdoffset, 4, 1, fp);
+
+	// Image from north to south
+	for(i=Grid.nlat-1; i>=0; i--) {
+		fwrite(data + (size_t)i*Grid.nlng, sizeof(float), Grid.nlng, fp);
+	};
+
+	// IFD with the tags in ascending order
+	us = 15;
+	memcpy(ifd, &us, 2);
+	p = ifd + 2;
+	TIFFEntry(p, 256, TIFF_LONG, 1, Grid.nlng);			p += 12;	// ImageWidth
+	TIFFEntry(p, 257, TIFF_LONG, 1, Grid.nlat);			p += 12;	// ImageLength
+	TIFFEntry(p, 258, TIFF_SHORT, 1, 32);				p += 12;	// BitsPerSample
+	TIFFEntry(p, 259, TIFF_SHORT, 1, 1);				p += 12;	// Compression none
+	TIFFEntry(p, 262, TIFF_SHORT, 1, 1);				p += 12;	// PhotometricInterpretation BlackIsZero
+	TIFFEntry(p, 273, TIFF_LONG, 1, 8);					p += 12;	// StripOffsets
+	TIFFEntry(p, 277, TIFF_SHORT, 1, 1);				p += 12;	// SamplesPerPixel
+	TIFFEntry(p, 278, TIFF_LONG, 1, Grid.nlat);			p += 12;	// RowsPerStrip
+	TIFFEntry(p, 279, TIFF_LONG, 1, imagesize);			p += 12;	// StripByteCounts
+	TIFFEntry(p, 284, TIFF_SHORT, 1, 1);				p += 12;	// PlanarConfiguration
+	TIFFEntry(p, 339, TIFF_SHORT, 1, 3);				p += 12;	// SampleFormat IEEE float
+	TIFFEntry(p, 33550, TIFF_DOUBLE, 3, extra);			p += 12;	// ModelPixelScaleTag
+	TIFFEntry(p, 33922, TIFF_DOUBLE, 6, extra + 24);	p += 12;	// ModelTiepointTag
+	TIFFEntry(p, 34735, TIFF_SHORT, 16, extra + 72);	p += 12;	// GeoKeyDirectoryTag
+	TIFFEntry(p, 42113, TIFF_ASCII, 6, extra + 104);	p += 12;	// GDAL_NODATA
+	memset(p, 0, 4);												// No next IFD
+	fwrite(ifd, 1, sizeof(ifd), fp);
+
+	scale[0] = Grid.lnginc;
+	scale[1] = Grid.latinc;
+	scale[2] = 0.0;
+	tie[0] = 0.0;
+	tie[1] = 0.0;
+	tie[2] = 0.0;
+	tie[3] = Grid.lngmin;
+	tie[4] = Grid.latmin + (Grid.nlat - 1)*Grid.latinc;
+	tie[5] = 0.0;
+	fwrite(scale, sizeof(double), 3, fp);
+	fwrite(tie, sizeof(double), 6, fp);
+	fwrite(geokeys, sizeof(unsigned short), 16, fp);
+	fwrite("-9999", 1, 6, fp);
+
+	if(ferror(fp)) err = TRUE;
+	if(fclose(fp) != 0) err = TRUE;
+
+	return (err == TRUE) ? FALSE : TRUE;
+};
+
+void TIFFEntry(unsigned char *p, int tag, int type, unsigned int count, unsigned int value) {
+
+	/*
+	 * TIFFEntry() - Makes a 12 byte IFD entry in native byte order. A SHORT value is left justified in the
+	 *		value field.
+	 */
+
+	unsigned short us;
+
+	us = (unsigned short)tag;
+	memcpy(p, &us, 2);
+	us = (unsigned short)type;
+	memcpy(p + 2, &us, 2);
+	memcpy(p + 4, &count, 4);
+	memset(p + 8, 0, 4);
+	if((type == TIFF_SHORT) && (count == 1)) {
+		us = (unsigned short)value;
+		memcpy(p + 8, &us, 2);
+	}
+	else {
+		memcpy(p + 8, &value, 4);
+	};
+
+	return;
+};
+
+int OpenRasterNetCDF(struct PathData path, struct ITURHFProp ITURHFP) {
+
+	/*
+	 * OpenRasterNetCDF() - Writes the header and coordinate variables of the NetCDF file. The quantities are
+	 *		float variables (month, hour, frequency, latitude, longitude) that are written a grid at a time by
+	 *		WriteRasterNetCDF() so only one grid is kept. The month and hour are 1 based as in the text report.
+	 *		The 64-bit offset format is used when the file would be too large for the classic format.
+	 */
+
+	struct NCHeader h;
+
+	unsigned char *coords;
+	unsigned char *p;
+
+	long long gridsize;
+	long long coordsize;
+	long long datasize;
+
+	double d;
+
+	int i, q;
+
+	gridsize = (long long)Grid.nlat*Grid.nlng*sizeof(float);
+	coordsize = 4*(long long)ITURHFP.imnthend + 4*(long long)ITURHFP.ihrend + 8*(long long)ITURHFP.ifrqend +
+		8*(long long)Grid.nlat + 8*(long long)Grid.nlng;
+	datasize = coordsize + Grid.nq*gridsize*ITURHFP.imnthend*ITURHFP.ihrend*ITURHFP.ifrqend;
+
+	// Find the size of the header. The offsets don't change its size.
+	h.p = NULL;
+	h.offset64 = FALSE;
+	NCHeader(&h, path, ITURHFP, 0);
+	if(h.n + datasize > 2147483647LL) {
+		h.offset64 = TRUE;
+		NCHeader(&h, path, ITURHFP, 0);
+	};
+
+	// The header followed by the coordinate variables
+	coords = (unsigned char *)malloc((size_t)(h.n + coordsize));
+	if(coords == NULL) {
+		printf("Raster: Error %d Can't allocate the NetCDF header\n", RTN_ERRRASTER);
+		return RTN_ERRRASTER;
+	};
+	h.p = coords;
+	NCHeader(&h, path, ITURHFP, h.n);
+
+	p = coords + h.n;
+	for(i=0; i<ITURHFP.imnthend; i++) {
+		q = ITURHFP.months[i] + 1;
+		PutBigEndian(p, &q, 4, 1);
+		p += 4;
+	};
+	for(i=0; i<ITURHFP.ihrend; i++) {
+		q = ITURHFP.hrs[i] + 1;
+		PutBigEndian(p, &q, 4, 1);
+		p += 4;
+	};
+	PutBigEndian(p, ITURHFP.frqs, 8, ITURHFP.ifrqend);
+	p += 8*ITURHFP.ifrqend;
+	for(i=0; i<Grid.nlat; i++) {
+		d = Grid.latmin + i*Grid.latinc;
+		PutBigEndian(p, &d, 8, 1);
+		p += 8;
+	};
+	for(i=0; i<Grid.nlng; i++) {
+		d = Grid.lngmin + i*Grid.lnginc;
+		PutBigEndian(p, &d, 8, 1);
+		p += 8;
+	};
+
+	fwrite(coords, 1, (size_t)(p - coords), ITURHFP.rptfp);
+	free(coords);
+
+	if(ferror(ITURHFP.rptfp)) {
+		printf("Raster: Error %d Can't write %s\n", RTN_ERRRASTER, ITURHFP.RptFilePath);
+		return RTN_ERRRASTER;
+	};
+
+	return RTN_RASTEROK;
+};
+
+int WriteRasterNetCDF(struct ITURHFProp ITURHFP) {
+
+	/*
+	 * WriteRasterNetCDF() - Writes the grid of each quantity for the month, hour and frequency at its place in
+	 *		the NetCDF variable.
+	 */
+
+	long long gridsize;
+	long long index;
+
+	int q;
+
+	gridsize = (long long)Grid.nlat*Grid.nlng*sizeof(float);
+	index = ((long long)ITURHFP.imnth*ITURHFP.ihrend + ITURHFP.ihr)*ITURHFP.ifrqend + ITURHFP.ifrq;
+
+	for(q=0; q<Grid.nq; q++) {
+		PutBigEndian(Grid.buf, Grid.grid + (size_t)q*Grid.nlat*Grid.nlng, 4, (long long)Grid.nlat*Grid.nlng);
+		if((fseek64(ITURHFP.rptfp, Grid.begin[q] + index*gridsize, SEEK_SET) != 0) ||
+			(fwrite(Grid.buf, 1, (size_t)gridsize, ITURHFP.rptfp) != (size_t)gridsize)) {
+			printf("Raster: Error %d Can't write %s\n", RTN_ERRRASTER, ITURHFP.RptFilePath);
+			return RTN_ERRRASTER;
+		};
+	};
+
+	return RTN_RASTEROK;
+};
+
+void NCHeader(struct NCHeader *h, struct PathData path, struct ITURHFProp ITURHFP, long long hdrsize) {
+
+	/*
+	 * NCHeader() - Makes the NetCDF header. The coordinate variables and then the quantities follow the header,
+	 *		which is hdrsize long, and the offset of each quantity is kept in Grid.begin[]. When h->p is NULL 
+	 *		only the size of the header is found.
+	 */
+
+	static const char *dimname[NCDIMS] = {"month", "hour", "frequency", "latitude", "longitude"};
+	static const int dimtype[NCDIMS] = {NC_INT, NC_INT, NC_DOUBLE, NC_DOUBLE, NC_DOUBLE};
+	static const char *dimunits[NCDIMS] = {NULL, NULL, "MHz", "degrees_north", "degrees_east"};
+
+	char created[64];
+	char txloc[64];
+	char ssn[16];
+
+	long long begin;
+	long long vsize;
+
+	int dimlen[NCDIMS];
+	int i, q;
+
+	dimlen[0] = ITURHFP.imnthend;
+	dimlen[1] = ITURHFP.ihrend;
+	dimlen[2] = ITURHFP.ifrqend;
+	dimlen[3] = Grid.nlat;
+	dimlen[4] = Grid.nlng;
+
+	strftime(created, sizeof(created), "%Y-%m-%d %H:%M:%S", ITURHFP.time);
+	sprintf(txloc, "%.6f %.6f", path.L_tx.lat*R2D, path.L_tx.lng*R2D);
+	sprintf(ssn, "%d", path.SSN);
+
+	if(h->p != NULL) {
+		memcpy(h->p, (h->offset64 == TRUE) ? "CDF\002" : "CDF\001", 4);
+	};
+	h->n = 4;
+	NCHeaderInt(h, 0);								// numrecs, there is no record dimension
+
+	NCHeaderInt(h, NC_DIMENSION);
+	NCHeaderInt(h, NCDIMS);
+	for(i=0; i<NCDIMS; i++) {
+		NCHeaderName(h, dimname[i]);
+		NCHeaderInt(h, dimlen[i]);
+	};
+
+	NCHeaderInt(h, NC_ATTRIBUTE);
+	NCHeaderInt(h, 8);
+	NCHeaderAtt(h, "title", "Recommendation ITU-R P.533 prediction");
+	NCHeaderAtt(h, "path_name", path.name);
+	NCHeaderAtt(h, "tx_name", path.txname);
+	NCHeaderAtt(h, "tx_latitude_longitude", txloc);
+	NCHeaderAtt(h, "SSN", ssn);
+	NCHeaderAtt(h, "P533_version", ITURHFP.P533ver);
+	NCHeaderAtt(h, "P533_compile_time", ITURHFP.P533compt);
+	NCHeaderAtt(h, "created", created);
+
+	NCHeaderInt(h, NC_VARIABLE);
+	NCHeaderInt(h, NCCOORDS + Grid.nq);
+
+	begin = hdrsize;
+	for(i=0; i<NCCOORDS; i++) {
+		vsize = (long long)dimlen[i]*((dimtype[i] == NC_INT) ? 4 : 8);
+		NCHeaderVar(h, dimname[i], dimtype[i], i, dimunits[i], vsize, begin);
+		begin += vsize;
+	};
+
+	vsize = (long long)ITURHFP.imnthend*ITURHFP.ihrend*ITURHFP.ifrqend*Grid.nlat*Grid.nlng*sizeof(float);
+	for(q=0; q<Grid.nq; q++) {
+		Grid.begin[q] = begin;
+		NCHeaderVar(h, Grid.name[q], NC_FLOAT, -1, NULL, vsize, begin);
+		begin += vsize;
+	};
+
+	return;
+};
+
+void NCHeaderInt(struct NCHeader *h, unsigned int val) {
+
+	/*
+	 * NCHeaderInt() - Adds a 32 bit integer big endian.
+	 */
+
+	if(h->p != NULL) {
+		h->p[h->n] = (unsigned char)(val >> 24);
+		h->p[h->n + 1] = (unsigned char)(val >> 16);
+		h->p[h->n + 2] = (unsigned char)(val >> 8);
+		h->p[h->n + 3] = (unsigned char)val;
+	};
+	h->n += 4;
+
+	return;
+};
+
+void NCHeaderOffset(struct NCHeader *h, long long val) {
+
+	/*
+	 * NCHeaderOffset() - Adds the offset of a variable, 64 bits in the 64-bit offset format.
+	 */
+
+	if(h->offset64 == TRUE) {
+		NCHeaderInt(h, (unsigned int)(val >> 32));
+	};
+	NCHeaderInt(h, (unsigned int)val);
+
+	return;
+};
+
+void NCHeaderName(struct NCHeader *h, const char *name) {
+
+	/*
+	 * NCHeaderName() - Adds the length of a string followed by the string padded with nulls to 4 bytes.
+	 */
+
+	int len;
+	int pad;
+
+	len = (int)strlen(name);
+	pad = (len + 3) & ~3;
+
+	NCHeaderInt(h, (unsigned int)len);
+	if(h->p != NULL) {
+		memcpy(h->p + h->n, name, len);
+		memset(h->p + h->n + len, 0, pad - len);
+	};
+	h->n += pad;
+
+	return;
+};
+
+void NCHeaderVar(struct NCHeader *h, const char *name, int type, int dimid, const char *units, long long vsize, long long begin) {
+
+	/*
+	 * NCHeaderVar() - Adds a variable. A coordinate variable has the one dimension dimid. The quantities, with
+	 *		a dimid of -1, have all the dimensions and a _FillValue. A vsize that doesn't fit in 32 bits is written as 2^32 - 1.
+	 */
+
+	int i;
+
+	NCHeaderName(h, name);
+	if(dimid >= 0) {
+		NCHeaderInt(h, 1);
+		NCHeaderInt(h, dimid);
+	}
+	else {
+		NCHeaderInt(h, NCDIMS);
+		for(i=0; i<NCDIMS; i++) {
+			NCHeaderInt(h, i);
+		};
+	};
+
+	if(units != NULL) {
+		NCHeaderInt(h, NC_ATTRIBUTE);
+		NCHeaderInt(h, 1);
+		NCHeaderAtt(h, "units", units);
+	}
+	else if(dimid < 0) {
+		NCHeaderInt(h, NC_ATTRIBUTE);
+		NCHeaderInt(h, 1);
+		NCHeaderFill(h);
+	}
+	else {
+		NCHeaderInt(h, 0);
+		NCHeaderInt(h, 0);
+	};
+
+	NCHeaderInt(h, type);
+	NCHeaderInt(h, (vsize > 4294967295LL) ? 4294967295U : (unsigned int)vsize);
+	NCHeaderOffset(h, begin);
+
+	return;
+};
+
+void NCHeaderAtt(struct NCHeader *h, const char *name, const char *value) {
+
+	/*
+	 * NCHeaderAtt() - Adds a text attribute.
+	 */
+
+	NCHeaderName(h, name);
+	NCHeaderInt(h, NC_CHAR);
+	NCHeaderName(h, value);
+
+	return;
+};
+
+void NCHeaderFill(struct NCHeader *h) {
+
+	/*
+	 * NCHeaderFill() - Adds the _FillValue attribute of a quantity, which is the NODATA value of the grids.
+	 */
+
+	float fill;
+	unsigned int u;
+
+	fill = (float)RASTERNODATA;
+	memcpy(&u, &fill, 4);
+
+	NCHeaderName(h, "_FillValue");
+	NCHeaderInt(h, NC_FLOAT);
+	NCHeaderInt(h, 1);
+	NCHeaderInt(h, u);
+
+	return;
+};
+
+void PutBigEndian(unsigned char *out, const void *in, int size, long long n) {
+
+	/*
+	 * PutBigEndian() - Copies n values of size 4 or 8 bytes big endian.
+	 */
+
+	const unsigned char *src;
+
+	unsigned int u4;
+	unsigned long long u8;
+
+	long long i;
+	int k;
+
+	src = (const unsigned char *)in;
+
+	for(i=0; i<n; i++) {
+		if(size == 4) {
+			memcpy(&u4, src + i*4, 4);
+			for(k=0; k<4; k++) out[i*4 + k] = (unsigned char)(u4 >> (24 - 8*k));
+		}
+		else {
+			memcpy(&u8, src + i*8, 8);
+			for(k=0; k<8; k++) out[i*8 + k] = (unsigned char)(u8 >> (56 - 8*k));
+		};
+	};
+
+	return;
+};
@@ -11,7 +11,6 @@
 // Local prototypes
 void substrbtwnchar(char instr[256], char searchchar, char * outstr);
 unsigned long OutputOption(char optstr[256]);
-void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path);
 // End local prototypes
 
 int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, struct PathData *path) {
@@ -322,11 +321,58 @@ int ReadInputConfiguration(char InFilePath[256], struct ITURHFProp *ITURHFP, str
 				sscanf(line, "%*s %lf", &ITURHFP->lnginc);
 				ITURHFP->lnginc = ITURHFP->lnginc*D2R;
 			};
+			if (strncmp("NoiseGridInc", line, 12) == 0) {
+				sscanf(line, "%*s %lf", &ITURHFP->NoiseGridInc);
+				ITURHFP->NoiseGridInc = ITURHFP->NoiseGridInc*D2R;
+			};
+			// Reductions of the results
+			if (strncmp("ReduceFrequency", line, 15) == 0) {
+				// The name is between two quotes-find them.
+				substrbtwnchar(line, '\"', instr);
+				if (strcmp(instr, "BCR") == 0) {
+					ITURHFP->reducefreq = REDUCE_BCR;
+				}
+				else if (strcmp(instr, "SNR") == 0) {
+					ITURHFP->reducefreq = REDUCE_SNR;
+				}
+				else if (strcmp(instr, "NONE") == 0) {
+					ITURHFP->reducefreq = REDUCE_NONE;
+				}
+				else {
+					ITURHFP->reducefreq = REDUCE_INVALID;
+				};
+			};
+			if (strncmp("ReduceHours", line, 11) == 0) {
+				// The name is between two quotes-find them.
+				substrbtwnchar(line, '\"', instr);
+				if (strcmp(instr, "MIN") == 0) {
+					ITURHFP->reducehours = REDUCE_MIN;
+				}
+				else if (strcmp(instr, "MAX") == 0) {
+					ITURHFP->reducehours = REDUCE_MAX;
+				}
+				else if (strcmp(instr, "MEAN") == 0) {
+					ITURHFP->reducehours = REDUCE_MEAN;
+				}
+				else if ((instr[0] == 'P') && (sscanf(&instr[1], "%lf", &ITURHFP->percentile) == 1)) {
+					ITURHFP->reducehours = REDUCE_PERCENTILE;
+				}
+				else if (strcmp(instr, "NONE") == 0) {
+					ITURHFP->reducehours = REDUCE_NONE;
+				}
+				else {
+					ITURHFP->reducehours = REDUCE_INVALID;
+				};
+			};
 			//
 			if (strncmp("DataFilePath", line, 12) == 0) {
 				// The name is between two quotes-find them.
 				substrbtwnchar(line, '\"', ITURHFP->DataFilePath);
 			};
+			if (strncmp("AntCachePath", line, 12) == 0) {
+				// The name is between two quotes-find them.
+				substrbtwnchar(line, '\"', ITURHFP->AntCachePath);
+			};
 		};
 		// Read the next line.
 		fgets(line, 256, fp);
@@ -567,7 +613,12 @@ void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path) {
 	ITURHFP->L_UR.lng = TOOBIG;
 	ITURHFP->latinc = 1.0;
 	ITURHFP->lnginc = 1.0;
+	ITURHFP->NoiseGridInc = 0.0;
+	ITURHFP->reducefreq = REDUCE_NONE;
+	ITURHFP->reducehours = REDUCE_NONE;
+	ITURHFP->percentile = 50.0;
 	sprintf(ITURHFP->DataFilePath, ".");
+	ITURHFP->AntCachePath[0] = '\0';
 
 	return;
 
@@ -577,21 +628,17 @@ void InitializeInput(struct ITURHFProp *ITURHFP, struct PathData *path) {
 int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
 
 	int retval;
-    int antType;
-    int lineCtr;
 
-    FILE *fp;
-	
-	char line[256];		// Read input line
-	char instr[256];	// String temp
+	char *CachePath;	// NULL for no NEC pattern cache
 
 	// User feedback
 	if(ITURHFP.silent != TRUE) {
 		printf("ReadAntennaPatterns: Reading transmit and receive antenna\n");
 	};
 
-	// At this point there is only one other antenna pattern file type that can be read.
-	// The antenna pattern must be rotated to the correct azimuth before P533() is run.
+	// The antenna patterns are stored relative to the main beam. The bearing is applied by P533().
+
+	CachePath = (path->NoCache == TRUE) ? NULL : ITURHFP.AntCachePath;
 
 	// Determine the type of receiver antenna file.
 	if(strcmp(ITURHFP.RXAntFilePath, "ISOTROPIC") == 0) { // Isotropic Antenna
@@ -600,50 +647,17 @@ int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
 		// Store the name of the antenna to the path structure.
 		strcpy(path->A_rx.Name, "ISOTROPIC");
 	} else {
-	    //If it's not an ISOTROPIC, open the file and take a look...
-	    /* VOACAP type antennas identify the antenna type on the forth
-	     * line; e.g;
-         *   14    [ 2] Antenna Type..: 30 x (efficiency + 91 gain values) follow
-         */
-	    fp = fopen(ITURHFP.RXAntFilePath, "r");
-
-	    if (fp == NULL) {
-            if(ITURHFP.silent != TRUE) {
+		retval = ReadAntennaFile(&path->A_rx, ITURHFP.RXAntFilePath, CachePath, ITURHFP.RXBearing, ITURHFP.silent);
+		if(retval == RTN_ERRCANTOPENANTFILE) {
+			if(ITURHFP.silent != TRUE) {
 				printf("Error opening Rx. antenna file %.65s\n", ITURHFP.RXAntFilePath);
 			};
-		    return RTN_ERRCANTOPENRXANTFILE;
-	    };
-
-	    for (lineCtr = 0 ; lineCtr<4 ; ++lineCtr) {
-		    fgets(line, sizeof(line), fp);		// Scroll to line 3, Antenna type
-	    }
-
-	    sscanf(line, " %d %s\n", &antType, instr);
-        rewind(fp);
-
-	    if(antType == 11) {
-		    retval = dllReadType11Func(&path->A_rx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if(antType == 13) {
-		    retval = dllReadType13Func(&path->A_rx, fp, ITURHFP.RXBearing, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    };
-	    } else if (antType == 14) {
-		    retval = dllReadType14Func(&path->A_rx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    };
-        } else {
-            printf("Unsuppported antenna type: %d\n",antType);
-            return RTN_ERRCANTOPENRXANTFILE;
-        }
-    }; // end of the rx antenna type
+			return RTN_ERRCANTOPENRXANTFILE;
+		}
+		else if(retval != RTN_READANTENNAPATTERNSOK) {
+			return retval;
+		};
+	}; // end of the rx antenna type
 
 	// Determine the type of transmitter antenna file.
 	if(strcmp(ITURHFP.TXAntFilePath, "ISOTROPIC") == 0) { // Isotropic Antenna
@@ -652,44 +666,123 @@ int ReadAntennaPatterns(struct PathData *path, struct ITURHFProp ITURHFP) {
 		// Store the name of the antenna to the path structure.
 		strcpy(path->A_tx.Name, "ISOTROPIC");
 	} else {
-        fp = fopen(ITURHFP.TXAntFilePath, "r");
-
-	    if (fp == NULL) {
+		retval = ReadAntennaFile(&path->A_tx, ITURHFP.TXAntFilePath, CachePath, ITURHFP.TXBearing, ITURHFP.silent);
+		if(retval == RTN_ERRCANTOPENANTFILE) {
 			if(ITURHFP.silent != TRUE) {
 				printf("Error opening Tx. antenna file %.65s\n", ITURHFP.TXAntFilePath);
 			};
-		    return RTN_ERRCANTOPENTXANTFILE;
-	    };
-	    for (lineCtr = 0 ; lineCtr<4 ; ++lineCtr) {
-		    fgets(line, sizeof(line), fp);		// Antenna type
-	    }
-	    sscanf(line, " %d %s\n", &antType, instr);
-
-        rewind(fp);
-
-	    if(antType == 11) {
-		    retval = dllReadType11Func(&path->A_tx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if(antType == 13) {
-		    retval = dllReadType13Func(&path->A_tx, fp, ITURHFP.TXBearing, ITURHFP.silent);
-            fclose(fp);
-		    if(retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-            }
-		} else if (antType == 14) {
-		    retval = dllReadType14Func(&path->A_tx, fp, ITURHFP.silent);
-            fclose(fp);
-		    if (retval != RTN_READANTENNAPATTERNSOK) {
-				    return retval;
-		    };
-	    } else {
-			printf("Unsuppported antenna type: %d\n",antType);
-            return RTN_ERRCANTOPENTXANTFILE;
-	    };
-    }
-		return RTN_READANTENNAPATTERNSOK;
+			return RTN_ERRCANTOPENTXANTFILE;
+		}
+		else if(retval != RTN_READANTENNAPATTERNSOK) {
+			return retval;
+		};
+	}; // end of the tx antenna type
+
+	return RTN_READANTENNAPATTERNSOK;
+};
+
+int ReadAntennaFile(struct Antenna *Ant, char *FilePath, char *CachePath, double bearing, int silent) {
+
+	/*
+	  ReadAntennaFile() - Reads one antenna file into the structure Antenna. A compiled antenna file, made 
+			with the -a option, is recognised by its leading magic number and is mapped into memory. 
+			A file that starts with an NEC CM, CE or GW card is an NEC deck and the pattern is generated from it.
+			Otherwise the file is a VOACAP type 11, 13 or 14 text file.
+
+			INPUT
+				struct Antenna *Ant
+				char *FilePath
+				char *CachePath - Directory of the NEC pattern cache. If empty the cache is kept with the deck
+					and if NULL there is no cache.
+				double bearing - Main beam bearing (radians)
+				int silent
+
+			OUTPUT
+				Returns RTN_READANTENNAPATTERNSOK, RTN_ERRCANTOPENANTFILE if the file can not be opened or is of
+				an unsupported type, or the error from the reader
+
+			SUBROUTINES
+				dllReadAntennaBinFunc()
+				dllReadNECFunc()
+				dllReadType11Func()
+				dllReadType13Func()
+				dllReadType14Func()
+	*/
+
+	int retval;
+	int antType = 0;
+	int lineCtr;
+
+	FILE *fp;
+
+	char line[256] = "";	// Read input line
+	char instr[256];	// String temp
+	char magic[8];		// Possible compiled antenna file magic number
+	char deckdir[256];	// Directory of an NEC deck
+	char *c;
+
+	// Look for a compiled antenna file first.
+	fp = fopen(FilePath, "rb");
+	if (fp == NULL) {
+		return RTN_ERRCANTOPENANTFILE;
+	};
+	lineCtr = (int)fread(magic, 1, sizeof(magic), fp);
+	fclose(fp);
+
+	if((lineCtr == sizeof(magic)) && (memcmp(magic, ANTBINMAGIC, sizeof(magic)) == 0)) {
+		return dllReadAntennaBinFunc(Ant, FilePath, bearing, silent);
+	};
+
+	fp = fopen(FilePath, "r");
+	if (fp == NULL) {
+		return RTN_ERRCANTOPENANTFILE;
+	};
+
+	// NEC decks start with a comment or a wire card.
+	instr[0] = '\0';
+	fgets(line, sizeof(line), fp);
+	sscanf(line, " %2s", instr);
+	if((strcmp(instr, "CM") == 0) || (strcmp(instr, "CE") == 0) || (strcmp(instr, "GW") == 0)) {
+		rewind(fp);
+		if((CachePath != NULL) && (CachePath[0] == '\0')) {
+			// Keep the cache with the deck.
+			strcpy(deckdir, FilePath);
+			c = strrchr(deckdir, '/');
+			if(c == NULL) c = strrchr(deckdir, '\\');
+			if(c != NULL) *c = '\0';
+			else strcpy(deckdir, ".");
+			CachePath = deckdir;
+		};
+		retval = dllReadNECFunc(Ant, fp, CachePath, bearing, silent);
+		fclose(fp);
+		return retval;
+	};
+	rewind(fp);
+
+	// VOACAP type antennas identify the antenna type on the forth
+	// line; e.g;
+	//   14    [ 2] Antenna Type..: 30 x (efficiency + 91 gain values) follow
+
+	for (lineCtr = 0 ; lineCtr<4 ; ++lineCtr) {
+		fgets(line, sizeof(line), fp);		// Scroll to line 3, Antenna type
+	}
+
+	sscanf(line, " %d %s\n", &antType, instr);
+	rewind(fp);
+
+	if(antType == 11) {
+		retval = dllReadType11Func(Ant, fp, silent);
+	} else if(antType == 13) {
+		retval = dllReadType13Func(Ant, fp, bearing, silent);
+	} else if (antType == 14) {
+		retval = dllReadType14Func(Ant, fp, silent);
+	} else {
+		printf("Unsuppported antenna type: %d\n",antType);
+		retval = RTN_ERRCANTOPENANTFILE;
+	};
+
+	fclose(fp);
+
+	return retval;
 };
 
@@ -0,0 +1,406 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local #define
+#define RDLABELS		10			// Values a mode label is counted as: 0 to 8 and 9 for no mode
+#define RDNAMESIZE		4096		// Column names from ReportColumns(), which aren't used
+// End local #define
+
+// Local structures
+// The results that are being reduced. A result is the values of the columns of the report from
+// ReportRawValues(), so the reduction is the same for the report, the binary report and the raster files.
+struct Reduction {
+	int started;
+	int ncols;				// Columns of a result
+	int npoints;			// Receivers of the area
+	int nslots;				// Results whose hours are reduced, for each frequency and receiver
+	int nlabels;			// Columns that are mode labels
+	int *label;				// Column of each mode label
+	double *v;				// Values of the result being reduced
+	// ReduceFrequency
+	double *best;			// Values of the best frequency for each receiver (npoints x ncols)
+	double *crit;			// BCR or SNR of the best frequency for each receiver
+	// ReduceHours
+	double *acc;			// Minimum, maximum or sum for each slot (nslots x ncols)
+	double *hrv;			// Values of each hour for a percentile (nslots x ncols x ihrend)
+	unsigned char *count;	// Hours that each label has for each slot (nslots x nlabels x RDLABELS)
+	double *sort;			// Values of one column of a slot to be sorted
+	struct PathData out;	// Result that is written
+};
+// End local structures
+
+// Local prototypes
+int StartReduce(struct PathData *path, struct ITURHFProp *ITURHFP);
+int ReduceHour(struct PathData *path, struct ITURHFProp *ITURHFP, int point, int f, double *v);
+int ReduceEmit(struct PathData *path, struct ITURHFProp *ITURHFP, int point, int f, double *v);
+double Percentile(double *x, int n, double p);
+int CompareDoubles(const void *a, const void *b);
+// End local prototypes
+
+// Local globals
+static struct Reduction Rd;
+// End local globals
+
+int Reduce(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * Reduce() - Takes the result of a P533() run in place of the report or raster files and writes the
+	 *		reduction of the results given by ITURHFP->reducefreq and ITURHFP->reducehours. The results are kept
+	 *		only until their dimension has been run. The best frequency for each receiver is written, or has its
+	 *		hours reduced, after the last frequency of an hour. The reduced hours are written after the last hour
+	 *		of a month.
+	 *
+	 *		The best frequency is the one with the largest BCR or SNR. The lowest frequency of equals is taken.
+	 *		The minimum, maximum, mean and percentile of the hours are found for each column independently. The
+	 *		percentile is interpolated between the sorted values of the hours. A mode label column is given the
+	 *		label that the most hours have, the lower mode of equals. The values of the dominant mode are found
+	 *		with 0.0 for the hours with no dominant mode as in the report.
+	 *
+	 *			INPUT
+	 *				struct PathData *path
+	 *				struct ITURHFProp *ITURHFP
+	 *
+	 *			OUTPUT
+	 *				Returns RTN_REDUCEOK or an error
+	 *
+	 *			SUBROUTINES
+	 *				StartReduce()
+	 *				ReportRawValues()
+	 *				ReduceHour()
+	 */
+
+	double crit;
+
+	int point;
+	int k;
+	int retval;
+
+	if(Rd.started != TRUE) {
+		retval = StartReduce(path, ITURHFP);
+		if(retval != RTN_REDUCEOK) {
+			return retval;
+		};
+	};
+
+	point = ITURHFP->ilat*ITURHFP->ilngend + ITURHFP->ilng;
+
+	ReportRawValues(path, Rd.v);
+
+	if(ITURHFP->reducefreq == REDUCE_NONE) {
+		return ReduceHour(path, ITURHFP, point, ITURHFP->ifrq, Rd.v);
+	};
+
+	crit = (ITURHFP->reducefreq == REDUCE_BCR) ? path->BCR : path->SNR;
+	if((ITURHFP->ifrq == 0) || (crit > Rd.crit[point])) {
+		Rd.crit[point] = crit;
+		memcpy(&Rd.best[(size_t)point*Rd.ncols], Rd.v, Rd.ncols*sizeof(double));
+	};
+
+	// After the last frequency of the hour the best of each receiver is known
+	if((ITURHFP->ifrq == ITURHFP->ifrqend - 1) && (point == Rd.npoints - 1)) {
+		for(k=0; k<Rd.npoints; k++) {
+			retval = ReduceHour(path, ITURHFP, k, 0, &Rd.best[(size_t)k*Rd.ncols]);
+			if(retval != RTN_REDUCEOK) {
+				return retval;
+			};
+		};
+	};
+
+	return RTN_REDUCEOK;
+
+};
+
+int StartReduce(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * StartReduce() - Allocates the results that are kept for the reduction
+	 *
+	 *			SUBROUTINES
+	 *				ReportColumns()
+	 *				ReportLabelColumn()
+	 */
+
+	char *names;
+
+	int i;
+
+	names = (char *)malloc(RDNAMESIZE);
+	if(names == NULL) {
+		printf("Reduce: Error %d Can't allocate memory\n", RTN_ERRREDUCE);
+		return RTN_ERRREDUCE;
+	};
+	Rd.ncols = ReportColumns(*path, *ITURHFP, names, RDNAMESIZE);
+	free(names);
+	if(Rd.ncols == 0) {
+		printf("Reduce: Error %d Too many columns\n", RTN_ERRREDUCE);
+		return RTN_ERRREDUCE;
+	};
+
+	Rd.npoints = ITURHFP->ilatend*ITURHFP->ilngend;
+	Rd.nslots = Rd.npoints*((ITURHFP->reducefreq == REDUCE_NONE) ? ITURHFP->ifrqend : 1);
+
+	Rd.label = (int *)malloc(Rd.ncols*sizeof(int));
+	Rd.v = (double *)malloc(Rd.ncols*sizeof(double));
+	if((Rd.label == NULL) || (Rd.v == NULL)) {
+		printf("Reduce: Error %d Can't allocate memory\n", RTN_ERRREDUCE);
+		return RTN_ERRREDUCE;
+	};
+	Rd.nlabels = 0;
+	for(i=0; i<Rd.ncols; i++) {
+		if(ReportLabelColumn(i) == TRUE) {
+			Rd.label[Rd.nlabels++] = i;
+		};
+	};
+
+	if(ITURHFP->reducefreq != REDUCE_NONE) {
+		Rd.best = (double *)malloc((size_t)Rd.npoints*Rd.ncols*sizeof(double));
+		Rd.crit = (double *)malloc((size_t)Rd.npoints*sizeof(double));
+		if((Rd.best == NULL) || (Rd.crit == NULL)) {
+			printf("Reduce: Error %d Can't allocate memory for %d receivers\n", RTN_ERRREDUCE, Rd.npoints);
+			return RTN_ERRREDUCE;
+		};
+	};
+
+	if(ITURHFP->reducehours != REDUCE_NONE) {
+		Rd.acc = (double *)malloc((size_t)Rd.nslots*Rd.ncols*sizeof(double));
+		Rd.count = (unsigned char *)malloc((size_t)Rd.nslots*Rd.nlabels*RDLABELS + 1);
+		Rd.sort = (double *)malloc(ITURHFP->ihrend*sizeof(double));
+		if(ITURHFP->reducehours == REDUCE_PERCENTILE) {
+			Rd.hrv = (double *)malloc((size_t)Rd.nslots*Rd.ncols*ITURHFP->ihrend*sizeof(double));
+		};
+		if((Rd.acc == NULL) || (Rd.count == NULL) || (Rd.sort == NULL) ||
+		   ((ITURHFP->reducehours == REDUCE_PERCENTILE) && (Rd.hrv == NULL))) {
+			printf("Reduce: Error %d Can't allocate memory for %d results of %d hours\n", RTN_ERRREDUCE, Rd.nslots, ITURHFP->ihrend);
+			return RTN_ERRREDUCE;
+		};
+	};
+
+	Rd.started = TRUE;
+
+	return RTN_REDUCEOK;
+
+};
+
+void StopReduce(void) {
+
+	/*
+	 * StopReduce() - Frees the results that are kept for the reduction so the next analysis starts its own.
+	 *		ITURHFProp() calls it before and after the analysis.
+	 */
+
+	free(Rd.label);
+	free(Rd.v);
+	free(Rd.best);
+	free(Rd.crit);
+	free(Rd.acc);
+	free(Rd.hrv);
+	free(Rd.count);
+	free(Rd.sort);
+
+	memset(&Rd, 0, sizeof(Rd));
+
+	return;
+
+};
+
+int ReduceHour(struct PathData *path, struct ITURHFProp *ITURHFP, int point, int f, double *v) {
+
+	/*
+	 * ReduceHour() - Adds the values v of the receiver point and frequency index f to the reduction of the hours
+	 *		or writes them if the hours aren't reduced. After the last result of the month the reduced hours of
+	 *		each frequency and receiver are written.
+	 *
+	 *			SUBROUTINES
+	 *				ReduceEmit()
+	 *				Percentile()
+	 */
+
+	double *acc;
+	double *x;
+	unsigned char *count;
+
+	int slot;
+	int nf;
+	int nh;
+	int i, j, k;
+	int retval;
+
+	if(ITURHFP->reducehours == REDUCE_NONE) {
+		return ReduceEmit(path, ITURHFP, point, f, v);
+	};
+
+	slot = f*Rd.npoints + point;
+	acc = &Rd.acc[(size_t)slot*Rd.ncols];
+	count = &Rd.count[(size_t)slot*Rd.nlabels*RDLABELS];
+	nh = ITURHFP->ihrend;
+
+	if(ITURHFP->ihr == 0) {
+		memcpy(acc, v, Rd.ncols*sizeof(double));
+		memset(count, 0, Rd.nlabels*RDLABELS);
+	}
+	else {
+		for(i=0; i<Rd.ncols; i++) {
+			switch(ITURHFP->reducehours) {
+				case REDUCE_MIN:
+					if(v[i] < acc[i]) acc[i] = v[i];
+					break;
+				case REDUCE_MAX:
+					if(v[i] > acc[i]) acc[i] = v[i];
+					break;
+				case REDUCE_MEAN:
+					acc[i] += v[i];
+					break;
+			};
+		};
+	};
+	if(ITURHFP->reducehours == REDUCE_PERCENTILE) {
+		for(i=0; i<Rd.ncols; i++) {
+			Rd.hrv[((size_t)slot*Rd.ncols + i)*nh + ITURHFP->ihr] = v[i];
+		};
+	};
+	for(j=0; j<Rd.nlabels; j++) {
+		k = (int)v[Rd.label[j]];
+		count[j*RDLABELS + (((k >= 0) && (k < RDLABELS-1)) ? k : RDLABELS-1)]++;
+	};
+
+	// The slots are given in order so the last one of the last hour ends the month.
+	nf = Rd.nslots/Rd.npoints;
+	if((ITURHFP->ihr != nh - 1) || (slot != Rd.nslots - 1)) {
+		return RTN_REDUCEOK;
+	};
+
+	for(slot=0; slot<Rd.nslots; slot++) {
+		acc = &Rd.acc[(size_t)slot*Rd.ncols];
+		count = &Rd.count[(size_t)slot*Rd.nlabels*RDLABELS];
+		for(i=0; i<Rd.ncols; i++) {
+			if(ITURHFP->reducehours == REDUCE_MEAN) {
+				acc[i] = acc[i]/nh;
+			}
+			else if(ITURHFP->reducehours == REDUCE_PERCENTILE) {
+				x = &Rd.hrv[((size_t)slot*Rd.ncols + i)*nh];
+				memcpy(Rd.sort, x, nh*sizeof(double));
+				acc[i] = Percentile(Rd.sort, nh, ITURHFP->percentile);
+			};
+		};
+		// The label that the most hours have
+		for(j=0; j<Rd.nlabels; j++) {
+			k = 0;
+			for(i=1; i<RDLABELS; i++) {
+				if(count[j*RDLABELS + i] > count[j*RDLABELS + k]) k = i;
+			};
+			acc[Rd.label[j]] = (k == RDLABELS-1) ? NODOMINANTMODE : k;
+		};
+
+		retval = ReduceEmit(path, ITURHFP, slot % Rd.npoints, (nf > 1) ? slot/Rd.npoints : f, acc);
+		if(retval != RTN_REDUCEOK) {
+			return retval;
+		};
+	};
+
+	return RTN_REDUCEOK;
+
+};
+
+int ReduceEmit(struct PathData *path, struct ITURHFProp *ITURHFP, int point, int f, double *v) {
+
+	/*
+	 * ReduceEmit() - Writes the reduced values v of the receiver point and frequency index f to the report or
+	 *		raster files, or gives them to the callback. The indices of a reduced dimension are those of a run that
+	 *		has only one.
+	 *
+	 *			SUBROUTINES
+	 *				ReportSetValues()
+	 *				StreamResult()
+	 *				Raster()
+	 *				QueueOutput()
+	 */
+
+	struct ITURHFProp it;
+
+	int retval;
+
+	it = *ITURHFP;
+	Rd.out = *path;
+
+	it.ilat = point/it.ilngend;
+	it.ilng = point % it.ilngend;
+	Rd.out.L_rx.lat = it.L_LL.lat + it.ilat*it.latinc;
+	Rd.out.L_rx.lng = it.L_LL.lng + it.ilng*it.lnginc;
+
+	if(it.reducefreq != REDUCE_NONE) {
+		it.ifrq = 0;
+		it.ifrqend = 1;
+		it.frqs[0] = 0.0;
+	}
+	else {
+		it.ifrq = f;
+		Rd.out.frequency = it.frqs[f];
+	};
+
+	if(it.reducehours != REDUCE_NONE) {
+		it.ihr = 0;
+		it.ihrend = 1;
+		it.hrs[0] = -1;
+		Rd.out.hour = -1;
+	};
+
+	ReportSetValues(&Rd.out, v);
+
+	if(it.callback != NULL) {
+		retval = StreamResult(&Rd.out, &it);
+		if(retval != RTN_STREAMOK) {
+			return retval;
+		};
+	}
+	else if(it.raster != RASTER_NONE) {
+		retval = Raster(Rd.out, it);
+		if(retval != RTN_RASTEROK) {
+			return retval;
+		};
+	}
+	else {
+		QueueOutput(&Rd.out, &it);
+	};
+
+	return RTN_REDUCEOK;
+
+};
+
+double Percentile(double *x, int n, double p) {
+
+	/*
+	 * Percentile() - Returns the p percentile of the n values x, which are sorted. The percentile is
+	 *		interpolated between the values at the ranks on either side of p/100*(n - 1).
+	 */
+
+	double r;
+	int i;
+
+	qsort(x, n, sizeof(double), CompareDoubles);
+
+	r = p/100.0*(n - 1);
+	i = (int)floor(r);
+	if(i >= n - 1) {
+		return x[n-1];
+	};
+
+	return x[i] + (r - i)*(x[i+1] - x[i]);
+
+};
+
+int CompareDoubles(const void *a, const void *b) {
+
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+
+};
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <stddef.h>
 #include <time.h>
 
 // Local includes
@@ -26,45 +27,104 @@
 #define PRINT_RFC4180_DATA 2
 #define PRINT_HEADER	1
 #define PRINT_DATA		0
+
+// Record columns
+#define RPTCOL_DOUBLE	0			// A double in struct PathData
+#define RPTCOL_DOMINANT	1			// A double in the dominant mode, 0.0 if there is none
+#define RPTCOL_N0F2		2			// Lowest order F2 mode
+#define RPTCOL_N0E		3			// Lowest order E mode
+#define RPTCOL_DMLABEL	4			// Dominant mode
+
+#define RPTMAXCOLS		96			// More than all the RPT_ columns
+
+// The RPT_ columns that need each stage of P533() past Part 1. See ReportOutputs().
+#define RPTOUT_FIELD		(RPT_DMAX | RPT_ELE | RPT_E | RPT_PR | RPT_GRW | RPT_DOMMODE | RPT_ESL | RPT_LONG)
+#define RPTOUT_NOISE		(RPT_NOISESOURCES | RPT_NOISESOURCESD | RPT_NOISETOTALD | RPT_NOISETOTAL)
+#define RPTOUT_RELIABILITY	(RPT_SNR | RPT_SNRD | RPT_SNRXX | RPT_SIR | RPT_SIRD | RPT_RSN | RPT_BCR | RPT_OCR | RPT_OCRS | RPT_MIR)
+#define RPTROWMAX		16384		// Size of the record buffer
+#define RPTFIELDMAX		512			// Longest field, which is a %f of the largest double (see PutFixed())
 // End local #define
 
+// Local structures
+// A record is written from a list of columns that is made once from RptFileFormat. Each column
+// knows where its value is and the width, precision and flag of its printf format, so the record can
+// be formatted into a buffer by Format.c and written with one fwrite().
+struct RptColumn {
+	int type;			// RPTCOL_
+	size_t offset;		// Offset of the value in struct PathData or struct Mode
+	double scale;		// Unit conversion, R2D or 1.0
+	int width;			// Minimum field width of the format
+	int prec;			// Precision of the format
+	int space;			// The format has the space flag
+	int shortest;		// The value is written with the fewest digits that read back the same
+};
+
+struct RptRecord {
+	unsigned long format;	// RptFileFormat the columns were made for
+	int option;				// PRINT_DATA or PRINT_RFC4180_DATA
+	int ncols;
+	struct RptColumn col[RPTMAXCOLS];
+};
+
+// A binary report is written a row group at a time.
+struct RptBinFile {
+	struct RptBinHeader hdr;
+	struct RptBinColumn col[RPTMAXCOLS+2];	// The month and hour are the first two columns
+	char *group;							// Row group buffer
+	int row;								// Rows in the row group buffer
+};
+// End local structures
+
 // Local prototypes
 void PrintHeader(struct PathData path, struct ITURHFProp ITURHFP);
 void PrintRecord(struct PathData path, struct ITURHFProp ITURHFP, int printhr);
 void PrintLastRecord(struct PathData path, struct ITURHFProp ITURHFP);
 char EW(double lng);
 char NS(double lat);
-void function_RPT_D(   struct PathData path, int option, int *col);
-void function_RPT_DMAX(struct PathData path, int option, int *col);
-void function_RPT_ELE( struct PathData path, int option, int *col);
-void function_RPT_BMUF(struct PathData path, int option, int *col);
-void function_RPT_BMUFD(struct PathData path, int option, int *col);
-void function_RPT_OPMUF(struct PathData path, int option, int *col);
-void function_RPT_OPMUFD(struct PathData path, int option, int *col);
-void function_RPT_N0_F2(struct PathData path, int option, int *col);
-void function_RPT_N0_E(struct PathData path, int option, int *col);
-void function_RPT_E(struct PathData path, int option, int *col);
-void function_RPT_PR(struct PathData path, int option, int *col);
-void function_RPT_GRW(struct PathData path, int option, int *col);
-void function_RPT_NOISESOURCES(struct PathData path, int option, int *col);
-void function_RPT_NOISESOURCESD(struct PathData path, int option, int *col);
-void function_RPT_NOISETOTALD(struct PathData path, int option, int *col);
-void function_RPT_NOISETOTAL(struct PathData path, int option, int *col);
-void function_RPT_SNR(struct PathData path, int option, int *col);
-void function_RPT_SNRD(struct PathData path, int option, int *col);
+void function_RPT_D(int option, int *col);
+void function_RPT_DMAX(int option, int *col);
+void function_RPT_ELE(int option, int *col);
+void function_RPT_BMUF(int option, int *col);
+void function_RPT_BMUFD(int option, int *col);
+void function_RPT_OPMUF(int option, int *col);
+void function_RPT_OPMUFD(int option, int *col);
+void function_RPT_N0_F2(int option, int *col);
+void function_RPT_N0_E(int option, int *col);
+void function_RPT_E(int option, int *col);
+void function_RPT_PR(int option, int *col);
+void function_RPT_GRW(int option, int *col);
+void function_RPT_NOISESOURCES(int option, int *col);
+void function_RPT_NOISESOURCESD(int option, int *col);
+void function_RPT_NOISETOTALD(int option, int *col);
+void function_RPT_NOISETOTAL(int option, int *col);
+void function_RPT_SNR(int option, int *col);
+void function_RPT_SNRD(int option, int *col);
 void function_RPT_SNRXX(struct PathData path, int option, int *col);
-void function_RPT_SIRD(struct PathData path, int option, int *col);
-void function_RPT_SIR(struct PathData path, int option, int *col);
-void function_RPT_RSN(struct PathData path, int option, int *col);
-void function_RPT_BCR(struct PathData path, int option, int *col);
-void function_RPT_OCR(struct PathData path, int option, int *col);
-void function_RPT_OCRS(struct PathData path, int option, int *col);
-void function_RPT_MIR(struct PathData path, int option, int *col);
+void function_RPT_SIRD(int option, int *col);
+void function_RPT_SIR(int option, int *col);
+void function_RPT_RSN(int option, int *col);
+void function_RPT_BCR(int option, int *col);
+void function_RPT_OCR(int option, int *col);
+void function_RPT_OCRS(int option, int *col);
+void function_RPT_MIR(int option, int *col);
 void function_RPT_ANTENNA(struct PathData path, int option, int *col);
-void function_RPT_DOMMODE(struct PathData path, int option, int *col);
-void function_RPT_RXLOCATION(struct PathData path, int option, int *col);
-void function_RPT_ESL(struct PathData path, int option, int *col);
-void function_RPT_LONG(struct PathData path, int option, int *col);
+void function_RPT_DOMMODE(int option, int *col);
+void function_RPT_RXLOCATION(int option, int *col);
+void function_RPT_ESL(int option, int *col);
+void function_RPT_LONG(int option, int *col);
+void PrintColumns(struct PathData path, struct ITURHFProp ITURHFP, int option, int *col);
+void CompileRecord(struct PathData path, struct ITURHFProp ITURHFP, int option);
+void WriteRecord(struct PathData *path);
+void RptDouble(size_t offset, double scale, const char *fmt);
+void RptDominant(size_t offset, double scale, const char *fmt);
+void RptLabel(int type, int option);
+struct RptColumn *RptColumn(int type, const char *fmt);
+int PutValue(char *s, double v, struct RptColumn *c);
+int PutModeLabel(char *s, int hops, const char *layer, struct RptColumn *c);
+int OpenBinReport(struct PathData path, struct ITURHFProp ITURHFP);
+void WriteBinRecord(struct PathData *path);
+void CloseBinReport(void);
+void RptHeader(const char *text);
 // End local prototypes
 
 // Local globals
@@ -74,6 +134,11 @@ char *season[] = {"Winter", "Equinox", "Summer"};
 char outstr[256] = "";
 FILE *fp; // Temp file pointer for readability
 static int Header = TRUE; // The first time you enter this routine the head will need to be printed.
+static struct RptRecord Record = {0, -1, 0, {{0, 0, 0.0, 0, 0, 0, 0}}}; // Columns of the data records
+static char row[RPTROWMAX]; // Record buffer
+static struct RptBinFile Bin; // Binary report
+static char *Names = NULL; // Column names are collected here rather than printed when it is set
+static int NamesSize;
 // End local globals
 
 void Report(struct PathData path, struct ITURHFProp ITURHFP) {
@@ -104,6 +169,28 @@ void Report(struct PathData path, struct ITURHFProp ITURHFP) {
 	// For readability set the local global file pointer.
 	fp = ITURHFP.rptfp;
 
+	// The binary report has its own header and is finished after the last record.
+	if(ITURHFP.binary == TRUE) {
+		if(Header == TRUE) {
+			Header = FALSE;
+			if(OpenBinReport(path, ITURHFP) != TRUE) {
+				printf("Report: Error Can't allocate the binary report\n");
+			};
+		};
+		if(Bin.group != NULL) {
+			WriteBinRecord(&path);
+			if ((ITURHFP.ihr == ITURHFP.ihrend - 1) &&
+				(ITURHFP.ifrq == ITURHFP.ifrqend - 1) &&
+				(ITURHFP.ilng == ITURHFP.ilngend - 1) &&
+				(ITURHFP.imnth == ITURHFP.imnthend - 1) &&
+				(ITURHFP.ilat == ITURHFP.ilatend - 1)) {
+				// Last record of the report
+				CloseBinReport();
+			};
+		};
+		return;
+	};
+
 	// Determine if the the user wants the header printed
 	if (ITURHFP.header == TRUE) {
 		if (Header == TRUE) {
@@ -158,6 +245,11 @@ void Report(struct PathData path, struct ITURHFProp ITURHFP) {
 
 void PrintRecord(struct PathData path, struct ITURHFProp ITURHFP, int option) {
 
+	/*
+	 * PrintRecord() - Prints the data format header or a data record. The data records are written by
+	 *		WriteRecord() from the columns that CompileRecord() made from ITURHFP.RptFileFormat.
+	 */
+
 	int col;
 
 	col = 3;
@@ -169,131 +261,254 @@ void PrintRecord(struct PathData path, struct ITURHFProp ITURHFP, int option) {
 			fprintf(fp, "Column 03: Frequency (MHz)\n");
 			break;
 		case PRINT_RFC4180_HEADER:
-		  fprintf(fp, "month,hour,frequency");
+		  RptHeader("month,hour,frequency");
 			break;
 		case PRINT_DATA:
-			// Each record will require the month, hour, and frequency
-			// Month
-			fprintf(fp, "%02d", path.month+1);
-			fprintf(fp,",");
-			// Hour
-			fprintf(fp, " %02d", path.hour+1);
-			fprintf(fp,",");
-			// Frequency
-			fprintf(fp, DBLFIELD3, path.frequency);
-			break;
 		case PRINT_RFC4180_DATA:
-			// Each record will require the month, hour, and frequency
-			// Month
-			fprintf(fp, "%d,%d,", path.month+1, path.hour+1);
-			fprintf(fp, RFC4180_DBLFIELD, path.frequency);
-			break;
+			// The columns are made for the first record and whenever the format changes.
+			if((Record.format != ITURHFP.RptFileFormat) || (Record.option != option)) {
+				CompileRecord(path, ITURHFP, option);
+			};
+			WriteRecord(&path);
+			return;
 	};
 
+	PrintColumns(path, ITURHFP, option, &col);
+
+	// If the data format header is being printed, put the tail on.
+	if(option == PRINT_HEADER) {
+		fprintf(fp, "\n");
+	    fprintf(fp, "************************** End Data Format ********************************\n");
+		fprintf(fp, "\n");
+		fprintf(fp, "************************ Calculated Parameters ****************************\n");
+		fprintf(fp, "\n");
+	}
+	else {
+		// End of output record line
+		RptHeader("\n");
+	};
+
+	return;
+};
+
+void PrintColumns(struct PathData path, struct ITURHFProp ITURHFP, int option, int *col) {
+
+	/*
+	 * PrintColumns() - Calls the function_RPT_ routine of each option in ITURHFP.RptFileFormat in the 
+	 *		order of the columns. For the header options they print the description of their columns and
+	 *		for the data options they add their columns to the record.
+	 */
+
 	if((ITURHFP.RptFileFormat & RPT_RXLOCATION) == RPT_RXLOCATION) {
-		function_RPT_RXLOCATION(path, option, &col);
+		function_RPT_RXLOCATION(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_D) == RPT_D) {
-		function_RPT_D(path, option, &col);
+		function_RPT_D(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_DMAX) == RPT_DMAX) {
-		function_RPT_DMAX(path, option, &col);
+		function_RPT_DMAX(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_ELE) == RPT_ELE) {
-		function_RPT_ELE(path, option, &col);
+		function_RPT_ELE(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_BMUF) == RPT_BMUF) {
-		function_RPT_BMUF(path, option, &col);
+		function_RPT_BMUF(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_BMUFD) == RPT_BMUFD) {
-		function_RPT_BMUFD(path, option, &col);
+		function_RPT_BMUFD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_OPMUF) == RPT_OPMUF) {
-		function_RPT_OPMUF(path, option, &col);
+		function_RPT_OPMUF(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_OPMUFD) == RPT_OPMUFD) {
-		function_RPT_OPMUFD(path, option, &col);
+		function_RPT_OPMUFD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_N0_F2) == RPT_N0_F2) {
-		function_RPT_N0_F2(path, option, &col);
+		function_RPT_N0_F2(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_N0_E) == RPT_N0_E) {
-		function_RPT_N0_E(path, option, &col);
+		function_RPT_N0_E(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_E) == RPT_E) {
-		function_RPT_E(path, option, &col);
+		function_RPT_E(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_PR) == RPT_PR) {
-		function_RPT_PR(path, option, &col);
+		function_RPT_PR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_GRW) == RPT_GRW) {
-		function_RPT_GRW(path, option, &col);
+		function_RPT_GRW(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_NOISESOURCES) == RPT_NOISESOURCES) {
-		function_RPT_NOISESOURCES(path, option, &col);
+		function_RPT_NOISESOURCES(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_NOISESOURCESD) == RPT_NOISESOURCESD) {
-		function_RPT_NOISESOURCESD(path, option, &col);
+		function_RPT_NOISESOURCESD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_NOISETOTALD) == RPT_NOISETOTALD) {
-		function_RPT_NOISETOTALD(path, option, &col);
+		function_RPT_NOISETOTALD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_NOISETOTAL) == RPT_NOISETOTAL) {
-		function_RPT_NOISETOTAL(path, option, &col);
+		function_RPT_NOISETOTAL(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_SNR) == RPT_SNR) {
-		function_RPT_SNR(path, option, &col);
+		function_RPT_SNR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_SNRD) == RPT_SNRD) {
-		function_RPT_SNRD(path, option, &col);
+		function_RPT_SNRD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_SNRXX) == RPT_SNRXX) {
-		function_RPT_SNRXX(path, option, &col);
+		function_RPT_SNRXX(path, option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_SIR) == RPT_SIR) {
-		function_RPT_SIR(path, option, &col);
+		function_RPT_SIR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_SIRD) == RPT_SIRD) {
-		function_RPT_SIRD(path, option, &col);
+		function_RPT_SIRD(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_RSN) == RPT_RSN) {
-		function_RPT_RSN(path, option, &col);
+		function_RPT_RSN(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_BCR) == RPT_BCR) {
-		function_RPT_BCR(path, option, &col);
+		function_RPT_BCR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_OCR) == RPT_OCR) {
-		function_RPT_OCR(path, option, &col);
+		function_RPT_OCR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_OCRS) ==RPT_OCRS ) {
-		function_RPT_OCRS(path, option, &col);
+		function_RPT_OCRS(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_MIR) == RPT_MIR) {
-		function_RPT_MIR(path, option, &col);
+		function_RPT_MIR(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_DOMMODE) == RPT_DOMMODE) {
-		function_RPT_DOMMODE(path, option, &col);
+		function_RPT_DOMMODE(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_ESL) == RPT_ESL) {
-		function_RPT_ESL(path, option, &col);
+		function_RPT_ESL(option, col);
 	};
 	if((ITURHFP.RptFileFormat & RPT_LONG) == RPT_LONG) {
-		function_RPT_LONG(path, option, &col);
+		function_RPT_LONG(option, col);
 	};
 
-	// If the data format header is being printed, put the tail on.
-	if(option == PRINT_HEADER) {
-		fprintf(fp, "\n");
-	    fprintf(fp, "************************** End Data Format ********************************\n");
-		fprintf(fp, "\n");
-		fprintf(fp, "************************ Calculated Parameters ****************************\n");
-		fprintf(fp, "\n");
+	return;
+};
+
+void CompileRecord(struct PathData path, struct ITURHFProp ITURHFP, int option) {
+
+	/*
+	 * CompileRecord() - Makes the list of columns of a data record. The month and hour are not
+	 *		columns since they are always the first two fields.
+	 */
+
+	int col;
+
+	col = 3;
+
+	Record.format = ITURHFP.RptFileFormat;
+	Record.option = option;
+	Record.ncols = 0;
+
+	// Frequency
+	if(option == PRINT_DATA) {
+		RptDouble(offsetof(struct PathData, frequency), 1.0, DBLFIELD3);
 	}
 	else {
-		// End of output record line
-		fprintf(fp, "\n");
+		RptDouble(offsetof(struct PathData, frequency), 1.0, RFC4180_DBLFIELD);
+	};
+
+	PrintColumns(path, ITURHFP, option, &col);
+
+	if((option == PRINT_RFC4180_DATA) && (ITURHFP.shortest == TRUE)) {
+		for(col=0; col<Record.ncols; col++) {
+			Record.col[col].shortest = TRUE;
+		};
+	};
+
+	return;
+};
+
+void WriteRecord(struct PathData *path) {
+
+	/*
+	 * WriteRecord() - Formats a data record in the record buffer and writes it. The text is the same as 
+	 *		the fprintf() of each field with the format of its column would give.
+	 */
+
+	struct RptColumn *c;
+
+	double v;
+
+	char *s;
+	int i;
+	int hops;
+
+	s = row;
+
+	// Each record will require the month, hour, and frequency
+	if(Record.option == PRINT_DATA) {
+		s += PutInt(s, path->month+1, 2);
+		*s++ = ',';
+		*s++ = ' ';
+		s += PutInt(s, path->hour+1, 2);
+	}
+	else {
+		s += PutInt(s, path->month+1, 1);
+		*s++ = ',';
+		s += PutInt(s, path->hour+1, 1);
 	};
 
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+
+		// Write out the buffer before it could overflow.
+		if(s - row > RPTROWMAX - RPTFIELDMAX) {
+			fwrite(row, 1, s - row, fp);
+			s = row;
+		};
+
+		*s++ = ',';
+
+		switch(c->type) {
+			case RPTCOL_DOUBLE:
+				v = *(double *)((char *)path + c->offset);
+				s += PutValue(s, v*c->scale, c);
+				break;
+			case RPTCOL_DOMINANT:
+				if(path->DMidx <= MAXMDS) {
+					v = *(double *)((char *)path->DMptr + c->offset);
+					s += PutValue(s, v*c->scale, c);
+				}
+				else {
+					s += PutValue(s, 0.0, c);
+				};
+				break;
+			case RPTCOL_N0F2:
+				hops = (path->n0_F2 != NOLOWESTMODE) ? path->n0_F2+1 : 0;
+				s += PutModeLabel(s, hops, "F2", c);
+				break;
+			case RPTCOL_N0E:
+				hops = (path->n0_E != NOLOWESTMODE) ? path->n0_E+1 : 0;
+				s += PutModeLabel(s, hops, "E", c);
+				break;
+			case RPTCOL_DMLABEL:
+				if(path->DMidx < MAXEMDS) { // E mode dominant
+					s += PutModeLabel(s, path->DMidx+1, "E", c);
+				}
+				else if((path->DMidx >= MAXEMDS) && (path->DMidx <= MAXMDS)) { // F2 mode dominant
+					s += PutModeLabel(s, path->DMidx-2, "F2", c);
+				}
+				else { // There is no dominant mode
+					s += PutModeLabel(s, 0, "", c);
+				};
+				break;
+		};
+	};
+
+	// End of output record line
+	*s++ = '\n';
+
+	fwrite(row, 1, s - row, fp);
+
 	return;
 };
 
@@ -413,6 +628,17 @@ void PrintHeader(struct PathData path, struct ITURHFProp ITURHFP) {
 	fprintf(fp, "\tNumber of months      : %d\n", ITURHFP.imnthend);
 	fprintf(fp, "\tLatitude increment    : %lf (deg)\n", ITURHFP.latinc*R2D);
 	fprintf(fp, "\tLongitude increment   : %lf (deg)\n", ITURHFP.lnginc*R2D);
+	// The frequency and hour of a reduced result are 0
+	if(ITURHFP.reducefreq != REDUCE_NONE) {
+		fprintf(fp, "\tReduce frequency      : Frequency of the largest %s\n", (ITURHFP.reducefreq == REDUCE_BCR) ? "BCR" : "SNR");
+	};
+	if(ITURHFP.reducehours == REDUCE_PERCENTILE) {
+		fprintf(fp, "\tReduce hours          : %lf percentile of the hours\n", ITURHFP.percentile);
+	}
+	else if(ITURHFP.reducehours != REDUCE_NONE) {
+		fprintf(fp, "\tReduce hours          : %s of the hours\n",
+			(ITURHFP.reducehours == REDUCE_MIN) ? "Minimum" : (ITURHFP.reducehours == REDUCE_MAX) ? "Maximum" : "Mean");
+	};
 	fprintf(fp, "\n");
 	fprintf(fp, "************************** ITURHFP Input Parameters *****************************\n");
 	fprintf(fp, "\n");
@@ -434,96 +660,86 @@ void PrintLastRecord(struct PathData path, struct ITURHFProp ITURHFP) {
 
 };
 
-void function_RPT_D(struct PathData path, int option, int *col) {
+void function_RPT_D(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: D - Path distance (km)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",distance");
+			RptHeader(",distance");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD2, path.distance);
+			RptDouble(offsetof(struct PathData, distance), 1.0, DBLFIELD2);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD2, path.distance);
+			RptDouble(offsetof(struct PathData, distance), 1.0, RFC4180_DBLFIELD2);
 			break;
 	};
 	return;
 };
 
-void function_RPT_DMAX(struct PathData path, int option, int *col) {
+void function_RPT_DMAX(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: dmax - Path maximum hop distance (km)\n", ++*col);
 			fprintf(fp, "Column %02d: ptick - Slant Path distance (km)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",dmax,ptick");
+			RptHeader(",dmax,ptick");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.dmax);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD2, path.ptick);
+			RptDouble(offsetof(struct PathData, dmax), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, ptick), 1.0, DBLFIELD2);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.dmax);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD2, path.ptick);
+			RptDouble(offsetof(struct PathData, dmax), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, ptick), 1.0, RFC4180_DBLFIELD2);
 			break;
 	};
 	return;
 };
 
-void function_RPT_ELE(struct PathData path, int option, int *col) {
+void function_RPT_ELE(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: ele - Path minimum Rx elevation angle (deg)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",ele");
+			RptHeader(",ele");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.ele*R2D);
+			RptDouble(offsetof(struct PathData, ele), R2D, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.ele*R2D);
+			RptDouble(offsetof(struct PathData, ele), R2D, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_BMUF(struct PathData path, int option, int *col) {
+void function_RPT_BMUF(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: BMUF - Path basic MUF (MHz)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",BMUF");
+			RptHeader(",BMUF");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.BMUF);
+			RptDouble(offsetof(struct PathData, BMUF), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.BMUF);
+			RptDouble(offsetof(struct PathData, BMUF), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_BMUFD(struct PathData path, int option, int *col) {
+void function_RPT_BMUFD(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: MUF50 - 50%% Path basic MUF (MHz)\n", ++*col);
@@ -531,46 +747,38 @@ void function_RPT_BMUFD(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: MUF10 - 10%% Path basic MUF (MHz)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",MUF50,MUF90,MUF10");
+			RptHeader(",MUF50,MUF90,MUF10");
 			*col = *col + 3;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.MUF50);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.MUF90);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.MUF10);
+			RptDouble(offsetof(struct PathData, MUF50), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, MUF90), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, MUF10), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.MUF50);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.MUF90);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.MUF10);
+			RptDouble(offsetof(struct PathData, MUF50), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, MUF90), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, MUF10), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 
 	return;
 };
 
-void function_RPT_OPMUF(struct PathData path, int option, int *col) {
+void function_RPT_OPMUF(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: OPMUF - Operation MUF (MHz)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",OPMUF");
+			RptHeader(",OPMUF");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.OPMUF);
+			RptDouble(offsetof(struct PathData, OPMUF), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.OPMUF);
+			RptDouble(offsetof(struct PathData, OPMUF), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 
@@ -578,7 +786,7 @@ void function_RPT_OPMUF(struct PathData path, int option, int *col) {
 
 };
 
-void function_RPT_OPMUFD(struct PathData path, int option, int *col) {
+void function_RPT_OPMUFD(int option, int *col) {
 
 	switch(option) {
 		case PRINT_HEADER:
@@ -586,155 +794,113 @@ void function_RPT_OPMUFD(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: OPMUF10 - 10%% Operation MUF (MHz)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",OPMUF90,OPMUF10");
+			RptHeader(",OPMUF90,OPMUF10");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.OPMUF90);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.OPMUF10);
+			RptDouble(offsetof(struct PathData, OPMUF90), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, OPMUF10), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.OPMUF90);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.OPMUF10);
+			RptDouble(offsetof(struct PathData, OPMUF90), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, OPMUF10), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_N0_F2(struct PathData path, int option, int *col) {
+void function_RPT_N0_F2(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Lowest order mode for the F2 layer\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",n0_F2");
+			RptHeader(",n0_F2");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			if(path.n0_F2 != NOLOWESTMODE) {
-				sprintf(outstr, "  %1dF2 ", path.n0_F2+1);
-			}
-			else {
-				sprintf(outstr, " NONE ");
-			};
-			fprintf(fp, STRFIELD, outstr);
-			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			if(path.n0_F2 != NOLOWESTMODE) {
-				sprintf(outstr, "%dF2", path.n0_F2+1);
-			}
-			else {
-				sprintf(outstr, "NONE");
-			};
-			fprintf(fp, RFC4180_STRFIELD, outstr);
+			RptLabel(RPTCOL_N0F2, option);
 			break;
 	};
 	return;
 };
 
-void function_RPT_N0_E(struct PathData path, int option, int *col) {
+void function_RPT_N0_E(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Lowest order mode for the E layer\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",n0_E");
+			RptHeader(",n0_E");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			if(path.n0_E != NOLOWESTMODE) {
-				sprintf(outstr, "   %1dE ", path.n0_E+1);
-			}
-			else {
-				sprintf(outstr, " NONE ");
-			};
-			fprintf(fp, STRFIELD, outstr);
-			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			if(path.n0_E != NOLOWESTMODE) {
-				sprintf(outstr, "%dE", path.n0_E+1);
-			}
-			else {
-				sprintf(outstr, "NONE");
-			};
-			fprintf(fp, RFC4180_STRFIELD, outstr);
+			RptLabel(RPTCOL_N0E, option);
 			break;
 	};
 	return;
 };
 
-void function_RPT_E(struct PathData path, int option, int *col) {
+void function_RPT_E(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: E - Path Field Strength (dB(1uV/m))\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",Ep");
+			RptHeader(",Ep");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.Ep);
+			RptDouble(offsetof(struct PathData, Ep), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.Ep);
+			RptDouble(offsetof(struct PathData, Ep), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_GRW(struct PathData path, int option, int *col) {
+void function_RPT_GRW(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Grw - Receive Antenna Gain (dbi)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",Grw");
+			RptHeader(",Grw");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.Grw);
+			RptDouble(offsetof(struct PathData, Grw), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.Grw);
+			RptDouble(offsetof(struct PathData, Grw), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_PR(struct PathData path, int option, int *col) {
+void function_RPT_PR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Pr - Median receiver power (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",PR");
+			RptHeader(",PR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.Pr);
+			RptDouble(offsetof(struct PathData, Pr), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.Pr);
+			RptDouble(offsetof(struct PathData, Pr), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_NOISESOURCES(struct PathData path, int option, int *col) {
+void function_RPT_NOISESOURCES(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: FaA - Atmospheric noise (dB)\n", ++*col);
@@ -742,30 +908,24 @@ void function_RPT_NOISESOURCES(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: FaG - Galactic noise (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",FaA,FaM,FaG");
+			RptHeader(",FaA,FaM,FaG");
 			*col = *col + 3;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.FaA);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.FaM);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.FaG);
+			RptDouble(offsetof(struct PathData, noiseP.FaA), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.FaM), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.FaG), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.FaA);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.FaM);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.FaG);
+			RptDouble(offsetof(struct PathData, noiseP.FaA), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.FaM), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.FaG), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_NOISESOURCESD(struct PathData path, int option, int *col) {
+void function_RPT_NOISESOURCESD(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: DuA - Upper decile deviation of atmospheric noise (dB)\n", ++*col);
@@ -776,130 +936,106 @@ void function_RPT_NOISESOURCESD(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: DlG - Lower decile deviation of atmospheric noise (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",DuA,DlA,DuM,DlM,DuG,DlG");
+			RptHeader(",DuA,DlA,DuM,DlM,DuG,DlG");
 			*col = *col + 6;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DuA);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DlA);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DuM);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DlM);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DuG);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DlG);
+			RptDouble(offsetof(struct PathData, noiseP.DuA), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlA), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DuM), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlM), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DuG), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlG), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DuA);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DlA);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DuM);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DlM);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DuG);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DlG);
+			RptDouble(offsetof(struct PathData, noiseP.DuA), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlA), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DuM), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlM), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DuG), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlG), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_NOISETOTALD(struct PathData path, int option, int *col) {
+void function_RPT_NOISETOTALD(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: DuT - Upper decile deviation of total noise (dB)\n", ++*col);
 			fprintf(fp, "Column %02d: DlT - Lower decile deviation of total noise (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",DuT,DlT");
+			RptHeader(",DuT,DlT");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DuT);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.DlT);
+			RptDouble(offsetof(struct PathData, noiseP.DuT), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlT), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DuT);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.DlT);
+			RptDouble(offsetof(struct PathData, noiseP.DuT), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, noiseP.DlT), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_NOISETOTAL(struct PathData path, int option, int *col) {
+void function_RPT_NOISETOTAL(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: FamT - Total noise (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",FamT");
+			RptHeader(",FamT");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.noiseP.FamT);
+			RptDouble(offsetof(struct PathData, noiseP.FamT), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.noiseP.FamT);
+			RptDouble(offsetof(struct PathData, noiseP.FamT), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_SNR(struct PathData path, int option, int *col) {
+void function_RPT_SNR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: SNR - Median signal-to-noise ratio (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",SNR");
+			RptHeader(",SNR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.SNR);
+			RptDouble(offsetof(struct PathData, SNR), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.SNR);
+			RptDouble(offsetof(struct PathData, SNR), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_SNRD(struct PathData path, int option, int *col) {
+void function_RPT_SNRD(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: DuSN - Upper decile deviation of signal-to-noise ratio (dB)\n", ++*col);
 			fprintf(fp, "Column %02d: DlSN - Lower decile deviation of signal-to-noise ratio (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",DuSN,DlSN");
+			RptHeader(",DuSN,DlSN");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.DuSN);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.DlSN);
+			RptDouble(offsetof(struct PathData, DuSN), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, DlSN), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.DuSN);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.DlSN);
+			RptDouble(offsetof(struct PathData, DuSN), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, DlSN), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
@@ -911,69 +1047,61 @@ void function_RPT_SNRXX(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: SNRXXp - Signal-to-noise ratio at %0d%% of month\n", ++*col, path.SNRXXp);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",SNRXXp");
+			RptHeader(",SNRXXp");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.SNRXX);
+			RptDouble(offsetof(struct PathData, SNRXX), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.SNRXX);
+			RptDouble(offsetof(struct PathData, SNRXX), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_SIR(struct PathData path, int option, int *col) {
+void function_RPT_SIR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: SIR - Signal-to-interference ratio (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",SIR");
+			RptHeader(",SIR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.SIR);
+			RptDouble(offsetof(struct PathData, SIR), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.SIR);
+			RptDouble(offsetof(struct PathData, SIR), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_SIRD(struct PathData path, int option, int *col) {
+void function_RPT_SIRD(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: DuSI - Upper decile deviation of signal-to-interference ratio (dB)\n", ++*col);
 			fprintf(fp, "Column %02d: DlSI - Lower decile deviation of signal-to-interference ratio (dB)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",DuSI,DlSI");
+			RptHeader(",DuSI,DlSI");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.DuSI);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.DlSI);
+			RptDouble(offsetof(struct PathData, DuSI), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, DlSI), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.DuSI);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.DlSI);
+			RptDouble(offsetof(struct PathData, DuSI), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, DlSI), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_RSN(struct PathData path, int option, int *col) {
+void function_RPT_RSN(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: RSN - Probability that the required SNR is achieved (%%)\n", ++*col);
@@ -981,72 +1109,62 @@ void function_RPT_RSN(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: RF - Probability that the required frequency spread f0 is not exceeded (%%)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",RSN,RT,RF");
+			RptHeader(",RSN,RT,RF");
 			*col = *col + 3;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.RSN);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.RT);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.RF);
+			RptDouble(offsetof(struct PathData, RSN), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, RT), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, RF), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.RSN);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.RT);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.RF);
+			RptDouble(offsetof(struct PathData, RSN), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, RT), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, RF), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_BCR(struct PathData path, int option, int *col) {
+void function_RPT_BCR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: BCR - Basic circuit reliability (%%)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-		  fprintf(fp, ",BCR");
+		  RptHeader(",BCR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.BCR);
+			RptDouble(offsetof(struct PathData, BCR), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.BCR);
+			RptDouble(offsetof(struct PathData, BCR), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_OCR(struct PathData path, int option, int *col) {
+void function_RPT_OCR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: OCR - Overall circuit reliability not considering scattering (%%)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",OCR");
+			RptHeader(",OCR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.OCR);
+			RptDouble(offsetof(struct PathData, OCR), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.OCR);
+			RptDouble(offsetof(struct PathData, OCR), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_OCRS(struct PathData path, int option, int *col) {
+void function_RPT_OCRS(int option, int *col) {
 
 	switch(option) {
 		case PRINT_HEADER:
@@ -1054,99 +1172,85 @@ void function_RPT_OCRS(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: Probocc - Probability of scattering (%%)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",OCRs,probocc");
+			RptHeader(",OCRs,probocc");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.OCRs);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.probocc);
+			RptDouble(offsetof(struct PathData, OCRs), 1.0, DBLFIELD);
+			RptDouble(offsetof(struct PathData, probocc), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.OCRs);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.probocc);
+			RptDouble(offsetof(struct PathData, OCRs), 1.0, RFC4180_DBLFIELD);
+			RptDouble(offsetof(struct PathData, probocc), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_MIR(struct PathData path, int option, int *col) {
+void function_RPT_MIR(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: MIR - Multimode Interference (%%)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",MIR");
+			RptHeader(",MIR");
 			++*col;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD, path.MIR);
+			RptDouble(offsetof(struct PathData, MIR), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD, path.MIR);
+			RptDouble(offsetof(struct PathData, MIR), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 	return;
 };
 
-void function_RPT_RXLOCATION(struct PathData path, int option, int *col) {
+void function_RPT_RXLOCATION(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Receiver latitude (deg)\n", ++*col);
 			fprintf(fp, "Column %02d: Receiver longitude (deg)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",rxlat,rxlng");
+			RptHeader(",rxlat,rxlng");
 			*col = *col+2;
 		  break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.L_rx.lat*R2D);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.L_rx.lng*R2D);
+			RptDouble(offsetof(struct PathData, L_rx.lat), R2D, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, L_rx.lng), R2D, DBLFIELD1);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.L_rx.lat*R2D);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.L_rx.lng*R2D);
+			RptDouble(offsetof(struct PathData, L_rx.lat), R2D, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, L_rx.lng), R2D, RFC4180_DBLFIELD1);
 			break;
 	};
 	return;
 };
 
-void function_RPT_ESL(struct PathData path, int option, int *col) {
+void function_RPT_ESL(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Short Path (<=7000 km) Field Strength (dB(1uV/m))\n", ++*col);
 			fprintf(fp, "Column %02d: Long Path (>9000km) Field Strength (dB(1uV/m))\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",Es,El");
+			RptHeader(",Es,El");
 			*col = *col + 2;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.Es);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.El);
+			RptDouble(offsetof(struct PathData, Es), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, El), 1.0, DBLFIELD1);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.Es);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.El);
+			RptDouble(offsetof(struct PathData, Es), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, El), 1.0, RFC4180_DBLFIELD1);
 			break;
 	};
 	return;
 };
 
-void function_RPT_LONG(struct PathData path, int option, int *col) {
+void function_RPT_LONG(int option, int *col) {
 	switch(option) {
 		case PRINT_HEADER:
 			fprintf(fp, "Column %02d: Free-space Field Strength 3 MW e.i.r.p. (dB(1uV/m)\n", ++*col);
@@ -1162,62 +1266,40 @@ void function_RPT_LONG(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: Scale factor f(f ,fL, fM, fH)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",E0,Gap,Ly,fM,fL,K0,K1,Gtl,Grw,fH,Fscale");
+			RptHeader(",E0,Gap,Ly,fM,fL,K0,K1,Gtl,Grw,fH,Fscale");
 			*col = *col + 11;
 			break;
 		case PRINT_DATA:
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.E0);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.Gap);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.Ly);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.fM);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.fL);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.K[0]);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.K[1]);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.Gtl);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.Grw);
-			fprintf(fp, ",");
-			fprintf(fp, DBLFIELD1, path.fH);
-			fprintf(fp,",");
-			fprintf(fp, DBLFIELD1, path.F);
+			RptDouble(offsetof(struct PathData, E0), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Gap), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Ly), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fM), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fL), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, K[0]), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, K[1]), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Gtl), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Grw), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fH), 1.0, DBLFIELD1);
+			RptDouble(offsetof(struct PathData, F), 1.0, DBLFIELD1);
 			break;
 		case PRINT_RFC4180_DATA:
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.E0);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.Gap);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.Ly);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.fM);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.fL);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.K[0]);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.K[1]);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.Gtl);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.Grw);
-			fprintf(fp, ",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.fH);
-			fprintf(fp,",");
-			fprintf(fp, RFC4180_DBLFIELD1, path.F);
+			RptDouble(offsetof(struct PathData, E0), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Gap), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Ly), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fM), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fL), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, K[0]), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, K[1]), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Gtl), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, Grw), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, fH), 1.0, RFC4180_DBLFIELD1);
+			RptDouble(offsetof(struct PathData, F), 1.0, RFC4180_DBLFIELD1);
 			break;
 	};
 	return;
 };
 
-void function_RPT_DOMMODE(struct PathData path, int option, int *col) {
+void function_RPT_DOMMODE(int option, int *col) {
 
 	switch(option) {
 		case PRINT_HEADER:
@@ -1233,126 +1315,594 @@ void function_RPT_DOMMODE(struct PathData path, int option, int *col) {
 			fprintf(fp, "Column %02d: Dominant mode - Basic MUF (MHz)\n", ++*col);
 			break;
 		case PRINT_RFC4180_HEADER:
-			fprintf(fp, ",DMidx,DMele,DMtau,DMLb,DMFprob,DMhr,DMPrw,DMGrw,DMEw,DMBMUF");
+			RptHeader(",DMidx,DMele,DMtau,DMLb,DMFprob,DMhr,DMPrw,DMGrw,DMEw,DMBMUF");
 			*col = *col + 10;
 			break;
 		case PRINT_DATA:
-			if(path.DMidx < MAXEMDS) { // E mode dominant
-				sprintf(outstr,  "   %1dE ", path.DMidx+1);
-			}
-			else if((path.DMidx >= MAXEMDS) && (path.DMidx <= MAXMDS)) { // F2 mode dominant
-				sprintf(outstr, "  %1dF2 ", path.DMidx-2);
-			}
-			else { // There is no dominant mode
-				sprintf(outstr, " NONE ");
-			};
-
-			if(path.DMidx <= MAXMDS) {
-				fprintf(fp,",");
-				fprintf(fp, STRFIELD, outstr);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->ele*R2D);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->tau);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->Lb);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->Fprob);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->hr);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->Prw);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->Grw);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->Ew);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, path.DMptr->BMUF);
-			}
-			else {
-				fprintf(fp,",");
-				fprintf(fp, STRFIELD, outstr);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, DBLFIELD, 0.0);
-			};
+			RptLabel(RPTCOL_DMLABEL, option);
+			RptDominant(offsetof(struct Mode, ele), R2D, DBLFIELD);
+			RptDominant(offsetof(struct Mode, tau), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, Lb), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, Fprob), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, hr), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, Prw), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, Grw), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, Ew), 1.0, DBLFIELD);
+			RptDominant(offsetof(struct Mode, BMUF), 1.0, DBLFIELD);
 			break;
 		case PRINT_RFC4180_DATA:
-			if(path.DMidx < MAXEMDS) { // E mode dominant
-				sprintf(outstr,  "%dE", path.DMidx+1);
-			}
-			else if((path.DMidx >= MAXEMDS) && (path.DMidx <= MAXMDS)) { // F2 mode dominant
-				sprintf(outstr, "%dF2", path.DMidx-2);
-			}
-			else { // There is no dominant mode
-				sprintf(outstr, "NONE");
-			};
-
-			if(path.DMidx <= MAXMDS) {
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_STRFIELD, outstr);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->ele*R2D);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->tau);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->Lb);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->Fprob);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->hr);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->Prw);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->Grw);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->Ew);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, path.DMptr->BMUF);
-			}
-			else {
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_STRFIELD, outstr);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-				fprintf(fp,",");
-				fprintf(fp, RFC4180_DBLFIELD, 0.0);
-			};
+			RptLabel(RPTCOL_DMLABEL, option);
+			RptDominant(offsetof(struct Mode, ele), R2D, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, tau), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, Lb), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, Fprob), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, hr), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, Prw), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, Grw), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, Ew), 1.0, RFC4180_DBLFIELD);
+			RptDominant(offsetof(struct Mode, BMUF), 1.0, RFC4180_DBLFIELD);
 			break;
 	};
 
 	return;
 };
 
+int ReportColumns(struct PathData path, struct ITURHFProp ITURHFP, char *names, int size) {
+
+	/*
+	 * ReportColumns() - Makes the columns of the RFC 4180 data record for other outputs, which get the values of
+	 *		a record with ReportValues(). The names of the columns, as in the RFC 4180 header, are put in names 
+	 *		separated by commas. The month and hour are not columns so the first column is the frequency.
+	 *
+	 *			INPUT
+	 *				struct PathData path
+	 *				struct ITURHFProp ITURHFP
+	 *				char *names
+	 *				int size		Size of names
+	 *
+	 *			OUTPUT
+	 *				names
+	 *
+	 *				Returns the number of columns or 0 if the names don't fit
+	 *
+	 *			SUBROUTINES
+	 *				CompileRecord()
+	 *				PrintRecord()
+	 */
+
+	char *s;
+
+	int n;
+
+	CompileRecord(path, ITURHFP, PRINT_RFC4180_DATA);
+
+	names[0] = '\0';
+	Names = names;
+	NamesSize = size;
+	PrintRecord(path, ITURHFP, PRINT_RFC4180_HEADER);
+	Names = NULL;
+
+	// Remove the month and hour and the end of line.
+	s = strstr(names, "frequency");
+	if(s == NULL) {
+		return 0;
+	};
+	memmove(names, s, strlen(s) + 1);
+	names[strcspn(names, "\n")] = '\0';
+
+	// There is a name for each column unless they were too long for names.
+	n = 1;
+	for(s=names; *s != '\0'; s++) {
+		if(*s == ',') n++;
+	};
+	if(n != Record.ncols) {
+		return 0;
+	};
+
+	return Record.ncols;
+};
+
+void ReportValues(struct PathData *path, double *v) {
+
+	/*
+	 * ReportValues() - Puts the values of the columns made by ReportColumns() in v. The mode columns are
+	 *		n0_F2, n0_E and DMidx.
+	 */
+
+	struct RptColumn *c;
+
+	int i;
+
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+		switch(c->type) {
+			case RPTCOL_DOUBLE:
+				v[i] = *(double *)((char *)path + c->offset)*c->scale;
+				break;
+			case RPTCOL_DOMINANT:
+				if(path->DMidx <= MAXMDS) {
+					v[i] = *(double *)((char *)path->DMptr + c->offset)*c->scale;
+				}
+				else {
+					v[i] = 0.0;
+				};
+				break;
+			case RPTCOL_N0F2:
+				v[i] = path->n0_F2;
+				break;
+			case RPTCOL_N0E:
+				v[i] = path->n0_E;
+				break;
+			case RPTCOL_DMLABEL:
+				v[i] = path->DMidx;
+				break;
+		};
+	};
+
+	return;
+};
+
+void ReportRawValues(struct PathData *path, double *v) {
+
+	/*
+	 * ReportRawValues() - Puts the values of the columns made by ReportColumns() in v as ReportValues() does
+	 *		but without the change of units, so they can be put back in a struct PathData by ReportSetValues().
+	 */
+
+	struct RptColumn *c;
+
+	int i;
+
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+		switch(c->type) {
+			case RPTCOL_DOUBLE:
+				v[i] = *(double *)((char *)path + c->offset);
+				break;
+			case RPTCOL_DOMINANT:
+				if(path->DMidx <= MAXMDS) {
+					v[i] = *(double *)((char *)path->DMptr + c->offset);
+				}
+				else {
+					v[i] = 0.0;
+				};
+				break;
+			case RPTCOL_N0F2:
+				v[i] = path->n0_F2;
+				break;
+			case RPTCOL_N0E:
+				v[i] = path->n0_E;
+				break;
+			case RPTCOL_DMLABEL:
+				v[i] = path->DMidx;
+				break;
+		};
+	};
+
+	return;
+};
+
+void ReportSetValues(struct PathData *path, double *v) {
+
+	/*
+	 * ReportSetValues() - Puts the values v from ReportRawValues() back in the columns of path so a record
+	 *		that was made from them can be written. The dominant mode is set before its values.
+	 */
+
+	struct RptColumn *c;
+
+	int i;
+
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+		switch(c->type) {
+			case RPTCOL_N0F2:
+				path->n0_F2 = (int)v[i];
+				break;
+			case RPTCOL_N0E:
+				path->n0_E = (int)v[i];
+				break;
+			case RPTCOL_DMLABEL:
+				path->DMidx = (int)v[i];
+				break;
+		};
+	};
+
+	if(path->DMidx < MAXEMDS) {
+		path->DMptr = &path->Md_E[path->DMidx];
+	}
+	else if(path->DMidx < MAXMDS) {
+		path->DMptr = &path->Md_F2[path->DMidx - MAXEMDS];
+	}
+	else {
+		path->DMptr = NULL;
+	};
+
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+		switch(c->type) {
+			case RPTCOL_DOUBLE:
+				*(double *)((char *)path + c->offset) = v[i];
+				break;
+			case RPTCOL_DOMINANT:
+				if(path->DMptr != NULL) {
+					*(double *)((char *)path->DMptr + c->offset) = v[i];
+				};
+				break;
+		};
+	};
+
+	return;
+};
+
+int ReportLabelColumn(int i) {
+
+	/*
+	 * ReportLabelColumn() - Returns TRUE if column i made by ReportColumns() is the label of a mode rather than
+	 *		a quantity, which are n0_F2, n0_E and DMidx. 
+	 */
+
+	return ((Record.col[i].type == RPTCOL_N0F2) || (Record.col[i].type == RPTCOL_N0E) || 
+		(Record.col[i].type == RPTCOL_DMLABEL));
+};
+
+int ReportOutputs(struct ITURHFProp ITURHFP) {
+
+	/*
+	 * ReportOutputs() - Returns the OUT_ results of P533() that the columns in ITURHFP.RptFileFormat need,
+	 *		for the Outputs of struct PathData. The path data dump needs them all. 
+	 *
+	 *			INPUT
+	 *				struct ITURHFProp ITURHFP
+	 *
+	 *			OUTPUT
+	 *				Returns the OUT_ flags
+	 */
+
+	int outputs;
+
+	if(ITURHFP.RptFileFormat == RPT_DUMPPATH) {
+		return OUT_ALL;
+	};
+
+	outputs = OUT_MUF;
+	if((ITURHFP.RptFileFormat & RPTOUT_FIELD) != 0) {
+		outputs |= OUT_FIELD;
+	};
+	if((ITURHFP.RptFileFormat & RPTOUT_NOISE) != 0) {
+		outputs |= OUT_NOISE;
+	};
+	if((ITURHFP.RptFileFormat & RPTOUT_RELIABILITY) != 0) {
+		outputs |= OUT_RELIABILITY;
+	};
+
+	return outputs;
+};
+
+void RptHeader(const char *text) {
+
+	/*
+	 * RptHeader() - Prints part of the RFC 4180 header or adds it to the names for ReportColumns().
+	 */
+
+	int len;
+
+	if(Names == NULL) {
+		fputs(text, fp);
+	}
+	else {
+		len = (int)strlen(Names);
+		if(len + (int)strlen(text) < NamesSize) {
+			strcpy(Names + len, text);
+		};
+	};
+
+	return;
+};
+
+int OpenBinReport(struct PathData path, struct ITURHFProp ITURHFP) {
+
+	/*
+	 * OpenBinReport() - Starts a binary report. The columns are those of the RFC 4180 data record. The
+	 *		header is written with the report header text and the column names. Its counts are filled in 
+	 *		by CloseBinReport(). Returns FALSE if the row group buffer can't be allocated.
+	 *
+	 *			INPUT
+	 *				struct PathData path
+	 *				struct ITURHFProp ITURHFP
+	 *
+	 *			OUTPUT
+	 *				The header of the binary report
+	 *
+	 *			SUBROUTINES
+	 *				CompileRecord()
+	 *				PrintHeader()
+	 *				PrintRecord()
+	 */
+
+	static const char zero[RPTBINALIGN] = {0};
+
+	struct RptBinColumn *col;
+
+	long long offset;
+	long pos;
+	int i;
+
+	CompileRecord(path, ITURHFP, PRINT_RFC4180_DATA);
+
+	memset(&Bin, 0, sizeof(struct RptBinFile));
+	memcpy(Bin.hdr.magic, RPTBINMAGIC, sizeof(RPTBINMAGIC));
+	Bin.hdr.byteorder = RPTBINBYTEORDER;
+	Bin.hdr.version = RPTBINVERSION;
+	Bin.hdr.ncols = Record.ncols + 2;
+	Bin.hdr.grouprows = RPTBINGROUPROWS;
+	Bin.hdr.format = (long long)ITURHFP.RptFileFormat;
+
+	// Lay out the columns in the row group. RPTBINGROUPROWS is even so the doubles stay aligned.
+	offset = 0;
+	for(i=0; i<(int)Bin.hdr.ncols; i++) {
+		col = &Bin.col[i];
+		if((i < 2) || (Record.col[i-2].type == RPTCOL_N0F2) || (Record.col[i-2].type == RPTCOL_N0E) || 
+			(Record.col[i-2].type == RPTCOL_DMLABEL)) {
+			col->type = RPTBIN_INT;
+			col->size = sizeof(int);
+		}
+		else {
+			col->type = RPTBIN_DOUBLE;
+			col->size = sizeof(double);
+		};
+		col->offset = offset;
+		offset += (long long)col->size*RPTBINGROUPROWS;
+	};
+	Bin.hdr.groupsize = (unsigned int)offset;
+
+	Bin.group = (char *)calloc(1, Bin.hdr.groupsize);
+	if(Bin.group == NULL) {
+		return FALSE;
+	};
+
+	// The header is written now to leave room for it and again when the counts are known.
+	fwrite(&Bin.hdr, sizeof(struct RptBinHeader), 1, fp);
+	fwrite(Bin.col, sizeof(struct RptBinColumn), Bin.hdr.ncols, fp);
+
+	Bin.hdr.textoffset = (unsigned int)ftell(fp);
+	PrintHeader(path, ITURHFP);
+	Bin.hdr.nameoffset = (unsigned int)ftell(fp);
+	Bin.hdr.textsize = Bin.hdr.nameoffset - Bin.hdr.textoffset;
+	PrintRecord(path, ITURHFP, PRINT_RFC4180_HEADER);
+	pos = ftell(fp);
+	Bin.hdr.namesize = (unsigned int)pos - Bin.hdr.nameoffset;
+
+	// The row groups are aligned.
+	fwrite(zero, 1, (RPTBINALIGN - pos%RPTBINALIGN)%RPTBINALIGN, fp);
+	Bin.hdr.hdrsize = (unsigned int)ftell(fp);
+
+	return TRUE;
+};
+
+void WriteBinRecord(struct PathData *path) {
+
+	/*
+	 * WriteBinRecord() - Puts a data record in the row group buffer and writes the row group when it is full.
+	 */
+
+	struct RptColumn *c;
+
+	double v;
+
+	int *ip;
+	int i;
+	int r;
+
+	r = Bin.row;
+
+	ip = (int *)(Bin.group + Bin.col[0].offset);
+	ip[r] = path->month + 1;
+	ip = (int *)(Bin.group + Bin.col[1].offset);
+	ip[r] = path->hour + 1;
+
+	for(i=0; i<Record.ncols; i++) {
+		c = &Record.col[i];
+		switch(c->type) {
+			case RPTCOL_DOUBLE:
+				v = *(double *)((char *)path + c->offset);
+				((double *)(Bin.group + Bin.col[i+2].offset))[r] = v*c->scale;
+				break;
+			case RPTCOL_DOMINANT:
+				if(path->DMidx <= MAXMDS) {
+					v = *(double *)((char *)path->DMptr + c->offset)*c->scale;
+				}
+				else {
+					v = 0.0;
+				};
+				((double *)(Bin.group + Bin.col[i+2].offset))[r] = v;
+				break;
+			case RPTCOL_N0F2:
+				((int *)(Bin.group + Bin.col[i+2].offset))[r] = path->n0_F2;
+				break;
+			case RPTCOL_N0E:
+				((int *)(Bin.group + Bin.col[i+2].offset))[r] = path->n0_E;
+				break;
+			case RPTCOL_DMLABEL:
+				((int *)(Bin.group + Bin.col[i+2].offset))[r] = path->DMidx;
+				break;
+		};
+	};
+
+	Bin.hdr.nrows++;
+	Bin.row++;
+	if(Bin.row == RPTBINGROUPROWS) {
+		fwrite(Bin.group, 1, Bin.hdr.groupsize, fp);
+		Bin.hdr.ngroups++;
+		Bin.row = 0;
+	};
+
+	return;
+};
+
+void CloseBinReport(void) {
+
+	/*
+	 * CloseBinReport() - Writes the last row group, which holds only its rows, and the completed header.
+	 *		Writing the columns one after the other with an even number of rows gives the offsets of the
+	 *		columns in the short row group described in ITURHFProp.h.
+	 */
+
+	int i;
+	int rows;	// Rows in the last row group
+
+	if(Bin.row > 0) {
+		rows = Bin.row + Bin.row%2;
+		for(i=0; i<(int)Bin.hdr.ncols; i++) {
+			memset(Bin.group + Bin.col[i].offset + (long long)Bin.row*Bin.col[i].size, 0, 
+				(size_t)(rows - Bin.row)*Bin.col[i].size);
+			fwrite(Bin.group + Bin.col[i].offset, Bin.col[i].size, rows, fp);
+		};
+		Bin.hdr.ngroups++;
+		Bin.row = 0;
+	};
+
+	fseek(fp, 0, SEEK_SET);
+	fwrite(&Bin.hdr, sizeof(struct RptBinHeader), 1, fp);
+	fseek(fp, 0, SEEK_END);
+
+	free(Bin.group);
+	Bin.group = NULL;
+
+	return;
+};
+
+void RptDouble(size_t offset, double scale, const char *fmt) {
+
+	/*
+	 * RptDouble() - Adds a column for the double at offset in struct PathData.
+	 */
+
+	struct RptColumn *c;
+
+	c = RptColumn(RPTCOL_DOUBLE, fmt);
+	if(c == NULL) return;
+
+	c->offset = offset;
+	c->scale = scale;
+
+	return;
+};
+
+void RptDominant(size_t offset, double scale, const char *fmt) {
+
+	/*
+	 * RptDominant() - Adds a column for the double at offset in the struct Mode of the dominant mode.
+	 */
+
+	struct RptColumn *c;
+
+	c = RptColumn(RPTCOL_DOMINANT, fmt);
+	if(c == NULL) return;
+
+	c->offset = offset;
+	c->scale = scale;
+
+	return;
+};
+
+void RptLabel(int type, int option) {
+
+	/*
+	 * RptLabel() - Adds a column for a mode name, such as "2F2".
+	 */
+
+	if(option == PRINT_DATA) {
+		RptColumn(type, STRFIELD);
+	}
+	else {
+		RptColumn(type, RFC4180_STRFIELD);
+	};
+
+	return;
+};
+
+struct RptColumn *RptColumn(int type, const char *fmt) {
+
+	/*
+	 * RptColumn() - Adds a column to the record and reads the flag, width and precision of its format
+	 *		so that it doesn't have to be parsed for each value. Returns NULL if the record is full.
+	 */
+
+	struct RptColumn *c;
+
+	const char *f;
+
+	if(Record.ncols >= RPTMAXCOLS) return NULL;
+
+	c = &Record.col[Record.ncols++];
+	memset(c, 0, sizeof(struct RptColumn));
+	c->type = type;
+	c->scale = 1.0;
+
+	f = fmt + 1; // Past the %
+	if(*f == ' ') {
+		c->space = TRUE;
+		f++;
+	};
+	while((*f >= '0') && (*f <= '9')) {
+		c->width = 10*c->width + (*f++ - '0');
+	};
+	if(*f == '.') {
+		f++;
+		while((*f >= '0') && (*f <= '9')) {
+			c->prec = 10*c->prec + (*f++ - '0');
+		};
+	};
+
+	return c;
+};
+
+int PutValue(char *s, double v, struct RptColumn *c) {
+
+	/*
+	 * PutValue() - Writes v with the format of the column and returns the number of characters
+	 */
+
+	if(c->shortest == TRUE) {
+		return PutShortest(s, v);
+	};
+
+	return PutFixed(s, v, c->width, c->prec, c->space);
+};
+
+int PutModeLabel(char *s, int hops, const char *layer, struct RptColumn *c) {
+
+	/*
+	 * PutModeLabel() - Writes the name of a mode, such as "  2F2 " in the fixed width format or "2F2" in
+	 *		RFC 4180, and returns the number of characters. A hops of 0 is written as NONE.
+	 */
+
+	char buf[32];
+	int len;
+	int k;
+
+	len = 0;
+	if(hops == 0) {
+		strcpy(buf, (c->width > 0) ? " NONE " : "NONE");
+		len = (int)strlen(buf);
+	}
+	else {
+		if(c->width > 0) { // The number is right justified in front of the layer name
+			for(k=(int)strlen(layer); k<4; k++) buf[len++] = ' ';
+		};
+		len += PutInt(buf + len, hops, 1);
+		strcpy(buf + len, layer);
+		len += (int)strlen(layer);
+		if(c->width > 0) buf[len++] = ' ';
+	};
+
+	for(k=len; k<c->width; k++) *s++ = ' ';
+	memcpy(s, buf, len);
+
+	return max(len, c->width);
+};
+
 char EW(double lng) {
 
 	if(lng < 0.0) return 'W';
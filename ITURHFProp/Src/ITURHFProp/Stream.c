@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+/*
+ * Stream.c - The analysis of ITURHFProp() for a program that embeds it. Each result is given to a callback of the
+ *		program as it is calculated in place of being written to a report, path data dump or raster file. Such a
+ *		program compiles ITURHFProp.c with ITURHFPROP_LIB, which leaves out main(), and links the other files of
+ *		ITURHFProp. With the Linux Makefile "make lib" builds libiturhfprop.a. The analysis is run by
+ *
+ *			StreamOpen(&path, &ITURHFP);
+ *			(Set the input in path and ITURHFP as ReadInputConfiguration() would, or call it)
+ *			StreamRun(&path, &ITURHFP, callback, user);
+ *			StreamClose(&path);
+ *
+ *		Only the data files in ITURHFP.DataFilePath and the antenna files are read. StreamOpen() sets path->NoCache
+ *		so that no file is written: an ionosXX.txt.cache that is already there is read but a missing one is not 
+ *		made, and NEC decks are solved without the pattern cache. A program that clears path->NoCache lets 
+ *		ionosXX.txt.cache be written next to the atlas and NEC pattern caches be written in ITURHFP.AntCachePath
+ *		or next to the deck, as ITURHFProp does.
+ */
+
+int StreamOpen(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * StreamOpen() - Loads the P533 DLL, allocates the arrays of path and sets the input of path and ITURHFP to
+	 *		the defaults of ReadInputConfiguration(). ITURHFProp() is silent unless ITURHFP->silent is changed and 
+	 *		writes no cache file unless path->NoCache is changed.
+	 *
+	 *			INPUT
+	 *				struct PathData *path
+	 *				struct ITURHFProp *ITURHFP
+	 *
+	 *			OUTPUT
+	 *				Returns RTN_STREAMOK or an error
+	 *
+	 *			SUBROUTINES
+	 *				LoadP533()
+	 *				dllAllocatePathMemory()
+	 *				InitializeInput()
+	 */
+
+	int retval;
+
+	memset(ITURHFP, 0, sizeof(struct ITURHFProp));
+
+	retval = LoadP533(ITURHFP);
+	if(retval != RTN_LOADP533OK) {
+		return retval;
+	};
+
+	retval = dllAllocatePathMemory(path);
+	if(retval != RTN_ALLOCATEP533OK) {
+		printf("StreamOpen: Error %d from dllAllocatePathMemory\n", retval);
+		return retval;
+	};
+
+	InitializeInput(ITURHFP, path);
+
+	ITURHFP->silent = TRUE;
+	ITURHFP->raster = RASTER_NONE;
+	ITURHFP->rptfp = NULL;
+	path->NoCache = TRUE;
+
+	return RTN_STREAMOK;
+
+};
+
+int StreamRun(struct PathData *path, struct ITURHFProp *ITURHFP, int (*callback)(const struct PathData *path, const struct ITURHFProp *ITURHFP, void *user), void *user) {
+
+	/*
+	 * StreamRun() - Runs the analysis of ITURHFProp() and gives each result to callback. The result is path after
+	 *		P533() with path->DMptr at the dominant mode, or the reduction of the results if ITURHFP->reducefreq or
+	 *		ITURHFP->reducehours are set. The loop indices ITURHFP->imnth, ihr, ifrq, ilat and ilng say which
+	 *		result it is. ITURHFP->RptFileFormat chooses the outputs that P533() calculates; RPT_DUMPPATH is all of
+	 *		them. The result is only valid during the callback. The callback returns TRUE to go on or FALSE to stop
+	 *		the analysis.
+	 *
+	 *			INPUT
+	 *				struct PathData *path
+	 *				struct ITURHFProp *ITURHFP
+	 *				callback - The function that is given each result
+	 *				user - Passed to callback
+	 *
+	 *			OUTPUT
+	 *				Returns RTN_STREAMOK, RTN_ERRSTREAM if the callback stopped the analysis or an error
+	 *
+	 *			SUBROUTINES
+	 *				PrepareITURHFP()
+	 *				ITURHFProp()
+	 */
+
+	int retval;
+
+	ITURHFP->callback = callback;
+	ITURHFP->user = user;
+
+	retval = PrepareITURHFP(path, ITURHFP);
+	if(retval != RTN_VALIDATEITURHFPOK) {
+		printf("StreamRun: Error %d from PrepareITURHFP\n", retval);
+		return retval;
+	};
+
+	retval = ITURHFProp(path, ITURHFP);
+
+	ITURHFP->callback = NULL;
+	ITURHFP->user = NULL;
+
+	if(retval != RTN_ITURHFPropOK) {
+		return retval;
+	};
+
+	return RTN_STREAMOK;
+
+};
+
+int StreamClose(struct PathData *path) {
+
+	/*
+	 * StreamClose() - Frees the arrays of path
+	 *
+	 *			SUBROUTINES
+	 *				dllFreePathMemory()
+	 */
+
+	int retval;
+
+	retval = dllFreePathMemory(path);
+	if(retval != RTN_PATHFREED) {
+		printf("StreamClose: Error %d from dllFreePathMemory\n", retval);
+		return retval;
+	};
+
+	return RTN_STREAMOK;
+
+};
+
+int StreamResult(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * StreamResult() - Gives a result to the callback. It is called by ITURHFProp() and Reduce() in place of
+	 *		writing the result.
+	 *
+	 *			INPUT
+	 *				struct PathData *path
+	 *				struct ITURHFProp *ITURHFP
+	 *
+	 *			OUTPUT
+	 *				Returns RTN_STREAMOK or RTN_ERRSTREAM if the callback stopped the analysis
+	 */
+
+	if(ITURHFP->callback(path, ITURHFP, ITURHFP->user) != TRUE) {
+		return RTN_ERRSTREAM;
+	};
+
+	return RTN_STREAMOK;
+
+};
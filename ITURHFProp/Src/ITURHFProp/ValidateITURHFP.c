@@ -46,6 +46,10 @@ int ValidateITURHFP(struct ITURHFProp ITURHFP) {
 
 	if ((ITURHFP.AntennaOrientation != MANUAL) && (ITURHFP.AntennaOrientation != TX2RX))		return RTN_ERRANTENNAORN;
 
+	if((ITURHFP.reducefreq == REDUCE_INVALID) || (ITURHFP.reducehours == REDUCE_INVALID))		return RTN_ERRREDUCE;
+	if((ITURHFP.reducehours == REDUCE_PERCENTILE) &&
+	   ((ITURHFP.percentile < 0.0) || (ITURHFP.percentile > 100.0)))							return RTN_ERRREDUCE;
+
 	return RTN_VALIDATEITURHFPOK;
 };
 
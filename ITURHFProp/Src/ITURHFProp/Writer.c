@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if __linux__ || __APPLE__
+	#include <pthread.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+#include "ITURHFProp.h"
+// End local includes
+
+// Local structures
+// A result that is waiting to be written. ITURHFP is kept because Report() uses the loop indices to find the
+// last record.
+struct WriterRecord {
+	struct PathData path;
+	struct ITURHFProp ITURHFP;
+};
+
+// The calculation fills one buffer of records while the thread writes the other. When the buffer being
+// filled is full the calculation waits until the thread has finished the other one, then they swap.
+struct Writer {
+	struct WriterRecord *buf[2];
+	int n[2];				// Records in each buffer
+	int full[2];			// The buffer has been handed to the thread
+	int fill;				// Buffer being filled
+	int stop;				// No more buffers will be handed over
+	int started;			// The thread is running
+#ifdef _WIN32
+	HANDLE th;
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE cond;
+#elif __linux__ || __APPLE__
+	pthread_t th;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+#endif
+};
+// End local structures
+
+// Local prototypes
+#ifdef _WIN32
+DWORD WINAPI WriterThreadProc(LPVOID arg);
+#elif __linux__ || __APPLE__
+void* WriterThreadProc(void* arg);
+#endif
+void HandOver(void);
+void WriteOutput(struct PathData *path, struct ITURHFProp *ITURHFP);
+void WriterLock(void);
+void WriterUnlock(void);
+void WriterWait(void);
+void WriterWake(void);
+// End local prototypes
+
+// Local globals
+static struct Writer Wr;
+// End local globals
+
+int StartWriter(void) {
+
+	/*
+	 * StartWriter() - Starts the thread that formats and writes the report or path data dump so P533() can run
+	 *		while the output is written. The results are queued by QueueOutput() and the thread is finished by
+	 *		StopWriter(). If the thread can't be started QueueOutput() writes each result as it is given.
+	 *
+	 *			INPUT
+	 *				None
+	 *
+	 *			OUTPUT
+	 *				Returns
+	 *					TRUE if the thread was started
+	 *					FALSE otherwise
+	 *
+	 *			SUBROUTINES
+	 *				WriterThreadProc()
+	 */
+
+	memset(&Wr, 0, sizeof(Wr));
+
+	Wr.buf[0] = malloc(2*RPTQUEUEROWS*sizeof(struct WriterRecord));
+	if(Wr.buf[0] == NULL) {
+		return FALSE;
+	};
+	Wr.buf[1] = Wr.buf[0] + RPTQUEUEROWS;
+
+#ifdef _WIN32
+	InitializeCriticalSection(&Wr.lock);
+	InitializeConditionVariable(&Wr.cond);
+	Wr.th = CreateThread(NULL, 0, WriterThreadProc, &Wr, 0, NULL);
+	Wr.started = (Wr.th != NULL);
+	if(Wr.started != TRUE) {
+		DeleteCriticalSection(&Wr.lock);
+	};
+#elif __linux__ || __APPLE__
+	pthread_mutex_init(&Wr.lock, NULL);
+	pthread_cond_init(&Wr.cond, NULL);
+	Wr.started = (pthread_create(&Wr.th, NULL, WriterThreadProc, &Wr) == 0);
+	if(Wr.started != TRUE) {
+		pthread_mutex_destroy(&Wr.lock);
+		pthread_cond_destroy(&Wr.cond);
+	};
+#endif
+
+	if(Wr.started != TRUE) {
+		free(Wr.buf[0]);
+		Wr.buf[0] = NULL;
+		Wr.buf[1] = NULL;
+		return FALSE;
+	};
+
+	return TRUE;
+
+};
+
+void QueueOutput(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * QueueOutput() - Gives the result of a P533() run to the writer thread. The result is copied so the
+	 *		calculation can go on with path. The pointer to the dominant mode is moved to the copy of the mode.
+	 *		Without the thread the result is written here.
+	 *
+	 *			INPUT
+	 *				struct PathData *path
+	 *				struct ITURHFProp *ITURHFP
+	 *
+	 *			OUTPUT
+	 *				The result is queued or written
+	 *
+	 *			SUBROUTINES
+	 *				HandOver()
+	 *				WriteOutput()
+	 */
+
+	struct WriterRecord *r;
+
+	if(Wr.started != TRUE) {
+		WriteOutput(path, ITURHFP);
+		return;
+	};
+
+	r = &Wr.buf[Wr.fill][Wr.n[Wr.fill]++];
+	r->path = *path;
+	r->ITURHFP = *ITURHFP;
+	if(path->DMptr != NULL) {
+		r->path.DMptr = (struct Mode *)((char *)&r->path + ((char *)path->DMptr - (char *)path));
+	};
+
+	if(Wr.n[Wr.fill] == RPTQUEUEROWS) {
+		HandOver();
+	};
+
+	return;
+
+};
+
+void StopWriter(void) {
+
+	/*
+	 * StopWriter() - Hands the last results to the writer thread and waits for it to write them. After this
+	 *		the report file can be closed.
+	 *
+	 *			SUBROUTINES
+	 *				HandOver()
+	 */
+
+	if(Wr.started != TRUE) {
+		return;
+	};
+
+	if(Wr.n[Wr.fill] > 0) {
+		HandOver();
+	};
+
+	WriterLock();
+	Wr.stop = TRUE;
+	WriterWake();
+	WriterUnlock();
+
+#ifdef _WIN32
+	WaitForSingleObject(Wr.th, INFINITE);
+	CloseHandle(Wr.th);
+	DeleteCriticalSection(&Wr.lock);
+#elif __linux__ || __APPLE__
+	pthread_join(Wr.th, NULL);
+	pthread_mutex_destroy(&Wr.lock);
+	pthread_cond_destroy(&Wr.cond);
+#endif
+
+	free(Wr.buf[0]);
+	Wr.buf[0] = NULL;
+	Wr.buf[1] = NULL;
+	Wr.started = FALSE;
+
+	return;
+
+};
+
+void HandOver(void) {
+
+	/*
+	 * HandOver() - Gives the buffer being filled to the thread and waits until the other buffer is written
+	 */
+
+	int other;
+
+	other = 1 - Wr.fill;
+
+	WriterLock();
+	Wr.full[Wr.fill] = TRUE;
+	WriterWake();
+	while(Wr.full[other] == TRUE) {
+		WriterWait();
+	};
+	WriterUnlock();
+
+	Wr.n[other] = 0;
+	Wr.fill = other;
+
+	return;
+
+};
+
+#ifdef _WIN32
+DWORD WINAPI WriterThreadProc(LPVOID arg) {
+#elif __linux__ || __APPLE__
+void* WriterThreadProc(void* arg) {
+#endif
+
+	/*
+		WriterThreadProc - Thread entry point that writes the buffers in the order they are filled
+	*/
+
+	struct Writer *w = (struct Writer*) arg;
+
+	int b;
+	int i;
+
+	b = 0;
+	for(;;) {
+		WriterLock();
+		while((w->full[b] != TRUE) && (w->stop != TRUE)) {
+			WriterWait();
+		};
+		if(w->full[b] != TRUE) {
+			WriterUnlock();
+			break;
+		};
+		WriterUnlock();
+
+		for(i=0; i<w->n[b]; i++) {
+			WriteOutput(&w->buf[b][i].path, &w->buf[b][i].ITURHFP);
+		};
+
+		WriterLock();
+		w->full[b] = FALSE;
+		WriterWake();
+		WriterUnlock();
+
+		b = 1 - b;
+	};
+
+	return 0;
+
+};
+
+void WriteOutput(struct PathData *path, struct ITURHFProp *ITURHFP) {
+
+	/*
+	 * WriteOutput() - Writes a result to the path data dump or the report
+	 */
+
+	if((ITURHFP->RptFileFormat & RPT_DUMPPATH) == RPT_DUMPPATH) {
+		DumpPathData(*path, *ITURHFP);
+	}
+	else {
+		Report(*path, *ITURHFP);
+	};
+
+	return;
+
+};
+
+void WriterLock(void) {
+#ifdef _WIN32
+	EnterCriticalSection(&Wr.lock);
+#elif __linux__ || __APPLE__
+	pthread_mutex_lock(&Wr.lock);
+#endif
+	return;
+};
+
+void WriterUnlock(void) {
+#ifdef _WIN32
+	LeaveCriticalSection(&Wr.lock);
+#elif __linux__ || __APPLE__
+	pthread_mutex_unlock(&Wr.lock);
+#endif
+	return;
+};
+
+void WriterWait(void) {
+#ifdef _WIN32
+	SleepConditionVariableCS(&Wr.cond, &Wr.lock, INFINITE);
+#elif __linux__ || __APPLE__
+	pthread_cond_wait(&Wr.cond, &Wr.lock);
+#endif
+	return;
+};
+
+void WriterWake(void) {
+#ifdef _WIN32
+	WakeAllConditionVariable(&Wr.cond);
+#elif __linux__ || __APPLE__
+	pthread_cond_broadcast(&Wr.cond);
+#endif
+	return;
+};
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local include
+#include "ReadRptBin.h"
+// End local include 
+
+int ReadRptBin(struct RptBin *Rpt, const char *FilePath) {
+
+	/*
+	 * ReadRptBin() Reads a binary report file written by ITURHFProp with the -b option. Each column is read into
+	 *		an array of nrows values so a column is used the same way whatever the size of the row groups. The 
+	 *		arrays are released by FreeRptBin().
+	 *
+	 *		The row groups but the last are a fixed size so the file can also be used without this routine. For 
+	 *		example in NumPy the row groups are the records of a structured dtype with a (grouprows,) array field 
+	 *		for each column at its offset, given to numpy.memmap() with offset hdrsize and shape ngroups - 1, and 
+	 *		the last row group is the same with the rows and offsets scaled. See ReadRptBin.txt.
+	 *
+	 *		INPUT
+	 *			struct RptBin *Rpt
+	 *			const char *FilePath - The binary report file
+	 *
+	 *		OUTPUT
+	 *			struct RptBin *Rpt - The header, column names, report header text and the columns 
+	 *
+	 *			Returns
+	 *				RTN_READRPTBINOK
+	 *				RTN_ERRCANTOPENRPTBIN
+	 *				RTN_ERRREADRPTBIN
+	 *				RTN_ERRALLOCATERPTBIN
+	 *
+	 *		SUBROUTINES
+	 *			FreeRptBin()
+	 *			NullRptBin()
+	 *
+	 */
+
+	FILE *fp;
+
+	char *group;		// Row group buffer
+	char *s;
+
+	long long g;
+	long long n;		// Rows in the row group
+	long long r0;		// First row of the row group
+	long long rows;		// Rows stored in the row group
+	long long offset;	// Offset of the column in the row group
+
+	size_t size;		// Size of the row group
+
+	unsigned int i;
+	int retval;
+
+	NullRptBin(Rpt);
+
+	fp = fopen(FilePath, "rb");
+	if(fp == NULL) {
+		return RTN_ERRCANTOPENRPTBIN;
+	};
+
+	if(fread(&Rpt->hdr, sizeof(struct RptBinHeader), 1, fp) != 1) {
+		fclose(fp);
+		return RTN_ERRREADRPTBIN;
+	};
+
+	// A file from another machine, another version or that was not completed is not read.
+	if((memcmp(Rpt->hdr.magic, RPTBINMAGIC, sizeof(RPTBINMAGIC)) != 0) || (Rpt->hdr.byteorder != RPTBINBYTEORDER) ||
+		(Rpt->hdr.version != RPTBINVERSION) || (Rpt->hdr.ncols == 0) || (Rpt->hdr.grouprows == 0) || 
+		(Rpt->hdr.grouprows%2 != 0) || (Rpt->hdr.nrows > Rpt->hdr.ngroups*Rpt->hdr.grouprows) || 
+		(Rpt->hdr.nrows <= (Rpt->hdr.ngroups - 1)*Rpt->hdr.grouprows)) {
+		fclose(fp);
+		return RTN_ERRREADRPTBIN;
+	};
+
+	Rpt->col = (struct RptBinColumn *)malloc(Rpt->hdr.ncols*sizeof(struct RptBinColumn));
+	Rpt->text = (char *)malloc(Rpt->hdr.textsize + 1);
+	Rpt->names = (char *)malloc(Rpt->hdr.namesize + 1);
+	Rpt->name = (char **)calloc(Rpt->hdr.ncols, sizeof(char *));
+	Rpt->data = (void **)calloc(Rpt->hdr.ncols, sizeof(void *));
+	group = (char *)malloc(Rpt->hdr.groupsize);
+	if((Rpt->col == NULL) || (Rpt->text == NULL) || (Rpt->names == NULL) || (Rpt->name == NULL) || 
+		(Rpt->data == NULL) || (group == NULL)) {
+		free(group);
+		fclose(fp);
+		FreeRptBin(Rpt);
+		return RTN_ERRALLOCATERPTBIN;
+	};
+
+	retval = RTN_READRPTBINOK;
+
+	// Columns
+	if(fread(Rpt->col, sizeof(struct RptBinColumn), Rpt->hdr.ncols, fp) != Rpt->hdr.ncols) {
+		retval = RTN_ERRREADRPTBIN;
+	};
+
+	// Report header text
+	if((retval == RTN_READRPTBINOK) && ((fseek(fp, Rpt->hdr.textoffset, SEEK_SET) != 0) || 
+		(fread(Rpt->text, 1, Rpt->hdr.textsize, fp) != Rpt->hdr.textsize))) {
+		retval = RTN_ERRREADRPTBIN;
+	};
+	Rpt->text[Rpt->hdr.textsize] = '\0';
+
+	// Column names, which are the RFC 4180 header line
+	if((retval == RTN_READRPTBINOK) && ((fseek(fp, Rpt->hdr.nameoffset, SEEK_SET) != 0) || 
+		(fread(Rpt->names, 1, Rpt->hdr.namesize, fp) != Rpt->hdr.namesize))) {
+		retval = RTN_ERRREADRPTBIN;
+	};
+	Rpt->names[Rpt->hdr.namesize] = '\0';
+	s = Rpt->names;
+	for(i=0; (i<Rpt->hdr.ncols) && (retval == RTN_READRPTBINOK); i++) {
+		Rpt->name[i] = s;
+		s += strcspn(s, ",\r\n");
+		if(*s == '\0') break;
+		*s++ = '\0';
+	};
+	if(i < Rpt->hdr.ncols - 1) {
+		retval = RTN_ERRREADRPTBIN;
+	};
+
+	// Columns
+	for(i=0; (i<Rpt->hdr.ncols) && (retval == RTN_READRPTBINOK); i++) {
+		if((Rpt->col[i].size <= 0) || (Rpt->col[i].offset + Rpt->col[i].size*(long long)Rpt->hdr.grouprows > Rpt->hdr.groupsize)) {
+			retval = RTN_ERRREADRPTBIN;
+			break;
+		};
+		Rpt->data[i] = malloc((size_t)(Rpt->hdr.nrows > 0 ? Rpt->hdr.nrows : 1)*Rpt->col[i].size);
+		if(Rpt->data[i] == NULL) {
+			retval = RTN_ERRALLOCATERPTBIN;
+		};
+	};
+
+	// Row groups
+	if((retval == RTN_READRPTBINOK) && (fseek(fp, Rpt->hdr.hdrsize, SEEK_SET) != 0)) {
+		retval = RTN_ERRREADRPTBIN;
+	};
+	// The last row group holds n rows rounded up to an even number and is scaled to that size.
+	for(g=0, r0=0; (r0<Rpt->hdr.nrows) && (retval == RTN_READRPTBINOK); g++, r0+=Rpt->hdr.grouprows) {
+		n = Rpt->hdr.nrows - r0;
+		if(n > Rpt->hdr.grouprows) n = Rpt->hdr.grouprows;
+		rows = n + n%2;
+		size = (size_t)(Rpt->hdr.groupsize/Rpt->hdr.grouprows*rows);
+		if(fread(group, 1, size, fp) != size) {
+			retval = RTN_ERRREADRPTBIN;
+			break;
+		};
+		for(i=0; i<Rpt->hdr.ncols; i++) {
+			offset = Rpt->col[i].offset/Rpt->hdr.grouprows*rows;
+			memcpy((char *)Rpt->data[i] + r0*Rpt->col[i].size, group + offset, (size_t)(n*Rpt->col[i].size));
+		};
+	};
+
+	free(group);
+	fclose(fp);
+
+	if(retval != RTN_READRPTBINOK) {
+		FreeRptBin(Rpt);
+	};
+
+	return retval;
+
+};
+
+int FindRptBinColumn(struct RptBin *Rpt, const char *name) {
+
+	/*
+	 * FindRptBinColumn() - Returns the index of the column with the name, as in the RFC 4180 header, or -1.
+	 */
+
+	unsigned int i;
+
+	for(i=0; i<Rpt->hdr.ncols; i++) {
+		if((Rpt->name[i] != NULL) && (strcmp(Rpt->name[i], name) == 0)) {
+			return (int)i;
+		};
+	};
+
+	return -1;
+
+};
+
+void FreeRptBin(struct RptBin *Rpt) {
+
+	/*
+	 * FreeRptBin() - Frees the memory allocated by ReadRptBin().
+	 */
+
+	unsigned int i;
+
+	if(Rpt->data != NULL) {
+		for(i=0; i<Rpt->hdr.ncols; i++) {
+			free(Rpt->data[i]);
+		};
+	};
+	free(Rpt->data);
+	free(Rpt->name);
+	free(Rpt->names);
+	free(Rpt->text);
+	free(Rpt->col);
+
+	NullRptBin(Rpt);
+
+	return;
+
+};
+
+void NullRptBin(struct RptBin *Rpt) {
+
+	/*
+	 * NullRptBin() - Clears the structure so that FreeRptBin() can be called on it.
+	 */
+
+	memset(Rpt, 0, sizeof(struct RptBin));
+
+	return;
+
+};
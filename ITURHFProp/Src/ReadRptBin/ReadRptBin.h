@@ -0,0 +1,73 @@
+// ReadRptBin.h - Reads the binary columnar report files that ITURHFProp writes with the -b option.
+// The layout of the file is the same as in ITURHFProp.h.
+
+// Binary report file ****************************************************************************
+// The -b option writes the report as a binary columnar file rather than text. The file has the same
+// columns as the RFC 4180 CSV file for the RptFileFormat. It is
+//		struct RptBinHeader
+//		struct RptBinColumn for each column
+//		The report header, with the input configuration, as text (textoffset, textsize)
+//		The RFC 4180 header line, which is the comma separated column names (nameoffset, namesize)
+//		Zero fill to hdrsize
+//		The row groups
+// Each row group holds grouprows rows. The values of each column are together in the row group at the
+// offset of the column, so a row group is a record of fixed size groupsize with an array for each
+// column. The last row group is shorter. It holds lastrows = nrows - (ngroups - 1)*grouprows rows, 
+// rounded up to an even number with a row of zeros so that the doubles stay aligned, and everything in 
+// it is lastrows/grouprows the size, the offset of each column included. Everything is in native byte 
+// order. The month and hour are 1 based as in the text. The columns of the lowest order F2 and E modes
+// and the dominant mode hold n0_F2, n0_E and DMidx from struct PathData.
+#define RPTBINMAGIC			"P533RPT"	// 7 characters and the null fill magic[8]
+#define RPTBINVERSION		2			// 2 has the short last row group
+#define RPTBINBYTEORDER		0x01020304	// Written natively so a file from a machine with a different byte order is detected
+#define RPTBINGROUPROWS		4096		// Rows in a row group
+#define RPTBINALIGN			64			// The row groups start on a multiple of this
+
+// Column types
+#define RPTBIN_DOUBLE		0			// 8 byte double
+#define RPTBIN_INT			1			// 4 byte int
+
+struct RptBinHeader {
+	char magic[8];
+	unsigned int byteorder;
+	unsigned int version;
+	unsigned int hdrsize;		// Offset of the first row group
+	unsigned int ncols;			// Number of columns
+	unsigned int grouprows;		// Rows in a row group
+	unsigned int groupsize;		// Size of a row group (bytes)
+	long long nrows;			// Number of rows
+	long long ngroups;			// Number of row groups
+	long long format;			// RptFileFormat
+	unsigned int textoffset;	// Report header
+	unsigned int textsize;
+	unsigned int nameoffset;	// Column names
+	unsigned int namesize;
+};
+
+struct RptBinColumn {
+	int type;					// RPTBIN_DOUBLE or RPTBIN_INT
+	int size;					// Size of a value (bytes)
+	long long offset;			// Offset of the values from the start of the row group
+};
+// End binary report file ************************************************************************
+
+// Return codes
+#define RTN_READRPTBINOK		0
+#define RTN_ERRCANTOPENRPTBIN	1		// The file can't be found or read
+#define RTN_ERRREADRPTBIN		2		// The file is not a binary report or is incomplete
+#define RTN_ERRALLOCATERPTBIN	3
+
+struct RptBin {
+	struct RptBinHeader hdr;
+	struct RptBinColumn *col;	// Type and offset of each column
+	char *text;					// Report header, null terminated
+	char **name;				// Name of each column
+	void **data;				// nrows values of each column, double * or int * by col[].type
+	char *names;				// Storage of the names
+};
+
+// ReadRptBin.c prototypes
+int ReadRptBin(struct RptBin *Rpt, const char *FilePath);
+int FindRptBinColumn(struct RptBin *Rpt, const char *name);
+void FreeRptBin(struct RptBin *Rpt);
+void NullRptBin(struct RptBin *Rpt);
@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local include
+#include "ReadRptBin.h"
+// End local include 
+ 
+int main(int argc, char *argv[]) {
+
+		struct RptBin Rpt;
+
+		double *snr;
+
+		long long n;
+		unsigned int i;
+		int col;
+
+		if(argc < 2) {
+			printf("ReadRptBinExample [Binary Report File]\n");
+			return 1;
+		};
+
+		if(ReadRptBin(&Rpt, argv[1]) != RTN_READRPTBINOK) {
+			printf("ReadRptBinExample: Error Can't read %s\n", argv[1]);
+			return 1;
+		};
+
+		printf("%lld rows in %lld row groups\n", Rpt.hdr.nrows, Rpt.hdr.ngroups);
+		for(i=0; i<Rpt.hdr.ncols; i++) {
+			printf("%3d %-10s %s\n", i, Rpt.name[i], (Rpt.col[i].type == RPTBIN_DOUBLE) ? "double" : "int");
+		};
+
+		// Do something with this wonderful data.
+		col = FindRptBinColumn(&Rpt, "SNR");
+		if((col >= 0) && (Rpt.hdr.nrows > 0)) {
+			snr = (double *)Rpt.data[col];
+			for(n=0; n<Rpt.hdr.nrows && n<5; n++) {
+				printf("SNR[%lld] = %.2lf\n", n, snr[n]);
+			};
+		};
+
+		FreeRptBin(&Rpt);
+
+		return 0;
+
+};
@@ -7,6 +7,10 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 //#include <unistd.h>
+#if __linux__ || __APPLE__
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 // Local includes
 #include "Common.h"
@@ -14,6 +18,40 @@
 #include "ITURNoise.h"
 // End Local includes
 
+// Local globals
+// The routines of the P372 DLL that ITURNoise uses. They are declared in Noise.h.
+#ifdef _WIN32
+	HINSTANCE hLib;
+	cP372Info dllP372Version;
+	cP372Info dllP372CompileTime;
+	iNoise dllNoise;
+	iNoiseMemory dllAllocateNoiseMemory;
+	iNoiseMemory dllFreeNoiseMemory;
+	iReadFamDud dllReadFamDud;
+	vInitializeNoise dllInitializeNoise;
+	vAtmosphericNoise dllAtmosphericNoise;
+	vAtmosphericNoise_LT dllAtmosphericNoise_LT;
+	iMakeNoise dllMakeNoise;
+	iMakeNoiseOpen dllMakeNoiseOpen;
+	iMakeNoiseBatch dllMakeNoiseBatch;
+	vMakeNoiseClose dllMakeNoiseClose;
+#elif __linux__ || __APPLE__
+	void* hLib;
+	char* (*dllP372Version)();
+	char* (*dllP372CompileTime)();
+	int(*dllNoise)(struct NoiseParams*, int, double, double, double);
+	int(*dllAllocateNoiseMemory)(struct NoiseParams*);
+	int(*dllFreeNoiseMemory)(struct NoiseParams*);
+	int(*dllReadFamDud)(struct NoiseParams*, const char*, int);
+	void(*dllInitializeNoise)(struct NoiseParams*);
+	void(*dllAtmosphericNoise_LT)(struct NoiseParams*, struct FamStats*, int, double, double, double);
+	int(*dllMakeNoise)(int, int, double, double, double, double, char*, double*, int);
+	int(*dllMakeNoiseOpen)(int, const char*, struct NoiseParams**);
+	int(*dllMakeNoiseBatch)(struct NoiseParams*, int, int*, double*, double*, double*, double*, double*);
+	void(*dllMakeNoiseClose)(struct NoiseParams*);
+#endif
+// End Local globals
+
 #define PRINTALL 100
 #define PRINTCSV 101
 
@@ -21,7 +59,14 @@
 void PrintCSVLine(int month, int hour, double freq, double rlat, double rlng, double* out);
 void PrintCSVHeader(const char* P372ver, const char* P372compt);
 void PrintUsage();
-int RunAtmosNoiseMonths(char* datafilepath);
+int RunAtmosNoiseMonths(char* datafilepath, int nthreads, int format);
+void RunFigureJobs(struct WorkThread* wt);
+void FreeFigureJobs(struct FigureJob* job, int njobs);
+#ifdef _WIN32
+DWORD WINAPI WorkThreadProc(LPVOID arg);
+#elif __linux__ || __APPLE__
+void* WorkThreadProc(void* arg);
+#endif
 void FindV_d(double freq, double c[5], double d[5], double* V_d, double* sigma_V_d);
 // End Local Prototypes
 
@@ -52,6 +97,13 @@ int main(int argc, char* argv[]) {
 			OUTPUT
 				The output is printed to stdout depending on the print flag
 
+			Given only the data file path, optionally followed by -nc and -t#, the data for the
+			P.372 atmospheric noise Figures is generated instead, see RunAtmosNoiseMonths()
+
+			Given -map as the first argument a noise map is made, see RunNoiseMap()
+
+			Given -check as the first argument the noise is checked against a reference file, see RunNoiseCheck()
+
 			Example: ITURNoise 1 14 1.0 40.0 165.0 0 "G:\\User\\Data"
 							   Calculation made for January 14th hour (UTC)
 							   at 40 degrees North and 165 degrees East
@@ -119,20 +171,55 @@ int main(int argc, char* argv[]) {
 	const char* P372ver;
 	const char* P372compt;
 
+	int figformat = FIGURECSV;
+	int nthreads = 0;
+
 	struct stat sb;
 
-	if (argc == 2) {
+	if ((argc > 1) && (strcmp(argv[1], "-map") == 0)) {
+
+		// Then the user wants the noise over a grid of locations
+		return RunNoiseMap(argc, argv);
+
+	}; // -map
+
+	if ((argc > 1) && (strcmp(argv[1], "-check") == 0)) {
+
+		// Then the user wants to compare the noise with that of another P372 DLL
+		return RunNoiseCheck(argc, argv);
+
+	}; // -check
+
+	if ((argc >= 2) && (argc <= 4)) {
 
 		// Then the user wants to run all the tables necessary to create the
 		// Atmospheric noise Figures in Recommendation P.372-14 
-		// Assume that the only argument given is the path to the data files
-		sprintf(&datafilepath[0], "%s\\", argv[1]);
+		// The first argument is the path to the data files which may be followed by options
+		sprintf(&datafilepath[0], "%s" DIRSEP, argv[1]);
 
-		RunAtmosNoiseMonths(&datafilepath[0]);
+		for (int i = 2; i < argc; i++) {
+			if (strcmp(argv[i], "-nc") == 0) {
+				figformat = FIGURENETCDF;
+			}
+			else if (strncmp(argv[i], "-t", 2) == 0) {
+				nthreads = atoi(&argv[i][2]);
+			}
+			else {
+				printf("ITURNoise: ERROR: Unknown option %s\n", argv[i]);
+				printf("\n");
+				PrintUsage();
+				return RTN_ERRCOMMANDLINEARGS;
+			};
+		};
+
+		retval = RunAtmosNoiseMonths(&datafilepath[0], nthreads, figformat);
+		if (retval != RTN_ATMOSFILESOK) {
+			return retval;
+		};
 
 		return RTN_ITURNOISEOK;
 
-	}; // argc == 2
+	}; // argc == 2 to 4
 
 	// Are there enough command line arguments to proceed?
 	if (argc > 6) {
@@ -175,7 +262,7 @@ int main(int argc, char* argv[]) {
 
 		mmnoise = atof(argv[6]); // 
 
-		sprintf(&datafilepath[0], "%s\\", argv[7]);
+		sprintf(&datafilepath[0], "%s" DIRSEP, argv[7]);
 		if (stat(datafilepath, &sb)) { // Check to see if the directory exists
 			printf("ITURNoise: Error: Data file path %s does not exist\n", datafilepath);
 			return RTN_ERRBADDATAFILEPATH;
@@ -231,7 +318,6 @@ int main(int argc, char* argv[]) {
 			dllP372CompileTime = (cP372Info)GetProcAddress((HMODULE)hLib, "P372CompileTime");
 			dllMakeNoise = (iMakeNoise)GetProcAddress((HMODULE)hLib, "__MakeNoise@52");
 #elif __linux__ || __APPLE__
-			void* hLib;
 			hLib = dlopen("libp372.so", RTLD_NOW);
 			if (!hLib) {
 				printf("Couldn't load libp372.so, exiting.\n");
@@ -245,6 +331,7 @@ int main(int argc, char* argv[]) {
 			dllFreeNoiseMemory = dlsym(hLib, "FreeNoiseMemory");
 			dllInitializeNoise = dlsym(hLib, "InitializeNoise");
 			dllReadFamDud = dlsym(hLib, "ReadFamDud");
+			dllMakeNoise = dlsym(hLib, "MakeNoise");
 #endif	
 	
 			// Load the version and compile time of the P372.DLL
@@ -270,25 +357,46 @@ int main(int argc, char* argv[]) {
 		return RTN_ERRCOMMANDLINEARGS;
 	};
 
+#ifdef _WIN32
 	FreeLibrary(hLib);
+#elif __linux__ || __APPLE__
+	dlclose(hLib);
+#endif
  
 return retval;
 
 };
 
-int RunAtmosNoiseMonths(char * datafilepath) {
+int RunAtmosNoiseMonths(char * datafilepath, int nthreads, int format) {
 
 	/*
 		RunMonths - Outputs the files necessary to parse to create Recommendation 
 					P.372-14 Figures of atmospheric noise.
 
+					The a) figure maps are calculated across threads, one month and
+					local time hour at a time. The b) and c) figure data are small and
+					are calculated afterwards in this thread.
+
 			INPUT
 				char * datafilepath Pointer to the CCIR data files 
+				int nthreads		Number of threads for the a) figure maps (0 for one per processor)
+				int format			FIGURECSV or FIGURENETCDF
 
 			OUTPUT
-				12 P.372-14 Atmospheric Noice a) Figure Data Files
-				12 P.372-14 Atmospheric Noice b) Figure Data Files
-				12 P.372-14 Atmospheric Noice c) Figure Data Files
+				FIGURECSV
+				24 P.372-14 Atmospheric Noice a) Figure Data Files
+				24 P.372-14 Atmospheric Noice b) Figure Data Files
+				24 P.372-14 Atmospheric Noice c) Figure Data Files
+				FIGURENETCDF
+				.\P372_figures\P372_figures.nc with all the a), b) and c) Figure data
+
+			SUBROUTINES
+				ThreadCount()
+				RunThreads()
+				RunFigureJobs()
+				FreeFigureJobs()
+				FindV_d()
+				WriteNetCDF()
 
 		CAUTION: This routine relies on the code in Noise.c and specifically the 
 		subroutine AtmosphericNoise(). Any modifications to AtmosphericNoise()
@@ -334,25 +442,27 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 	dllAllocateNoiseMemory = dlsym(hLib, "AllocateNoiseMemory");
 	dllFreeNoiseMemory = dlsym(hLib, "FreeNoiseMemory");
 	dllInitializeNoise = dlsym(hLib, "InitializeNoise");
+	dllAtmosphericNoise_LT = dlsym(hLib, "AtmosphericNoise_LT");
 #endif
 
 	FILE* fp = NULL;
 	FILE* fp_V_d = NULL;
 	FILE* fp_sigma_V_d = NULL;
 
-	int i;
+	int i, j;
 	int dummy = 0;
 	int s, tb; // s = season and tb = timeblock counter for reading V_d and sigma_V_d data 
 	int retval;
-	int fn = 41; // Number of elements in the f_log array below
+	int fn = NFIGFREQ; // Number of elements in the f_log array below
+	int njobs = NFIGMONTHS * NFIGTIMEBLOCKS; // One a) figure map for each month and hour
 
 	const char* P372ver;
 	const char* P372compt;
 
 	struct NoiseParams noiseP;
 	struct FamStats FamS;
+	struct FigureJob* job;
 
-	double freq;
 	double rlat, rlng;
 	double V_d, sigma_V_d;
 
@@ -370,49 +480,72 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 
 	// Variables specific to the code fragment from AtmosphericNoise() 
 	// for the b) figure data generation
-	double pz, px, cz;
+	double pz, px;
+	double cz = 0.0;	// Set for k = 0 and used once k = 1
 	double u[2];
 	double Fam[11]; // Output array for b) figure data generation
 	double Fam1MHz;
 	// End Variables for code fragment from AtmosphericNoise() 
 
+	// Figure data kept for the NetCDF file
+	float* FaA_a;											// a) FaA by month, hour, latitude and longitude
+	float Fam_b[NFIGMONTHS][NFIGTIMEBLOCKS][NFIGFREQ][NFIGFAM1MHZ];	// b) Fam by month, hour, frequency and Fam at 1 MHz
+	float Stats_c[8][NFIGMONTHS][NFIGTIMEBLOCKS][NFIGFREQ];	// c) statistics by month, hour and frequency
+	int months[NFIGMONTHS];
+	int hours[NFIGTIMEBLOCKS];
+	float lats[NFIGLAT];
+	float lngs[NFIGLNG];
+	float fams[NFIGFAM1MHZ];
+
 	struct tm* ntime;
 	time_t tm;
 
 	char ntimestr[64];
+	char created[64];
 
-	char outputfilename[256];
+	char outputfilename[300];	// A directory below and the name of a file
 	char acsvfilepath[256];
 	char bcsvfilepath[256];
 	char ccsvfilepath[256];
+	char figfilepath[256];
 	char V_dfilepath[256];
 	char sigma_V_dfilepath[256];
-	char command[256];
+	char command[270];
 
 	struct stat st = { 0 };
 	
 	// Open output file directories if necessary
 	// The file structure for output files is static
-	sprintf(acsvfilepath, "%s", ".\\P372_figures\\a\\csv\\");
-	sprintf(bcsvfilepath, "%s", ".\\P372_figures\\b\\csv\\");
-	sprintf(ccsvfilepath, "%s", ".\\P372_figures\\c\\csv\\");
-
-	// Check to see if the A csv directory exists
-	if (stat(acsvfilepath, &st) == -1) {
-		sprintf(command, "mkdir %s", acsvfilepath);
-		system(command);
-	};
+	sprintf(acsvfilepath, "%s", "." DIRSEP "P372_figures" DIRSEP "a" DIRSEP "csv" DIRSEP);
+	sprintf(bcsvfilepath, "%s", "." DIRSEP "P372_figures" DIRSEP "b" DIRSEP "csv" DIRSEP);
+	sprintf(ccsvfilepath, "%s", "." DIRSEP "P372_figures" DIRSEP "c" DIRSEP "csv" DIRSEP);
+	sprintf(figfilepath, "%s", "." DIRSEP "P372_figures" DIRSEP);
+
+	if (format == FIGURECSV) {
+		// Check to see if the A csv directory exists
+		if (stat(acsvfilepath, &st) == -1) {
+			snprintf(command, sizeof(command), MKDIR " %s", acsvfilepath);
+			system(command);
+		};
 
-	// Check to see if the B csv directory exists
-	if (stat(bcsvfilepath, &st) == -1) {
-		sprintf(command, "mkdir %s", bcsvfilepath);
-		system(command);
-	};
+		// Check to see if the B csv directory exists
+		if (stat(bcsvfilepath, &st) == -1) {
+			snprintf(command, sizeof(command), MKDIR " %s", bcsvfilepath);
+			system(command);
+		};
 
-	// Check to see if the C csv directory exists
-	if (stat(ccsvfilepath, &st) == -1) {
-		sprintf(command, "mkdir %s", ccsvfilepath);
-		system(command);
+		// Check to see if the C csv directory exists
+		if (stat(ccsvfilepath, &st) == -1) {
+			snprintf(command, sizeof(command), MKDIR " %s", ccsvfilepath);
+			system(command);
+		};
+	}
+	else {
+		// Check to see if the figure directory exists
+		if (stat(figfilepath, &st) == -1) {
+			snprintf(command, sizeof(command), MKDIR " %s", figfilepath);
+			system(command);
+		};
 	};
 
 	// End opening output file directories
@@ -423,14 +556,14 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 	// files. They have been extracted from NTIA Report 85-173 which contains 
 	// the Behm verified CCIR coefficient data that is used throughout in 
 	// ITURHFProp(). 
-	sprintf(V_dfilepath, "%s\\%s", datafilepath, "V_d.txt");
+	sprintf(V_dfilepath, "%s%s", datafilepath, "V_d.txt");
 	fp_V_d = fopen(V_dfilepath, "r");
 	if (fp_V_d == NULL) {
 		printf("ITURNoise: Error: Can't open input file %s (%s)\n", V_dfilepath, strerror(errno));
 		return RTN_ERRV_DCANTOPENFILE;
 	};
 
-	sprintf(sigma_V_dfilepath, "%s\\%s", datafilepath, "sigma_V_d.txt");
+	sprintf(sigma_V_dfilepath, "%s%s", datafilepath, "sigma_V_d.txt");
 	fp_sigma_V_d = fopen(sigma_V_dfilepath, "r");
 	if (fp_sigma_V_d == NULL) {
 		printf("ITURNoise: Error: Can't open input file %s (%s)\n", sigma_V_dfilepath, strerror(errno));
@@ -441,8 +574,8 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 	s = 0;
 	while (fscanf(fp_V_d, "%[^\n] ", line) != EOF) {
 		
-		int retval = sscanf(line, "%d %d %s %s %s %s %s",
-			&dummy, &dummy, &strl[4], &strl[3], &strl[2], &strl[1], &strl[0]);
+		sscanf(line, "%d %d %s %s %s %s %s",
+			&dummy, &dummy, strl[4], strl[3], strl[2], strl[1], strl[0]);
 
 		for (i = 0; i < 5; i++) {
 			c[s][tb][i] = atof(strl[i]);
@@ -459,8 +592,8 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 	s = 0;
 	while (fscanf(fp_sigma_V_d, "%[^\n] ", line) != EOF) {
 		
-		int retval = sscanf(line, "%d %d %s %s %s %s %s",
-			&dummy, &dummy, &strl[4], &strl[3], &strl[2], &strl[1], &strl[0]);
+		sscanf(line, "%d %d %s %s %s %s %s",
+			&dummy, &dummy, strl[4], strl[3], strl[2], strl[1], strl[0]);
 
 		for (i = 0; i < 5; i++) {
 			d[s][tb][i] = atof(strl[i]);
@@ -506,6 +639,9 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 	printf("************************************************************\n");
 	printf("\nBegin Data Generation for a) Figures\n");
 
+	// Keep the time stamp for the NetCDF file
+	strcpy(created, ntimestr);
+
 	// Make a filename compatible string from the time stamp
 	// to be used in the loops below
 	sprintf(ntimestr, "%0d%0d%0dd-%02d%02d%02dt",
@@ -514,58 +650,71 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 
 	// Initialize variables
 	noiseP.ManMadeNoise = RURAL;
-	freq = 1.0;
 	
 	/*********************************************************************
 						Generate a) Figure Data
        Expected values of atmospheric noise, Fam (dB above kT_0B at 1MHz)
     **********************************************************************/
 	
-	for (int m = 0; m < 12; m+=3) {
+	// Each month and hour is a job with its own coefficients so the threads share nothing.
+	job = (struct FigureJob*) calloc(njobs, sizeof(struct FigureJob));
+	FaA_a = (float*) malloc((size_t)njobs * NFIGLAT * NFIGLNG * sizeof(float));
+	if ((job == NULL) || (FaA_a == NULL)) {
+		free(job);
+		free(FaA_a);
+		dllFreeNoiseMemory(&noiseP);
+		return RTN_ERRALLOCATENOISE;
+	};
+
+	for (j = 0; j < njobs; j++) {
+		job[j].month = (j / NFIGTIMEBLOCKS) * 3;
+		job[j].hour = (j % NFIGTIMEBLOCKS) * 4; // hour local time
+		job[j].format = format;
+		job[j].FaA = FaA_a + (size_t)j * NFIGLAT * NFIGLNG;
+		snprintf(job[j].outputfilename, sizeof(job[j].outputfilename), "%sa_%0dm%0dh.csv", acsvfilepath, job[j].month + 1, job[j].hour);
+
+		retval = dllAllocateNoiseMemory(&job[j].noiseP);
+		if (retval != RTN_ALLOCATEP372OK) {
+			retval = RTN_ERRALLOCATENOISE;
+			break;
+		};
+
+		dllInitializeNoise(&job[j].noiseP);
+		job[j].noiseP.ManMadeNoise = RURAL;
 
 		// Read in the atmospheric coefficients for the particular month.
 		// The subroutine dllReadFamDud() is from P372.dll
-		retval = dllReadFamDud(&noiseP, datafilepath, m);
+		retval = dllReadFamDud(&job[j].noiseP, datafilepath, job[j].month);
 		if (retval != RTN_READFAMDUDOK) {
-			return retval;
+			break;
 		};
+	};
 			
-		for (int h = 0; h <= 23; h+=4) { // hour local time
-	
-			sprintf(outputfilename, "%sa_%0dm%0dh.csv", acsvfilepath, m+1, h);
-			fp = fopen(outputfilename, "w");
-			if (fp == NULL) {
-				printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfilename, strerror(errno));
-				return RTN_ERRCANTOPENFILE;
-			};
-			
-			// The file is open proceed
-			// User feedback
-			printf("Writing file %s\n", outputfilename);
-
-			// Write the column headings to the file
-			fprintf(fp, "month,hour,freq,latitude,longitude,FaA\n");
-			
-			for (int ilat = -90; ilat <= 90; ilat++) { //
-				rlat = ilat * D2R;
-				for (int ilng = -180; ilng <= 180; ilng++) { //
-					rlng = ilng * D2R;
-					
-					// Call the AtmosphericNoise_LT() from the P372.dll
-					// Which calculates the atmospheric noise and returns the full statistics. 
-					dllAtmosphericNoise_LT(&noiseP, &FamS, h, rlng, rlat, freq);
-										
-					// Write the data out to the file
-					fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f\n", 
-						m + 1, h, freq, rlat * R2D, rlng * R2D, FamS.FA);
-
-				}; //  End Longitude loop
-			}; // End Latitude loop
+	if (j == njobs) {
+		nthreads = ThreadCount(nthreads, njobs);
 
-			fclose(fp);
+		// User feedback
+		printf("ITURNoise: Calculating %d maps on %d threads\n", njobs, nthreads);
 
-		}; // End hour for
-	}; // End month for
+		if (RunThreads(RunFigureJobs, job, njobs, nthreads) != TRUE) {
+			retval = RTN_ERRALLOCATENOISE;
+		}
+		else {
+			// Return the first error from the jobs
+			for (j = 0; j < njobs; j++) {
+				retval = job[j].retval;
+				if (retval != RTN_ATMOSFILESOK) break;
+			};
+		};
+	};
+	
+	FreeFigureJobs(job, njobs);
+			
+	if (retval != RTN_ATMOSFILESOK) {
+		free(FaA_a);
+		dllFreeNoiseMemory(&noiseP);
+		return retval;
+	};
 	
 	/********************* End Generate a) Figure Data *******************/
 	
@@ -585,28 +734,40 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 
 	for (int m = 0; m < 12; m += 3) {
 
+		// Set the season index, s, for the figure data arrays
+		s = m / 3;
+
 		// Read in the atmospheric coefficients for the particular month.
 		// The subroutine dllReadFamDud() is from P372.dll
 		retval = dllReadFamDud(&noiseP, datafilepath, m);
 		if (retval != RTN_READFAMDUDOK) {
+			free(FaA_a);
+			dllFreeNoiseMemory(&noiseP);
 			return retval;
 		};
 
 		for (int h = 0; h <= 23; h += 4) { // hour local time
 
-			sprintf(outputfilename, "%sb_%0dm%0dh.csv", bcsvfilepath, m + 1, h);
-			fp = fopen(outputfilename, "w");
-			if (fp == NULL) {
-				printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfilename, strerror(errno));
-				return RTN_ERRCANTOPENFILE;
-			};
+			// Set the time block index, tb, for the figure data arrays
+			tb = h / 4;
 
-			// The file is open proceed
-			// User feedback
-			printf("Writing file %s\n", outputfilename);
+			if (format == FIGURECSV) {
+				snprintf(outputfilename, sizeof(outputfilename), "%sb_%0dm%0dh.csv", bcsvfilepath, m + 1, h);
+				fp = fopen(outputfilename, "w");
+				if (fp == NULL) {
+					printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfilename, strerror(errno));
+					free(FaA_a);
+					dllFreeNoiseMemory(&noiseP);
+					return RTN_ERRCANTOPENFILE;
+				};
 
-			// Write the column headings to the file
-			fprintf(fp, "month,hour,freq,latitude,longitude,Fam5,Fam10,Fam20,Fam30,Fam40,Fam50,Fam60,Fam70,Fam80,Fam90,Fam100\n");
+				// The file is open proceed
+				// User feedback
+				printf("Writing file %s\n", outputfilename);
+
+				// Write the column headings to the file
+				fprintf(fp, "month,hour,freq,latitude,longitude,Fam5,Fam10,Fam20,Fam30,Fam40,Fam50,Fam60,Fam70,Fam80,Fam90,Fam100\n");
+			};
 
 			for (int f = 0; f < fn; f++) { //
 				for (int F1 = 0; F1 <= 10; F1++) {
@@ -658,17 +819,25 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 					Fam[F1] = cz * pz + px;
 					//*** Code from AtmosphericNoise() **********************************
 
+					Fam_b[s][tb][f][F1] = (float)Fam[F1];
+					fams[F1] = (float)Fam1MHz;
+
 				}; // End Fam1MHz loop
 
 				// Print out all Fam1MHz data for this frequency
-				fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f\n", 
-					m+1,h,f_log[f],rlat*R2D,rlng*R2D,Fam[0],Fam[1],Fam[2],Fam[3],Fam[4],Fam[5],Fam[6],Fam[7],Fam[8],Fam[9],Fam[10]);
+				if (fp != NULL) {
+					fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f\n",
+						m+1,h,f_log[f],rlat*R2D,rlng*R2D,Fam[0],Fam[1],Fam[2],Fam[3],Fam[4],Fam[5],Fam[6],Fam[7],Fam[8],Fam[9],Fam[10]);
+				};
 			
 			}; // End f loop
-		}; // End h loop
 
-		fclose(fp);
+			if (fp != NULL) {
+				fclose(fp);
+				fp = NULL;
+			};
 
+		}; // End h loop
 	}; // End m loop
 
 	// User feedback
@@ -689,6 +858,8 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 		// The subroutine dllReadFamDud() is from P372.dll
 		retval = dllReadFamDud(&noiseP, datafilepath, m);
 		if (retval != RTN_READFAMDUDOK) {
+			free(FaA_a);
+			dllFreeNoiseMemory(&noiseP);
 			return retval;
 		};
 
@@ -697,19 +868,23 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 			// Set the time block index, tb, for the c and d arrays
 			tb = h / 4;
 
-			sprintf(outputfilename, "%sc_%0dm%0dh.csv", ccsvfilepath, m + 1, h);
-			fp = fopen(outputfilename, "w");
-			if (fp == NULL) {
-				printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfilename, strerror(errno));
-				return RTN_ERRCANTOPENFILE;
-			};
+			if (format == FIGURECSV) {
+				snprintf(outputfilename, sizeof(outputfilename), "%sc_%0dm%0dh.csv", ccsvfilepath, m + 1, h);
+				fp = fopen(outputfilename, "w");
+				if (fp == NULL) {
+					printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfilename, strerror(errno));
+					free(FaA_a);
+					dllFreeNoiseMemory(&noiseP);
+					return RTN_ERRCANTOPENFILE;
+				};
 
-			// The file is open proceed
-			// User feedback
-			printf("Writing file %s\n", outputfilename);
+				// The file is open proceed
+				// User feedback
+				printf("Writing file %s\n", outputfilename);
 
-			// Write the column headings to the file
-			fprintf(fp, "month,hour,freq,latitude,longitude,FaA,DuA,DlA,sigmaFaA,sigmaDuA,sigmaDlA,V_d,sigma_V_d\n");
+				// Write the column headings to the file
+				fprintf(fp, "month,hour,freq,latitude,longitude,FaA,DuA,DlA,sigmaFaA,sigmaDuA,sigmaDlA,V_d,sigma_V_d\n");
+			};
 
 			for (int f = 0; f < fn; f++) { //
 
@@ -720,13 +895,27 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 				// Determine V_d and sigma_V_d
 				FindV_d(f_log[f], c[s][tb], d[s][tb], &V_d, &sigma_V_d);
 
+				Stats_c[0][s][tb][f] = (float)FamS.FA;
+				Stats_c[1][s][tb][f] = (float)FamS.Du;
+				Stats_c[2][s][tb][f] = (float)FamS.Dl;
+				Stats_c[3][s][tb][f] = (float)FamS.SigmaFam;
+				Stats_c[4][s][tb][f] = (float)FamS.SigmaDu;
+				Stats_c[5][s][tb][f] = (float)FamS.SigmaDl;
+				Stats_c[6][s][tb][f] = (float)V_d;
+				Stats_c[7][s][tb][f] = (float)sigma_V_d;
+
 				// Write the data out to the file
-				fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f\n", 
-					m+1, h, f_log[f], rlat* R2D, rlng* R2D, FamS.FA, FamS.Du, FamS.Dl, FamS.SigmaFam, FamS.SigmaDu, FamS.SigmaDl, V_d, sigma_V_d);
+				if (fp != NULL) {
+					fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f, %5.4f\n",
+						m+1, h, f_log[f], rlat* R2D, rlng* R2D, FamS.FA, FamS.Du, FamS.Dl, FamS.SigmaFam, FamS.SigmaDu, FamS.SigmaDl, V_d, sigma_V_d);
+				};
 
 			}; // End frequency loop
 
-			fclose(fp);
+			if (fp != NULL) {
+				fclose(fp);
+				fp = NULL;
+			};
 
 		}; // End hour for
 	}; // End month for
@@ -735,18 +924,312 @@ int RunAtmosNoiseMonths(char * datafilepath) {
 
 	fclose(fp_V_d);
 	fclose(fp_sigma_V_d);
+	dllFreeNoiseMemory(&noiseP);
 
 	// User feedback
 	printf("ITURNoise: Data for c) Figures Complete\n");
+
+	/*********************************************************************
+						   Write the NetCDF File
+	**********************************************************************/
+
+	if (format == FIGURENETCDF) {
+
+		struct NCDim dim[] = {
+			{ "month", NFIGMONTHS },
+			{ "hour", NFIGTIMEBLOCKS },
+			{ "latitude", NFIGLAT },
+			{ "longitude", NFIGLNG },
+			{ "frequency", NFIGFREQ },
+			{ "fam1mhz", NFIGFAM1MHZ }
+		};
+
+		struct NCVar var[] = {
+			{ "month", NC_INT, 1, { 0 }, NULL, months },
+			{ "hour", NC_INT, 1, { 1 }, "hours (local time)", hours },
+			{ "latitude", NC_FLOAT, 1, { 2 }, "degrees_north", lats },
+			{ "longitude", NC_FLOAT, 1, { 3 }, "degrees_east", lngs },
+			{ "frequency", NC_DOUBLE, 1, { 4 }, "MHz", f_log },
+			{ "fam1mhz", NC_FLOAT, 1, { 5 }, "dB above kT0b at 1 MHz", fams },
+			{ "a_FaA", NC_FLOAT, 4, { 0, 1, 2, 3 }, "dB above kT0b at 1 MHz", FaA_a },
+			{ "b_Fam", NC_FLOAT, 4, { 0, 1, 4, 5 }, "dB above kT0b", Fam_b },
+			{ "c_FaA", NC_FLOAT, 3, { 0, 1, 4 }, "dB above kT0b", Stats_c[0] },
+			{ "c_DuA", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[1] },
+			{ "c_DlA", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[2] },
+			{ "c_sigmaFaA", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[3] },
+			{ "c_sigmaDuA", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[4] },
+			{ "c_sigmaDlA", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[5] },
+			{ "c_V_d", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[6] },
+			{ "c_sigma_V_d", NC_FLOAT, 3, { 0, 1, 4 }, "dB", Stats_c[7] }
+		};
+
+		struct NCAtt att[] = {
+			{ "title", "Recommendation ITU-R P.372 atmospheric noise figure data" },
+			{ "P372_version", P372ver },
+			{ "P372_compile_time", P372compt },
+			{ "created", created },
+			{ "location_b_c", "Boulder, Colorado (40.015744 N, 105.27932 W)" }
+		};
+
+		// Coordinates of the figure data
+		for (i = 0; i < NFIGMONTHS; i++) months[i] = i * 3 + 1;
+		for (i = 0; i < NFIGTIMEBLOCKS; i++) hours[i] = i * 4;
+		for (i = 0; i < NFIGLAT; i++) lats[i] = (float)(i - 90);
+		for (i = 0; i < NFIGLNG; i++) lngs[i] = (float)(i - 180);
+
+		snprintf(outputfilename, sizeof(outputfilename), "%sP372_figures.nc", figfilepath);
+
+		// User feedback
+		printf("\nWriting file %s\n", outputfilename);
+
+		retval = WriteNetCDF(outputfilename, att, sizeof(att) / sizeof(att[0]), dim, sizeof(dim) / sizeof(dim[0]), var, sizeof(var) / sizeof(var[0]));
+		if (retval != RTN_WRITENETCDFOK) {
+			printf("ITURNoise: Error: Can't write output file %s\n", outputfilename);
+			free(FaA_a);
+			return retval;
+		};
+	};
+
+	free(FaA_a);
+
 	printf("\n*** End ITURNoise Data Generation ***\n");
 
+#ifdef _WIN32
 	FreeLibrary(hLib);
+#elif __linux__ || __APPLE__
+	dlclose(hLib);
+#endif
 
 	return RTN_ATMOSFILESOK;
 	   
 	 // End P372.DLL Load ************************************************
 };
 
+int RunThreads(void (*run)(struct WorkThread*), void* job, int njobs, int nthreads) {
+
+	/*
+		RunThreads - Shares jobs between threads and waits for them to finish. The jobs are
+					 dealt out in turn so every thread has about the same work. Thread t runs
+					 jobs t, t + nthreads, ... A thread that can't be started has its jobs run
+					 here instead.
+
+			INPUT
+				void (*run)(struct WorkThread*)	Runs the jobs of one thread
+				void* job						The jobs
+				int njobs						Number of jobs
+				int nthreads					Number of threads
+
+			OUTPUT
+				Whatever run() does
+
+				Returns
+					TRUE or FALSE if the memory for the threads can't be allocated
+
+			SUBROUTINES
+				WorkThreadProc()
+
+	*/
+
+	struct WorkThread* wt;
+
+	int* started;
+	int t;
+
+#ifdef _WIN32
+	HANDLE* th;
+#elif __linux__ || __APPLE__
+	pthread_t* th;
+#endif
+
+	wt = (struct WorkThread*) malloc(nthreads * sizeof(struct WorkThread));
+	started = (int*) malloc(nthreads * sizeof(int));
+	th = malloc(nthreads * sizeof(*th));
+	if ((wt == NULL) || (started == NULL) || (th == NULL)) {
+		free(wt);
+		free(started);
+		free(th);
+		return FALSE;
+	};
+
+	for (t = 0; t < nthreads; t++) {
+		wt[t].run = run;
+		wt[t].job = job;
+		wt[t].njobs = njobs;
+		wt[t].first = t;
+		wt[t].step = nthreads;
+
+		started[t] = FALSE;
+		if (nthreads > 1) {
+#ifdef _WIN32
+			th[t] = CreateThread(NULL, 0, WorkThreadProc, &wt[t], 0, NULL);
+			started[t] = (th[t] != NULL);
+#elif __linux__ || __APPLE__
+			started[t] = (pthread_create(&th[t], NULL, WorkThreadProc, &wt[t]) == 0);
+#endif
+		};
+		if (started[t] != TRUE) {
+			run(&wt[t]);
+		};
+	};
+
+	for (t = 0; t < nthreads; t++) {
+		if (started[t] == TRUE) {
+#ifdef _WIN32
+			WaitForSingleObject(th[t], INFINITE);
+			CloseHandle(th[t]);
+#elif __linux__ || __APPLE__
+			pthread_join(th[t], NULL);
+#endif
+		};
+	};
+
+	free(wt);
+	free(started);
+	free(th);
+
+	return TRUE;
+
+};
+
+#ifdef _WIN32
+DWORD WINAPI WorkThreadProc(LPVOID arg) {
+#elif __linux__ || __APPLE__
+void* WorkThreadProc(void* arg) {
+#endif
+
+	/*
+		WorkThreadProc - Thread entry point that runs the jobs of one struct WorkThread
+	*/
+
+	struct WorkThread* wt = (struct WorkThread*) arg;
+
+	wt->run(wt);
+
+	return 0;
+
+};
+
+void RunFigureJobs(struct WorkThread* wt) {
+
+	/*
+		RunFigureJobs - Calculates the a) figure maps of one thread. Each job has its own
+						coefficients and Fam cache so nothing is written that another
+						thread reads.
+
+			INPUT
+				struct WorkThread* wt	wt->job is the array of struct FigureJob
+
+			OUTPUT
+				FaA, retval and the a) CSV files of the jobs of the thread
+
+			SUBROUTINES
+				dllAtmosphericNoise_LT()
+
+	*/
+
+	FILE* fp;
+
+	struct FigureJob* job;
+	struct FamStats FamS;
+
+	double freq = 1.0;
+	double rlat, rlng;
+
+	int j;
+
+	for (j = wt->first; j < wt->njobs; j += wt->step) {
+
+		job = (struct FigureJob*) wt->job + j;
+		fp = NULL;
+
+		if (job->format == FIGURECSV) {
+			fp = fopen(job->outputfilename, "w");
+			if (fp == NULL) {
+				printf("ITURNoise: Error: Can't open output file %s (%s)\n", job->outputfilename, strerror(errno));
+				job->retval = RTN_ERRCANTOPENFILE;
+				continue;
+			};
+
+			// The file is open proceed
+			// User feedback
+			printf("Writing file %s\n", job->outputfilename);
+
+			// Write the column headings to the file
+			fprintf(fp, "month,hour,freq,latitude,longitude,FaA\n");
+		};
+
+		for (int ilat = -90; ilat <= 90; ilat++) { //
+			rlat = ilat * D2R;
+			for (int ilng = -180; ilng <= 180; ilng++) { //
+				rlng = ilng * D2R;
+
+				// Call the AtmosphericNoise_LT() from the P372.dll
+				// Which calculates the atmospheric noise and returns the full statistics.
+				dllAtmosphericNoise_LT(&job->noiseP, &FamS, job->hour, rlng, rlat, freq);
+
+				job->FaA[(ilat + 90) * NFIGLNG + (ilng + 180)] = (float)FamS.FA;
+
+				// Write the data out to the file
+				if (fp != NULL) {
+					fprintf(fp, "%d, %d, %5.4f, %5.4f, %5.4f, %5.4f\n",
+						job->month + 1, job->hour, freq, rlat * R2D, rlng * R2D, FamS.FA);
+				};
+
+			}; //  End Longitude loop
+		}; // End Latitude loop
+
+		if (fp != NULL) {
+			fclose(fp);
+		};
+
+		job->retval = RTN_ATMOSFILESOK;
+
+	}; // End job for
+
+	return;
+
+};
+
+int ThreadCount(int nthreads, int njobs) {
+
+	/*
+		ThreadCount - Returns the number of threads to use for njobs. If nthreads is not
+					  given (0) there is one thread per processor. There are never more
+					  threads than jobs.
+	*/
+
+	if (nthreads <= 0) {
+#ifdef _WIN32
+		SYSTEM_INFO si;
+		GetSystemInfo(&si);
+		nthreads = (int)si.dwNumberOfProcessors;
+#elif __linux__ || __APPLE__
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	};
+
+	return max(1, min(nthreads, njobs));
+
+};
+
+void FreeFigureJobs(struct FigureJob* job, int njobs) {
+
+	/*
+		FreeFigureJobs - Frees the coefficients of the a) figure jobs and the jobs.
+	*/
+
+	int j;
+
+	for (j = 0; j < njobs; j++) {
+		dllFreeNoiseMemory(&job[j].noiseP);
+	};
+
+	free(job);
+
+	return;
+
+};
+
 void PrintUsage() {
 
 	/*
@@ -791,6 +1274,42 @@ void PrintUsage() {
     printf("\t\tat 40 degrees North and 165 degrees East\n");
 	printf("\t\tfor 1.0 MHz print detailed output to stdout\n");
 	printf("\n");
+	printf("USEAGE: ITURNoise [data file path] [-nc] [-t#]\n");
+	printf("\t\tGenerates the data for the P.372 atmospheric noise Figures\n");
+	printf("\n");
+	printf("\tArgument 1:  data file path within double quotes without trailing back slash\n");
+	printf("\t-nc         write one NetCDF file .\\P372_figures\\P372_figures.nc [Optional]\n");
+	printf("\t            instead of the CSV files in .\\P372_figures\\a, b and c\n");
+	printf("\t-t#         number of threads, for example -t4 [Optional]\n");
+	printf("\t            the default is one thread per processor\n");
+	printf("\n");
+	printf("Example: ITURNoise \"G:\\User\\Data\" -nc\n");
+	printf("\n");
+	printf("USEAGE: ITURNoise -map [month] [hour] [frequency] [man-made noise]\n");
+	printf("\t\t[data file path] [output file] [-g#] [-r#,#,#,#] [-asc] [-t#]\n");
+	printf("\t\tCalculates the noise over a grid of locations\n");
+	printf("\n");
+	printf("\tArguments 1 to 4 are as above and the man-made noise is argument 6 above\n");
+	printf("\t-g#         grid spacing (degrees), default 1.0 [Optional]\n");
+	printf("\t-r#,#,#,#   region latmin,latmax,lngmin,lngmax (degrees) [Optional]\n");
+	printf("\t            the default is -90,90,-180,180\n");
+	printf("\t-asc        write ESRI ASCII grids [output file]_FaA.asc ... [Optional]\n");
+	printf("\t            instead of one NetCDF file\n");
+	printf("\t-t#         number of threads, default one per processor [Optional]\n");
+	printf("\n");
+	printf("Example: ITURNoise -map 1 14 1.0 2.0 \"G:\\User\\Data\" noise.nc -g0.5 -r30,60,-20,40\n");
+	printf("\t\tNoise for January 14th hour (UTC) at 1.0 MHz in a rural environment\n");
+	printf("\t\tfrom 30 to 60 degrees North and 20 degrees West to 40 degrees East\n");
+	printf("\n");
+	printf("USEAGE: ITURNoise -check [data file path] [output file] [reference file] [-e#]\n");
+	printf("\t\tWrites the noise at a fixed set of points to the output file and\n");
+	printf("\t\tcompares it with a reference file written by an earlier P372 DLL\n");
+	printf("\n");
+	printf("\t-e#         largest difference from the reference (dB), default 1e-12 [Optional]\n");
+	printf("\t            -e0 checks that the noise is bit for bit the same\n");
+	printf("\n");
+	printf("Example: ITURNoise -check \"G:\\User\\Data\" new.csv ref.csv -e1e-12\n");
+	printf("\n");
 	printf("******************************************************************************\n");
 
 	return;
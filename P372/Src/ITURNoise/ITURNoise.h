@@ -10,14 +10,109 @@
 #define RTN_ERRBADDATAFILEPATH          107 // ERROR: Data file path does not exist
 #define RTN_ERRV_DCANTOPENFILE			108 // ERROR: Input file .\P372\DATA\V_d.txt can't be opened
 #define RTN_ERRSIGMA_V_DCANTOPENFILE	109 // ERROR: Input file .\P372\DATA\sigma_V_d.txt can't be opened
+#define RTN_ERRFIGURETHREAD				110 // ERROR: Can't start a figure data thread
+#define RTN_ERRWRITENETCDF				111 // ERROR: Can't write the figure data NetCDF file
+#define RTN_ERRNOISEMAPGRID				112 // ERROR: Invalid noise map grid
+#define RTN_ERRNOISECHECK				113 // ERROR: Noise differs from the reference file
 
 // Successfull return codes 
 #define RTN_ITURNOISEOK					 90 // Normal successful exit
 #define RTN_ATMOSFILESOK                 91 // All atmospheric noise files created 
+#define RTN_WRITENETCDFOK				 92 // NetCDF file written
+#define RTN_NOISEMAPOK					 93 // Noise map files created
+#define RTN_NOISECHECKOK				 94 // Noise check file written and within the tolerance of the reference
 // End ITURNoise return codes
 
+// Separator of the directories of a path and the command that makes a directory and its parents
+#ifdef _WIN32
+#define DIRSEP		"\\"
+#define MKDIR		"mkdir"
+#else
+#define DIRSEP		"/"
+#define MKDIR		"mkdir -p"
+#endif
+
 // ITURNoise Print Flag 
 #define PRINTCSV	101 // Print just csv output line for single run
 #define PRINTCSVALL 102 // Print CSV header and line
 
+// Mode 2 figure data formats
+#define FIGURECSV		0 // 72 CSV files in .\P372_figures\a, b and c
+#define FIGURENETCDF	1 // One NetCDF classic file .\P372_figures\P372_figures.nc
+
+// Size of the Mode 2 figure data
+#define NFIGMONTHS		4	// January, April, July and October
+#define NFIGTIMEBLOCKS	6	// Local time hours 0, 4, 8, 12, 16 and 20
+#define NFIGLAT			181	// Latitudes -90 to 90 degrees by 1 degree
+#define NFIGLNG			361	// Longitudes -180 to 180 degrees by 1 degree
+#define NFIGFREQ		41	// Frequencies of the b) and c) figures
+#define NFIGFAM1MHZ		11	// Fam at 1 MHz of the b) figures
+
+// NetCDF classic external types
+#define NC_CHAR		2
+#define NC_INT		4
+#define NC_FLOAT	5
+#define NC_DOUBLE	6
+
+// One a) figure map, a month and a local time hour, that is calculated by a thread
+struct FigureJob {
+	int month;						// Month index (0 to 11)
+	int hour;						// Local time hour
+	int format;						// FIGURECSV or FIGURENETCDF
+	int retval;						// RTN_ATMOSFILESOK or an error
+	struct NoiseParams noiseP;		// Coefficients for the month, one per job as the Fam cache is written
+	float *FaA;						// NFIGLAT x NFIGLNG map of FaA
+	char outputfilename[300];		// CSV file when the format is FIGURECSV
+};
+
+// A thread and its share of the jobs for RunThreads()
+struct WorkThread {
+	void (*run)(struct WorkThread *wt);	// Runs the jobs of the thread
+	void *job;						// All the jobs
+	int njobs;
+	int first;						// Thread number and its first job
+	int step;						// Number of threads
+};
+
+// A noise map over a latitude and longitude grid that is calculated by RunNoiseMap()
+struct NoiseMap {
+	int hour;						// Hour index (0 to 23 UTC)
+	double freq;					// Frequency (MHz)
+	double mmnoise;					// Man-made noise environment or value as for MakeNoise()
+	int nlat;						// Number of latitudes
+	int nlng;						// Number of longitudes
+	double latmin;					// Latitude of the first row (degrees)
+	double lngmin;					// Longitude of the first column (degrees)
+	double inc;						// Grid spacing (degrees)
+	struct NoiseParams **handle;	// One handle from MakeNoiseOpen() for each thread
+	int *retval;					// RTN_MAKENOISEBATCHOK or an error for each thread
+	float *out;						// MNOUTVALS maps of nlat x nlng in the order of MakeNoise()
+};
+
+// NetCDF dimension, variable and global attribute descriptions for WriteNetCDF()
+struct NCDim {
+	const char *name;
+	int len;
+};
+
+struct NCVar {
+	const char *name;
+	int type;						// NC_INT, NC_FLOAT or NC_DOUBLE
+	int ndims;
+	int dimid[4];					// Indices into the dimension list, slowest varying first
+	const char *units;				// units attribute or NULL
+	const void *data;				// Values in native byte order
+};
+
+struct NCAtt {
+	const char *name;
+	const char *value;
+};
 
+// Prototypes
+void PrintUsage();
+int RunNoiseMap(int argc, char *argv[]);
+int RunNoiseCheck(int argc, char *argv[]);
+int RunThreads(void (*run)(struct WorkThread*), void *job, int njobs, int nthreads);
+int ThreadCount(int nthreads, int njobs);
+int WriteNetCDF(const char *filename, struct NCAtt *att, int natts, struct NCDim *dim, int ndims, struct NCVar *var, int nvars);
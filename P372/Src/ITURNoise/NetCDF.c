@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local includes
+#include "Common.h"
+#include "Noise.h"
+#include "ITURNoise.h"
+// End Local includes
+
+// Local Prototypes
+void NCPutInt(FILE *fp, unsigned int val);
+void NCPutName(FILE *fp, const char *name);
+int NCPutData(FILE *fp, const void *data, int type, long n);
+long NCPad(long len);
+long NCTypeSize(int type);
+long NCNameSize(const char *name);
+// End Local Prototypes
+
+// NetCDF classic header tags
+#define NC_DIMENSION	0x0A
+#define NC_VARIABLE		0x0B
+#define NC_ATTRIBUTE	0x0C
+
+int WriteNetCDF(const char *filename, struct NCAtt *att, int natts, struct NCDim *dim, int ndims, struct NCVar *var, int nvars) {
+
+	/*
+
+		WriteNetCDF - Writes fixed size variables to a NetCDF classic (CDF-1) file. The file carries
+			the names and lengths of the dimensions, the units of the variables and the global attributes
+			so it can be opened directly by NumPy based readers such as scipy.io.netcdf_file, netCDF4
+			or xarray. NetCDF classic is big endian so the values are converted as they are written.
+
+			INPUT
+				const char *filename
+				struct NCAtt *att		Global text attributes
+				int natts
+				struct NCDim *dim		Dimensions
+				int ndims
+				struct NCVar *var		Variables, each with its values in native byte order
+				int nvars
+
+			OUTPUT
+				The NetCDF file
+
+				Returns
+					RTN_WRITENETCDFOK
+					RTN_ERRWRITENETCDF
+
+			SUBROUTINES
+				NCPutInt()
+				NCPutName()
+				NCPutData()
+
+	*/
+
+	FILE *fp;
+
+	long hdrsize;		// Size of the header in bytes
+	long begin;			// Offset of the values of the next variable
+	long *vsize;		// Size of the values of each variable in bytes
+
+	int i, j;
+	int err = FALSE;
+
+	vsize = (long *) malloc(nvars * sizeof(long));
+	if (vsize == NULL) {
+		return RTN_ERRWRITENETCDF;
+	};
+
+	// Find the size of the header so that the offsets of the variables are known before it is written.
+	hdrsize = 4 + 4;								// magic and numrecs
+	hdrsize += 8;									// dim_list
+	for (i = 0; i < ndims; i++) {
+		hdrsize += NCNameSize(dim[i].name) + 4;
+	};
+	hdrsize += 8;									// gatt_list
+	for (i = 0; i < natts; i++) {
+		hdrsize += NCNameSize(att[i].name) + 8 + NCPad((long)strlen(att[i].value));
+	};
+	hdrsize += 8;									// var_list
+	for (i = 0; i < nvars; i++) {
+		hdrsize += NCNameSize(var[i].name) + 4 + 4 * var[i].ndims;
+		hdrsize += 8;								// vatt_list
+		if (var[i].units != NULL) {
+			hdrsize += NCNameSize("units") + 8 + NCPad((long)strlen(var[i].units));
+		};
+		hdrsize += 12;								// nc_type, vsize and begin
+
+		vsize[i] = NCTypeSize(var[i].type);
+		for (j = 0; j < var[i].ndims; j++) {
+			vsize[i] *= dim[var[i].dimid[j]].len;
+		};
+	};
+
+	fp = fopen(filename, "wb");
+	if (fp == NULL) {
+		free(vsize);
+		return RTN_ERRWRITENETCDF;
+	};
+
+	// Header
+	fwrite("CDF\001", 1, 4, fp);
+	NCPutInt(fp, 0);								// numrecs, there is no record dimension
+
+	if (ndims > 0) {
+		NCPutInt(fp, NC_DIMENSION);
+		NCPutInt(fp, ndims);
+		for (i = 0; i < ndims; i++) {
+			NCPutName(fp, dim[i].name);
+			NCPutInt(fp, dim[i].len);
+		};
+	}
+	else {
+		NCPutInt(fp, 0);
+		NCPutInt(fp, 0);
+	};
+
+	if (natts > 0) {
+		NCPutInt(fp, NC_ATTRIBUTE);
+		NCPutInt(fp, natts);
+		for (i = 0; i < natts; i++) {
+			NCPutName(fp, att[i].name);
+			NCPutInt(fp, NC_CHAR);
+			NCPutName(fp, att[i].value);
+		};
+	}
+	else {
+		NCPutInt(fp, 0);
+		NCPutInt(fp, 0);
+	};
+
+	NCPutInt(fp, NC_VARIABLE);
+	NCPutInt(fp, nvars);
+	begin = hdrsize;
+	for (i = 0; i < nvars; i++) {
+		NCPutName(fp, var[i].name);
+		NCPutInt(fp, var[i].ndims);
+		for (j = 0; j < var[i].ndims; j++) {
+			NCPutInt(fp, var[i].dimid[j]);
+		};
+		if (var[i].units != NULL) {
+			NCPutInt(fp, NC_ATTRIBUTE);
+			NCPutInt(fp, 1);
+			NCPutName(fp, "units");
+			NCPutInt(fp, NC_CHAR);
+			NCPutName(fp, var[i].units);
+		}
+		else {
+			NCPutInt(fp, 0);
+			NCPutInt(fp, 0);
+		};
+		NCPutInt(fp, var[i].type);
+		NCPutInt(fp, (unsigned int)vsize[i]);
+		NCPutInt(fp, (unsigned int)begin);
+		begin += vsize[i];
+	};
+
+	// The values of the variables in the order of the header
+	for (i = 0; i < nvars; i++) {
+		if (NCPutData(fp, var[i].data, var[i].type, vsize[i] / NCTypeSize(var[i].type)) != TRUE) {
+			err = TRUE;
+		};
+	};
+
+	if (ftell(fp) != begin) err = TRUE;
+	if (fclose(fp) != 0) err = TRUE;
+
+	free(vsize);
+
+	if (err == TRUE) {
+		return RTN_ERRWRITENETCDF;
+	};
+
+	return RTN_WRITENETCDFOK;
+
+};
+
+void NCPutInt(FILE *fp, unsigned int val) {
+
+	/*
+		NCPutInt - Writes a 32 bit integer big endian.
+	*/
+
+	unsigned char b[4];
+
+	b[0] = (unsigned char)(val >> 24);
+	b[1] = (unsigned char)(val >> 16);
+	b[2] = (unsigned char)(val >> 8);
+	b[3] = (unsigned char)val;
+
+	fwrite(b, 1, 4, fp);
+
+	return;
+
+};
+
+void NCPutName(FILE *fp, const char *name) {
+
+	/*
+		NCPutName - Writes the length of a string followed by the string padded with nulls to 4 bytes.
+	*/
+
+	static const char zero[4] = { 0, 0, 0, 0 };
+	long len;
+
+	len = (long)strlen(name);
+
+	NCPutInt(fp, (unsigned int)len);
+	fwrite(name, 1, len, fp);
+	fwrite(zero, 1, NCPad(len) - len, fp);
+
+	return;
+
+};
+
+int NCPutData(FILE *fp, const void *data, int type, long n) {
+
+	/*
+		NCPutData - Writes n values of a NetCDF type big endian. Returns FALSE if the write fails.
+	*/
+
+	unsigned char buf[4096];
+	const unsigned char *src;
+	unsigned int u4;
+	unsigned long long u8;
+	long size, nbuf, i;
+	int k;
+
+	size = NCTypeSize(type);
+	src = (const unsigned char *)data;
+
+	while (n > 0) {
+		nbuf = min(n, (long)sizeof(buf) / size);
+		for (i = 0; i < nbuf; i++) {
+			if (size == 4) {
+				memcpy(&u4, src + i * size, 4);
+				for (k = 0; k < 4; k++) buf[i * 4 + k] = (unsigned char)(u4 >> (24 - 8 * k));
+			}
+			else {
+				memcpy(&u8, src + i * size, 8);
+				for (k = 0; k < 8; k++) buf[i * 8 + k] = (unsigned char)(u8 >> (56 - 8 * k));
+			};
+		};
+		if (fwrite(buf, size, nbuf, fp) != (size_t)nbuf) {
+			return FALSE;
+		};
+		src += nbuf * size;
+		n -= nbuf;
+	};
+
+	return TRUE;
+
+};
+
+long NCPad(long len) {
+
+	/*
+		NCPad - Returns len rounded up to a multiple of 4 bytes.
+	*/
+
+	return (len + 3) & ~3L;
+
+};
+
+long NCTypeSize(int type) {
+
+	/*
+		NCTypeSize - Returns the size in bytes of one value of a NetCDF type.
+	*/
+
+	if (type == NC_DOUBLE) return 8;
+
+	return 4;
+
+};
+
+long NCNameSize(const char *name) {
+
+	/*
+		NCNameSize - Returns the size in the header of a string written by NCPutName().
+	*/
+
+	return 4 + NCPad((long)strlen(name));
+
+};
@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// Local includes
+#include "Common.h"
+#include "Noise.h"
+#include "ITURNoise.h"
+// End Local includes
+
+// Local Prototypes
+int ReadCheckLine(FILE* fp, int* month, int* hour, double* key, double* val);
+// End Local Prototypes
+
+// The points of the check. Every month and every third hour at each point of a 30 degree grid
+// for each of the frequencies. The man-made noise environment steps through CITY to QUIET so
+// that every frequency meets every environment.
+#define NCHECKFREQS		5
+static const double CheckFreq[NCHECKFREQS] = { 0.1, 1.0, 3.0, 10.0, 30.0 };
+#define NCHECKENVS		6
+
+// Default largest difference from the reference (dB)
+#define CHECKTOLERANCE	1.0e-12
+
+// Names of the MNOUTVALS values in the order of MakeNoise()
+static const char* CheckName[MNOUTVALS] = { "FaA", "DuA", "DlA", "FaM", "DuM", "DlM", "FaG", "DuG", "DlG", "FamT", "DuT", "DlT" };
+
+int RunNoiseCheck(int argc, char* argv[]) {
+
+	/*
+
+		RunNoiseCheck - Writes the noise at a fixed set of points with every digit of each value and
+			compares it with a reference file written the same way. This is Mode 4 of ITURNoise, for example
+
+				ITURNoise -check "G:\User\Data" new.csv ref.csv -e1e-12
+
+			The reference is made by running the check without a reference file against the P372 DLL
+			that is known to be good. A change to P372 is then checked against it, either within a
+			tolerance or, with -e0, bit for bit. Only AllocateNoiseMemory(), InitializeNoise(), ReadFamDud(),
+			Noise() and FreeNoiseMemory() are used so any version of the DLL can make the reference.
+			The points are every month, every third hour (UTC), a 30 degree grid, the frequencies in
+			CheckFreq[] and each man-made noise environment. Every third hour on the 30 degree grid gives
+			every local hour, so every timeblock of the Fam coefficients of each month is used. This is the
+			tolerance test of the sine recurrences in FamHarmonic() against the direct sin() series.
+
+			INPUT
+				argv[2]		data file path
+				argv[3]		output file
+				argv[4]		reference file [Optional]
+				Options
+					-e#					largest difference from the reference (dB), default CHECKTOLERANCE
+
+			OUTPUT
+				The output file and, if there is a reference, the largest difference of each value
+
+				Returns
+					RTN_NOISECHECKOK
+					RTN_ERRNOISECHECK
+					RTN_ERRCOMMANDLINEARGS
+					RTN_ERRBADDATAFILEPATH
+					RTN_ERRCANTOPENFILE
+					RTN_ERRALLOCATENOISE
+					Errors from ReadFamDud() and Noise()
+
+			SUBROUTINES
+				AllocateNoiseMemory()
+				InitializeNoise()
+				ReadFamDud()
+				Noise()
+				FreeNoiseMemory()
+				ReadCheckLine()
+
+	*/
+
+	struct NoiseParams noiseP;
+
+	FILE* fp;
+	FILE* ref = NULL;
+
+	int month, hour;
+	int rmonth, rhour;
+	int ilat, ilng, ifreq;
+	int env = 0;
+	int npnts = 0;
+	int retval;
+	int i;
+
+	double tolerance = CHECKTOLERANCE;
+	double key[4];					// lat, lng, freq and man-made noise of the point
+	double rkey[4];
+	double out[MNOUTVALS];
+	double rout[MNOUTVALS];
+	double diff;
+	double maxdiff[MNOUTVALS];
+	int at[MNOUTVALS];				// Line of the reference file with maxdiff
+
+	const char* P372ver;
+	const char* P372compt;
+
+	char datafilepath[256];
+
+	struct stat sb;
+
+	if (argc < 4) {
+		printf("ITURNoise: ERROR: Insufficient number (%d) of command line arguments for -check, 3 required.\n", argc);
+		printf("\n");
+		PrintUsage();
+		return RTN_ERRCOMMANDLINEARGS;
+	};
+
+	snprintf(datafilepath, sizeof(datafilepath), "%s" DIRSEP, argv[2]);
+	if (stat(datafilepath, &sb)) { // Check to see if the directory exists
+		printf("ITURNoise: Error: Data file path %s does not exist\n", datafilepath);
+		return RTN_ERRBADDATAFILEPATH;
+	};
+
+	for (i = 4; i < argc; i++) {
+		if (strncmp(argv[i], "-e", 2) == 0) {
+			tolerance = atof(&argv[i][2]);
+		}
+		else if ((i == 4) && (argv[i][0] != '-')) {
+			ref = fopen(argv[i], "r");
+			if (ref == NULL) {
+				printf("ITURNoise: Error: Can't open reference file %s (%s)\n", argv[i], strerror(errno));
+				return RTN_ERRCANTOPENFILE;
+			};
+		}
+		else {
+			printf("ITURNoise: ERROR: Unknown option %s\n", argv[i]);
+			printf("\n");
+			PrintUsage();
+			if (ref != NULL) fclose(ref);
+			return RTN_ERRCOMMANDLINEARGS;
+		};
+	};
+
+	fp = fopen(argv[3], "w");
+	if (fp == NULL) {
+		printf("ITURNoise: Error: Can't open output file %s (%s)\n", argv[3], strerror(errno));
+		if (ref != NULL) fclose(ref);
+		return RTN_ERRCANTOPENFILE;
+	};
+
+	// Load the Noise routines in P372.dll ******************************
+#ifdef _WIN32
+	// Get the handle to the P372 DLL.
+	hLib = LoadLibrary(TEXT("P372.dll"));
+	if (hLib == NULL) {
+		printf("ITURNoise: Error %d P372.DLL Not Found\n", RTN_ERRP372DLL);
+		fclose(fp);
+		if (ref != NULL) fclose(ref);
+		return RTN_ERRP372DLL;
+	};
+	dllP372Version = (cP372Info)GetProcAddress((HMODULE)hLib, "P372Version");
+	dllP372CompileTime = (cP372Info)GetProcAddress((HMODULE)hLib, "P372CompileTime");
+	dllNoise = (iNoise)GetProcAddress((HMODULE)hLib, "Noise");
+	dllAllocateNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "AllocateNoiseMemory");
+	dllFreeNoiseMemory = (iNoiseMemory)GetProcAddress((HMODULE)hLib, "FreeNoiseMemory");
+	dllInitializeNoise = (vInitializeNoise)GetProcAddress((HMODULE)hLib, "InitializeNoise");
+	dllReadFamDud = (iReadFamDud)GetProcAddress((HMODULE)hLib, "ReadFamDud");
+#elif __linux__ || __APPLE__
+	hLib = dlopen("libp372.so", RTLD_NOW);
+	if (!hLib) {
+		printf("Couldn't load libp372.so, exiting.\n");
+		exit(1);
+	};
+	dllP372Version = dlsym(hLib, "P372Version");
+	dllP372CompileTime = dlsym(hLib, "P372CompileTime");
+	dllNoise = dlsym(hLib, "Noise");
+	dllAllocateNoiseMemory = dlsym(hLib, "AllocateNoiseMemory");
+	dllFreeNoiseMemory = dlsym(hLib, "FreeNoiseMemory");
+	dllInitializeNoise = dlsym(hLib, "InitializeNoise");
+	dllReadFamDud = dlsym(hLib, "ReadFamDud");
+#endif
+
+	P372ver = dllP372Version();
+	P372compt = dllP372CompileTime();
+
+	for (i = 0; i < MNOUTVALS; i++) {
+		maxdiff[i] = 0.0;
+		at[i] = 0;
+	};
+
+	// The structure is cleared so that a newer DLL finds its own arrays unallocated.
+	memset(&noiseP, 0, sizeof(struct NoiseParams));
+	retval = dllAllocateNoiseMemory(&noiseP);
+	if (retval != RTN_ALLOCATEP372OK) {
+		printf("ITURNoise: Error %d from AllocateNoiseMemory\n", retval);
+		retval = RTN_ERRALLOCATENOISE;
+	}
+	else {
+		dllInitializeNoise(&noiseP);
+		retval = RTN_NOISEOK;
+	};
+
+	// The header has the DLL that made the file. The reference file has the same two lines.
+	fprintf(fp, "# ITURNoise -check P372 Version %s Compile Time %s\n", P372ver, P372compt);
+	fprintf(fp, "# Month,Hour (UTC),Latitude (deg),Longitude (deg),Frequency (MHz),Man-made noise");
+	for (i = 0; i < MNOUTVALS; i++) {
+		fprintf(fp, ",%s", CheckName[i]);
+	};
+	fprintf(fp, "\n");
+
+	for (month = 0; (month < 12) && (retval == RTN_NOISEOK); month++) {
+		retval = dllReadFamDud(&noiseP, datafilepath, month);
+		if (retval != RTN_READFAMDUDOK) {
+			printf("ITURNoise: Error %d from ReadFamDud for month %d\n", retval, month + 1);
+			break;
+		};
+		retval = RTN_NOISEOK;
+		for (hour = 0; (hour < 24) && (retval == RTN_NOISEOK); hour += 3) {
+			for (ilat = -90; (ilat <= 90) && (retval == RTN_NOISEOK); ilat += 30) {
+				for (ilng = -180; (ilng < 180) && (retval == RTN_NOISEOK); ilng += 30) {
+					for (ifreq = 0; (ifreq < NCHECKFREQS) && (retval == RTN_NOISEOK); ifreq++) {
+						key[0] = ilat;
+						key[1] = ilng;
+						key[2] = CheckFreq[ifreq];
+						key[3] = env;
+						env = (env + 1) % NCHECKENVS;
+
+						noiseP.ManMadeNoise = key[3];
+						retval = dllNoise(&noiseP, hour, key[1] * D2R, key[0] * D2R, key[2]);
+						if (retval != RTN_NOISEOK) {
+							printf("ITURNoise: Error %d from Noise\n", retval);
+							break;
+						};
+
+						out[0] = noiseP.FaA;
+						out[1] = noiseP.DuA;
+						out[2] = noiseP.DlA;
+						out[3] = noiseP.FaM;
+						out[4] = noiseP.DuM;
+						out[5] = noiseP.DlM;
+						out[6] = noiseP.FaG;
+						out[7] = noiseP.DuG;
+						out[8] = noiseP.DlG;
+						out[9] = noiseP.FamT;
+						out[10] = noiseP.DuT;
+						out[11] = noiseP.DlT;
+
+						// %.17g gives back the same double when it is read.
+						fprintf(fp, "%d,%d,%.17g,%.17g,%.17g,%.17g", month + 1, hour + 1, key[0], key[1], key[2], key[3]);
+						for (i = 0; i < MNOUTVALS; i++) {
+							fprintf(fp, ",%.17g", out[i]);
+						};
+						fprintf(fp, "\n");
+						npnts++;
+
+						if (ref == NULL) continue;
+
+						if ((ReadCheckLine(ref, &rmonth, &rhour, rkey, rout) != TRUE) || (rmonth != month + 1) || (rhour != hour + 1) ||
+							(rkey[0] != key[0]) || (rkey[1] != key[1]) || (rkey[2] != key[2]) || (rkey[3] != key[3])) {
+							printf("ITURNoise: Error: Line %d of the reference file is not the point %d %d %g %g %g %g\n",
+								npnts, month + 1, hour + 1, key[0], key[1], key[2], key[3]);
+							retval = RTN_ERRNOISECHECK;
+							break;
+						};
+
+						for (i = 0; i < MNOUTVALS; i++) {
+							if (out[i] == rout[i]) {
+								diff = 0.0;
+							}
+							else if (isnan(out[i]) && isnan(rout[i])) {
+								diff = 0.0;
+							}
+							else {
+								diff = fabs(out[i] - rout[i]);
+								if (isnan(diff)) diff = INFINITY;
+							};
+							if (diff > maxdiff[i]) {
+								maxdiff[i] = diff;
+								at[i] = npnts;
+							};
+						};
+					};
+				};
+			};
+		};
+	};
+
+	if (noiseP.fakp != NULL) {
+		dllFreeNoiseMemory(&noiseP);
+	};
+
+	fclose(fp);
+
+	if ((retval == RTN_NOISEOK) && (ref != NULL)) {
+		// The reference must not have more points than the check.
+		if (ReadCheckLine(ref, &rmonth, &rhour, rkey, rout) == TRUE) {
+			printf("ITURNoise: Error: The reference file has more than %d points\n", npnts);
+			retval = RTN_ERRNOISECHECK;
+		};
+	};
+
+	if (ref != NULL) {
+		fclose(ref);
+	};
+
+	if (retval == RTN_NOISEOK) {
+		printf("ITURNoise: %d points written to %s\n", npnts, argv[3]);
+		retval = RTN_NOISECHECKOK;
+		if (ref != NULL) {
+			printf("ITURNoise: Largest difference from %s (dB) with tolerance %g\n", argv[4], tolerance);
+			for (i = 0; i < MNOUTVALS; i++) {
+				printf("\t%-4s %-12.3g", CheckName[i], maxdiff[i]);
+				if (maxdiff[i] > tolerance) {
+					printf(" FAIL at line %d", at[i]);
+					retval = RTN_ERRNOISECHECK;
+				};
+				printf("\n");
+			};
+			printf("ITURNoise: Noise check %s\n", (retval == RTN_NOISECHECKOK) ? "passed" : "failed");
+		};
+	};
+
+#ifdef _WIN32
+	FreeLibrary(hLib);
+#elif __linux__ || __APPLE__
+	dlclose(hLib);
+#endif
+
+	return retval;
+
+};
+
+int ReadCheckLine(FILE* fp, int* month, int* hour, double* key, double* val) {
+
+	/*
+
+		ReadCheckLine - Reads the next point of a file written by RunNoiseCheck(). The header lines
+			start with #.
+
+			INPUT
+				FILE* fp
+
+			OUTPUT
+				int* month
+				int* hour
+				double* key		lat, lng, freq and man-made noise
+				double* val		MNOUTVALS values
+
+				Returns TRUE if a point was read
+
+	*/
+
+	char line[1024];
+	char* c;
+	char* end;
+
+	int i;
+
+	do {
+		if (fgets(line, sizeof(line), fp) == NULL) return FALSE;
+	} while (line[0] == '#');
+
+	if (sscanf(line, "%d,%d", month, hour) != 2) return FALSE;
+
+	// The two integers then every double after a comma
+	c = strchr(line, ',');
+	if (c != NULL) c = strchr(c + 1, ',');
+	for (i = 0; i < 4 + MNOUTVALS; i++) {
+		if (c == NULL) return FALSE;
+		if (i < 4) key[i] = strtod(c + 1, &end);
+		else val[i - 4] = strtod(c + 1, &end);
+		if (end == c + 1) return FALSE;
+		c = (*end == ',') ? end : NULL;
+		if ((i < 3 + MNOUTVALS) && (c == NULL)) return FALSE;
+	};
+
+	return TRUE;
+
+};
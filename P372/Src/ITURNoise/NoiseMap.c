@@ -0,0 +1,475 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// Local includes
+#include "Common.h"
+#include "Noise.h"
+#include "ITURNoise.h"
+// End Local includes
+
+// Local Prototypes
+void RunNoiseMapRows(struct WorkThread* wt);
+int WriteESRIGrid(const char* filename, const float* data, int nlat, int nlng, double latmin, double lngmin, double inc);
+// End Local Prototypes
+
+// Names and units of the MNOUTVALS values from MakeNoiseBatch() in their order
+static const char* MapName[MNOUTVALS] = { "FaA", "DuA", "DlA", "FaM", "DuM", "DlM", "FaG", "DuG", "DlG", "FamT", "DuT", "DlT" };
+static const char* MapUnits[MNOUTVALS] = { "dB above kT0b", "dB", "dB", "dB above kT0b", "dB", "dB",
+										   "dB above kT0b", "dB", "dB", "dB above kT0b", "dB", "dB" };
+
+int RunNoiseMap(int argc, char* argv[]) {
+
+	/*
+
+		RunNoiseMap - Calculates the noise over a latitude and longitude grid for one month, hour,
+			frequency and man-made noise. This is Mode 3 of ITURNoise, for example
+
+				ITURNoise -map 1 14 1.0 2.0 "G:\User\Data" noise.nc -g0.5 -r30,60,-20,40
+
+			The coefficients for the month are read once for each thread with MakeNoiseOpen() and the
+			latitude rows of the grid are shared between the threads. Each row is one call to
+			MakeNoiseBatch() so the noise is found by Noise() as it is in ITURHFProp. The 12 values of
+			MakeNoise() are written for every point either to one NetCDF classic file or to ESRI ASCII
+			grids, one for each value, named with the output file as a prefix.
+
+			INPUT
+				argv[2]		month (1 to 12)
+				argv[3]		hour (1 to 24 (UTC))
+				argv[4]		frequency (0.01 to 30 MHz)
+				argv[5]		man-made noise 0-5 or value of man-made noise (dB)
+				argv[6]		data file path
+				argv[7]		output file
+				Options
+					-g#					grid spacing (degrees), default 1.0
+					-r#,#,#,#			region latmin,latmax,lngmin,lngmax (degrees), default -90,90,-180,180
+					-asc				ESRI ASCII grids <output file>_FaA.asc ... instead of NetCDF
+					-t#					number of threads, default one per processor
+
+			OUTPUT
+				The noise map files
+
+				Returns
+					RTN_NOISEMAPOK
+					RTN_ERRCOMMANDLINEARGS
+					RTN_ERRMONTH
+					RTN_ERRHOUR
+					RTN_ERRFREQ
+					RTN_ERRBADDATAFILEPATH
+					RTN_ERRNOISEMAPGRID
+					RTN_ERRCANTOPENFILE
+					RTN_ERRWRITENETCDF
+					Errors from MakeNoiseOpen() and MakeNoiseBatch()
+
+			SUBROUTINES
+				MakeNoiseOpen()
+				MakeNoiseClose()
+				ThreadCount()
+				RunThreads()
+				RunNoiseMapRows()
+				WriteNetCDF()
+				WriteESRIGrid()
+
+	*/
+
+	struct NoiseMap map;
+
+	int month;
+	int nthreads = 0;
+	int esri = FALSE;
+	int retval;
+	int i, t;
+
+	double latmax = 90.0;
+	double lngmax = 180.0;
+
+	float* lats;
+	float* lngs;
+
+	const char* P372ver;
+	const char* P372compt;
+
+	char datafilepath[256];
+	char outputfile[256];
+	char filename[300];
+	char strmonth[16];
+	char strhour[16];
+	char strfreq[32];
+	char strmmnoise[32];
+	char created[64];
+
+	struct tm* ntime;
+	time_t tm;
+
+	struct stat sb;
+
+	if (argc < 8) {
+		printf("ITURNoise: ERROR: Insufficient number (%d) of command line arguments for -map, 7 required.\n", argc);
+		printf("\n");
+		PrintUsage();
+		return RTN_ERRCOMMANDLINEARGS;
+	};
+
+	memset(&map, 0, sizeof(struct NoiseMap));
+
+	month = atoi(argv[2]) - 1;
+	if ((month < 0) || (month > 11)) {
+		printf("ITURNoise: Error: Month (%d) Out of Range (1 to 12)\n", month + 1);
+		return RTN_ERRMONTH;
+	};
+
+	map.hour = atoi(argv[3]) - 1;
+	if ((map.hour < 0) || (map.hour > 23)) {
+		printf("ITURNoise: Error: Hour (%d (UTC)) Out of Range (1 to 24 UTC)\n", map.hour + 1);
+		return RTN_ERRHOUR;
+	};
+
+	map.freq = atof(argv[4]);
+	if ((map.freq < 0.01) || (map.freq > 30)) {
+		printf("ITURNoise: Error: Frequency (%5.4f (MHz)) Out of Range (0.01 to 30 MHz)\n", map.freq);
+		return RTN_ERRFREQ;
+	};
+
+	map.mmnoise = atof(argv[5]);
+
+	sprintf(datafilepath, "%s" DIRSEP, argv[6]);
+	if (stat(datafilepath, &sb)) { // Check to see if the directory exists
+		printf("ITURNoise: Error: Data file path %s does not exist\n", datafilepath);
+		return RTN_ERRBADDATAFILEPATH;
+	};
+
+	snprintf(outputfile, sizeof(outputfile), "%s", argv[7]);
+
+	// Options
+	map.latmin = -90.0;
+	map.lngmin = -180.0;
+	map.inc = 1.0;
+	for (i = 8; i < argc; i++) {
+		if (strcmp(argv[i], "-asc") == 0) {
+			esri = TRUE;
+		}
+		else if (strncmp(argv[i], "-g", 2) == 0) {
+			map.inc = atof(&argv[i][2]);
+		}
+		else if (strncmp(argv[i], "-r", 2) == 0) {
+			if (sscanf(&argv[i][2], "%lf,%lf,%lf,%lf", &map.latmin, &latmax, &map.lngmin, &lngmax) != 4) {
+				printf("ITURNoise: Error: Region %s is not latmin,latmax,lngmin,lngmax\n", &argv[i][2]);
+				return RTN_ERRNOISEMAPGRID;
+			};
+		}
+		else if (strncmp(argv[i], "-t", 2) == 0) {
+			nthreads = atoi(&argv[i][2]);
+		}
+		else {
+			printf("ITURNoise: ERROR: Unknown option %s\n", argv[i]);
+			printf("\n");
+			PrintUsage();
+			return RTN_ERRCOMMANDLINEARGS;
+		};
+	};
+
+	if ((map.inc <= 0.0) || (map.latmin < -90.0) || (latmax > 90.0) || (map.latmin > latmax) ||
+		(map.lngmin < -180.0) || (lngmax > 180.0) || (map.lngmin > lngmax)) {
+		printf("ITURNoise: Error: Noise map grid %g to %g (lat) %g to %g (lng) by %g (degrees) is not valid\n",
+			map.latmin, latmax, map.lngmin, lngmax, map.inc);
+		return RTN_ERRNOISEMAPGRID;
+	};
+
+	// The grid includes both edges when they are a whole number of steps apart.
+	map.nlat = (int)floor((latmax - map.latmin) / map.inc + 1.0e-9) + 1;
+	map.nlng = (int)floor((lngmax - map.lngmin) / map.inc + 1.0e-9) + 1;
+
+	// Load the Noise routines in P372.dll ******************************
+#ifdef _WIN32
+	// Get the handle to the P372 DLL.
+	hLib = LoadLibrary(TEXT("P372.dll"));
+	if (hLib == NULL) {
+		printf("ITURNoise: Error %d P372.DLL Not Found\n", RTN_ERRP372DLL);
+		return RTN_ERRP372DLL;
+	};
+	dllP372Version = (cP372Info)GetProcAddress((HMODULE)hLib, "P372Version");
+	dllP372CompileTime = (cP372Info)GetProcAddress((HMODULE)hLib, "P372CompileTime");
+	dllMakeNoiseOpen = (iMakeNoiseOpen)GetProcAddress((HMODULE)hLib, "MakeNoiseOpen");
+	dllMakeNoiseBatch = (iMakeNoiseBatch)GetProcAddress((HMODULE)hLib, "MakeNoiseBatch");
+	dllMakeNoiseClose = (vMakeNoiseClose)GetProcAddress((HMODULE)hLib, "MakeNoiseClose");
+#elif __linux__ || __APPLE__
+	hLib = dlopen("libp372.so", RTLD_NOW);
+	if (!hLib) {
+		printf("Couldn't load libp372.so, exiting.\n");
+		exit(1);
+	};
+	dllP372Version = dlsym(hLib, "P372Version");
+	dllP372CompileTime = dlsym(hLib, "P372CompileTime");
+	dllMakeNoiseOpen = dlsym(hLib, "MakeNoiseOpen");
+	dllMakeNoiseBatch = dlsym(hLib, "MakeNoiseBatch");
+	dllMakeNoiseClose = dlsym(hLib, "MakeNoiseClose");
+#endif
+
+	P372ver = dllP372Version();
+	P372compt = dllP372CompileTime();
+
+	nthreads = ThreadCount(nthreads, map.nlat);
+
+	map.handle = (struct NoiseParams**) calloc(nthreads, sizeof(struct NoiseParams*));
+	map.retval = (int*) calloc(nthreads, sizeof(int));
+	map.out = (float*) malloc((size_t)MNOUTVALS * map.nlat * map.nlng * sizeof(float));
+	lats = (float*) malloc(map.nlat * sizeof(float));
+	lngs = (float*) malloc(map.nlng * sizeof(float));
+
+	retval = RTN_MAKENOISEOPENOK;
+	if ((map.handle == NULL) || (map.retval == NULL) || (map.out == NULL) || (lats == NULL) || (lngs == NULL)) {
+		retval = RTN_ERRALLOCATENOISE;
+	};
+
+	// Each thread has a handle of its own as the handle keeps a Fam cache.
+	for (t = 0; (t < nthreads) && (retval == RTN_MAKENOISEOPENOK); t++) {
+		retval = dllMakeNoiseOpen(month, datafilepath, &map.handle[t]);
+	};
+
+	// User feedback
+	if (retval == RTN_MAKENOISEOPENOK) {
+		printf("ITURNoise: Calculating %d x %d noise map on %d threads\n", map.nlat, map.nlng, nthreads);
+		if (RunThreads(RunNoiseMapRows, &map, map.nlat, nthreads) != TRUE) {
+			retval = RTN_ERRALLOCATENOISE;
+		}
+		else {
+			retval = RTN_MAKENOISEBATCHOK;
+			for (t = 0; (t < nthreads) && (retval == RTN_MAKENOISEBATCHOK); t++) {
+				retval = map.retval[t];
+			};
+		};
+	};
+
+	if (map.handle != NULL) {
+		for (t = 0; t < nthreads; t++) {
+			dllMakeNoiseClose(map.handle[t]);
+		};
+	};
+
+	if (retval == RTN_MAKENOISEBATCHOK) {
+
+		// Get the time to time stamp the output files.
+		tm = time(NULL);
+		ntime = localtime(&tm);
+		sprintf(created, "%0d/%0d/%0d %02d:%02d:%02d",
+			ntime->tm_mday, ntime->tm_mon + 1, ntime->tm_year - 100,
+			ntime->tm_hour, ntime->tm_min, ntime->tm_sec);
+
+		for (i = 0; i < map.nlat; i++) lats[i] = (float)(map.latmin + i * map.inc);
+		for (i = 0; i < map.nlng; i++) lngs[i] = (float)(map.lngmin + i * map.inc);
+
+		if (esri != TRUE) {
+
+			struct NCDim dim[] = {
+				{ "latitude", map.nlat },
+				{ "longitude", map.nlng }
+			};
+
+			struct NCVar var[2 + MNOUTVALS] = {
+				{ "latitude", NC_FLOAT, 1, { 0 }, "degrees_north", lats },
+				{ "longitude", NC_FLOAT, 1, { 1 }, "degrees_east", lngs }
+			};
+
+			struct NCAtt att[] = {
+				{ "title", "Recommendation ITU-R P.372 noise map" },
+				{ "month", strmonth },
+				{ "hour_UTC", strhour },
+				{ "frequency_MHz", strfreq },
+				{ "man_made_noise", strmmnoise },
+				{ "P372_version", P372ver },
+				{ "P372_compile_time", P372compt },
+				{ "created", created }
+			};
+
+			sprintf(strmonth, "%d", month + 1);
+			sprintf(strhour, "%d", map.hour + 1);
+			sprintf(strfreq, "%g", map.freq);
+			sprintf(strmmnoise, "%g", map.mmnoise);
+
+			for (i = 0; i < MNOUTVALS; i++) {
+				var[2 + i].name = MapName[i];
+				var[2 + i].type = NC_FLOAT;
+				var[2 + i].ndims = 2;
+				var[2 + i].dimid[0] = 0;
+				var[2 + i].dimid[1] = 1;
+				var[2 + i].units = MapUnits[i];
+				var[2 + i].data = map.out + (size_t)i * map.nlat * map.nlng;
+			};
+
+			// User feedback
+			printf("Writing file %s\n", outputfile);
+
+			retval = WriteNetCDF(outputfile, att, sizeof(att) / sizeof(att[0]), dim, 2, var, 2 + MNOUTVALS);
+			if (retval != RTN_WRITENETCDFOK) {
+				printf("ITURNoise: Error: Can't write output file %s\n", outputfile);
+			};
+		}
+		else {
+			retval = RTN_WRITENETCDFOK;
+			for (i = 0; (i < MNOUTVALS) && (retval == RTN_WRITENETCDFOK); i++) {
+				sprintf(filename, "%s_%s.asc", outputfile, MapName[i]);
+
+				// User feedback
+				printf("Writing file %s\n", filename);
+
+				if (WriteESRIGrid(filename, map.out + (size_t)i * map.nlat * map.nlng, map.nlat, map.nlng, map.latmin, map.lngmin, map.inc) != TRUE) {
+					printf("ITURNoise: Error: Can't write output file %s (%s)\n", filename, strerror(errno));
+					retval = RTN_ERRCANTOPENFILE;
+				};
+			};
+		};
+
+		if (retval == RTN_WRITENETCDFOK) {
+			retval = RTN_NOISEMAPOK;
+		};
+	};
+
+	free(map.handle);
+	free(map.retval);
+	free(map.out);
+	free(lats);
+	free(lngs);
+
+#ifdef _WIN32
+	FreeLibrary(hLib);
+#elif __linux__ || __APPLE__
+	dlclose(hLib);
+#endif
+
+	return retval;
+
+};
+
+void RunNoiseMapRows(struct WorkThread* wt) {
+
+	/*
+
+		RunNoiseMapRows - Calculates the latitude rows of a noise map given to one thread. The thread
+			uses the handle with its own number so the handles are never shared.
+
+			INPUT
+				struct WorkThread* wt	wt->job is the struct NoiseMap and the jobs are its rows
+
+			OUTPUT
+				map->out for the rows of the thread and map->retval[wt->first]
+
+			SUBROUTINES
+				MakeNoiseBatch()
+
+	*/
+
+	struct NoiseMap* map = (struct NoiseMap*) wt->job;
+
+	int* hour;
+	double* lat;
+	double* lng;
+	double* freq;
+	double* mmnoise;
+	double* out;
+
+	int i, j, k;
+	int retval = RTN_MAKENOISEBATCHOK;
+
+	hour = (int*) malloc(map->nlng * sizeof(int));
+	lat = (double*) malloc(map->nlng * sizeof(double));
+	lng = (double*) malloc(map->nlng * sizeof(double));
+	freq = (double*) malloc(map->nlng * sizeof(double));
+	mmnoise = (double*) malloc(map->nlng * sizeof(double));
+	out = (double*) malloc((size_t)MNOUTVALS * map->nlng * sizeof(double));
+
+	if ((hour == NULL) || (lat == NULL) || (lng == NULL) || (freq == NULL) || (mmnoise == NULL) || (out == NULL)) {
+		retval = RTN_ERRALLOCATENOISE;
+	}
+	else {
+		for (j = 0; j < map->nlng; j++) {
+			hour[j] = map->hour;
+			lng[j] = map->lngmin + j * map->inc;
+			freq[j] = map->freq;
+			mmnoise[j] = map->mmnoise;
+		};
+
+		for (i = wt->first; (i < wt->njobs) && (retval == RTN_MAKENOISEBATCHOK); i += wt->step) {
+			for (j = 0; j < map->nlng; j++) {
+				lat[j] = map->latmin + i * map->inc;
+			};
+
+			retval = dllMakeNoiseBatch(map->handle[wt->first], map->nlng, hour, lat, lng, freq, mmnoise, out);
+
+			// Store the row in each of the maps
+			for (k = 0; k < MNOUTVALS; k++) {
+				for (j = 0; j < map->nlng; j++) {
+					map->out[((size_t)k * map->nlat + i) * map->nlng + j] = (float)out[j * MNOUTVALS + k];
+				};
+			};
+		};
+	};
+
+	free(hour);
+	free(lat);
+	free(lng);
+	free(freq);
+	free(mmnoise);
+	free(out);
+
+	map->retval[wt->first] = retval;
+
+	return;
+
+};
+
+int WriteESRIGrid(const char* filename, const float* data, int nlat, int nlng, double latmin, double lngmin, double inc) {
+
+	/*
+
+		WriteESRIGrid - Writes one map as an ESRI ASCII grid. The rows are written from north to
+			south and the corner is given as the centre of the south west cell.
+
+			INPUT
+				const char* filename
+				const float* data	nlat x nlng values, the first row is latmin
+				int nlat
+				int nlng
+				double latmin		(degrees)
+				double lngmin		(degrees)
+				double inc			Grid spacing (degrees)
+
+			OUTPUT
+				Returns TRUE or FALSE if the file can't be written
+
+	*/
+
+	FILE* fp;
+
+	int i, j;
+	int err = FALSE;
+
+	fp = fopen(filename, "w");
+	if (fp == NULL) {
+		return FALSE;
+	};
+
+	fprintf(fp, "ncols %d\n", nlng);
+	fprintf(fp, "nrows %d\n", nlat);
+	fprintf(fp, "xllcenter %g\n", lngmin);
+	fprintf(fp, "yllcenter %g\n", latmin);
+	fprintf(fp, "cellsize %g\n", inc);
+	fprintf(fp, "NODATA_value -9999\n");
+
+	for (i = nlat - 1; i >= 0; i--) {
+		for (j = 0; j < nlng; j++) {
+			fprintf(fp, (j == 0) ? "%.4f" : " %.4f", data[(size_t)i * nlng + j]);
+		};
+		fprintf(fp, "\n");
+	};
+
+	if (ferror(fp)) err = TRUE;
+	if (fclose(fp) != 0) err = TRUE;
+
+	return (err == TRUE) ? FALSE : TRUE;
+
+};
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <errno.h>
 
 // Local includes
 #include "Common.h"
@@ -16,6 +17,8 @@ int MakeNoise(int month, int hour, double lat, double lng, double freq, double m
 	/*
 
 		MakeNoise - This program is a stand alone subroutine to use the P.372-14 method
+			It reads the coefficients for the month each time it is called. To find the noise at many
+			points use MakeNoiseOpen(), MakeNoiseBatch() and MakeNoiseClose() instead.
 
 			INPUT
 				int month
@@ -30,11 +33,14 @@ int MakeNoise(int month, int hour, double lat, double lng, double freq, double m
 			OUTPUT
 				double* out           Pointer to an array of 12 doubles
 
+			SUBROUTINES
+				MakeNoiseOpen()
+				MakeNoiseBatch()
+				MakeNoiseClose()
+				PrintFam()
 
 	*/
 
-	// End P372.DLL Load ************************************************
-
 	FILE* fp;
 
 	int retval;
@@ -45,7 +51,7 @@ int MakeNoise(int month, int hour, double lat, double lng, double freq, double m
 	const char* P372compt;
 	char outputfile[256];
 
-	struct NoiseParams noiseP;
+	struct NoiseParams* noiseP;
 
 	struct tm* ntime;
 	time_t tm;
@@ -55,16 +61,12 @@ int MakeNoise(int month, int hour, double lat, double lng, double freq, double m
 	rlat = lat * D2R;
 	rlng = lng * D2R;
 
-	// Allocate the memory in the noise structure
-	retval = AllocateNoiseMemory(&noiseP);
-	if (retval != RTN_ALLOCATEP372OK) {
-		return RTN_ERRALLOCATENOISE;
+	// Read in the atmospheric coefficients for the particular month.
+	retval = MakeNoiseOpen(month, datafilepath, &noiseP);
+	if (retval != RTN_MAKENOISEOPENOK) {
+		return retval;
 	};
 
-	// Initialize Noise from the P372.dll
-	InitializeNoise(&noiseP);
-	// End Initialize Noise
-
 	// Load the version and compile time of the P372.DLL
 	P372ver = P372Version();
 	P372compt = P372CompileTime();
@@ -76,59 +78,185 @@ int MakeNoise(int month, int hour, double lat, double lng, double freq, double m
 		ntime->tm_mday, ntime->tm_mon + 1, ntime->tm_year - 100,
 		ntime->tm_hour, ntime->tm_min, ntime->tm_sec);
 
-	// Read in the atmospheric coefficients for the particular month.
-	// The subroutine dllReadFamDud() is from P372.dll
-	retval = ReadFamDud(&noiseP, datafilepath, month);
-	if (retval != RTN_READFAMDUDOK) {
-		return retval;
+	// Calculate the noise at the one point. The handle is left holding its components.
+	retval = MakeNoiseBatch(noiseP, 1, &hour, &lat, &lng, &freq, &mmnoise, out);
+	if (retval != RTN_MAKENOISEBATCHOK) {
+		MakeNoiseClose(noiseP);
+		return retval; // check that the input parameters are correct
 	};
 
-	noiseP.ManMadeNoise = mmnoise;
-
-	// Call noise from the P372.dll
-	retval = Noise(&noiseP, hour, rlng, rlat, freq);
-	if (retval != RTN_NOISEOK) return retval; // check that the input parameters are correct
-
-	*out = noiseP.FaA;
-	*(out + 1) = noiseP.DuA;
-	*(out + 2) = noiseP.DlA;
-	*(out + 3) = noiseP.FaM;
-	*(out + 4) = noiseP.DuM;
-	*(out + 5) = noiseP.DlM;
-	*(out + 6) = noiseP.FaG;
-	*(out + 7) = noiseP.DuG;
-	*(out + 8) = noiseP.DlG;
-	*(out + 9) = noiseP.FamT;
-	*(out + 10) = noiseP.DuT;
-	*(out + 11) = noiseP.DlT;
-
 	// Check to see if there is a pntflag
 	if ((pntflag != MNNOPRINT) && (pntflag != MNPRINTTOFILE) && (pntflag != MNPRINTTOSTDOUT)) {
-		// The caller wants MakeNoise() to be silent and will presumably 
+		// The caller wants MakeNoise() to be silent and will presumably
 		// use the output parameters elsewhere
 		pntflag = MNNOPRINT;
 	};
 
 	// Does the caller desirer output?
 	if (pntflag == MNPRINTTOSTDOUT) {
-		PrintFam(stdout, &noiseP, month, hour, rlng, rlat, freq, ntimestr, P372ver, P372compt);
+		PrintFam(stdout, noiseP, month, hour, rlng, rlat, freq, ntimestr, P372ver, P372compt);
 	}
 	else if (pntflag == MNPRINTTOFILE) {
 		sprintf(outputfile, ".\\MakeNoiseOut.txt");
 		fp = fopen(outputfile, "w");
 		if (fp == NULL) {
 			printf("ITURNoise: Error: Can't open output file %s (%s)\n", outputfile, strerror(errno));
+			MakeNoiseClose(noiseP);
 			return RTN_ERRMNCANTOPENFILE;
 		};
 		printf("MakeNoise: Writing output file %s\n", outputfile);
-		PrintFam(fp, &noiseP, month, hour, rlng, rlat, freq, ntimestr, P372ver, P372compt);
+		PrintFam(fp, noiseP, month, hour, rlng, rlat, freq, ntimestr, P372ver, P372compt);
 		fclose(fp);
 	}
 
+	MakeNoiseClose(noiseP);
+
 	return RTN_MAKENOISEOK;
 
 };
 
+int MakeNoiseOpen(int month, const char* datafilepath, struct NoiseParams** handle) {
+
+	/*
+
+		MakeNoiseOpen - Opens a handle for finding the noise in one month at many points with
+			MakeNoiseBatch(). The coefficients for the month are read once and the handle owns all the
+			memory that is needed until it is given to MakeNoiseClose(). The handle is a struct NoiseParams
+			so it may also be given to Noise() or MakeNoiseGrid().
+
+			INPUT
+				int month		(0 to 11)
+				const char* datafilepath
+				struct NoiseParams** handle
+
+			OUTPUT
+				*handle			The handle or NULL if it could not be opened
+
+				Returns
+					RTN_MAKENOISEOPENOK
+					RTN_ERRALLOCATENOISE
+					Errors from ReadFamDud()
+
+			SUBROUTINES
+				AllocateNoiseMemory()
+				InitializeNoise()
+				ReadFamDud()
+				MakeNoiseClose()
+
+	*/
+
+	struct NoiseParams* noiseP;
+
+	int retval;
+
+	*handle = NULL;
+
+	// Clear the structure so that MakeNoiseClose() can free whatever has been allocated if there is an error.
+	noiseP = (struct NoiseParams*) calloc(1, sizeof(struct NoiseParams));
+	if (noiseP == NULL) {
+		return RTN_ERRALLOCATENOISE;
+	};
+
+	// Allocate the memory in the noise structure
+	retval = AllocateNoiseMemory(noiseP);
+	if (retval != RTN_ALLOCATEP372OK) {
+		MakeNoiseClose(noiseP);
+		return RTN_ERRALLOCATENOISE;
+	};
+
+	InitializeNoise(noiseP);
+
+	// Read in the atmospheric coefficients for the particular month.
+	retval = ReadFamDud(noiseP, datafilepath, month);
+	if (retval != RTN_READFAMDUDOK) {
+		MakeNoiseClose(noiseP);
+		return retval;
+	};
+
+	*handle = noiseP;
+
+	return RTN_MAKENOISEOPENOK;
+
+};
+
+int MakeNoiseBatch(struct NoiseParams* handle, int npnts, int* hour, double* lat, double* lng, double* freq, double* mmnoise, double* out) {
+
+	/*
+
+		MakeNoiseBatch - Finds the noise at an array of points with a handle from MakeNoiseOpen(). Each
+			point has its own hour, location, frequency and man-made noise. The Fam at 1 MHz found for a
+			point is kept in the handle, so later points at the same location and timeblock are quicker.
+
+			INPUT
+				struct NoiseParams* handle
+				int npnts		Number of points
+				int* hour		(0 to 23 UTC)
+				double* lat		(degrees)
+				double* lng		(degrees)
+				double* freq	(MHz)
+				double* mmnoise	Man-made noise environment or value as for MakeNoise()
+
+			OUTPUT
+				double* out		MNOUTVALS doubles for each point in the order of MakeNoise()
+
+				Returns
+					RTN_MAKENOISEBATCHOK
+					RTN_ERRMAKENOISEBATCH
+					Errors from Noise()
+
+			SUBROUTINES
+				Noise()
+
+	*/
+
+	int retval;
+	int n;
+
+	if ((handle == NULL) || (npnts < 0) || (hour == NULL) || (lat == NULL) || (lng == NULL) ||
+		(freq == NULL) || (mmnoise == NULL) || (out == NULL)) {
+		return RTN_ERRMAKENOISEBATCH;
+	};
+
+	for (n = 0; n < npnts; n++) {
+		handle->ManMadeNoise = mmnoise[n];
+
+		retval = Noise(handle, hour[n], lng[n] * D2R, lat[n] * D2R, freq[n]);
+		if (retval != RTN_NOISEOK) return retval;
+
+		out[0] = handle->FaA;
+		out[1] = handle->DuA;
+		out[2] = handle->DlA;
+		out[3] = handle->FaM;
+		out[4] = handle->DuM;
+		out[5] = handle->DlM;
+		out[6] = handle->FaG;
+		out[7] = handle->DuG;
+		out[8] = handle->DlG;
+		out[9] = handle->FamT;
+		out[10] = handle->DuT;
+		out[11] = handle->DlT;
+		out += MNOUTVALS;
+	};
+
+	return RTN_MAKENOISEBATCHOK;
+
+};
+
+void MakeNoiseClose(struct NoiseParams* handle) {
+
+	/*
+		MakeNoiseClose - Frees a handle from MakeNoiseOpen() and all the memory it owns.
+	*/
+
+	if (handle == NULL) return;
+
+	FreeNoiseMemory(handle);
+	free(handle);
+
+	return;
+
+};
+
 void PrintFam(FILE *fp, struct NoiseParams* noiseP, int month, int hour, double rlng, double rlat, double freq, char *ntimestr, const char* P372ver, const char* P372compt) {
 	
 	const char* monthnames[] = { "JANUARY ", "FEBRUARY", "MARCH", "APRIL", "MAY", "JUNE", "JULY", "AUGUST", "SEPTEMBER", "OCTOBER", "NOVEMBER", "DECEMBER" };
@@ -0,0 +1,371 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Local includes
+#include "Common.h"
+#include "Noise.h"
+// End local includes
+
+// Local prototypes
+void GalacticNoise(struct NoiseParams *noiseP, double frequency);
+void ManMadeNoise(struct NoiseParams *noiseP, double frequency);
+int NoiseGridLookup(struct NoiseParams *noiseP, int hour, double rlng, double rlat, double frequency);
+int NoiseGridIndex(double x, int n, int *i, double *t);
+int NoiseGridZone(double rlng, double rlat);
+void NoiseGridStore(struct NoiseParams *noiseP, double *val);
+void CombineNoise(struct NoiseParams *noiseP);
+// End local prototypes
+
+// Values kept at each node of the grid
+#define NGFAA	0
+#define NGDUA	1
+#define NGDLA	2
+
+// Values compared with Noise() when the grid is checked, the node values and then FamT, DuT and DlT
+#define NGCHECKVALS	(NOISEGRIDVALS + 3)
+
+// Tolerance on positions and frequencies at the edges of the grid in grid units
+#define NGEPS	1.0e-9
+
+int MakeNoiseGrid(struct NoiseParams *noiseP, int hour, double latmin, double latmax, double latinc,
+	double lngmin, double lngmax, double lnginc, double *freqs, int nfreqs) {
+
+	/*
+
+	  MakeNoiseGrid() - Tabulates the atmospheric noise from AtmosphericNoise() for one hour of the month at the
+			nodes of a latitude, longitude and frequency grid. While the grid is attached to noiseP, Noise()
+			interpolates FaA, DuA and DlA in it for that hour instead of calculating them and combines them with
+			the galactic and man-made noise as before. The noise is smooth within a 15 degree time zone
+			and within a hemisphere, but it steps where the local time used by AtmosphericNoise() changes and
+			at the equator. A point in a cell that crosses one of these is calculated by Noise() as before.
+			The frequency dependence of the atmospheric noise is too curved to interpolate between the
+			frequencies of a circuit so only the frequencies in the grid are looked up. Any other frequency is
+			calculated by Noise() as before.
+
+			The accuracy of the grid is measured as it is made. The centres of one cell in NOISEGRIDCHECK in
+			each direction are found both ways at each frequency. The largest difference in FaA, DuA, DlA,
+			FamT, DuT or DlT is kept in noiseP->NoiseG->maxerr. It is a measurement, not a bound: the error
+			elsewhere in a cell, and in the cells that are not checked, can be larger.
+
+			The grid saves the atmospheric noise calculation of each point but not the rest of P533(). In an
+			ITURHFProp area run the noise is a small part of the time, so the run is not measurably quicker.
+
+			The grid is released by FreeNoiseGrid(). It is also released when another grid is made, when
+			ReadFamDud() reads a month and by FreeNoiseMemory().
+
+	 		INPUT
+	 			struct NoiseParams *noiseP
+				int hour - UTC hour as it will be given to Noise()
+				double latmin, latmax - Latitude range (rad)
+				double latinc - Latitude increment (rad)
+				double lngmin, lngmax - Longitude range (rad)
+				double lnginc - Longitude increment (rad)
+				double *freqs - Frequencies (MHz) in any order
+				int nfreqs - Number of frequencies
+
+	 		OUTPUT
+	 			noiseP->NoiseG
+
+				Returns
+					RTN_MAKENOISEGRIDOK
+					RTN_ERRNOISEGRID
+					RTN_ERRALLOCATENOISEGRID
+
+			SUBROUTINES
+				FreeNoiseGrid()
+				AtmosphericNoise()
+				Noise()
+				NoiseGridLookup()
+				NoiseGridStore()
+				NoiseGridZone()
+
+	 */
+
+	struct NoiseGrid *G;
+
+	double exact[NGCHECKVALS];		// Noise() at a cell centre
+	double grid[NGCHECKVALS];		// Grid at a cell centre
+	double lat, lng;				// Position (rad)
+
+	size_t nodes;					// Nodes in one frequency of the grid
+	int i, j, k, m, n;
+
+	FreeNoiseGrid(noiseP);
+
+	// The override in Noise() does not depend on the position or the frequency.
+	if(noiseP->ManMadeNoise < 0.0) {
+		return RTN_MAKENOISEGRIDOK;
+	};
+
+	if((latinc <= 0.0) || (lnginc <= 0.0) || (latmax < latmin) || (lngmax < lngmin) || (nfreqs < 1)) {
+		return RTN_ERRNOISEGRID;
+	};
+
+	G = (struct NoiseGrid*) malloc(sizeof(struct NoiseGrid));
+	if(G == NULL) {
+		return RTN_ERRALLOCATENOISEGRID;
+	};
+
+	G->hour = hour;
+	G->ManMadeNoise = noiseP->ManMadeNoise;
+	G->latmin = latmin;
+	G->latinc = latinc;
+	G->lngmin = lngmin;
+	G->lnginc = lnginc;
+	G->maxerr = 0.0;
+	G->checked = 0;
+	G->lookups = 0;
+	G->exact = 0;
+
+	// The last row and column are at or beyond latmax and lngmax.
+	G->nlat = (int)ceil((latmax - latmin)/latinc - NGEPS) + 1;
+	G->nlng = (int)ceil((lngmax - lngmin)/lnginc - NGEPS) + 1;
+
+	// Keep the frequencies in ascending order without repeats.
+	G->freq = (double*) malloc(nfreqs * sizeof(double));
+	if(G->freq == NULL) {
+		free(G);
+		return RTN_ERRALLOCATENOISEGRID;
+	};
+	G->nfreq = 0;
+	for(n=0; n<nfreqs; n++) {
+		if(freqs[n] <= 0.0) {
+			free(G->freq);
+			free(G);
+			return RTN_ERRNOISEGRID;
+		};
+		for(m=0; (m < G->nfreq) && (G->freq[m] != freqs[n]); m++);
+		if(m < G->nfreq) {
+			continue;
+		};
+		for(m=G->nfreq; (m > 0) && (G->freq[m-1] > freqs[n]); m--) {
+			G->freq[m] = G->freq[m-1];
+		};
+		G->freq[m] = freqs[n];
+		G->nfreq++;
+	};
+
+	nodes = (size_t)G->nlat*G->nlng;
+	G->val = (double*) malloc((size_t)G->nfreq*nodes*NOISEGRIDVALS * sizeof(double));
+	if(G->val == NULL) {
+		free(G->freq);
+		free(G);
+		return RTN_ERRALLOCATENOISEGRID;
+	};
+
+	// Tabulate the noise with noiseP->NoiseG still empty so that Noise() calculates it.
+	for(k=0; k<G->nfreq; k++) {
+		for(i=0; i<G->nlat; i++) {
+			lat = latmin + i*latinc;
+			for(j=0; j<G->nlng; j++) {
+				lng = lngmin + j*lnginc;
+				AtmosphericNoise(noiseP, hour, lng, lat, G->freq[k]);
+				NoiseGridStore(noiseP, G->val + ((k*nodes) + (size_t)i*G->nlng + j)*NOISEGRIDVALS);
+			};
+		};
+	};
+
+	// Measure the accuracy at the centres of a sample of the cells.
+	for(k=0; k<G->nfreq; k++) {
+		for(i=0; i+1<G->nlat; i+=NOISEGRIDCHECK) {
+			lat = latmin + (i + 0.5)*latinc;
+			for(j=0; j+1<G->nlng; j+=NOISEGRIDCHECK) {
+				lng = lngmin + (j + 0.5)*lnginc;
+
+				noiseP->NoiseG = G;
+				if(NoiseGridLookup(noiseP, hour, lng, lat, G->freq[k]) != TRUE) {
+					noiseP->NoiseG = NULL;
+					continue;
+				};
+				NoiseGridStore(noiseP, grid);
+				grid[NOISEGRIDVALS] = noiseP->FamT;
+				grid[NOISEGRIDVALS + 1] = noiseP->DuT;
+				grid[NOISEGRIDVALS + 2] = noiseP->DlT;
+
+				noiseP->NoiseG = NULL;
+				Noise(noiseP, hour, lng, lat, G->freq[k]);
+				NoiseGridStore(noiseP, exact);
+				exact[NOISEGRIDVALS] = noiseP->FamT;
+				exact[NOISEGRIDVALS + 1] = noiseP->DuT;
+				exact[NOISEGRIDVALS + 2] = noiseP->DlT;
+
+				for(n=0; n<NGCHECKVALS; n++) {
+					G->maxerr = max(G->maxerr, fabs(grid[n] - exact[n]));
+				};
+				G->checked++;
+			};
+		};
+	};
+
+	G->lookups = 0;
+	G->exact = 0;
+
+	noiseP->NoiseG = G;
+
+	return RTN_MAKENOISEGRIDOK;
+
+};
+
+void FreeNoiseGrid(struct NoiseParams *noiseP) {
+
+	/*
+	  FreeNoiseGrid() - Releases the grid made by MakeNoiseGrid() so that Noise() calculates the noise again.
+	*/
+
+	if(noiseP->NoiseG != NULL) {
+		free(noiseP->NoiseG->val);
+		free(noiseP->NoiseG->freq);
+		free(noiseP->NoiseG);
+		noiseP->NoiseG = NULL;
+	};
+
+};
+
+int NoiseGridLookup(struct NoiseParams *noiseP, int hour, double rlng, double rlat, double frequency) {
+
+	/*
+
+	  NoiseGridLookup() - Interpolates the atmospheric noise at a point from the grid in noiseP->NoiseG and
+			combines it with the galactic and man-made noise. The interpolation is bilinear in latitude and
+			longitude at one of the frequencies of the grid. Returns FALSE if the grid
+			is not for this hour or man-made noise, if the point is outside the grid, if the frequency is not
+			in the grid or if the cell crosses a time zone or the equator. The noise must then be calculated.
+
+	 		INPUT
+	 			struct NoiseParams *noiseP
+				int hour
+				double rlng (rad)
+				double rlat (rad)
+				double frequency (MHz)
+
+	 		OUTPUT
+	 			noiseP->FaA, noiseP->DuA, noiseP->DlA from the grid
+				noiseP->FaG, noiseP->DuG, noiseP->DlG via GalacticNoise()
+				noiseP->FaM, noiseP->DuM, noiseP->DlM via ManMadeNoise()
+				noiseP->FamT, noiseP->DuT, noiseP->DlT via CombineNoise()
+
+			SUBROUTINES
+				GalacticNoise()
+				ManMadeNoise()
+				CombineNoise()
+				NoiseGridIndex()
+				NoiseGridZone()
+
+	 */
+
+	struct NoiseGrid *G;
+
+	double v[NOISEGRIDVALS];
+	double *a, *b, *c, *d;		// Corners of the cell
+	double tlat, tlng;			// Interpolation factors
+
+	size_t nodes;
+	int i, j, k, n;
+	int i1, j1;
+	int zone;
+
+	G = noiseP->NoiseG;
+
+	if((G->hour != hour) || (G->ManMadeNoise != noiseP->ManMadeNoise)) {
+		return FALSE;
+	};
+
+	if((NoiseGridIndex((rlat - G->latmin)/G->latinc, G->nlat, &i, &tlat) != TRUE) ||
+	   (NoiseGridIndex((rlng - G->lngmin)/G->lnginc, G->nlng, &j, &tlng) != TRUE)) {
+		return FALSE;
+	};
+
+	for(k=0; (k < G->nfreq) && (fabs(frequency - G->freq[k]) > NGEPS*G->freq[k]); k++);
+	if(k == G->nfreq) {
+		G->exact++;
+		return FALSE;
+	};
+
+	i1 = min(i+1, G->nlat-1);
+	j1 = min(j+1, G->nlng-1);
+
+	// The corners must be in the same time zone and hemisphere as the point.
+	zone = NoiseGridZone(rlng, rlat);
+	if((NoiseGridZone(G->lngmin + j*G->lnginc, G->latmin + i*G->latinc) != zone) ||
+	   (NoiseGridZone(G->lngmin + j1*G->lnginc, G->latmin + i*G->latinc) != zone) ||
+	   (NoiseGridZone(G->lngmin + j*G->lnginc, G->latmin + i1*G->latinc) != zone) ||
+	   (NoiseGridZone(G->lngmin + j1*G->lnginc, G->latmin + i1*G->latinc) != zone)) {
+		G->exact++;
+		return FALSE;
+	};
+
+	nodes = (size_t)G->nlat*G->nlng;
+	a = G->val + ((k*nodes) + (size_t)i*G->nlng + j)*NOISEGRIDVALS;
+	b = G->val + ((k*nodes) + (size_t)i*G->nlng + j1)*NOISEGRIDVALS;
+	c = G->val + ((k*nodes) + (size_t)i1*G->nlng + j)*NOISEGRIDVALS;
+	d = G->val + ((k*nodes) + (size_t)i1*G->nlng + j1)*NOISEGRIDVALS;
+
+	for(n=0; n<NOISEGRIDVALS; n++) {
+		v[n] = (1.0 - tlat)*((1.0 - tlng)*a[n] + tlng*b[n]) + tlat*((1.0 - tlng)*c[n] + tlng*d[n]);
+	};
+
+	noiseP->FaA = v[NGFAA];
+	noiseP->DuA = v[NGDUA];
+	noiseP->DlA = v[NGDLA];
+
+	// The galactic and man-made noise depend only on the frequency.
+	GalacticNoise(noiseP, frequency);
+	ManMadeNoise(noiseP, frequency);
+
+	// The combined noise is found from the interpolated components as Noise() would.
+	CombineNoise(noiseP);
+
+	G->lookups++;
+
+	return TRUE;
+
+};
+
+int NoiseGridIndex(double x, int n, int *i, double *t) {
+
+	/*
+	  NoiseGridIndex() - Finds the cell, i, and the fraction of the way across it, t, of the position x in grid
+			units along an axis of n nodes. Returns FALSE if x is outside the axis.
+	*/
+
+	if((x < -NGEPS) || (x > (n - 1) + NGEPS)) {
+		return FALSE;
+	};
+
+	*i = (int)floor(x);
+	if(*i > n - 2) *i = n - 2;
+	if(*i < 0) *i = 0;
+
+	*t = x - *i;
+	if(*t < 0.0) *t = 0.0;
+	if(*t > 1.0) *t = 1.0;
+	if(n == 1) *t = 0.0;
+
+	return TRUE;
+
+};
+
+int NoiseGridZone(double rlng, double rlat) {
+
+	/*
+	  NoiseGridZone() - Returns a number for the local time offset that AtmosphericNoise() uses at the longitude
+			and the hemisphere that GetFamParameters() uses at the latitude.
+	*/
+
+	return 2*(int)(rlng / (15.0 * D2R)) + ((rlat < 0) ? 1 : 0);
+
+};
+
+void NoiseGridStore(struct NoiseParams *noiseP, double *val) {
+
+	/*
+	  NoiseGridStore() - Copies the noise values that are kept at each node of the grid from noiseP to val.
+	*/
+
+	val[NGFAA] = noiseP->FaA;
+	val[NGDUA] = noiseP->DuA;
+	val[NGDLA] = noiseP->DlA;
+
+};
@@ -16,10 +16,14 @@ int AllocateNoiseMemory(struct NoiseParams *noiseP) {
 	 			struct NoiseParams *noiseP
 
 	 		OUTPUT
+	 		  noiseP->coeff
 	 		  noiseP->fakp
         noiseP->fakabp
         noiseP->fam
         noiseP->dud
+        noiseP->FamC
+        noiseP->NoiseG
+        noiseP->CoeffI
 
 	 		SUBROUTINES
 	 			None
@@ -30,59 +34,113 @@ int AllocateNoiseMemory(struct NoiseParams *noiseP) {
   double **fakabp;
   double **fam;
   double ***dud;
+  double *coeff;
+  void **ptrs;
+  struct FamCache *FamC;
+  struct CoeffIndex *CoeffI;
 
+  unsigned long e;
   int m, n;
 
-  // Create the fakp array
-	fakp = (double***) malloc(6 * sizeof(double**));
+  // Nothing is allocated until it is saved below, so that every pointer is NULL on any error return and 
+  // FreeNoiseMemory() can be called whatever this returns.
+  noiseP->CoeffI = NULL;
+  noiseP->coeff = NULL;
+  noiseP->dud = NULL;
+  noiseP->fam = NULL;
+  noiseP->fakp = NULL;
+  noiseP->fakabp = NULL;
+  noiseP->FamC = NULL;
+  noiseP->NoiseG = NULL;
+
+  // The coefficients are one contiguous block in the order they are found in the coefficient files,
+  // fakp[6][16][29], fakabp[6][2], dud[5][12][5] and fam[12][14], so that a row of fakp follows the one
+  // before it and the block is read by one copy, see SetFamDud(). The pointers that index it are kept
+  // after it in the same allocation so it is allocated and freed at once.
+  coeff = (double*) malloc(NNOISECOEFF*sizeof(double) + NNOISEPTRS*sizeof(void*));
+  if(coeff == NULL) {
+	  return RTN_ERRALLOCATEFAKP;
+  };
+  ptrs = (void**)(coeff + NNOISECOEFF);
+
+  // Index the fakp array
+	fakp = (double***)ptrs;
+	ptrs += 6;
 	for(n=0; n<6; n++) {
-		fakp[n] = (double**) malloc(16 * sizeof(double*));
+		fakp[n] = (double**)ptrs;
+		ptrs += 16;
 		for(m=0; m<16; m++) {
-			fakp[n][m] = (double*) malloc(29 * sizeof(double));
+			fakp[n][m] = coeff + (n*16 + m)*29;
 		};
 	};
 
-  // Create the fakabp array
-	fakabp = (double**) malloc(6 * sizeof(double*));
+  // Index the fakabp array
+	fakabp = (double**)ptrs;
+	ptrs += 6;
 	for(m=0; m<6; m++) {
-		fakabp[m] = (double*) malloc(2 * sizeof(double));
+		fakabp[m] = coeff + NFAKP + m*2;
 	};
 
-  // Create the dud array
-	dud = (double***) malloc(5 * sizeof(double**));
+  // Index the dud array
+	dud = (double***)ptrs;
+	ptrs += 5;
 	for(n=0; n<5; n++) {
-		dud[n] = (double**) malloc(12 * sizeof(double*));
+		dud[n] = (double**)ptrs;
+		ptrs += 12;
 		for(m=0; m<12; m++) {
-			dud[n][m] = (double*) malloc(5 * sizeof(double));
+			dud[n][m] = coeff + NFAKP + NFAKABP + (n*12 + m)*5;
 		};
 	};
 
-  // Create the fam array
-	fam = (double**) malloc(12 * sizeof(double*));
+  // Index the fam array
+	fam = (double**)ptrs;
 	for(m=0; m<12; m++) {
-		fam[m] = (double*) malloc(14 * sizeof(double));
+		fam[m] = coeff + NFAKP + NFAKABP + NDUD + m*14;
 	};
 
-  // Check for NULLs and save the pointers to the path structure.
-  if(dud != NULL)
-    noiseP->dud = dud;
-  else
-    return RTN_ERRALLOCATEDUD;
+  // Create the Fam cache. It starts small and grows as it is used.
+	FamC = (struct FamCache*) malloc(sizeof(struct FamCache));
+	if(FamC != NULL) {
+		FamC->entry = (struct FamCacheEntry*) malloc(FAMCACHEMIN * sizeof(struct FamCacheEntry));
+		if(FamC->entry == NULL) {
+			free(FamC);
+			FamC = NULL;
+		}
+		else {
+			FamC->month = -1;
+			FamC->hits = 0;
+			FamC->misses = 0;
+			FamC->size = FAMCACHEMIN;
+			FamC->used = 0;
+			for(e=0; e<FamC->size; e++) {
+				FamC->entry[e].tmblk = -1;
+			};
+		};
+	};
 
-  if(fam != NULL)
-    noiseP->fam = fam;
-  else
-	  return RTN_ERRALLOCATEFAM;
+  // The index of the text coefficient files is filled in as they are read. Without it they are scanned each time.
+	CoeffI = (struct CoeffIndex*) malloc(sizeof(struct CoeffIndex));
+	if(CoeffI != NULL) {
+		for(m=0; m<12; m++) {
+			CoeffI->file[m][0] = '\0';
+		};
+	};
 
-  if(fakp != NULL)
-    noiseP->fakp = fakp;
-  else
-	  return RTN_ERRALLOCATEFAKP;
+  // Without the Fam cache nothing is kept.
+	if(FamC == NULL) {
+		free(CoeffI);
+		free(coeff);
+		return RTN_ERRALLOCATEFAMCACHE;
+	};
 
-	if(fakabp != NULL)
-    noiseP->fakabp = fakabp;
-  else
-	  return RTN_ERRALLOCATEFAKABP;
+  // Save the pointers to the path structure. There is no noise grid until MakeNoiseGrid() is called.
+  noiseP->CoeffI = CoeffI;
+  noiseP->coeff = coeff;
+  noiseP->dud = dud;
+  noiseP->fam = fam;
+  noiseP->fakp = fakp;
+  noiseP->fakabp = fakabp;
+  noiseP->FamC = FamC;
 
   return RTN_ALLOCATEP372OK;
 
@@ -104,37 +162,27 @@ int FreeNoiseMemory(struct NoiseParams *noiseP) {
 
 	 */
 
-   int m, n;
-
-   // Free DUD
-	for(n=0; n<5; n++) {
-		for(m=0; m<12; m++) {
-			free(noiseP->dud[n][m]);
-		};
-		free(noiseP->dud[n]);
-	};
-	free(noiseP->dud);
-
-  // Free FAM
-	for(m=0; m<12; m++) {
-		free(noiseP->fam[m]);
+   // The coefficients and the pointers that index them are one allocation, see AllocateNoiseMemory().
+	free(noiseP->coeff);
+	noiseP->coeff = NULL;
+	noiseP->dud = NULL;
+	noiseP->fam = NULL;
+	noiseP->fakp = NULL;
+	noiseP->fakabp = NULL;
+
+	// Free the Fam cache
+	if(noiseP->FamC != NULL) {
+		free(noiseP->FamC->entry);
+		free(noiseP->FamC);
+		noiseP->FamC = NULL;
 	};
-	free(noiseP->fam);
 
-  // Free FAKP
-	for(n=0; n<6; n++) {
-		for(m=0; m<16; m++) {
-			free(noiseP->fakp[n][m]);
-		};
-    free(noiseP->fakp[n]);
-	};
-	free(noiseP->fakp);
+	// Free the index of the text coefficient files
+	free(noiseP->CoeffI);
+	noiseP->CoeffI = NULL;
 
-	// Free fakabp
-	for(m=0; m<6; m++) {
-		free(noiseP->fakabp[m]);
-	};
-	free(noiseP->fakabp);
+	// Free any noise grid
+	FreeNoiseGrid(noiseP);
 
   return RTN_NOISEFREED;
 
@@ -16,7 +16,7 @@ void WriteHeader(FILE *fp);
 void WriteData(FILE *fp, double FA, double lng, double lat);
 // End Local Prototypes
  
-void main() {
+void main(int argc, char *argv[]) {
 
 	double lat, lng, q;
 	double ZZ[29];
@@ -34,6 +34,7 @@ void main() {
 	int tmblklng, tmblklat;
 	
 	char OutFile[64];
+	char DataFilePath[256];
 
 	struct IonoCoeff Coeff;
 
@@ -59,7 +60,20 @@ void main() {
 	What2Read = GETFAKP | GETFAKABP | GETDUD |
 							GETFAM;
 		
-	ReadCoeff(&Coeff, 4, What2Read);
+	// The directory of the coefficient files may be given on the command line
+	if (argc > 1) {
+		strcpy(DataFilePath, argv[1]);
+	}
+	else {
+		strcpy(DataFilePath, "..\\..\\Data\\");
+	};
+
+	if (ReadCoeff(&Coeff, DataFilePath, 4, What2Read) != RTN_READCOEFFOK) {
+		printf("Press Enter...");
+		getchar();
+		fclose(fp);
+		return;
+	};
 
 	/////////////////////////////////////////
 	// Do something with this wonderful data.
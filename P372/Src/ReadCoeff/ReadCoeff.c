@@ -1,12 +1,68 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#elif __linux__ || __APPLE__
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
 
 // Local include
 #include "ReadCoeff.h"
 // End local include 
 
-void ReadCoeff(struct IonoCoeff *Coeff, int month, long What2Read) {
+// The blocks of the coefficient file in the order of the file
+struct CoeffBlock {
+	long flag;
+	const char *iname;		// Name of the int array in the text file or NULL
+	const char *xname;		// Name of the double array in the text file
+	size_t ioff;			// Where the int array pointer is kept in struct IonoCoeff
+	size_t xoff;			// Where the double array pointer is kept in struct IonoCoeff
+	int nint;
+	int ndims;
+	int dim[3];				// C order, slowest first
+};
+
+static const struct CoeffBlock CoeffBlocks[NCOEFFBLOCKS] = {
+	{GETXF2,	"if2",		"xf2",		offsetof(struct IonoCoeff, if2),	offsetof(struct IonoCoeff, xf2),	10, 3, {2, 76, 13}},
+	{GETXFM3,	"ifm3",		"xfm3",		offsetof(struct IonoCoeff, ifm3),	offsetof(struct IonoCoeff, xfm3),	10, 3, {2, 49, 9}},
+	{GETXE,		"ie",		"xe",		offsetof(struct IonoCoeff, ie),		offsetof(struct IonoCoeff, xe),		10, 3, {2, 22, 9}},
+	{GETXESU,	"iesu",		"xesu",		offsetof(struct IonoCoeff, iesu),	offsetof(struct IonoCoeff, xesu),	10, 3, {2, 55, 5}},
+	{GETXES,	"ies",		"xes",		offsetof(struct IonoCoeff, ies),	offsetof(struct IonoCoeff, xes),	10, 3, {2, 61, 7}},
+	{GETXESL,	"iesl",		"xesl",		offsetof(struct IonoCoeff, iesl),	offsetof(struct IonoCoeff, xesl),	10, 3, {2, 55, 5}},
+	{GETXHPO1,	"ihpo1",	"xhpo1",	offsetof(struct IonoCoeff, ihpo1),	offsetof(struct IonoCoeff, xhpo1),	10, 3, {2, 29, 13}},
+	{GETXHPO2,	"ihpo2",	"xhpo2",	offsetof(struct IonoCoeff, ihpo2),	offsetof(struct IonoCoeff, xhpo2),	10, 3, {2, 55, 9}},
+	{GETXHP,	"ihp",		"xhp",		offsetof(struct IonoCoeff, ihp),	offsetof(struct IonoCoeff, xhp),	10, 3, {2, 37, 9}},
+	{GETFAKP,	NULL,		"fakp",		0,									offsetof(struct IonoCoeff, fakp),	0,	3, {6, 16, 29}},
+	{GETFAKABP,	NULL,		"fakabp",	0,									offsetof(struct IonoCoeff, fakabp),	0,	2, {6, 2, 1}},
+	{GETDUD,	NULL,		"dud",		0,									offsetof(struct IonoCoeff, dud),	0,	3, {5, 12, 5}},
+	{GETFAM,	NULL,		"fam",		0,									offsetof(struct IonoCoeff, fam),	0,	2, {12, 14, 1}},
+	{GETSYS1,	NULL,		"sys1",		0,									offsetof(struct IonoCoeff, sys1),	0,	3, {6, 16, 9}},
+	{GETSYS2,	NULL,		"sys2",		0,									offsetof(struct IonoCoeff, sys2),	0,	3, {6, 16, 9}},
+	{GETPERR,	NULL,		"perr",		0,									offsetof(struct IonoCoeff, perr),	0,	3, {6, 4, 9}},
+	{GETF2D,	NULL,		"f2d",		0,									offsetof(struct IonoCoeff, f2d),	0,	3, {6, 6, 16}},
+	{GETPKO,	NULL,		"pko",		0,									offsetof(struct IonoCoeff, pko),	0,	3, {6, 7, 8}},
+	{GETSLP,	NULL,		"slp",		0,									offsetof(struct IonoCoeff, slp),	0,	3, {6, 7, 8}},
+	{GETCCR,	NULL,		"ccr",		0,									offsetof(struct IonoCoeff, ccr),	0,	3, {6, 7, 8}}
+};
+
+// Local prototypes
+unsigned char *ParseCoeffTxt(const char *InFilePath, struct CoeffCacheHeader *expected);
+unsigned char *MapCoeffCache(const char *CacheFilePath, struct CoeffCacheHeader *expected, long What2Read, size_t *mapsize);
+int WriteCoeffCache(const char *CacheFilePath, unsigned char *image);
+void UnmapCoeffFile(void *map, size_t mapsize);
+unsigned int CoeffChecksum(unsigned int crc, const unsigned char *buf, size_t len);
+size_t CoeffIndex(struct CoeffCacheHeader *hdr);
+size_t CoeffBlockSize(const struct CoeffBlock *blk);
+// End local prototypes
+
+int ReadCoeff(struct IonoCoeff *Coeff, const char *DataFilePath, int month, long What2Read) {
 
 	/*
 	 * ReadCoeff() Reads the harmonized coefficient files from Peter Suessman. The files have been renamed from Suessman's
@@ -18,8 +74,15 @@ void ReadCoeff(struct IonoCoeff *Coeff, int month, long What2Read) {
 	 *
 	 *		Although this routine was designed to be used with p533(), it can be used with ReadCoeff.h for other programs.  
 	 *
+	 *		The text file is parsed once and kept next to it as COEFFxxW.txt.cache, see struct CoeffCacheHeader. 
+	 *		Later calls map the cache into memory and point the requested arrays at their blocks through the index in
+	 *		its header, so a block costs the same whether or not the blocks before it are wanted. Only the row pointers
+	 *		of the arrays are allocated. If the cache can not be written, for example because the data directory is 
+	 *		read only, the text is parsed each time. The arrays are released by FreeCoeffArrays().
+	 *
 	 *		INPUT
 	 *			struct IonoCoeff *Coeff
+	 *			const char *DataFilePath - Directory of the coefficient files including the trailing separator
 	 *			int month - Month index
 	 *			long What2Read - Flag to determine what is to be extracted from the Coeff file
 	 *
@@ -27,1065 +90,480 @@ void ReadCoeff(struct IonoCoeff *Coeff, int month, long What2Read) {
 	 *			struct IonoCoeff *Coeff - The Coeff structure will contain pointers to the 
 	 *				the desired data from the coefficient file
 	 *
+	 *			Returns
+	 *				RTN_READCOEFFOK
+	 *				RTN_ERRCANTOPENCOEFF
+	 *				RTN_ERRREADCOEFF
+	 *				RTN_ERRALLOCATECOEFF
+	 *
+	 *		SUBROUTINES
+	 *			MapCoeffCache()
+	 *			ParseCoeffTxt()
+	 *			WriteCoeffCache()
+	 *			FreeCoeffArrays()
+	 *
 	 */
 	 
-	int i,j,k;
-	int n,m;
-
-	// A is the array that is read into from the file and aids in reshaping the target arrays
-	// in the Coeff structure
-	double *A;
-	
-	char line[256];
-
-	char CoeffFile[14];
-	char InFilePath[270];
-	
-	FILE *fp;
+	struct CoeffCacheHeader hdr;
+	struct stat st;
 
-	strcpy(InFilePath, "..\\..\\..\\data\\coeffs\\txt\\");
-	sprintf(CoeffFile, "COEFF%02dW.txt", month);
-	strcat(InFilePath, CoeffFile);
+	const struct CoeffBlock *blk;
 
-	fp = fopen(InFilePath, "r"); 
-	if(fp == NULL) {
-		printf("ReadCoeff: ERROR Can't find input file - %s\n", InFilePath);
-		printf("Press Enter...");
-		getchar();
-		return;
-	};
-	
-	// Clear the Coeff structure
-	NullCoeffArrays(Coeff);
+	unsigned char *image;	// The cache mapping or the parsed text in the same layout
+	size_t mapsize;
 
-	// Read the first header line
-	fgets(line, 256, fp);
+	double **rows;			// Row pointers of a double array
+	double ***planes;		// Plane pointers of a three dimensional double array
+	double *x;				// Values of a double array
 
-	// Store the header name
-	strcpy(Coeff->name, line);
-	
-	//************************************************************************************
-	// if2(10) & xf2(13,76,2)
-	
-	if((What2Read & GETXF2) == GETXF2) {
-		// Create the if2 array
-		Coeff->if2 = (int*) malloc(10 * sizeof(int));
-		// Create the xf2 array
-		Coeff->xf2 = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xf2[n] = (double**) malloc(76 * sizeof(double*));
-			for(m=0; m<76; m++) {
-				Coeff->xf2[n][m] = (double*) malloc(13 * sizeof(double));
-			};
-		};
+	int b, n, m;
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(13*76*2 * sizeof(double));
-
-		// Read the line "if2(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the if2 array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->if2+0, Coeff->if2+1, Coeff->if2+2,
-											   Coeff->if2+3, Coeff->if2+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->if2+5, Coeff->if2+6, Coeff->if2+7,
-											   Coeff->if2+8, Coeff->if2+9);
-		// Read the line "xf2(13,76,2)"
-		fgets(line, 256, fp);
-	
-		// Read 395 lines into the array 
-		for(n=0; n<395; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<76; j++) {
-				for(k=0; k<13; k++) {
-					Coeff->xf2[i][j][k] = *(A+76*13*i+13*j+k);
-				}
-			}
-		};
+	char CoeffFile[32];
+	char InFilePath[300];
+	char CacheFilePath[310];
 
-		// Free A
-		free(A);
+	// Clear the Coeff structure
+	NullCoeffArrays(Coeff);
 
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<400; n++) {
-			fgets(line, 256, fp); 
-		};
+	strcpy(InFilePath, DataFilePath);
+	sprintf(CoeffFile, "COEFF%02dW.txt", month);
+	strcat(InFilePath, CoeffFile);
+	sprintf(CacheFilePath, "%s.cache", InFilePath);
+
+	if(stat(InFilePath, &st) != 0) {
+		printf("ReadCoeff: ERROR Can't find input file - %s\n", InFilePath);
+		return RTN_ERRCANTOPENCOEFF;
 	};
 
-	//************************************************************************************
-	// ifm3(10) & xfm3(9,49,2)
-
-	if((What2Read & GETXFM3) == GETXFM3) {
-		// Create the ifm3 array
-		Coeff->ifm3 = (int*) malloc(10 * sizeof(int));
-		// Create the xfm3 array
-		Coeff->xfm3 = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xfm3[n] = (double**) malloc(49 * sizeof(double*));
-			for(m=0; m<49; m++) {
-				Coeff->xfm3[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
+	// The cache header describes the text file that it was made from.
+	memset(&hdr, 0, sizeof(struct CoeffCacheHeader));
+	memcpy(hdr.magic, COEFFCACHEMAGIC, sizeof(hdr.magic));
+	hdr.byteorder = COEFFBYTEORDER;
+	hdr.version = COEFFCACHEVERSION;
+	hdr.txtsize = (long long)st.st_size;
+	hdr.txtmtime = (long long)st.st_mtime;
+	hdr.nblocks = NCOEFFBLOCKS;
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*49*2 * sizeof(double));
-
-		// Read the line "ifm3(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ifm3 array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ifm3, Coeff->ifm3+1, Coeff->ifm3+2,
-											   Coeff->ifm3+3, Coeff->ifm3+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ifm3+5, Coeff->ifm3+6, Coeff->ifm3+7,
-											   Coeff->ifm3+8, Coeff->ifm3+9);
-		// Read the line "xfm3(19,49,2)"
-		fgets(line, 256, fp);
-
-		// Read 176 lines into the array A
-		for(n=0; n<176; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
+	image = MapCoeffCache(CacheFilePath, &hdr, What2Read, &mapsize);
+	if(image == NULL) {
+		image = ParseCoeffTxt(InFilePath, &hdr);
+		if(image == NULL) {
+			printf("ReadCoeff: ERROR Incomplete input file - %s\n", InFilePath);
+			return RTN_ERRREADCOEFF;
 		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf\n", A+5*n, A+5*n+1);
-
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<49; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->xfm3[i][j][k] = *(A+49*9*i+9*j+k);
-				}
-			}
-		};
-
-		// Free A
-		free(A);
+		mapsize = 0;
 
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<181; n++) {
-			fgets(line, 256, fp); 
+		if(WriteCoeffCache(CacheFilePath, image) != RTN_READCOEFFOK) {
+			printf("ReadCoeff: Can't write cache file %s\n", CacheFilePath);
 		};
 	};
-	//************************************************************************************
-	// ie(10) & xe(9,22,2)
-	if((What2Read & GETXE) == GETXE) {
-		// Create the ie array
-		Coeff->ie = (int*) malloc(10 * sizeof(int));
-		// Create the xe array
-		Coeff->xe = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xe[n] = (double**) malloc(22 * sizeof(double*));
-			for(m=0; m<22; m++) {
-				Coeff->xe[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
-
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*22*2 * sizeof(double));
-		
-		// Read the line "ie(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ie array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ie, Coeff->ie+1, Coeff->ie+2,
-											   Coeff->ie+3, Coeff->ie+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ie+5, &Coeff->ie+6, Coeff->ie+7,
-											   Coeff->ie+8, &Coeff->ie+9);
-		// Read the line "xe(13,76,2)"
-		fgets(line, 256, fp);
-
-		// Read 79 lines into the array A
-		for(n=0; n<79; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<22; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->xe[i][j][k] = *(A+22*9*i+9*j+k);
-				}
-			}
-		};
 
-		// Free A
-		free(A);
+	Coeff->map = image;
+	Coeff->mapsize = mapsize;
 
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<84; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
+	// Store the header name
+	memcpy(&hdr, image, sizeof(struct CoeffCacheHeader));
+	hdr.name[sizeof(hdr.name)-1] = '\0';
+	strcpy(Coeff->name, hdr.name);
 
-	//************************************************************************************
-	// iesu(10) & xesu(5,55,2)
-	if((What2Read & GETXESU) == GETXESU) {
-		// Create the iesu array
-		Coeff->iesu = (int*) malloc(10 * sizeof(int));
-		// Create the xesu array
-		Coeff->xesu = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xesu[n] = (double**) malloc(55 * sizeof(double*));
-			for(m=0; m<55; m++) {
-				Coeff->xesu[n][m] = (double*) malloc(5 * sizeof(double));
-			};
-		};
+	// Point the requested arrays into their blocks. The row pointers of a block are one allocation.
+	for(b=0; b<NCOEFFBLOCKS; b++) {
+		blk = &CoeffBlocks[b];
+		if((What2Read & blk->flag) != blk->flag) continue; // This data is not desired
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(5*55*2 * sizeof(double));
-
-		// Read the line "iesu(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the iesu array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->iesu, Coeff->iesu+1, Coeff->iesu+2,
-											   Coeff->iesu+3, Coeff->iesu+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->iesu+5, &Coeff->iesu+6, Coeff->iesu+7,
-											   Coeff->iesu+8, &Coeff->iesu+9);
-		// Read the line "xesu(13,76,2)"
-		fgets(line, 256, fp);
-	
-		// Read 79 lines into the array A
-		for(n=0; n<110; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
+		if(blk->nint != 0) {
+			*(int **)((char *)Coeff + blk->ioff) = (int *)(image + hdr.block[b].ioffset);
 		};
 
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<55; j++) {
-				for(k=0; k<5; k++) {
-					Coeff->xesu[i][j][k] = *(A+55*5*i+5*j+k);
-				}
-			}
-		};
-
-		// Free A
-		free(A);
-
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<114; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// ies(10) & xes(7,61,2)
-	if((What2Read & GETXES) == GETXES) {
-		// Create the ies array
-		Coeff->ies = (int*) malloc(10 * sizeof(int));
-		// Create the xes array
-		Coeff->xes = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xes[n] = (double**) malloc(61 * sizeof(double*));
-			for(m=0; m<61; m++) {
-				Coeff->xes[n][m] = (double*) malloc(7 * sizeof(double));
+		x = (double *)(image + hdr.block[b].xoffset);
+		if(blk->ndims == 2) {
+			rows = (double **) malloc(blk->dim[0] * sizeof(double *));
+			if(rows == NULL) {
+				FreeCoeffArrays(Coeff);
+				return RTN_ERRALLOCATECOEFF;
+			};
+			for(n=0; n<blk->dim[0]; n++) {
+				rows[n] = x + n*blk->dim[1];
 			};
+			*(double ***)((char *)Coeff + blk->xoff) = rows;
+		}
+		else {
+			planes = (double ***) malloc(blk->dim[0] * sizeof(double **) + blk->dim[0]*blk->dim[1] * sizeof(double *));
+			if(planes == NULL) {
+				FreeCoeffArrays(Coeff);
+				return RTN_ERRALLOCATECOEFF;
+			};
+			rows = (double **)(planes + blk->dim[0]);
+			for(n=0; n<blk->dim[0]; n++) {
+				planes[n] = rows + n*blk->dim[1];
+				for(m=0; m<blk->dim[1]; m++) {
+					planes[n][m] = x + (n*blk->dim[1] + m)*blk->dim[2];
+				};
+			};
+			*(double ****)((char *)Coeff + blk->xoff) = planes;
 		};
+	};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(7*61*2 * sizeof(double));
-
-		// Read the line "ies(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ies array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ies, Coeff->ies+1, Coeff->ies+2,
-											   Coeff->ies+3, Coeff->ies+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ies+5, &Coeff->ies+6, Coeff->ies+7,
-											   Coeff->ies+8, &Coeff->ies+9);
-		// Read the line "xes(7,61,2)"
-		fgets(line, 256, fp);
-
-		// Read 79 lines into the array A
-		for(n=0; n<170; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3);
-
-		// Reshape A in to the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<61; j++) {
-				for(k=0; k<7; k++) {
-					Coeff->xes[i][j][k] = *(A+61*7*i+7*j+k);
-				}
-			}
-		};
+	return RTN_READCOEFFOK;
+};
 
-		// Free A
-		free(A);
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<175; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// iels(10) & xels(5,55,2)
-	if((What2Read & GETXESL) == GETXESL) {
-		// Create the iels array
-		Coeff->iesl = (int*) malloc(10 * sizeof(int));
-		// Create the xels array
-		Coeff->xesl = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xesl[n] = (double**) malloc(55 * sizeof(double*));
-			for(m=0; m<55; m++) {
-				Coeff->xesl[n][m] = (double*) malloc(5 * sizeof(double));
-			};
-		};
+unsigned char *ParseCoeffTxt(const char *InFilePath, struct CoeffCacheHeader *expected) {
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(5*55*2 * sizeof(double));
-
-		// Read the line "iels(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the iels array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->iesl, Coeff->iesl+1, Coeff->iesl+2,
-											   Coeff->iesl+3, Coeff->iesl+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->iesl+5, &Coeff->iesl+6, Coeff->iesl+7,
-											   Coeff->iesl+8, &Coeff->iesl+9);
-		// Read the line "xels(13,76,2)"
-		fgets(line, 256, fp);
-
-		// Read 79 lines into the array A
-		for(n=0; n<110; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
+	/*
+	 * ParseCoeffTxt() - Reads the whole text file into an image with the layout of the cache file. Each block is found
+	 *		by the name line that starts it, for example "xf2(13,76,2)", and its values are read until the next name line.
+	 *		Returns NULL if the file can't be read, a block does not have the expected number of values or any array
+	 *		of the block table is missing or repeated, so that an incomplete image is never used or cached.
+	 *
+	 *		INPUT
+	 *			const char *InFilePath
+	 *			struct CoeffCacheHeader *expected - The header without the index, name or checksum
+	 *
+	 *		OUTPUT
+	 *			The image, which the caller frees
+	 *
+	 */
 
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<55; j++) {
-				for(k=0; k<5; k++) {
-					Coeff->xesl[i][j][k] = *(A+55*5*i+5*j+k);
-				}
-			}
-		};
+	struct CoeffCacheHeader *hdr;
+	const struct CoeffBlock *blk;
 
-		// Free A
-		free(A);
+	unsigned char *image;
+	size_t size;
 
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<114; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// ihpo1(10) & xhpo1(13,29,2)
-	if((What2Read & GETXHPO1) == GETXHPO1) {
-		// Create the ihpo1 array
-		Coeff->ihpo1 = (int*) malloc(10 * sizeof(int));
-		// Create the xhpo1 array
-		Coeff->xhpo1 = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xhpo1[n] = (double**) malloc(29 * sizeof(double*));
-			for(m=0; m<29; m++) {
-				Coeff->xhpo1[n][m] = (double*) malloc(13 * sizeof(double));
-			};
-		};
+	char *txt;				// The text file
+	char *p, *q;
+	char *name;				// Name of the array at p or NULL
+	long len;
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(13*29*2 * sizeof(double));
-
-		// Read the line "ihpo1(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ihpo1 array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihpo1, Coeff->ihpo1+1, Coeff->ihpo1+2,
-											   Coeff->ihpo1+3, Coeff->ihpo1+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihpo1+5, &Coeff->ihpo1+6, Coeff->ihpo1+7,
-											   Coeff->ihpo1+8, &Coeff->ihpo1+9);
-		// Read the line "xhpo1(13,29,2)"
-		fgets(line, 256, fp);
-	
-		// Read 79 lines into the array A
-		for(n=0; n<150; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3);
-
-		// Reshape A in to the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<29; j++) {
-				for(k=0; k<13; k++) {
-					Coeff->xhpo1[i][j][k] = *(A+29*13*i+13*j+k);
-				}
-			}
-		};
+	int *ivals;				// Int array being read or NULL
+	double *xvals;			// Double array being read or NULL
+	int n;					// Number of values expected
+	int count;				// Number of values read
+	int b, l;
+	int ok;
 
-		// Free A
-		free(A);
+	char ifilled[NCOEFFBLOCKS];	// The int array of the block has been read
+	char xfilled[NCOEFFBLOCKS];	// The double array of the block has been read
 
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<155; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// ihpo2(10) & xhpo2(9,55,2)
-	if((What2Read & GETXHPO2) == GETXHPO2) {
-		// Create the ihpo2 array
-		Coeff->ihpo2 = (int*) malloc(10 * sizeof(int));
-		// Create the xhpo2 array
-		Coeff->xhpo2 = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xhpo2[n] = (double**) malloc(55 * sizeof(double*));
-			for(m=0; m<55; m++) {
-				Coeff->xhpo2[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
+	FILE *fp;
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*55*2 * sizeof(double));
-
-		// Read the line "ihpo2(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ihpo2 array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihpo2, Coeff->ihpo2+1, Coeff->ihpo2+2,
-											   Coeff->ihpo2+3, Coeff->ihpo2+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihpo2+5, &Coeff->ihpo2+6, Coeff->ihpo2+7,
-											   Coeff->ihpo2+8, &Coeff->ihpo2+9);
-		// Read the line "xhpo2(9,55,2)"
-		fgets(line, 256, fp);
-	
-		// Read 79 lines into the array A
-		for(n=0; n<198; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
+	fp = fopen(InFilePath, "rb");
+	if(fp == NULL) return NULL;
 
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<55; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->xhpo2[i][j][k] = *(A+55*9*i+9*j+k);
-				}
-			}
-		};
+	fseek(fp, 0, SEEK_END);
+	len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
 
-		// Free A
-		free(A);
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<202; n++) {
-			fgets(line, 256, fp); 
-		};
+	txt = (char *) malloc(len + 1);
+	if(txt == NULL) {
+		fclose(fp);
+		return NULL;
 	};
-	//************************************************************************************
-	// ihp(10) & xhp(9,37,2)
-	if((What2Read & GETXHP) == GETXHP) {
-		// Create the ihp array
-		Coeff->ihp = (int*) malloc(10 * sizeof(int));
-		// Create the xhp array
-		Coeff->xhp = (double***) malloc(2 * sizeof(double**));
-		for(n=0; n<2; n++) {
-			Coeff->xhp[n] = (double**) malloc(37 * sizeof(double*));
-			for(m=0; m<37; m++) {
-				Coeff->xhp[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
-
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*37*2 * sizeof(double));
-
-		// Read the line "ihp(10)"
-		fgets(line, 256, fp);
-
-		// Read 2 lines into the ihp array
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihp, Coeff->ihp+1, Coeff->ihp+2,
-											   Coeff->ihp+3, Coeff->ihp+4);
-		fgets(line, 256, fp); 
-		sscanf(line, " %d %d %d %d %d\n", Coeff->ihp+5, &Coeff->ihp+6, Coeff->ihp+7,
-											   Coeff->ihp+8, &Coeff->ihp+9);
-		// Read the line "xhp(13,76,2)"
-		fgets(line, 256, fp);
-	
-		// Read 79 lines into the array A
-		for(n=0; n<133; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<2; i++) {
-			for(j=0; j<37; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->xhp[i][j][k] = *(A+37*9*i+9*j+k);
+	ok = (fread(txt, 1, len, fp) == (size_t)len);
+	fclose(fp);
+	txt[len] = '\0';
+
+	// Lay the image out from the block table and clear it
+	size = CoeffIndex(expected);
+	image = (unsigned char *) calloc(1, size);
+	if((image == NULL) || !ok) {
+		free(txt);
+		free(image);
+		return NULL;
+	};
+	hdr = (struct CoeffCacheHeader *)image;
+	memcpy(hdr, expected, sizeof(struct CoeffCacheHeader));
+
+	// The first line, with its line end, is the header name
+	p = strchr(txt, '\n');
+	p = (p == NULL) ? txt + len : p + 1;
+	l = (int)(p - txt);
+	if(l > (int)sizeof(hdr->name) - 1) l = (int)sizeof(hdr->name) - 1;
+	memcpy(hdr->name, txt, l);
+
+	memset(ifilled, 0, sizeof(ifilled));
+	memset(xfilled, 0, sizeof(xfilled));
+
+	ivals = NULL;
+	xvals = NULL;
+	n = 0;
+	count = 0;
+	while(ok && (*p != '\0')) {
+		while((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')) p++;
+		if((*p == '\0') || (*p == '\032')) break; // Some of the files end with a DOS end of file
+
+		if(((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z'))) {
+			// A name line ends the block before it
+			ok = (count == n);
+			name = p;
+			while((*p != '(') && (*p != '\n') && (*p != '\0')) p++;
+			l = (int)(p - name);
+			while((*p != '\n') && (*p != '\0')) p++;
+
+			ivals = NULL;
+			xvals = NULL;
+			n = 0;
+			count = 0;
+			for(b=0; b<NCOEFFBLOCKS; b++) {
+				blk = &CoeffBlocks[b];
+				if((blk->iname != NULL) && ((int)strlen(blk->iname) == l) && (strncmp(name, blk->iname, l) == 0)) {
+					ivals = (int *)(image + hdr->block[b].ioffset);
+					n = blk->nint;
+					ok = ok && !ifilled[b];
+					ifilled[b] = 1;
 				}
+				else if(((int)strlen(blk->xname) == l) && (strncmp(name, blk->xname, l) == 0)) {
+					xvals = (double *)(image + hdr->block[b].xoffset);
+					n = blk->dim[0]*blk->dim[1]*blk->dim[2];
+					ok = ok && !xfilled[b];
+					xfilled[b] = 1;
+				};
+			};
+			ok = ok && (n != 0);
+		}
+		else {
+			if(count == n) {
+				ok = 0;
+				q = p;
 			}
-		};
-
-		// Free A
-		free(A);
-
-	}
-	else { // This data is not desired
-		// Move to the next block
-		for(n=0; n<138; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// fakp(29,16,6)
-	if((What2Read & GETFAKP) == GETFAKP) {
-		// Create the fakp array
-		Coeff->fakp = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->fakp[n] = (double**) malloc(16 * sizeof(double*));
-			for(m=0; m<16; m++) {
-				Coeff->fakp[n][m] = (double*) malloc(29 * sizeof(double));
+			else if(ivals != NULL) {
+				ivals[count++] = (int)strtol(p, &q, 10);
+			}
+			else {
+				xvals[count++] = strtod(p, &q);
 			};
+			ok = ok && (q != p);
+			p = q;
 		};
+	};
+	ok = ok && (count == n);
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(29*16*6 * sizeof(double));
-
-		// Read the line "fakp(29,16,6)"
-		fgets(line, 256, fp);
+	// Every array of the block table must have been read. A name line is only passed when the array 
+	// before it is complete.
+	for(b=0; b<NCOEFFBLOCKS; b++) {
+		ok = ok && xfilled[b] && ((CoeffBlocks[b].nint == 0) || ifilled[b]);
+	};
 
-		// Read 556 lines into the array A
-		for(n=0; n<556; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<16; j++) {
-				for(k=0; k<29; k++) {
-					Coeff->fakp[i][j][k] = *(A+16*29*i+29*j+k);
-				};
-			};
-		};
+	free(txt);
 
-		// Free A
-		free(A);
+	if(!ok) {
+		free(image);
+		return NULL;
+	};
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<558; n++) {
-			fgets(line, 256, fp); 
-		};
+	for(b=0; b<NCOEFFBLOCKS; b++) {
+		hdr->block[b].checksum = CoeffChecksum(0, image + hdr->block[b].ioffset, CoeffBlockSize(&CoeffBlocks[b]));
 	};
+	hdr->checksum = CoeffChecksum(0, (const unsigned char *)hdr->block, sizeof(hdr->block));
 
-	//************************************************************************************
-	// fakabp(2,6)
-	if((What2Read & GETFAKABP) == GETFAKABP) {
-		// Create the fakabp array
-		Coeff->fakabp = (double**) malloc(6 * sizeof(double*));
-		for(m=0; m<6; m++) {
-			Coeff->fakabp[m] = (double*) malloc(2 * sizeof(double));
-		};
+	return image;
+};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(2*6 * sizeof(double));
+size_t CoeffIndex(struct CoeffCacheHeader *hdr) {
 
-		// Read the line "fakabp(2,6)"
-		fgets(line, 256, fp);
+	/*
+	 * CoeffIndex() - Fills the block index of the header from the block table and returns the size of the file.
+	 *		Each array starts on a multiple of 8 bytes so the doubles in a mapping are aligned.
+	 */
 
-		// Read 2 lines into the array A
-		for(n=0; n<2; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf\n", A+5*n, A+5*n+1);
-		
-		// Reshape A into the Coeff structure 
-		for(j=0; j<6; j++) {
-			for(k=0; k<2; k++) {
-				Coeff->fakabp[j][k] = *(A+2*j+k);
-			};
-		};
+	const struct CoeffBlock *blk;
+
+	size_t offset;
+	int b;
+
+	offset = sizeof(struct CoeffCacheHeader);
+	for(b=0; b<NCOEFFBLOCKS; b++) {
+		blk = &CoeffBlocks[b];
+		hdr->block[b].flag = (int)blk->flag;
+		hdr->block[b].nint = blk->nint;
+		hdr->block[b].ndims = blk->ndims;
+		hdr->block[b].dim[0] = blk->dim[0];
+		hdr->block[b].dim[1] = blk->dim[1];
+		hdr->block[b].dim[2] = blk->dim[2];
+		hdr->block[b].ioffset = (long long)offset;
+		hdr->block[b].xoffset = (long long)(offset + CoeffBlockSize(blk) - blk->dim[0]*blk->dim[1]*blk->dim[2] * sizeof(double));
+		offset += CoeffBlockSize(blk);
+	};
 
-		// Free A
-		free(A);
+	return offset;
+};
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<4; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// dud(5,12,5)
-	if((What2Read & GETDUD) == GETDUD) {
-		// Create the dud array
-		Coeff->dud = (double***) malloc(5 * sizeof(double**));
-		for(n=0; n<5; n++) {
-			Coeff->dud[n] = (double**) malloc(12 * sizeof(double*));
-			for(m=0; m<12; m++) {
-				Coeff->dud[n][m] = (double*) malloc(5 * sizeof(double));
-			};
-		};
+size_t CoeffBlockSize(const struct CoeffBlock *blk) {
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(5*12*5 * sizeof(double));
+	/*
+	 * CoeffBlockSize() - Returns the size of a block in the cache file. The int array is padded to a multiple of 8 bytes.
+	 */
 
-		// Read the line "dud(5,12,5)"
-		fgets(line, 256, fp);
+	return ((blk->nint * sizeof(int) + 7) & ~(size_t)7) + blk->dim[0]*blk->dim[1]*blk->dim[2] * sizeof(double);
+};
 
-		// Read 60 lines into the array A
-		for(n=0; n<60; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<5; i++) {
-			for(j=0; j<12; j++) {
-				for(k=0; k<5; k++) {
-					Coeff->dud[i][j][k] = *(A+5*12*i+5*j+k);
-				};
-			};
-		};
+unsigned char *MapCoeffCache(const char *CacheFilePath, struct CoeffCacheHeader *expected, long What2Read, size_t *mapsize) {
 
-		// Free A
-		free(A);
+	/*
+	 * MapCoeffCache() - Maps the cache file copy-on-write into memory if its header matches expected and the 
+	 *		checksums of the index and of the blocks in What2Read are good. Returns NULL otherwise. The other 
+	 *		blocks are not touched so their pages are never read.
+	 */
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<61; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// fam(14,12)
-	if((What2Read & GETFAM) == GETFAM) {
-		// Create the fam array
-		Coeff->fam = (double**) malloc(12 * sizeof(double*));
-		for(m=0; m<12; m++) {
-			Coeff->fam[m] = (double*) malloc(14 * sizeof(double));
-		};
-		
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(12*14 * sizeof(double));
+	struct CoeffCacheHeader hdr;
+	struct CoeffCacheHeader index;
 
-		// Read the line "fam(14,12)"
-		fgets(line, 256, fp);
+	unsigned char *map;
+	int b;
+	int ok;
 
-		// Read 33 lines into the array A
-		for(n=0; n<33; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2);
-		
-		// Reshape A into the Coeff structure 
-		for(j=0; j<12; j++) {
-			for(k=0; k<14; k++) {
-				Coeff->fam[j][k] = *(A+14*j+k);
-			};
-		};
+#ifdef _WIN32
+	HANDLE hFile;
+	HANDLE hMap;
+	LARGE_INTEGER size;
 
-		// Free A
-		free(A);
+	hFile = CreateFileA(CacheFilePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE) return NULL;
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<35; n++) {
-			fgets(line, 256, fp); 
-		};
+	if((GetFileSizeEx(hFile, &size) == 0) || (size.QuadPart < (LONGLONG)sizeof(struct CoeffCacheHeader))) {
+		CloseHandle(hFile);
+		return NULL;
 	};
-	//************************************************************************************
-	// sys1(9,16,6)
-	if((What2Read & GETSYS1) == GETSYS1) {
-		// Create the sys1 array
-		Coeff->sys1 = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->sys1[n] = (double**) malloc(16 * sizeof(double*));
-			for(m=0; m<16; m++) {
-				Coeff->sys1[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*16*6 * sizeof(double));
+	hMap = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle(hFile);
+	if(hMap == NULL) return NULL;
 
-		// Read the line "sys1(9,16,6)"
-		fgets(line, 256, fp);
+	// The view keeps the mapping object alive after its handle is closed.
+	map = (unsigned char *)MapViewOfFile(hMap, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(hMap);
+	if(map == NULL) return NULL;
 
-		// Read 172 lines into the array A
-		for(n=0; n<172; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<16; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->sys1[i][j][k] = *(A+16*9*i+9*j+k);
-				};
-			};
-		};
+	*mapsize = (size_t)size.QuadPart;
+#elif __linux__ || __APPLE__
+	int fd;
+	struct stat st;
 
-		// Free A
-		free(A);
+	fd = open(CacheFilePath, O_RDONLY);
+	if(fd < 0) return NULL;
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<174; n++) {
-			fgets(line, 256, fp); 
-		};
+	if((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(struct CoeffCacheHeader))) {
+		close(fd);
+		return NULL;
 	};
-	//************************************************************************************
-	// sys2(9,16,6)
-	if((What2Read & GETSYS2) == GETSYS2) {
-		// Create the sys2 array
-		Coeff->sys2 = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->sys2[n] = (double**) malloc(16 * sizeof(double*));
-			for(m=0; m<16; m++) {
-				Coeff->sys2[n][m] = (double*) malloc(9 * sizeof(double));
-			};
-		};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*16*6 * sizeof(double));
+	map = (unsigned char *)mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == (unsigned char *)MAP_FAILED) return NULL;
 
-		// Read the line "sys2(9,16,6)"
-		fgets(line, 256, fp);
+	*mapsize = (size_t)st.st_size;
+#endif
 
-		// Read 172 lines into the array A
-		for(n=0; n<172; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<16; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->sys2[i][j][k] = *(A+16*9*i+9*j+k);
-				};
-			};
-		};
+	memcpy(&hdr, map, sizeof(struct CoeffCacheHeader));
 
-		// Free A
-		free(A);
-
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<174; n++) {
-			fgets(line, 256, fp); 
-		};
+	// The index is made from the block table so a cache from a different table is not used.
+	memset(&index, 0, sizeof(struct CoeffCacheHeader));
+	ok = (memcmp(hdr.magic, expected->magic, sizeof(hdr.magic)) == 0);
+	ok = ok && (hdr.byteorder == expected->byteorder) && (hdr.version == expected->version);
+	ok = ok && (hdr.txtsize == expected->txtsize) && (hdr.txtmtime == expected->txtmtime);
+	ok = ok && (hdr.nblocks == expected->nblocks);
+	ok = ok && (CoeffIndex(&index) == *mapsize);
+	for(b=0; b<NCOEFFBLOCKS; b++) {
+		index.block[b].checksum = hdr.block[b].checksum;
 	};
-	//************************************************************************************
-	// perr(9,4,6)
-	if((What2Read & GETPERR) == GETPERR) {
-		// Create the perr array
-		Coeff->perr = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->perr[n] = (double**) malloc(4 * sizeof(double*));
-			for(m=0; m<4; m++) {
-				Coeff->perr[n][m] = (double*) malloc(9 * sizeof(double));
-			};
+	ok = ok && (memcmp(hdr.block, index.block, sizeof(index.block)) == 0);
+	ok = ok && (CoeffChecksum(0, (const unsigned char *)hdr.block, sizeof(hdr.block)) == hdr.checksum);
+	for(b=0; ok && (b<NCOEFFBLOCKS); b++) {
+		if((What2Read & CoeffBlocks[b].flag) == CoeffBlocks[b].flag) {
+			ok = (CoeffChecksum(0, map + hdr.block[b].ioffset, CoeffBlockSize(&CoeffBlocks[b])) == hdr.block[b].checksum);
 		};
+	};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(9*4*6 * sizeof(double));
-
-		// Read the line "perr(9,4,6)"
-		fgets(line, 256, fp);
-
-		// Read 43 lines into the array A
-		for(n=0; n<43; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<4; j++) {
-				for(k=0; k<9; k++) {
-					Coeff->perr[i][j][k] = *(A+4*9*i+9*j+k);
-				};
-			};
-		};
-
-		// Free A
-		free(A);
-
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<45; n++) {
-			fgets(line, 256, fp); 
-		};
+	if(!ok) {
+		UnmapCoeffFile(map, *mapsize);
+		return NULL;
 	};
-	//************************************************************************************
-	// f2d(16,6,6)
-	if((What2Read & GETF2D) == GETF2D) {
-		// Create the f2d array
-		Coeff->f2d = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->f2d[n] = (double**) malloc(6 * sizeof(double*));
-			for(m=0; m<6; m++) {
-				Coeff->f2d[n][m] = (double*) malloc(16 * sizeof(double));
-			};
-		};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(6*16*6 * sizeof(double));
+	return map;
+};
 
-		// Read the line "f2d(16,6,6)"
-		fgets(line, 256, fp);
+int WriteCoeffCache(const char *CacheFilePath, unsigned char *image) {
 
-		// Read 115 lines into the array A
-		for(n=0; n<115; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<6; j++) {
-				for(k=0; k<16; k++) {
-					Coeff->f2d[i][j][k] = *(A+6*16*i+16*j+k);
-				};
-			};
-		};
+	/*
+	 * WriteCoeffCache() - Writes the image made by ParseCoeffTxt() as the cache file. A partly written
+	 *		file is removed so that it is not mistaken for a cache.
+	 */
 
-		// Free A
-		free(A);
+	struct CoeffCacheHeader hdr;
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<117; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// pko(8,7,6)
-	if((What2Read & GETPKO) == GETPKO) {
-		// Create the pko array
-		Coeff->pko = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->pko[n] = (double**) malloc(7 * sizeof(double*));
-			for(m=0; m<7; m++) {
-				Coeff->pko[n][m] = (double*) malloc(8 * sizeof(double));
-			};
-		};
+	size_t size;
+	int ok;
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(8*7*6 * sizeof(double));
+	FILE *fp;
 
-		// Read the line "pko(8,7,6)"
-		fgets(line, 256, fp);
+	memset(&hdr, 0, sizeof(struct CoeffCacheHeader));
+	size = CoeffIndex(&hdr);
 
-		// Read 67 lines into the array A
-		for(n=0; n<67; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<7; j++) {
-				for(k=0; k<8; k++) {
-					Coeff->pko[i][j][k] = *(A+7*8*i+8*j+k);
-				};
-			};
-		};
+	fp = fopen(CacheFilePath, "wb");
+	if(fp == NULL) return RTN_ERRCANTOPENCOEFF;
 
-		// Free A
-		free(A);
+	ok = (fwrite(image, 1, size, fp) == size);
+	ok = (fclose(fp) == 0) && ok;
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<69; n++) {
-			fgets(line, 256, fp); 
-		};
+	if(!ok) {
+		remove(CacheFilePath);
+		return RTN_ERRCANTOPENCOEFF;
 	};
-	//************************************************************************************
-	// slp(8,7,6)
-	if((What2Read & GETSLP) == GETSLP) {
-		// Create the slp array
-		Coeff->slp = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->slp[n] = (double**) malloc(7 * sizeof(double*));
-			for(m=0; m<7; m++) {
-				Coeff->slp[n][m] = (double*) malloc(8 * sizeof(double));
-			};
-		};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(8*7*6 * sizeof(double));
+	return RTN_READCOEFFOK;
+};
 
-		// Read the line "slp(8,7,6)"
-		fgets(line, 256, fp);
+void UnmapCoeffFile(void *map, size_t mapsize) {
 
-		// Read 67 lines into the array A
-		for(n=0; n<67; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<7; j++) {
-				for(k=0; k<8; k++) {
-					Coeff->slp[i][j][k] = *(A+7*8*i+8*j+k);
-				};
-			};
-		};
+	/*
+	 * UnmapCoeffFile() - Releases a mapping made by MapCoeffCache().
+	 */
 
-		// Free A
-		free(A);
+#ifdef _WIN32
+	UnmapViewOfFile(map);
+#elif __linux__ || __APPLE__
+	munmap(map, mapsize);
+#endif
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<69; n++) {
-			fgets(line, 256, fp); 
-		};
-	};
-	//************************************************************************************
-	// ccr(8,7,6)
-	if((What2Read & GETCCR) == GETCCR) {
-		// Create the ccr array
-		Coeff->ccr = (double***) malloc(6 * sizeof(double**));
-		for(n=0; n<6; n++) {
-			Coeff->ccr[n] = (double**) malloc(7 * sizeof(double*));
-			for(m=0; m<7; m++) {
-				Coeff->ccr[n][m] = (double*) malloc(8 * sizeof(double));
-			};
-		};
+	return;
+};
 
-		// Allocate the array A that will allow for reshaping
-		A = (double*) malloc(8*7*6 * sizeof(double));
+unsigned int CoeffChecksum(unsigned int crc, const unsigned char *buf, size_t len) {
 
-		// Read the line "ccr(8,7,6)"
-		fgets(line, 256, fp);
+	/*
+	 * CoeffChecksum() - Returns the CRC-32 (IEEE 802.3) of buf continued from crc. Start with crc = 0.
+	 */
 
-		// Read 67 lines into the array A
-		for(n=0; n<67; n++) {
-			fgets(line, 256, fp); 
-			sscanf(line, " %lf %lf %lf %lf %lf\n", A+5*n, A+5*n+1, A+5*n+2, A+5*n+3, A+5*n+4);
-		};
-		// Read the last partial line
-		fgets(line, 256, fp); 
-		sscanf(line, " %lf\n", A+5*n);
-		
-		// Reshape A into the Coeff structure 
-		for(i=0; i<6; i++) {
-			for(j=0; j<7; j++) {
-				for(k=0; k<8; k++) {
-					Coeff->ccr[i][j][k] = *(A+7*8*i+8*j+k);
-				};
-			};
-		};
+	static unsigned int table[256];
+	static int init = 0;
 
-		// Free A
-		free(A);
+	unsigned int c;
+	int i, j;
 
-	}
-	else {// This data is not desired
-		// Move to the next block
-		for(n=0; n<69; n++) {
-			fgets(line, 256, fp); 
+	if(init == 0) {
+		for(i=0; i<256; i++) {
+			c = (unsigned int)i;
+			for(j=0; j<8; j++) {
+				c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : (c >> 1);
+			};
+			table[i] = c;
 		};
+		init = 1;
 	};
 
-	/**********************************************************************************************/
-
-	// Clean up;
-	fclose(fp);
+	crc = ~crc;
+	while(len--) {
+		crc = table[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+	};
 
-	return;
+	return ~crc;
 };
 
 void	FreeCoeffArrays(struct IonoCoeff *Coeff) {
 
 	/*
-	 *	FreeCoeffArrays() - Frees the memory 
+	 *	FreeCoeffArrays() - Frees the row pointers of the arrays and releases the cache mapping
+	 *		or parsed text that they point into
 	 *
 	 *		INPUT
 	 *			struct IonoCoeff *Coeff
@@ -1095,36 +573,26 @@ void	FreeCoeffArrays(struct IonoCoeff *Coeff) {
 	 *
 	 */
 
+	 void **x;
+	 int b;
+
+	 // The int arrays are in the image. Each double array is one allocation of row pointers.
+	 for(b=0; b<NCOEFFBLOCKS; b++) {
+		 x = (void **)((char *)Coeff + CoeffBlocks[b].xoff);
+		 if(*x != NULL) free(*x);
+	 };
+
+	 if(Coeff->map != NULL) {
+		 if(Coeff->mapsize != 0) {
+			 UnmapCoeffFile(Coeff->map, Coeff->mapsize);
+		 }
+		 else {
+			 free(Coeff->map);
+		 };
+	 };
+
+	 NullCoeffArrays(Coeff);
 	 strcpy(Coeff->name, "Free");		
-	 if(Coeff->if2 != NULL)		free(Coeff->if2);		
-	 if(Coeff->xf2 != NULL)		free(Coeff->xf2);		
-	 if(Coeff->ifm3 != NULL)		free(Coeff->ifm3);		
-	 if(Coeff->xfm3 != NULL)		free(Coeff->xfm3);		
-	 if(Coeff->ie != NULL)		free(Coeff->ie);			
-	 if(Coeff->xe != NULL)		free(Coeff->xe);		
-	 if(Coeff->iesu != NULL)		free(Coeff->iesu);		
-	 if(Coeff->xesu != NULL)		free(Coeff->xesu);		
-	 if(Coeff->ies != NULL)		free(Coeff->ies);		
-	 if(Coeff->xes != NULL)		free(Coeff->xes);		
-	 if(Coeff->iesl != NULL)		free(Coeff->iesl);		
-	 if(Coeff->xesl != NULL)		free(Coeff->xesl);		
-	 if(Coeff->ihpo1 != NULL)	free(Coeff->ihpo1);		
-	 if(Coeff->xhpo1 != NULL)	free(Coeff->xhpo1);	
-	 if(Coeff->ihpo2 != NULL)	free(Coeff->ihpo2);		
-	 if(Coeff->xhpo2 != NULL)	free(Coeff->xhpo2);	
-	 if(Coeff->ihp != NULL)		free(Coeff->ihp);		
-	 if(Coeff->xhp != NULL)		free(Coeff->xhp);		
-	 if(Coeff->fakp != NULL)		free(Coeff->fakp);		
-	 if(Coeff->fakabp != NULL)	free(Coeff->fakabp);	
-	 if(Coeff->dud != NULL)		free(Coeff->dud);		
-	 if(Coeff->fam != NULL)		free(Coeff->fam);		
-	 if(Coeff->sys1 != NULL)		free(Coeff->sys1);		
-	 if(Coeff->sys2 != NULL)		free(Coeff->sys2);		
-	 if(Coeff->perr != NULL)		free(Coeff->perr);		
-	 if(Coeff->f2d != NULL)		free(Coeff->f2d);		
-	 if(Coeff->pko != NULL)		free(Coeff->pko);		
-	 if(Coeff->slp != NULL)		free(Coeff->slp);		
-	 if(Coeff->ccr != NULL)		free(Coeff->ccr);		
 
 	 return;
 
@@ -1172,6 +640,8 @@ void	NullCoeffArrays(struct IonoCoeff *Coeff) {
 	 Coeff->pko = NULL;		
 	 Coeff->slp = NULL;		
 	 Coeff->ccr = NULL;		
+	 Coeff->map = NULL;
+	 Coeff->mapsize = 0;
 
 	 return;
 };
\ No newline at end of file
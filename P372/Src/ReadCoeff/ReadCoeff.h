@@ -19,6 +19,48 @@
 #define	GETSLP		262144	// MUF statistics 
 #define	GETCCR		524288	// MUF statistics 
 
+// Return codes
+#define RTN_READCOEFFOK			0
+#define RTN_ERRCANTOPENCOEFF	1		// The text file can't be found or read
+#define RTN_ERRREADCOEFF		2		// The text file is incomplete
+#define RTN_ERRALLOCATECOEFF	3
+
+// Compiled coefficient file ************************************************************************
+// ReadCoeff() keeps the parsed COEFFxxW.txt next to it as COEFFxxW.txt.cache. The cache is the struct
+// CoeffCacheHeader, which indexes the blocks, followed by the blocks in the order of the text file. Each
+// block is its int array (if any) and then its double array, both native and in the order of the text
+// file, which is the C order of the arrays in struct IonoCoeff. The cache is mapped into memory so a block
+// is reached directly by its offset and only the checksums of the blocks that are read are checked. It is 
+// used only while the size and modification time of the text file are those recorded in the header.
+#define NCOEFFBLOCKS		20
+#define COEFFCACHEMAGIC		"P372COF"	// 7 characters and the null fill magic[8]
+#define COEFFCACHEVERSION	1
+#define COEFFBYTEORDER		0x01020304	// Written natively so a file from a machine with a different byte order is detected
+
+struct CoeffBlockIndex {
+	int flag;					// GETXF2 ... GETCCR
+	int nint;					// Number of values in the int array (10 or 0)
+	int ndims;					// Dimensions of the double array (2 or 3)
+	int dim[3];					// C order, slowest first
+	long long ioffset;			// Offset of the int array from the start of the file
+	long long xoffset;			// Offset of the double array from the start of the file
+	unsigned int checksum;		// CRC-32 of the block
+	unsigned int spare;
+};
+
+struct CoeffCacheHeader {
+	char magic[8];
+	unsigned int byteorder;
+	unsigned int version;
+	long long txtsize;			// Size of the text file (bytes)
+	long long txtmtime;			// Modification time of the text file
+	unsigned int checksum;		// CRC-32 of the block index
+	int nblocks;				// NCOEFFBLOCKS
+	char name[256];				// File header name
+	struct CoeffBlockIndex block[NCOEFFBLOCKS];
+};
+// End compiled coefficient file ********************************************************************
+
 struct IonoCoeff {
 	char name[256];		// File header name
 						// Variable name line		
@@ -51,9 +93,11 @@ struct IonoCoeff {
 	double	***pko;		// pko(8,7,6)		2734 - 2801
 	double	***slp;		// slp(8,7,6)		2803 - 2870
 	double	***ccr;		// ccr(8,7,6)		2872 - 2939
+	unsigned char *map;	// Cache mapping (or parsed text) that the arrays point into
+	size_t	mapsize;		// Size of the mapping, 0 if map was allocated
 };
 
 // ReadCoeff.c prototypes
-void ReadCoeff(struct IonoCoeff *Coeff, int month, long What2Read);
+int ReadCoeff(struct IonoCoeff *Coeff, const char *DataFilePath, int month, long What2Read);
 void FreeCoeffArrays(struct IonoCoeff *Coeff);
 void NullCoeffArrays(struct IonoCoeff *Coeff);
\ No newline at end of file
@@ -6,12 +6,22 @@
 #include "ReadCoeff.h"
 // End local include 
  
-void main() {
+void main(int argc, char *argv[]) {
 
 		struct IonoCoeff Coeff;
 
 		long What2Read;
 
+		char DataFilePath[256];
+
+		// The directory of the coefficient files may be given on the command line
+		if(argc > 1) {
+			strcpy(DataFilePath, argv[1]);
+		}
+		else {
+			strcpy(DataFilePath, "..\\..\\Data\\");
+		};
+
 		// Clear the coeff structure
 		NullCoeffArrays(&Coeff);
 		
@@ -19,7 +29,9 @@ void main() {
 							 GETXHPO1 | GETXHPO2 | GETXHP | GETFAKP | GETFAKABP | GETDUD |
 							 GETFAM | GETSYS1 | GETSYS2 | GETPERR | GETF2D | GETPKO | GETSLP | GETCCR;
 		
-		ReadCoeff(&Coeff, 4, What2Read);
+		if(ReadCoeff(&Coeff, DataFilePath, 4, What2Read) != RTN_READCOEFFOK) {
+			return;
+		};
 
 		// Do something with this wonderful data.
 
@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+	#include <Windows.h>
+#elif __linux__ || __APPLE__
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+// Local prototypes
+void *MapAntennaFile(const char *FilePath, size_t *mapsize);
+// End local prototypes
+
+DLLEXPORT int ReadAntennaBin(struct Antenna *Ant, const char *FilePath, double bearing, int silent) {
+
+	/*
+
+	  ReadAntennaBin() - Loads a compiled antenna file that was created by WriteAntennaBin(). The file is
+			mapped into memory rather than read so the load time is independent of the size of the pattern
+			and processes that load the same file share the pages. The mapping is private so the pattern
+			may still be altered, for example by SetAntennaPatternVal(), without changing the file.
+			Only the frequency row pointers are allocated. The pattern is released by FreeAntennaMemory().
+
+	 		INPUT
+	 			struct Antenna *Ant
+				const char *FilePath - Path of the compiled antenna file
+				double bearing - Main beam bearing of the antenna (radians)
+				int silent
+
+	 		OUTPUT
+	 			Ant->Name, Ant->freqn, Ant->freqs, Ant->pattern, Ant->bearing, Ant->map and Ant->mapsize
+
+				Returns
+					RTN_READANTENNAPATTERNSOK
+					RTN_ERRCANTOPENANTFILE
+					RTN_ERRANTENNABIN
+					RTN_ERRANTENNABINCHECKSUM
+					RTN_ERRALLOCATEANT
+
+	 		SUBROUTINES
+	 			MapAntennaFile()
+				AntennaChecksum()
+				UnmapAntennaFile()
+
+	 */
+
+	struct AntennaBinHeader hdr;
+
+	size_t mapsize;			// Size of the file mapping
+	size_t expected;		// Size of the file expected from the header
+	size_t row;				// Size of an elevation row in doubles
+
+	unsigned char *map;		// Start of the file mapping
+	double *freqs;			// Frequencies in the mapping
+	double *gains;			// Gain values in the mapping
+
+	int m, n;				// Loop counters
+
+	map = (unsigned char *)MapAntennaFile(FilePath, &mapsize);
+	if(map == NULL) {
+		return RTN_ERRCANTOPENANTFILE;
+	};
+
+	if(mapsize < sizeof(struct AntennaBinHeader)) {
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABIN;
+	};
+
+	memcpy(&hdr, map, sizeof(struct AntennaBinHeader));
+
+	if((memcmp(hdr.magic, ANTBINMAGIC, sizeof(hdr.magic)) != 0) || (hdr.version != ANTBINVERSION)) {
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABIN;
+	};
+
+	// The data is in native layout so the file must come from a machine with the same byte order.
+	if(hdr.byteorder != ANTBINBYTEORDER) {
+		if(silent != TRUE) {
+			printf("ReadAntennaBin: %.65s was compiled on a machine with a different byte order\n", FilePath);
+		};
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABIN;
+	};
+
+	// AntennaGain() assumes 1 degree azimuth and elevation steps.
+	if((hdr.freqn < 1) || (hdr.azin != 360) || (hdr.elen != 91)) {
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABIN;
+	};
+
+	row = (size_t)hdr.elen;
+	expected = sizeof(struct AntennaBinHeader) + (size_t)hdr.freqn*sizeof(double) + (size_t)hdr.freqn*hdr.azin*row*sizeof(double);
+	if(mapsize != expected) {
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABIN;
+	};
+
+	if(AntennaChecksum(0, map + sizeof(struct AntennaBinHeader), mapsize - sizeof(struct AntennaBinHeader)) != hdr.checksum) {
+		if(silent != TRUE) {
+			printf("ReadAntennaBin: Checksum error in %.65s\n", FilePath);
+		};
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRANTENNABINCHECKSUM;
+	};
+
+	// The header is a multiple of 8 bytes long and the mapping is page aligned so the doubles are aligned.
+	freqs = (double *)(map + sizeof(struct AntennaBinHeader));
+	gains = freqs + hdr.freqn;
+
+	// Point the rows of the pattern into the mapping.
+	Ant->pattern = (double ***) malloc(hdr.freqn * sizeof(double **));
+	if(Ant->pattern == NULL) {
+		UnmapAntennaFile(map, mapsize);
+		return RTN_ERRALLOCATEANT;
+	};
+	for(m=0; m<hdr.freqn; m++) {
+		Ant->pattern[m] = (double **) malloc(hdr.azin * sizeof(double *));
+		if(Ant->pattern[m] == NULL) {
+			while(--m >= 0) free(Ant->pattern[m]);
+			free(Ant->pattern);
+			Ant->pattern = NULL;
+			UnmapAntennaFile(map, mapsize);
+			return RTN_ERRALLOCATEANT;
+		};
+		for(n=0; n<hdr.azin; n++) {
+			Ant->pattern[m][n] = gains + ((size_t)m*hdr.azin + n)*row;
+		};
+	};
+
+	hdr.Name[sizeof(hdr.Name)-1] = '\0';
+	strcpy(Ant->Name, hdr.Name);
+	Ant->freqn = hdr.freqn;
+	Ant->freqs = freqs;
+	Ant->bearing = bearing;
+	Ant->map = map;
+	Ant->mapsize = mapsize;
+
+	// User feedback
+	if(silent != TRUE) {
+		printf("ReadAntennaBin: Mapped antenna %.35s (%d frequencies)\n", Ant->Name, Ant->freqn);
+	};
+
+	return RTN_READANTENNAPATTERNSOK;
+
+};
+
+DLLEXPORT int WriteAntennaBin(struct Antenna *Ant, const char *FilePath, int silent) {
+
+	/*
+
+	  WriteAntennaBin() - Writes an antenna pattern as a compiled antenna file that can be loaded
+			by ReadAntennaBin(). The pattern is written in the native layout of this machine.
+
+	 		INPUT
+	 			struct Antenna *Ant
+				const char *FilePath - Path of the compiled antenna file
+				int silent
+
+	 		OUTPUT
+	 			The compiled antenna file
+
+				Returns
+					RTN_WRITEANTENNABINOK
+					RTN_ERRWRITEANTENNABIN
+
+	 		SUBROUTINES
+				AntennaChecksum()
+
+	 */
+
+	struct AntennaBinHeader hdr;
+
+	FILE *fp;
+
+	int azin = 360;			// Fixed number of azimuths at 1-degree intervals
+	int elen = 91;			// Fixed number of elevations at 1-degree intervals
+	int m, n;				// Loop counters
+	int err = FALSE;
+
+	memset(&hdr, 0, sizeof(struct AntennaBinHeader));
+	memcpy(hdr.magic, ANTBINMAGIC, sizeof(hdr.magic));
+	hdr.byteorder = ANTBINBYTEORDER;
+	hdr.version = ANTBINVERSION;
+	hdr.freqn = Ant->freqn;
+	hdr.azin = azin;
+	hdr.elen = elen;
+	snprintf(hdr.Name, sizeof(hdr.Name), "%s", Ant->Name);
+
+	// The checksum covers everything after the header in the order it is written.
+	hdr.checksum = AntennaChecksum(0, (const unsigned char *)Ant->freqs, Ant->freqn*sizeof(double));
+	for(m=0; m<Ant->freqn; m++) {
+		for(n=0; n<azin; n++) {
+			hdr.checksum = AntennaChecksum(hdr.checksum, (const unsigned char *)Ant->pattern[m][n], elen*sizeof(double));
+		};
+	};
+
+	fp = fopen(FilePath, "wb");
+	if(fp == NULL) {
+		return RTN_ERRWRITEANTENNABIN;
+	};
+
+	if(fwrite(&hdr, sizeof(struct AntennaBinHeader), 1, fp) != 1) err = TRUE;
+	if(fwrite(Ant->freqs, sizeof(double), Ant->freqn, fp) != (size_t)Ant->freqn) err = TRUE;
+	for(m=0; m<Ant->freqn; m++) {
+		for(n=0; n<azin; n++) {
+			if(fwrite(Ant->pattern[m][n], sizeof(double), elen, fp) != (size_t)elen) err = TRUE;
+		};
+	};
+	if(fclose(fp) != 0) err = TRUE;
+
+	if(err == TRUE) {
+		return RTN_ERRWRITEANTENNABIN;
+	};
+
+	// User feedback
+	if(silent != TRUE) {
+		printf("WriteAntennaBin: Wrote antenna %.35s (%d frequencies) to %.65s\n", Ant->Name, Ant->freqn, FilePath);
+	};
+
+	return RTN_WRITEANTENNABINOK;
+
+};
+
+void *MapAntennaFile(const char *FilePath, size_t *mapsize) {
+
+	/*
+	  MapAntennaFile() - Maps a file copy-on-write into memory. Returns NULL if the file can not be mapped.
+	*/
+
+	void *map;
+
+#ifdef _WIN32
+	HANDLE hFile;
+	HANDLE hMap;
+	LARGE_INTEGER size;
+
+	hFile = CreateFileA(FilePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE) return NULL;
+
+	if((GetFileSizeEx(hFile, &size) == 0) || (size.QuadPart == 0)) {
+		CloseHandle(hFile);
+		return NULL;
+	};
+
+	hMap = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle(hFile);
+	if(hMap == NULL) return NULL;
+
+	// The view keeps the mapping object alive after its handle is closed.
+	map = MapViewOfFile(hMap, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(hMap);
+
+	*mapsize = (size_t)size.QuadPart;
+#elif __linux__ || __APPLE__
+	int fd;
+	struct stat st;
+
+	fd = open(FilePath, O_RDONLY);
+	if(fd < 0) return NULL;
+
+	if((fstat(fd, &st) != 0) || (st.st_size == 0)) {
+		close(fd);
+		return NULL;
+	};
+
+	map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED) return NULL;
+
+	*mapsize = (size_t)st.st_size;
+#endif
+
+	return map;
+
+};
+
+void UnmapAntennaFile(void *map, size_t mapsize) {
+
+	/*
+	  UnmapAntennaFile() - Releases a mapping made by MapAntennaFile().
+	*/
+
+#ifdef _WIN32
+	UnmapViewOfFile(map);
+#elif __linux__ || __APPLE__
+	munmap(map, mapsize);
+#endif
+
+	return;
+
+};
+
+unsigned int AntennaChecksum(unsigned int crc, const unsigned char *buf, size_t len) {
+
+	/*
+	  AntennaChecksum() - Returns the CRC-32 (IEEE 802.3) of buf continued from crc. Start with crc = 0.
+			Eight bytes are taken at a time with the tables table[k], which advance the CRC of a byte by k 
+			more zero bytes.
+	*/
+
+	static unsigned int table[8][256];
+	static int init = FALSE;
+
+	unsigned int c;
+	int i, j;
+
+	if(init == FALSE) {
+		for(i=0; i<256; i++) {
+			c = (unsigned int)i;
+			for(j=0; j<8; j++) {
+				c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : (c >> 1);
+			};
+			table[0][i] = c;
+		};
+		for(i=0; i<256; i++) {
+			for(j=1; j<8; j++) {
+				table[j][i] = (table[j-1][i] >> 8) ^ table[0][table[j-1][i] & 0xFF];
+			};
+		};
+		init = TRUE;
+	};
+
+	crc = ~crc;
+	while(len >= 8) {
+		crc ^= (unsigned int)buf[0] | ((unsigned int)buf[1] << 8) | ((unsigned int)buf[2] << 16) | ((unsigned int)buf[3] << 24);
+		crc = table[7][crc & 0xFF] ^ table[6][(crc >> 8) & 0xFF] ^ table[5][(crc >> 16) & 0xFF] ^ table[4][crc >> 24] ^
+			  table[3][buf[4]] ^ table[2][buf[5]] ^ table[1][buf[6]] ^ table[0][buf[7]];
+		buf += 8;
+		len -= 8;
+	};
+	while(len--) {
+		crc = table[0][(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+	};
+
+	return ~crc;
+
+};
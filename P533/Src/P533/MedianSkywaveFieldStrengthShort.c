@@ -1186,6 +1186,11 @@ double AntennaGain(struct PathData path, struct Antenna Ant, double delta, int d
 		B = Bearing(path.L_rx, path.L_tx, path.SorL)*R2D; // degrees
 	}
 
+	// The antenna pattern is indexed relative to the main beam of the antenna so 
+	// rotate the bearing by the direction the antenna is pointing.
+	B = fmod(B - Ant.bearing*R2D, 360.0);
+	if(B < 0.0) B += 360.0;
+
 	// Now determine the gain at the elevation, delta
 	// Find the indices to determine the neighbors for the gain interpolation.
 	deltaU = (int)ceil(delta);
@@ -1204,7 +1209,7 @@ double AntennaGain(struct PathData path, struct Antenna Ant, double delta, int d
 	// Determine the fractional column and row.
 	// The distance between indices is fixed at 1 degree.
 	r = delta - (int)delta; // The fractional part of the row
-	c = B - (int)B;			// The fractional part of the column
+	c = B - floor(B);		// The fractional part of the column
 
 	G = BilinearInterpolation(LL, LR, UL, UR, r, c);
 
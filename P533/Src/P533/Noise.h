@@ -30,10 +30,32 @@
 #define MNNOPRINT		0
 #define MNPRINTTOSTDOUT	1
 #define MNPRINTTOFILE	2
+#define MNOUTVALS		12 // Values found for each point by MakeNoise() and MakeNoiseBatch()
+
+// Number of values in each of the coefficient arrays in the order they are found in the coefficient files
+#define NFAKP			(29*16*6)
+#define NFAKABP			(2*6)
+#define NDUD			(5*12*5)
+#define NFAM			(14*12)
+#define NNOISECOEFF		(NFAKP + NFAKABP + NDUD + NFAM)
+#define NNOISEPTRS		(6 + 6*16 + 6 + 5 + 5*12 + 12) // Pointers that index them as fakp, fakabp, dud and fam
+
+// Fam cache sizes in entries. The cache grows from the smaller to the larger.
+#define FAMCACHEMIN		1024
+#define FAMCACHEMAX		524288
+
+// Noise grid. One cell in NOISEGRIDCHECK in each direction is checked against Noise() when a grid is made.
+#define NOISEGRIDVALS	3
+#define NOISEGRIDCHECK	4
 // Return ERROR >= 200 and < 220
 
 // Return ERROR from ReadFamDud()
 #define RTN_ERROPENCOEFFFILE			201 // ERROR: Can Not Open Coefficient File
+#define RTN_ERRREADCOEFFFILE			209 // ERROR: Coefficient File Is Incomplete
+#define RTN_ERRALLOCATEFAMCACHE			210 // ERROR: Allocating Memory for the Fam Cache
+#define RTN_ERRALLOCATENOISEGRID		211 // ERROR: Allocating Memory for the Noise Grid
+#define RTN_ERRNOISEGRID				212 // ERROR: Noise Grid Increments or Frequencies are Invalid
+#define RTN_ERRMAKENOISEBATCH			213 // ERROR: Invalid Handle or Points Given to MakeNoiseBatch()
 
 // Return ERROR from AllocatePathMemory(), FreePathMemory() and InputDump()
 #define RTN_ERRALLOCATEDUD				202 // ERROR: Allocating Memory for DuD
@@ -51,6 +73,9 @@
 #define RTN_NOISEOK						24 // Noise()
 #define RTN_NOISEMANMADEOK				25 // Noise() Man-made noise override
 #define RTN_MAKENOISEOK					26 // MakeNoise() Stand alone P372 caller 
+#define RTN_MAKENOISEGRIDOK				27 // MakeNoiseGrid()
+#define RTN_MAKENOISEOPENOK				28 // MakeNoiseOpen()
+#define RTN_MAKENOISEBATCHOK			29 // MakeNoiseBatch()
 
 
 /******************************* End Defines **********************************/
@@ -67,6 +92,50 @@ struct FamStats {
 	double SigmaDl;		// Standard deviation of values of Dl
 };
 
+// Fam at 1 MHz for one timeblock and location
+struct FamCacheEntry {
+	int tmblk;			// Timeblock, -1 if the entry is empty
+	double lng;			// Longitude (rad)
+	double lat;			// Latitude (rad)
+	double Fam1MHz;		// Atmospheric noise Fam (dB above kT0b at 1 MHz)
+};
+
+struct FamCache {
+	int month;			// Month of the coefficients the entries were found with
+	long hits;			// Lookups found in the cache
+	long misses;		// Lookups that were calculated
+	unsigned long size;	// Number of entries, a power of 2
+	unsigned long used;	// Number of entries that are not empty
+	struct FamCacheEntry *entry;
+};
+
+// Where the arrays start in the text coefficient file of each month
+struct CoeffIndex {
+	char file[12][270];		// File that was indexed for the month, "" if none has been
+	long offset[12][4];		// Offset of the first value of fakp, fakabp, dud and fam
+};
+
+// Noise tabulated for one hour over a latitude, longitude and frequency grid
+struct NoiseGrid {
+	int hour;				// UTC hour the grid was made for
+	double ManMadeNoise;	// Man-made noise the grid was made with
+	double latmin;			// Latitude of the first row (rad)
+	double latinc;			// Latitude increment (rad)
+	int nlat;				// Number of rows
+	double lngmin;			// Longitude of the first column (rad)
+	double lnginc;			// Longitude increment (rad)
+	int nlng;				// Number of columns
+	int nfreq;				// Number of frequencies
+	double *freq;			// Frequencies in ascending order (MHz)
+	double *val;			// FaA, DuA and DlA by frequency, row and column
+	double maxerr;			// Largest difference from Noise() found at the centres of the cells checked (dB).
+							// It is a measurement at those points, not a bound for the whole of every cell.
+	long checked;			// Number of cell centres checked
+	long lookups;			// Calls to Noise() answered from the grid
+	long exact;				// Calls to Noise() in the grid that were calculated because the cell crossed a time zone
+							// or the equator or the frequency was not in the grid
+};
+
 struct NoiseParams {
   // Output Parameters
   double FaA;  // Atmospheric noise
@@ -88,6 +157,10 @@ struct NoiseParams {
   double **fakabp;
   double **fam;
   double ***dud;
+  double *coeff; // fakp, fakabp, dud and fam as one block that the pointers above index
+  struct FamCache *FamC; // Fam at 1 MHz by timeblock and location for the month in fakp and fakabp
+  struct NoiseGrid *NoiseG; // Noise for one hour of the month by location and frequency, if it has been made
+  struct CoeffIndex *CoeffI; // Offsets of the arrays in the text coefficient files that have been read
 };
 
 // End Structures
@@ -109,8 +182,21 @@ typedef void(__cdecl* vInitializeNoise)(struct NoiseParams* noiseP);
 typedef void(__cdecl* vAtmosphericNoise)(struct NoiseParams* noiseP, int iutc, double lng, double lat, double frequency);
 // AtmosphericNoise_LT()
 typedef void(__cdecl* vAtmosphericNoise_LT)(struct NoiseParams* noiseP, struct FamStats* FamS, int lrxmt, double lng, double lat, double frequency);
+// FamCacheStats()
+typedef void(__cdecl* vFamCacheStats)(struct NoiseParams* noiseP, long* hits, long* misses);
+// MakeNoiseGrid()
+typedef int(__cdecl* iMakeNoiseGrid)(struct NoiseParams* noiseP, int hour, double latmin, double latmax, double latinc,
+	double lngmin, double lngmax, double lnginc, double* freqs, int nfreqs);
+// FreeNoiseGrid()
+typedef void(__cdecl* vFreeNoiseGrid)(struct NoiseParams* noiseP);
 // MakeNoise()
 typedef int(__stdcall* iMakeNoise)(int month, int hour, double lat, double lng, double freq, double mmnoise, char* datafilepath, double* out, int pntflag);
+// MakeNoiseOpen()
+typedef int(__cdecl* iMakeNoiseOpen)(int month, const char* datafilepath, struct NoiseParams** handle);
+// MakeNoiseBatch()
+typedef int(__cdecl* iMakeNoiseBatch)(struct NoiseParams* handle, int npnts, int* hour, double* lat, double* lng, double* freq, double* mmnoise, double* out);
+// MakeNoiseClose()
+typedef void(__cdecl* vMakeNoiseClose)(struct NoiseParams* handle);
 
 #endif
 // End P372.DLL typedef ********************************************************
@@ -126,8 +212,16 @@ DLLEXPORT char const * P372CompileTime();
 DLLEXPORT char const * P372Version();
 DLLEXPORT void AtmosphericNoise(struct NoiseParams* noiseP, int iutc, double rlng, double rlat, double frequency);
 DLLEXPORT void AtmosphericNoise_LT(struct NoiseParams* noiseP, struct FamStats* FamS, int lrxmt, double rlng, double rlat, double frequency);
+DLLEXPORT void FamCacheStats(struct NoiseParams* noiseP, long* hits, long* misses);
+DLLEXPORT int MakeNoiseGrid(struct NoiseParams* noiseP, int hour, double latmin, double latmax, double latinc,
+	double lngmin, double lngmax, double lnginc, double* freqs, int nfreqs);
+DLLEXPORT void FreeNoiseGrid(struct NoiseParams* noiseP);
 // Note: MakeNoise() requires decimal degrees lat and lng
 DLLEXPORT int MakeNoise(int month, int hour, double lat, double lng, double freq, double mmnoise, char* datafilepath, double* out, int pntflag);
+// Note: MakeNoiseBatch() requires decimal degrees lat and lng
+DLLEXPORT int MakeNoiseOpen(int month, const char* datafilepath, struct NoiseParams** handle);
+DLLEXPORT int MakeNoiseBatch(struct NoiseParams* handle, int npnts, int* hour, double* lat, double* lng, double* freq, double* mmnoise, double* out);
+DLLEXPORT void MakeNoiseClose(struct NoiseParams* handle);
 
 #if _WIN32
 // _stdcall exports dummies used to provide entry points in the DLL for MS excel
@@ -140,33 +234,55 @@ DLLEXPORT char  const* __stdcall _P372CompileTime();
 DLLEXPORT char  const* __stdcall _P372Version();
 DLLEXPORT void __stdcall _AtmosphericNoise(struct NoiseParams* noiseP, int iutc, double rlng, double rlat, double frequency);
 DLLEXPORT void __stdcall _AtmosphericNoise_LT(struct NoiseParams* noiseP, struct FamStats* FamS, int lrxmt, double rlng, double rlat, double frequency);
+DLLEXPORT void __stdcall _FamCacheStats(struct NoiseParams* noiseP, long* hits, long* misses);
+DLLEXPORT int __stdcall _MakeNoiseGrid(struct NoiseParams* noiseP, int hour, double latmin, double latmax, double latinc,
+	double lngmin, double lngmax, double lnginc, double* freqs, int nfreqs);
+DLLEXPORT void __stdcall _FreeNoiseGrid(struct NoiseParams* noiseP);
 // Note: MakeNoise() requires decimal degrees lat and lng as input
 DLLEXPORT int __stdcall _MakeNoise(int month, int hour, double lat, double lng, double freq, double mmnoise, char* datafilepath, double* out, int pntflag);
+DLLEXPORT int __stdcall _MakeNoiseOpen(int month, const char* datafilepath, struct NoiseParams** handle);
+DLLEXPORT int __stdcall _MakeNoiseBatch(struct NoiseParams* handle, int npnts, int* hour, double* lat, double* lng, double* freq, double* mmnoise, double* out);
+DLLEXPORT void __stdcall _MakeNoiseClose(struct NoiseParams* handle);
 #endif
 // End Prototypes
 
+// The pointers to the routines of the P372 DLL are defined once by the program or library that loads it
 #ifdef _WIN32
-	HINSTANCE hLib;
-	cP372Info dllP372Version;
-	cP372Info dllP372CompileTime;
-	iNoise dllNoise;
-	iNoiseMemory dllAllocateNoiseMemory;
-	iNoiseMemory dllFreeNoiseMemory;
-	iReadFamDud dllReadFamDud;
-	vInitializeNoise dllInitializeNoise;
-	vAtmosphericNoise dllAtmosphericNoise;
-	vAtmosphericNoise_LT dllAtmosphericNoise_LT;
-	iMakeNoise dllMakeNoise;
+	extern HINSTANCE hLib;
+	extern cP372Info dllP372Version;
+	extern cP372Info dllP372CompileTime;
+	extern iNoise dllNoise;
+	extern iNoiseMemory dllAllocateNoiseMemory;
+	extern iNoiseMemory dllFreeNoiseMemory;
+	extern iReadFamDud dllReadFamDud;
+	extern vInitializeNoise dllInitializeNoise;
+	extern vAtmosphericNoise dllAtmosphericNoise;
+	extern vAtmosphericNoise_LT dllAtmosphericNoise_LT;
+	extern iMakeNoise dllMakeNoise;
+	extern vFamCacheStats dllFamCacheStats;
+	extern iMakeNoiseGrid dllMakeNoiseGrid;
+	extern vFreeNoiseGrid dllFreeNoiseGrid;
+	extern iMakeNoiseOpen dllMakeNoiseOpen;
+	extern iMakeNoiseBatch dllMakeNoiseBatch;
+	extern vMakeNoiseClose dllMakeNoiseClose;
 #elif defined(__linux__) || defined(__APPLE__)
 	#include <dlfcn.h>
-	void* hLib;
-	char* (*dllP372Version)();
-	char* (*dllP372CompileTime)();
-	int(*dllNoise)(struct NoiseParams*, int, double, double, double);
-	int(*dllAllocateNoiseMemory)(struct NoiseParams*);
-	int(*dllFreeNoiseMemory)(struct NoiseParams*);
-	int(*dllReadFamDud)(struct NoiseParams*, const char*, int);
-	void(*dllInitializeNoise)(struct NoiseParams*);
+	extern void* hLib;
+	extern char* (*dllP372Version)();
+	extern char* (*dllP372CompileTime)();
+	extern int(*dllNoise)(struct NoiseParams*, int, double, double, double);
+	extern int(*dllAllocateNoiseMemory)(struct NoiseParams*);
+	extern int(*dllFreeNoiseMemory)(struct NoiseParams*);
+	extern int(*dllReadFamDud)(struct NoiseParams*, const char*, int);
+	extern void(*dllInitializeNoise)(struct NoiseParams*);
+	extern void(*dllAtmosphericNoise_LT)(struct NoiseParams*, struct FamStats*, int, double, double, double);
+	extern int(*dllMakeNoise)(int, int, double, double, double, double, char*, double*, int);
+	extern void(*dllFamCacheStats)(struct NoiseParams*, long*, long*);
+	extern int(*dllMakeNoiseGrid)(struct NoiseParams*, int, double, double, double, double, double, double, double*, int);
+	extern void(*dllFreeNoiseGrid)(struct NoiseParams*);
+	extern int(*dllMakeNoiseOpen)(int, const char*, struct NoiseParams**);
+	extern int(*dllMakeNoiseBatch)(struct NoiseParams*, int, int*, double*, double*, double*, double*, double*);
+	extern void(*dllMakeNoiseClose)(struct NoiseParams*);
 #endif
 // End operating system preprocessor *******************************************
 
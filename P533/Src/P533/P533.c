@@ -7,6 +7,27 @@
 #include "P533.h"
 // End Local Include **************************************************
 
+// Local globals ******************************************************
+// The routines of the P372 DLL that P533 uses. They are declared in Noise.h.
+#ifdef _WIN32
+	HINSTANCE hLib;
+	cP372Info dllP372Version;
+	cP372Info dllP372CompileTime;
+	iNoise dllNoise;
+	iNoiseMemory dllAllocateNoiseMemory;
+	iNoiseMemory dllFreeNoiseMemory;
+	vInitializeNoise dllInitializeNoise;
+#elif __linux__ || __APPLE__
+	void* hLib;
+	char* (*dllP372Version)();
+	char* (*dllP372CompileTime)();
+	int(*dllNoise)(struct NoiseParams*, int, double, double, double);
+	int(*dllAllocateNoiseMemory)(struct NoiseParams*);
+	int(*dllFreeNoiseMemory)(struct NoiseParams*);
+	void(*dllInitializeNoise)(struct NoiseParams*);
+#endif
+// End Local globals **************************************************
+
 	int P533(struct PathData *path) {
 
 		/*
@@ -157,6 +178,7 @@
 		*/
 
 	int retval; // return value
+	int outputs; // OUT_ results to find
 
 	// Load the Noise routines in P372.dll ******************************
 	#ifdef _WIN32
@@ -207,6 +229,19 @@
 	// This will aso determine the ionospheric parameters for 3 of the potential 5 control points.
 	InitializePath(path);
 
+	// Only the stages for the results that are needed are run
+	outputs = path->Outputs;
+	if(outputs == 0) {
+		outputs = OUT_ALL;
+	};
+	if((outputs & OUT_RELIABILITY) == OUT_RELIABILITY) {
+		outputs |= OUT_FIELD | OUT_NOISE;
+	};
+	// The MUFs of a path of 7000 km or more are found in MedianSkywaveFieldStrengthLong() and Between7000kmand9000km()
+	if(path->distance >= 7000.0) {
+		outputs |= OUT_FIELD;
+	};
+
 	/************************************************************/
 	/* Part 1 � Frequency availability                          */
 	/************************************************************/
@@ -247,23 +282,29 @@
 	 *		iii)	Between7000kmand9000km()			Interpolation for path->distance between 7000 and 9000 km
 	 */
 
-	 MedianSkywaveFieldStrengthShort(path);
+	if((outputs & OUT_FIELD) == OUT_FIELD) {
+		MedianSkywaveFieldStrengthShort(path);
 
-	 MedianSkywaveFieldStrengthLong(path);
+		MedianSkywaveFieldStrengthLong(path);
 
-	 Between7000kmand9000km(path);
+		Between7000kmand9000km(path);
 
-	 MedianAvailableReceiverPower(path);
+		MedianAvailableReceiverPower(path);
+	};
 
 	/************************************************************/
 	/* Part 3 � The prediction of system performance            */
 	/************************************************************/
 
 	// Call noise from the P372.dll
-	retval = dllNoise(&path->noiseP, path->hour, path->L_rx.lng, path->L_rx.lat, path->frequency);
-	if (retval != RTN_NOISEOK) return retval; // check that the input parameters are correct
-
-	CircuitReliability(path);
+	if((outputs & OUT_NOISE) == OUT_NOISE) {
+		retval = dllNoise(&path->noiseP, path->hour, path->L_rx.lng, path->L_rx.lat, path->frequency);
+		if (retval != RTN_NOISEOK) return retval; // check that the input parameters are correct
+	};
+
+	if((outputs & OUT_RELIABILITY) == OUT_RELIABILITY) {
+		CircuitReliability(path);
+	};
 
 	return RTN_P533OK;  // Return no errors
 }
@@ -17,6 +17,8 @@ DLLEXPORT int AllocateAntennaMemory(struct Antenna *ant, int freqn, int azin, in
 	double ***antpat;
 	int m, n;
 	
+	ant->map = NULL;
+	ant->mapsize = 0;
 	ant->freqn = freqn;
 	freqList = (double *) malloc(ant->freqn * sizeof(double));
 	if(freqList != NULL) {
@@ -43,6 +45,116 @@ DLLEXPORT int AllocateAntennaMemory(struct Antenna *ant, int freqn, int azin, in
 
 }
 
+DLLEXPORT void FreeAntennaMemory(struct Antenna *ant) {
+
+	/*
+
+	  FreeAntennaMemory() - Frees the antenna pattern either allocated by AllocateAntennaMemory() or
+			mapped from a compiled antenna file by ReadAntennaBin().
+
+	 		INPUT
+	 			struct Antenna *ant
+
+	 		OUTPUT
+	 			none
+
+	*/
+
+	int m, n;
+	int azimuth = 360;
+
+	if(ant->pattern == NULL) return;
+
+	if(ant->map != NULL) {
+		// Only the row pointers were allocated. The data belongs to the file mapping.
+		for (m=0; m < ant->freqn; m++) {
+			free(ant->pattern[m]);
+		}
+		free(ant->pattern);
+		UnmapAntennaFile(ant->map, ant->mapsize);
+	}
+	else {
+		free(ant->freqs);
+		for (m=0; m < ant->freqn; m++) {
+			for (n=0; n<azimuth; n++) {
+				free(ant->pattern[m][n]);
+			}
+			free(ant->pattern[m]);
+		}
+		free(ant->pattern);
+	};
+
+	ant->pattern = NULL;
+	ant->freqs = NULL;
+	ant->map = NULL;
+	ant->mapsize = 0;
+
+	return;
+}
+
+
+float ****AllocateIonMap(int hrs, int lng, int lat, int ssn) {
+
+	/*
+
+	  AllocateIonMap() - Allocates an ionospheric parameter map that is indexed map[hour][longitude][latitude][SSN].
+			The values are one contiguous block in that order and each level of pointers is one block, so
+			there are four allocations rather than one for each row. &map[0][0][0][0] is the start of the values.
+
+	 		INPUT
+	 			int hrs, lng, lat, ssn - Dimensions of the map
+
+	 		OUTPUT
+	 			Returns the map or NULL if it can not be allocated
+
+	 */
+
+	float ****map;
+	float ***lngs;
+	float **lats;
+	float *values;
+
+	int i, j, k;
+
+	map = (float ****) malloc(hrs * sizeof(float ***));
+	lngs = (float ***) malloc(hrs * lng * sizeof(float **));
+	lats = (float **) malloc((size_t)hrs * lng * lat * sizeof(float *));
+	values = (float *) calloc((size_t)hrs * lng * lat * ssn, sizeof(float));
+	if((map == NULL) || (lngs == NULL) || (lats == NULL) || (values == NULL)) {
+		free(map); free(lngs); free(lats); free(values);
+		return NULL;
+	};
+
+	for (i=0; i<hrs; i++) {
+		map[i] = &lngs[i*lng];
+		for (j=0; j<lng; j++) {
+			map[i][j] = &lats[((size_t)i*lng + j)*lat];
+			for (k=0; k<lat; k++) {
+				map[i][j][k] = &values[(((size_t)i*lng + j)*lat + k)*ssn];
+			};
+		};
+	};
+
+	return map;
+
+}
+
+void FreeIonMap(float ****map) {
+
+	/*
+	  FreeIonMap() - Frees a map allocated by AllocateIonMap().
+	*/
+
+	if(map == NULL) return;
+
+	free(map[0][0][0]);
+	free(map[0][0]);
+	free(map[0]);
+	free(map);
+
+	return;
+
+}
 
 DLLEXPORT int AllocatePathMemory(struct PathData *path) {
 	
@@ -59,6 +171,8 @@ DLLEXPORT int AllocatePathMemory(struct PathData *path) {
 	 			path->foF2var
 	 			path->dud
 	 			path->fam 
+	 			path->Outputs
+	 			path->NoCache
 	 
 	 		SUBROUTINES
 	 			None
@@ -84,32 +198,11 @@ DLLEXPORT int AllocatePathMemory(struct PathData *path) {
 	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
 
 	/* 
-	 * Create the foF2 array so you can pass it into the core P.533 process.
+	 * Create the foF2 and M(3000)F2 arrays so you can pass them into the core P.533 process.
+	 * Each is one contiguous block so that it can be loaded in bulk, see AllocateIonMap().
 	 */
-	foF2 = (float****) malloc(hrs * sizeof(float***));
-	for (i=0; i<hrs; i++) {
-		foF2[i] = (float***) malloc(lng * sizeof(float**));
-		for (j=0; j<lng; j++) {
-			foF2[i][j] = (float**) malloc(lat * sizeof(float*));
-			for (k=0; k<lat; k++) {
-				foF2[i][j][k] = (float*) malloc(ssn * sizeof(float));
-			};
-		};
-	};
-
-	/* 
-	 * Create the M(3000)F2 array so you can pass it into the core P.533 process.
-	 */
-	M3kF2 = (float****) malloc(hrs * sizeof(float***));
-	for (i=0; i<hrs; i++) {
-		M3kF2[i] = (float***) malloc(lng * sizeof(float**));
-		for (j=0; j<lng; j++) {
-			M3kF2[i][j] = (float**) malloc(lat * sizeof(float*));
-			for (k=0; k<lat; k++) {
-				M3kF2[i][j][k] = (float*) malloc(ssn * sizeof(float));
-			};
-		};
-	};	
+	foF2 = AllocateIonMap(hrs, lng, lat, ssn);
+	M3kF2 = AllocateIonMap(hrs, lng, lat, ssn);
 
    /*
 	* Allocate the foF2 variablity arrays that will be used by the P533 engine.
@@ -150,6 +243,14 @@ DLLEXPORT int AllocatePathMemory(struct PathData *path) {
 	 */
  	path->A_tx.pattern = NULL;
 	path->A_rx.pattern = NULL;
+	path->A_tx.bearing = 0.0;
+	path->A_rx.bearing = 0.0;
+	path->A_tx.map = NULL;
+	path->A_rx.map = NULL;
+
+	// Every stage of P533() is run unless the caller asks for fewer results.
+	path->Outputs = 0;
+	path->NoCache = FALSE;
 
 	// Check for NULLs and save the pointers to the path structure.
 	if(foF2 != NULL) path->foF2 = foF2;
@@ -220,43 +321,19 @@ DLLEXPORT int FreePathMemory(struct PathData *path) {
 	 */
 
 	int retval;
-	int hrs, lng, lat, ssn;
-	int i, j, k, m, n;
+	int hrs, lat, ssn;
+	int i, j, k, m;
 	int season;
-	int azimuth;
 	
 	/*
 	 * Free the ionospheric parameter arrays.
 	 */
-	hrs = 24;	// 24 hours
-	lng = 241;	// 241 longitudes at 1.5 degree increments
-	lat = 121;	// 121 latitudes at 1.5 degree increments
-	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
-
-	for (i=0; i<hrs; i++) {
-		for (j=0; j<lng; j++) {
-			for (k=0; k<lat; k++) {
-				free(path->foF2[i][j][k]);
-				};
-			free(path->foF2[i][j]);
-			};
-		free(path->foF2[i]);
-	};
-	free(path->foF2);
-
-	for (i=0; i<hrs; i++) {
-		for (j=0; j<lng; j++) {
-			for (k=0; k<lat; k++) {
-				free(path->M3kF2[i][j][k]);
-			};
-			free(path->M3kF2[i][j]);
-		};
-		free(path->M3kF2[i]);
-	};
-	free(path->M3kF2);
+	FreeIonMap(path->foF2);
+	FreeIonMap(path->M3kF2);
 
 	// Free the foF2 variability memory
 	season = 3;	 
+	hrs = 24;
 	lat = 19;	
 	ssn = 3;	
 
@@ -275,24 +352,8 @@ DLLEXPORT int FreePathMemory(struct PathData *path) {
 	free(path->foF2var);
 	
 	// Free antenna array
-	azimuth = 360;
-	free(path->A_tx.freqs);
-	for (m=0; m < path->A_tx.freqn; m++) {
-		for (n=0; n<azimuth; n++) {
-			free(path->A_tx.pattern[m][n]);
-		}
-		free(path->A_tx.pattern[m]);
-    }
-	free(path->A_tx.pattern);
-
-  free(path->A_rx.freqs);
-	for (m=0; m < path->A_rx.freqn; m++) {
-		for (n=0; n<azimuth; n++) {
-			free(path->A_rx.pattern[m][n]);
-		}
-		free(path->A_rx.pattern[m]);
-	}
-	free(path->A_rx.pattern);
+	FreeAntennaMemory(&path->A_tx);
+	FreeAntennaMemory(&path->A_rx);
 
 	// Free the noise memory
 	retval = dllFreeNoiseMemory(&path->noiseP);
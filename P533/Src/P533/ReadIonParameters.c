@@ -2,12 +2,27 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 // Local includes
 #include "Common.h"
 #include "P533.h"
 // End local includes
 
+// Local prototypes
+int ParseIonParametersTxt(const char *InFilePath, float *values, int n);
+int ReadIonCache(const char *CacheFilePath, struct IonCacheHeader *expected, float *values, int n);
+int WriteIonCache(const char *CacheFilePath, struct IonCacheHeader *hdr, float *values, int n);
+int ReadIonMapBin(FILE *fp, float ****map, int hrs, int lng, int lat, int ssn);
+// End local prototypes
+
+// Smallest normal float and the largest float (rounded up) as doubles
+#define FLTMINNORMAL	1.1754943508222875e-38
+#define FLTMAXNORMAL	3.4028235677973366e+38
+// Largest integer below which every integer is an exact float
+#define FLTEXACTINT		16777216ULL
+
 /*
  * These routines use the ionospheric data from the monthly median parameter maps that are generated internally to the REC533() 
  * program. It is hoped that the routines in this program which use ionospheric maps can then take advantage of more contemporary 
@@ -39,25 +54,38 @@ int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int sile
 	 *	on work of several administrations. These ionospheric parameter files are based on CCIR spherical harmonic coefficients from 
 	 *	the 1958 Geophysical year. Please refer to P.1239 for details on how to convert between the coefficients and foF2 and M(3000)F2
 	 *
+	 *	The text file is read whole and the numbers are converted by ParseIonParametersTxt() rather than sscanf().
+	 *	The result is then written next to the text file as ionosXX.txt.cache, see struct IonCacheHeader, 
+	 *	which is read instead of the text on later runs for as long as the text file is unchanged. 
+	 *	If the cache can not be written, for example because the data directory is read only, the text is parsed each time.
+	 *	It is not written when path->NoCache is TRUE.
+	 *
 	 *		INPUT
 	 *			struct PathData *path
 	 *	
 	 *		OUTPUT
 	 *			Data is read into the arrays foF2 and M3kF2
 	 *
+	 *		SUBROUTINES
+	 *			ReadIonCache()
+	 *			ParseIonParametersTxt()
+	 *			WriteIonCache()
+	 *
 	 */
 
-	int		j, k, m;
+	struct IonCacheHeader hdr;
+	struct stat st;
+
+	int		i, j, k, m;
 	int		hrs, lng, lat, ssn; // Temp gridmap maxima
+	int		n;					// Number of values of each parameter
 
-	int linelen = 300;
-	char line[300];
+	float	*readBuffer;		// foF2 then M3kF2 in the order of the text file
 
 	char InFilePath[256];
+	char CacheFilePath[300];
 	char MapFile[32];
 	
-	FILE *fp;
-	
 	// At present the path structure is not used but is passed in so that it can select the correct map file based on month
 
 	// The dimensions of the array are fixed by Suessman's file generating program "iongrid"
@@ -66,6 +94,7 @@ int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int sile
 	lng = 241;	// 241 longitudes at 1.5-degree increments
 	lat = 121;	// 121 latitudes at 1.5-degree increments
 	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
+	n = hrs * lng * lat * ssn;
 	
 	// This may require error handling at some point.
 	// Eventually you want the file that is indicated by GUIConfig to be opened.
@@ -74,77 +103,263 @@ int ReadIonParametersTxt(struct PathData *path, char DataFilePath[256], int sile
 	//strcat(InFilePath, "ionmap/TXT/");
 	sprintf(MapFile, "ionos%02d.txt", path->month+1);
 	strcat(InFilePath, MapFile);
-	fp = fopen(InFilePath, "r"); 
-	//fp = fopen("..\\..\\ionmap\\ionos04.txt", "r"); 
-	if(fp == NULL) {
+	sprintf(CacheFilePath, "%s.cache", InFilePath);
+
+	if(stat(InFilePath, &st) != 0) {
 		printf("ReadIonParameters: ERROR Can't find input file %s\n", InFilePath);
 		return RTN_ERRREADIONPARAMETERS;
 	};
 
-	if(silent != TRUE) {
-		printf("ReadIonParameters: Reading file ionos%02d.txt for ionospheric parameters\n", path->month+1);
-		printf("ReadIonParameters: Reading foF2 into array\n");
+	readBuffer = (float *) malloc(2 * n * sizeof(float));
+	if(readBuffer == NULL) {
+		return RTN_ERRREADIONPARAMETERS;
 	};
 
-	// Read in foF2
-	for(m = 0; m < ssn; m++) { // SSN
-		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file.
-				// There are six lines for 24 hours.
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[0][j][k][m], &path->foF2[1][j][k][m], &path->foF2[2][j][k][m],                 
-					                                 &path->foF2[3][j][k][m], &path->foF2[4][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[5][j][k][m], &path->foF2[6][j][k][m],&path->foF2[7][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[8][j][k][m], &path->foF2[9][j][k][m], &path->foF2[10][j][k][m],
-					                                 &path->foF2[11][j][k][m], &path->foF2[12][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[13][j][k][m], &path->foF2[14][j][k][m], &path->foF2[15][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->foF2[16][j][k][m], &path->foF2[17][j][k][m], &path->foF2[18][j][k][m],
-					                                 &path->foF2[19][j][k][m], &path->foF2[20][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->foF2[21][j][k][m],&path->foF2[22][j][k][m],&path->foF2[23][j][k][m]);
+	// The cache header describes the text file that it was made from.
+	memset(&hdr, 0, sizeof(struct IonCacheHeader));
+	memcpy(hdr.magic, IONCACHEMAGIC, sizeof(hdr.magic));
+	hdr.byteorder = ANTBINBYTEORDER;
+	hdr.version = IONCACHEVERSION;
+	hdr.txtsize = (long long)st.st_size;
+	hdr.txtmtime = (long long)st.st_mtime;
+	hdr.hrs = hrs;
+	hdr.lng = lng;
+	hdr.lat = lat;
+	hdr.ssn = ssn;
+
+	if(ReadIonCache(CacheFilePath, &hdr, readBuffer, 2 * n) == TRUE) {
+		if(silent != TRUE) {
+			printf("ReadIonParameters: Reading file ionos%02d.txt.cache for ionospheric parameters\n", path->month+1);
+		};
+	}
+	else {
+		if(silent != TRUE) {
+			printf("ReadIonParameters: Reading file ionos%02d.txt for ionospheric parameters\n", path->month+1);
+		};
+
+		// Read in foF2 then M3kF2
+		if(ParseIonParametersTxt(InFilePath, readBuffer, 2 * n) != 2 * n) {
+			printf("ReadIonParameters: ERROR Incomplete input file %s\n", InFilePath);
+			free(readBuffer);
+			return RTN_ERRREADIONPARAMETERS;
+		};
+
+		hdr.checksum = AntennaChecksum(0, (const unsigned char *)readBuffer, 2 * n * sizeof(float));
+		if((path->NoCache != TRUE) && (WriteIonCache(CacheFilePath, &hdr, readBuffer, 2 * n) != TRUE)) {
+			if(silent != TRUE) {
+				printf("ReadIonParameters: Can't write cache file %s\n", CacheFilePath);
 			};
-		};	
+		};
 	};
 
-	if(silent != TRUE) {
-		printf("ReadIonParameters: Reading M3kF2 into array\n");
+	// Each line group of the Dambolt/Seussman ionospheric atlas file is 24 hours of data.
+	// The SSN is innermost so that the arrays, which are [hour][longitude][latitude][SSN], are filled
+	// a longitude at a time rather than once for each SSN.
+	for(j = 0; j < lng; j++) { // Longitude
+		for(k = 0; k < lat; k++) { // Latitude
+			for(i = 0; i < hrs; i++) { // Hour
+				for(m = 0; m < ssn; m++) { // SSN
+					path->foF2[i][j][k][m] = readBuffer[(m * (lng * lat * hrs)) + (j * (lat * hrs)) + (k * hrs) + i];
+					path->M3kF2[i][j][k][m] = readBuffer[n + (m * (lng * lat * hrs)) + (j * (lat * hrs)) + (k * hrs) + i];
+				};
+			};
+		};
 	};
 
-	// Read in M3kF2
-	for(m = 0; m < ssn; m++) { // SSN
-		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file.
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[0][j][k][m], &path->M3kF2[1][j][k][m], &path->M3kF2[2][j][k][m],
-					                                 &path->M3kF2[3][j][k][m], &path->M3kF2[4][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[5][j][k][m], &path->M3kF2[6][j][k][m], &path->M3kF2[7][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[8][j][k][m],  &path->M3kF2[9][j][k][m], &path->M3kF2[10][j][k][m],
-					                                 &path->M3kF2[11][j][k][m], &path->M3kF2[12][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[13][j][k][m], &path->M3kF2[14][j][k][m], &path->M3kF2[15][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f  %f  %f", &path->M3kF2[16][j][k][m], &path->M3kF2[17][j][k][m], &path->M3kF2[18][j][k][m], 
-					                                 &path->M3kF2[19][j][k][m], &path->M3kF2[20][j][k][m]);
-				fgets(line, linelen, fp);
-				sscanf(line, "  %f  %f  %f", &path->M3kF2[21][j][k][m], &path->M3kF2[22][j][k][m], &path->M3kF2[23][j][k][m]);
+	free(readBuffer);
+
+	return RTN_READIONPARAOK;
+}
+
+int ParseIonParametersTxt(const char *InFilePath, float *values, int n) {
+	/*
+	 * ParseIonParametersTxt() - Reads up to n numbers from the text file into values and returns the number read.
+	 *		The whole file is read into memory and each number is converted here. A number with no more than 
+	 *		15 significant digits, which is all of them in the atlas, is rounded once to double then to float. The 
+	 *		two roundings only differ from the single rounding of sscanf("%f") when the double is halfway between 
+	 *		two floats, which cannot happen when the digits and the power of ten are both exact floats, so a 
+	 *		larger number that is a midpoint and anything longer is given to strtof() and every value is the 
+	 *		float sscanf() would give.
+	 */
+
+	static const double p10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+									 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	FILE *fp;
+
+	char *buf, *c, *start;
+	long size;
+
+	unsigned long long mant;	// Digits of the number
+	double v;
+	float f, g;					// The float nearest v and its neighbour on the other side of v
+	unsigned long long bits;	// The bits of v
+	int digits;					// Significant digits in mant
+	int scale;					// Power of ten to divide mant by
+	int ex, esign;
+	int neg;
+	int any;					// A digit was found
+	int count = 0;
+
+	fp = fopen(InFilePath, "rb");
+	if(fp == NULL) return 0;
+
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if(size <= 0) {
+		fclose(fp);
+		return 0;
+	};
+
+	buf = (char *) malloc(size + 1);
+	if(buf == NULL) {
+		fclose(fp);
+		return 0;
+	};
+	size = (long)fread(buf, 1, size, fp);
+	fclose(fp);
+	buf[size] = '\0';
+
+	c = buf;
+	while(count < n) {
+		while((*c == ' ') || (*c == '\t') || (*c == '\r') || (*c == '\n')) c++;
+		if(*c == '\0') break;
+
+		start = c;
+		neg = FALSE;
+		if((*c == '-') || (*c == '+')) {
+			neg = (*c == '-');
+			c++;
+		};
+
+		mant = 0;
+		digits = 0;
+		scale = 0;
+		any = FALSE;
+		while((*c >= '0') && (*c <= '9')) {
+			any = TRUE;
+			if((mant != 0) || (*c != '0')) digits++;
+			mant = mant*10 + (unsigned long long)(*c - '0');
+			c++;
+		};
+		if(*c == '.') {
+			c++;
+			while((*c >= '0') && (*c <= '9')) {
+				any = TRUE;
+				if((mant != 0) || (*c != '0')) digits++;
+				mant = mant*10 + (unsigned long long)(*c - '0');
+				scale++;
+				c++;
 			};
-		};	
+		};
+		if(any == FALSE) {
+			break; // Not a number
+		};
+		if((*c == 'e') || (*c == 'E')) {
+			c++;
+			esign = 1;
+			if((*c == '-') || (*c == '+')) {
+				esign = (*c == '-') ? -1 : 1;
+				c++;
+			};
+			ex = 0;
+			while((*c >= '0') && (*c <= '9')) {
+				if(ex < 10000) ex = ex*10 + (*c - '0');
+				c++;
+			};
+			scale -= esign*ex;
+		};
+
+		if((digits <= 15) && (scale >= -22) && (scale <= 22)) {
+			// Both mant and the power of ten are exact so there is one rounding to double.
+			v = (scale >= 0) ? (double)mant/p10[scale] : (double)mant*p10[-scale];
+			if(neg) v = -v;
+			f = (float)v;
+			// When mant and the power of ten are both exact floats the double quotient or product
+			// rounds to the same float as the exact value, so only larger numbers can be a midpoint.
+			if((mant > FLTEXACTINT) || (scale < -10) || (scale > 10)) {
+				if((fabs(v) >= FLTMINNORMAL) && (fabs(v) < FLTMAXNORMAL)) {
+					// In the range of the normal floats v is halfway between two floats only when the 29
+					// bits of its mantissa that a float drops are a one followed by 28 zeros.
+					memcpy(&bits, &v, sizeof(bits));
+					if((bits & 0x1FFFFFFFULL) == 0x10000000ULL) {
+						f = strtof(start, NULL);
+					};
+				}
+				else if((double)f != v) {
+					g = nextafterf(f, (v > (double)f) ? INFINITY : -INFINITY);
+					// The sum of two neighbouring floats is exact in double.
+					if(((double)f + (double)g) == 2.0*v) {
+						f = strtof(start, NULL);
+					};
+				};
+			};
+		}
+		else {
+			f = strtof(start, NULL);
+		};
+
+		values[count++] = f;
 	};
 
-	// Close the file and return.
+	free(buf);
+
+	return count;
+}
+
+int ReadIonCache(const char *CacheFilePath, struct IonCacheHeader *expected, float *values, int n) {
+	/*
+	 * ReadIonCache() - Reads n values from the cache file if its header matches expected and the checksum is good.
+	 *		Returns TRUE if the values were read.
+	 */
+
+	struct IonCacheHeader hdr;
+
+	FILE *fp;
+
+	int ok;
+
+	fp = fopen(CacheFilePath, "rb");
+	if(fp == NULL) return FALSE;
+
+	ok = (fread(&hdr, sizeof(struct IonCacheHeader), 1, fp) == 1);
+	ok = ok && (memcmp(hdr.magic, expected->magic, sizeof(hdr.magic)) == 0);
+	ok = ok && (hdr.byteorder == expected->byteorder) && (hdr.version == expected->version);
+	ok = ok && (hdr.txtsize == expected->txtsize) && (hdr.txtmtime == expected->txtmtime);
+	ok = ok && (hdr.hrs == expected->hrs) && (hdr.lng == expected->lng) && (hdr.lat == expected->lat) && (hdr.ssn == expected->ssn);
+	ok = ok && (fread(values, sizeof(float), n, fp) == (size_t)n);
+	ok = ok && (fgetc(fp) == EOF);
 	fclose(fp);
 
-	return RTN_READIONPARAOK;
+	ok = ok && (AntennaChecksum(0, (const unsigned char *)values, n * sizeof(float)) == hdr.checksum);
+
+	return ok ? TRUE : FALSE;
+}
+
+int WriteIonCache(const char *CacheFilePath, struct IonCacheHeader *hdr, float *values, int n) {
+	/*
+	 * WriteIonCache() - Writes the cache file. Returns TRUE if it was written. A partly written
+	 *		file is removed so that it is not mistaken for a cache.
+	 */
+
+	FILE *fp;
+
+	int ok;
+
+	fp = fopen(CacheFilePath, "wb");
+	if(fp == NULL) return FALSE;
+
+	ok = (fwrite(hdr, sizeof(struct IonCacheHeader), 1, fp) == 1);
+	ok = ok && (fwrite(values, sizeof(float), n, fp) == (size_t)n);
+	ok = (fclose(fp) == 0) && ok;
+
+	if(!ok) remove(CacheFilePath);
+
+	return ok ? TRUE : FALSE;
 }
 
+
 int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFilePath[256], int silent) {
 	/*
 	 * ReadIonParametersBin() is a routine to read ionospheric parameters from a file into arrays necessary for the ITU-R P.533 
@@ -169,22 +384,25 @@ int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFi
 	 *	on work of several administrations. These ionospheric parameter files are based on CCIR spherical harmonic coefficients from 
 	 *	the 1958 Geophysical year. Please refer to P.1239 for details on how to convert between the coefficients and foF2 and M(3000)F2
 	 *
+	 *	The file is read one longitude at a time, 24 hours for each latitude, and each value is put straight 
+	 *	into the arrays so there is no copy of the whole map. The arrays are allocated once by AllocatePathMemory()
+	 *	and are reused for each month. The values in the file are little-endian.
+	 *
 	 *		INPUT
 	 *			struct PathData *path
 	 *	
 	 *		OUTPUT
 	 *			data is read into the arrays foF2 and M3kF2
 	 *
+	 *		SUBROUTINES
+	 *			ReadIonMapBin()
+	 *
 	 */
 
 	char buffer[256];
 
-	int	i, j, k, m;
 	int	hrs, lng, lat, ssn; // Temp gridmap maxima
-	int numfoF2;
-	int linelen = 300;
-
-	float * readBuffer;
+	int ok;				// All of the file was read
 
 	char InFilePath[256];
 	char MapFile[32];
@@ -199,7 +417,7 @@ int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFi
 	lng = 241;	// 241 longitudes at 1.5-degree increments
 	lat = 121;	// 121 latitudes at 1.5-degree increments
 	ssn = 2;	// 2 SSN (12-month smoothed sun spot numbers) high and low
-	numfoF2 = hrs * lng * lat * ssn;
+
 	// This may require error handling at some point.
 	// Eventually you want the file that is indicated by GUIConfig to be opened.
 	strcpy(InFilePath, DataFilePath);
@@ -215,68 +433,74 @@ int ReadIonParametersBin(int month, float ****foF2, float ****M3kF2, char DataFi
 	};
 
 	if(silent != TRUE) {
-		printf("ReadIonParameters: Reading file ionos%02d.txt for ionospheric parameters\n", month+1);
+		printf("ReadIonParameters: Reading file ionos%02d.bin for ionospheric parameters\n", month+1);
+		printf("ReadIonParameters: Reading foF2 (binary) into array\n");
 	};
 
 	//The first 5 bytes of the file are overhead that FORTRAN puts in 
-	fread(&buffer, sizeof(char), 5, fp);
-
-	readBuffer = (float *) malloc(sizeof(float) * numfoF2);
-	fread(readBuffer,sizeof(float),numfoF2,fp);
-
-	if(silent != TRUE) {
-		printf("ReadIonParameters: Reading foF2 (binary) into array\n");
-	};
+	ok = (fread(&buffer, sizeof(char), 5, fp) == 5) ? TRUE : FALSE;
 
 	// Read in foF2
-	for(m = 0; m < ssn; m++) { // SSN
-		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file
-				for(i = 0; i < hrs; i++) { // Latitude
-					foF2[i][j][k][m] = readBuffer[ (m * (lng * lat * hrs)) + 
-													(j * (lat * hrs)) +
-													(k * (hrs)) +
-													 i];
-					// fread(&foF2[i][j][k][m], sizeof(float), 1, fp);
-				};
-			};
-		};	
-	};
-	
-	free(readBuffer);
+	ok = ok && ReadIonMapBin(fp, foF2, hrs, lng, lat, ssn);
 
 	// The next 5 bytes are the tail of the foF2 record followed by 5 bytes of header for the M(3000)F2 record.
-	fread(&buffer, sizeof(char), 10, fp);
+	ok = ok && (fread(&buffer, sizeof(char), 10, fp) == 10);
 	
 	if(silent != TRUE) {
 		printf("ReadIonParameters: Reading M3kF2 (binary) into array\n");
 	};
 
-	readBuffer = (float *) malloc(sizeof(float) * numfoF2);
-	fread(readBuffer,sizeof(float),numfoF2,fp);
-
 	// Read in M3kF2
+	ok = ok && ReadIonMapBin(fp, M3kF2, hrs, lng, lat, ssn);
+
+	// Close the file and return.
+	fclose(fp);
+
+	if(ok != TRUE) {
+		printf("ReadIonParameters: ERROR Incomplete input file %s\n", InFilePath);
+		return RTN_ERRREADIONPARAMETERS;
+	};
+
+	return RTN_READIONPARAOK;
+
+};
+
+int ReadIonMapBin(FILE *fp, float ****map, int hrs, int lng, int lat, int ssn) {
+	/*
+	 * ReadIonMapBin() - Reads one parameter of the binary ionospheric atlas into map[hour][longitude][latitude][SSN].
+	 *		The file is in [SSN][longitude][latitude][hour] order. Each longitude, lat x hrs values, is read in one
+	 *		fread() and is byte swapped if this machine is big-endian. Returns TRUE if all the values were read.
+	 */
+
+	float slab[121*24];		// One longitude of the file
+	float **row;
+	unsigned char *b, t;
+
+	unsigned int one = 1;
+	int bigendian = (*(unsigned char *)&one == 0);
+	int	i, j, k, m, n;
+
+	if(lat*hrs > (int)(sizeof(slab)/sizeof(float))) return FALSE;
+
 	for(m = 0; m < ssn; m++) { // SSN
 		for(j = 0; j < lng; j++) { // Longitude
-			for(k = 0; k < lat; k++) { // Latitude
-				// Read 24 hours of data from the Dambolt/Seussman ionospheric atlas file.
-				for(i = 0; i < hrs; i++) { // Latitude
-					M3kF2[i][j][k][m] = readBuffer[ (m * (lng * lat * hrs)) + 
-													(j * (lat * hrs)) +
-													(k * (hrs)) +
-													 i];
-					// fread(&M3kF2[i][j][k][m], sizeof(float), 1, fp);
+			if(fread(slab, sizeof(float), lat*hrs, fp) != (size_t)(lat*hrs)) return FALSE;
+			if(bigendian) {
+				for(n = 0; n < lat*hrs; n++) {
+					b = (unsigned char *)&slab[n];
+					t = b[0]; b[0] = b[3]; b[3] = t;
+					t = b[1]; b[1] = b[2]; b[2] = t;
+				};
+			};
+			for(i = 0; i < hrs; i++) { // Hour
+				row = map[i][j];
+				for(k = 0; k < lat; k++) { // Latitude
+					row[k][m] = slab[k*hrs + i];
 				};
 			};
 		};	
 	};
-	
-	free(readBuffer);
 
-	// Close the file and return.
-	fclose(fp);
-
-	return RTN_READIONPARAOK;
+	return TRUE;
 
 };
@@ -0,0 +1,1331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+
+// Local includes
+#include "Common.h"
+#include "P533.h"
+// End local includes
+
+/*
+ * ReadNEC.c - Generates antenna patterns from NEC thin-wire decks.
+ *
+ * The solver is a Galerkin method of moments for the mixed potential electric field integral
+ * equation on straight thin wires. The current is expanded in triangle functions that span the
+ * two segments either side of each node and the reduced (thin-wire) kernel is used. The 1/R part
+ * of the kernel is integrated analytically for neighbouring segments. The ground is either free space,
+ * perfect or finite. A finite ground is treated as perfect when the currents are found and by the
+ * Fresnel reflection coefficients when the far field is found. This is the NEC reflection coefficient
+ * approximation without the near-field correction and is a good approximation for antennas that are
+ * more than about 0.1 wavelengths above the ground.
+ *
+ * The matrix is solved directly so the time goes up with the cube of the number of segments. The
+ * largest ITS curtain decks take some minutes and about 1 GB, which is why the result is cached.
+ *
+ * The following cards are understood. Any other geometry, excitation or ground card is an error.
+ *		CM CE			Comments. The first CM card is the name of the antenna
+ *		GW				Straight wire
+ *		GS				Scale the geometry
+ *		GE				End of geometry. I1 != 0 places a perfect ground
+ *		GN				Ground: -1 free space, 1 perfect, 0 and 2 finite (EPSE SIG)
+ *		EX 0			Voltage source at the centre of a segment
+ *		LD 0 1 2 3 4 5	Series RLC, parallel RLC, per meter RLC, impedance and wire conductivity
+ *		TL NT			Transmission lines and two-port networks between segments
+ *		FR				Frequencies
+ *		EK RP XQ EN		Ignored. The pattern is always 360 x 91 at 1 degree
+ */
+
+// NEC solver #defines
+#define NECMU0			(4.0e-7*PI)					// Permeability of free space (H/m)
+#define NECEPS0			(1.0/(NECMU0*VofL*VofL))	// Permittivity of free space (F/m)
+#define NECETA0			(NECMU0*VofL)				// Impedance of free space (ohm)
+#define NECVERSION		"ReadNEC 1"					// Part of the cache key. Change it when the solver changes.
+
+#define NECFREESPACE	-1
+#define NECFINITE		0
+#define NECPERFECT		1
+
+#define NECMINGAIN		-99.999						// Gain (dBi) for a null as in the type 13 files
+#define NECMAXUNKNOWNS	12000						// The matrix is 16 bytes per element, about 2.3 GB at this size
+// End NEC solver #defines
+
+struct NECComplex {
+	double re;
+	double im;
+};
+
+struct NECSegment {
+	double r0[3];				// Start of the segment (m)
+	double u[3];				// Unit vector from the start to the end
+	double c[3];				// Centre of the segment (m)
+	double L;					// Length (m)
+	double a;					// Radius (m)
+	int tag;					// Tag of the wire
+	int seg;					// Segment number on the wire starting at 1
+	int node[2];				// Node at the start and end of the segment
+	double sigma;				// Conductivity (S/m). 0 is a perfect conductor
+	struct NECComplex ZL;		// Lumped load at the centre (ohm)
+	struct NECComplex I0, I1;	// Current at the start and end of the segment (A)
+	int pstart, pn;				// Basis function pieces on this segment
+};
+
+// A piece is the part of a basis function on one segment. The current in the direction of the
+// segment is linear from v0 at the start to v1 at the end.
+struct NECPiece {
+	int basis;
+	double v0, v1;
+};
+
+struct NECLoad {
+	int type, tag, m, n;
+	double f1, f2, f3;
+};
+
+struct NECSource {
+	int seg;
+	struct NECComplex V;
+};
+
+struct NECNetwork {
+	int type;					// 0 = TL, 1 = NT
+	int seg1, seg2;
+	double f[6];				// TL: Z0, length, Y1R, Y1I, Y2R, Y2I  NT: Y11R, Y11I, Y12R, Y12I, Y22R, Y22I
+};
+
+struct NECDeck {
+	char Name[256];
+	struct NECSegment *seg;
+	int nseg;
+	struct NECPiece *piece;
+	int npiece;
+	int nbasis;
+	struct NECLoad *ld;
+	int nld;
+	struct NECSource *ex;
+	int nex;
+	struct NECNetwork *nt;
+	int nnt;
+	int ground;					// NECFREESPACE, NECFINITE or NECPERFECT
+	double epsr, sig;			// Finite ground relative permittivity and conductivity (S/m)
+	int ifrq, nfrq;				// FR card
+	double fmhz, delfrq;
+	double Pin;				// Input power at the last frequency solved (W)
+};
+
+// Local prototypes
+int NECParse(struct NECDeck *deck, char *buf, int silent);
+int NECConnect(struct NECDeck *deck);
+int NECFindSegment(struct NECDeck *deck, int tag, int m);
+int NECSolve(struct NECDeck *deck, double freq, int silent);
+void NECPattern(struct NECDeck *deck, double freq, double **pattern);
+void NECMoments(const double p0[3], const double pu[3], double Lp, const double q0[3], const double qu[3], double Lq, double a, double k, struct NECComplex M[4]);
+int NECGaussSolve(struct NECComplex *A, struct NECComplex *b, int n);
+void NECFree(struct NECDeck *deck);
+unsigned long long NECHash(const char *buf);
+struct NECComplex NECc(double re, double im);
+struct NECComplex NECcmul(struct NECComplex a, struct NECComplex b);
+struct NECComplex NECcdiv(struct NECComplex a, struct NECComplex b);
+// End local prototypes
+
+DLLEXPORT int ReadNEC(struct Antenna *Ant, FILE *fp, const char *CachePath, double bearing, int silent) {
+
+	/*
+
+	  ReadNEC() - Generates the antenna pattern from an NEC thin-wire deck. There is one pattern for
+			each frequency on the FR card. When CachePath is given the pattern is kept there as a compiled
+			antenna file named by a hash of the deck, so the deck is only solved again when it changes.
+
+	 		INPUT
+	 			struct Antenna *Ant
+				FILE *fp - The NEC deck
+				const char *CachePath - Directory of the pattern cache. NULL or "" for no cache.
+				double bearing - Main beam bearing of the antenna (radians)
+				int silent
+
+	 		OUTPUT
+	 			Ant->Name, Ant->freqn, Ant->freqs, Ant->pattern and Ant->bearing
+
+				Returns
+					RTN_READANTENNAPATTERNSOK
+					RTN_ERRCANTOPENANTFILE
+					RTN_ERRNECDECK
+					RTN_ERRNECSOLVE
+					RTN_ERRALLOCATEANT
+
+	 		SUBROUTINES
+				NECHash()
+				ReadAntennaBin()
+				NECParse()
+				NECConnect()
+				NECSolve()
+				NECPattern()
+				WriteAntennaBin()
+
+	 */
+
+	struct NECDeck deck;
+
+	char *buf;					// The deck
+	char *grown;				// buf after it has been enlarged
+	char CacheFile[512];
+
+	size_t len, size;
+	int c;
+	int i;
+	int retval;
+
+	double freq;				// Frequency (MHz)
+
+	if(fp == NULL) {
+		return RTN_ERRCANTOPENANTFILE;
+	};
+
+	// Read the whole deck.
+	size = 4096;
+	len = 0;
+	buf = (char *) malloc(size);
+	if(buf == NULL) return RTN_ERRALLOCATEANT;
+	while((c = fgetc(fp)) != EOF) {
+		if(len + 1 >= size) {
+			size *= 2;
+			grown = (char *) realloc(buf, size);
+			if(grown == NULL) {
+				free(buf);
+				return RTN_ERRALLOCATEANT;
+			};
+			buf = grown;
+		};
+		if(c != '\r') buf[len++] = (char)c;
+	};
+	buf[len] = '\0';
+
+	// Look for the pattern in the cache.
+	CacheFile[0] = '\0';
+	if((CachePath != NULL) && (CachePath[0] != '\0')) {
+		len = strlen(CachePath);
+		if((CachePath[len-1] == '/') || (CachePath[len-1] == '\\')) {
+			sprintf(CacheFile, "%.400sNEC%016llx.bin", CachePath, NECHash(buf));
+		}
+		else {
+			sprintf(CacheFile, "%.400s/NEC%016llx.bin", CachePath, NECHash(buf));
+		};
+		Ant->pattern = NULL;
+		retval = ReadAntennaBin(Ant, CacheFile, bearing, TRUE);
+		if(retval == RTN_READANTENNAPATTERNSOK) {
+			if(silent != TRUE) {
+				printf("ReadNEC: Using cached pattern %.65s for %.35s\n", CacheFile, Ant->Name);
+			};
+			free(buf);
+			return RTN_READANTENNAPATTERNSOK;
+		};
+	};
+
+	memset(&deck, 0, sizeof(struct NECDeck));
+	retval = NECParse(&deck, buf, silent);
+	free(buf);
+	if(retval == RTN_READANTENNAPATTERNSOK) {
+		retval = NECConnect(&deck);
+	};
+	if(retval != RTN_READANTENNAPATTERNSOK) {
+		NECFree(&deck);
+		return retval;
+	};
+
+	retval = AllocateAntennaMemory(Ant, deck.nfrq, 360, 91);
+	if(retval != RTN_ALLOCATEP533OK) {
+		NECFree(&deck);
+		return retval;
+	};
+
+	strcpy(Ant->Name, deck.Name);
+	Ant->bearing = bearing;
+
+	// User feedback
+	if(silent != TRUE) {
+		printf("ReadNEC: Solving antenna %.35s (%d segments, %d unknowns)\n", Ant->Name, deck.nseg, deck.nbasis);
+	};
+
+	freq = deck.fmhz;
+	for(i=0; i<deck.nfrq; i++) {
+		Ant->freqs[i] = freq;
+
+		retval = NECSolve(&deck, freq, silent);
+		if(retval != RTN_READANTENNAPATTERNSOK) {
+			NECFree(&deck);
+			FreeAntennaMemory(Ant);
+			return retval;
+		};
+
+		NECPattern(&deck, freq, Ant->pattern[i]);
+
+		if(deck.ifrq == 1) freq *= deck.delfrq;
+		else freq += deck.delfrq;
+	};
+
+	NECFree(&deck);
+
+	// Save the pattern in the cache. It is not an error if the cache can not be written.
+	if(CacheFile[0] != '\0') {
+		retval = WriteAntennaBin(Ant, CacheFile, TRUE);
+		if((retval != RTN_WRITEANTENNABINOK) && (silent != TRUE)) {
+			printf("ReadNEC: Can not write the pattern cache %.65s\n", CacheFile);
+		};
+	};
+
+	return RTN_READANTENNAPATTERNSOK;
+
+};
+
+int NECParse(struct NECDeck *deck, char *buf, int silent) {
+
+	/*
+	  NECParse() - Reads the cards of an NEC deck into the structure NECDeck.
+	*/
+
+	struct NECSegment *s;
+
+	void *grown;			// An array after it has been enlarged. The deck keeps the old one if it can't be.
+
+	char *line, *next;
+	char card[3];
+
+	double f[9];			// Floating point fields
+	double d[3];			// Wire vector
+	double wl;				// Wire length
+	double scale;
+
+	int I[4];				// Integer fields
+	int nf;					// Number of fields read
+	int ns;					// Number of segments on a wire
+	int maxseg = 0, maxld = 0, maxex = 0, maxnt = 0;
+	int i, j;
+	int ge = FALSE;			// GE card read
+	int frq = FALSE;		// FR card read
+
+	deck->ground = NECFREESPACE;
+	deck->epsr = 1.0;
+	deck->sig = 0.0;
+	strcpy(deck->Name, "NEC");
+
+	for(line = buf; line != NULL; line = next) {
+		next = strchr(line, '\n');
+		if(next != NULL) *next++ = '\0';
+
+		while(isspace((unsigned char)*line)) line++;
+		if(*line == '\0') continue;
+
+		card[0] = (char)toupper((unsigned char)line[0]);
+		card[1] = (char)toupper((unsigned char)line[1]);
+		card[2] = '\0';
+
+		// Fields may be separated by spaces or commas
+		for(i=2; line[i] != '\0'; i++) {
+			if(line[i] == ',') line[i] = ' ';
+		};
+
+		if(strcmp(card, "CM") == 0) {
+			if(strcmp(deck->Name, "NEC") == 0) {
+				line += 2;
+				while(isspace((unsigned char)*line)) line++;
+				if(*line != '\0') {
+					strncpy(deck->Name, line, sizeof(deck->Name)-1);
+					deck->Name[sizeof(deck->Name)-1] = '\0';
+				};
+			};
+			continue;
+		};
+
+		if((strcmp(card, "CE") == 0) || (strcmp(card, "EK") == 0) || (strcmp(card, "RP") == 0)
+			|| (strcmp(card, "XQ") == 0) || (strcmp(card, "PT") == 0) || (strcmp(card, "PQ") == 0)) {
+			continue;
+		};
+
+		if(strcmp(card, "EN") == 0) {
+			break;
+		};
+
+		I[0] = I[1] = I[2] = I[3] = 0;
+		for(i=0; i<9; i++) f[i] = 0.0;
+
+		if(strcmp(card, "GW") == 0) {
+			nf = sscanf(line+2, "%d %d %lf %lf %lf %lf %lf %lf %lf", &I[0], &ns, &f[0], &f[1], &f[2], &f[3], &f[4], &f[5], &f[6]);
+			if((nf < 9) || (ns < 1) || (f[6] <= 0.0)) {
+				if(silent != TRUE) printf("ReadNEC: Error invalid or tapered wire: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			if(deck->nseg + ns > maxseg) {
+				maxseg = 2*(deck->nseg + ns);
+				grown = realloc(deck->seg, maxseg*sizeof(struct NECSegment));
+				if(grown == NULL) return RTN_ERRALLOCATEANT;
+				deck->seg = (struct NECSegment *) grown;
+			};
+			for(j=0; j<3; j++) d[j] = f[j+3] - f[j];
+			wl = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+			if(wl <= 0.0) {
+				if(silent != TRUE) printf("ReadNEC: Error zero length wire: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			for(i=0; i<ns; i++) {
+				s = &deck->seg[deck->nseg++];
+				memset(s, 0, sizeof(struct NECSegment));
+				for(j=0; j<3; j++) {
+					s->r0[j] = f[j] + d[j]*i/ns;
+					s->u[j] = d[j]/wl;
+					s->c[j] = f[j] + d[j]*(i + 0.5)/ns;
+				};
+				s->L = wl/ns;
+				s->a = f[6];
+				s->tag = I[0];
+				s->seg = i + 1;
+			};
+		}
+		else if(strcmp(card, "GS") == 0) {
+			sscanf(line+2, "%d %d %lf", &I[0], &I[1], &scale);
+			for(i=0; i<deck->nseg; i++) {
+				s = &deck->seg[i];
+				for(j=0; j<3; j++) {
+					s->r0[j] *= scale;
+					s->c[j] *= scale;
+				};
+				s->L *= scale;
+				s->a *= scale;
+			};
+		}
+		else if(strcmp(card, "GE") == 0) {
+			sscanf(line+2, "%d", &I[0]);
+			if(I[0] != 0) deck->ground = NECPERFECT;
+			ge = TRUE;
+		}
+		else if(strcmp(card, "GN") == 0) {
+			nf = sscanf(line+2, "%d %d %d %d %lf %lf", &I[0], &I[1], &I[2], &I[3], &f[0], &f[1]);
+			if(I[0] == -1) {
+				deck->ground = NECFREESPACE;
+			}
+			else if(I[0] == 1) {
+				deck->ground = NECPERFECT;
+			}
+			else {
+				// Sommerfeld ground (2) is approximated by the reflection coefficient ground (0).
+				if((nf < 6) || (f[0] <= 0.0)) {
+					if(silent != TRUE) printf("ReadNEC: Error invalid ground: %.60s\n", line);
+					return RTN_ERRNECDECK;
+				};
+				deck->ground = NECFINITE;
+				deck->epsr = f[0];
+				deck->sig = f[1];
+			};
+		}
+		else if(strcmp(card, "EX") == 0) {
+			sscanf(line+2, "%d %d %d %d %lf %lf", &I[0], &I[1], &I[2], &I[3], &f[0], &f[1]);
+			if(I[0] != 0) {
+				if(silent != TRUE) printf("ReadNEC: Error only voltage sources (EX 0) are supported: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			if(deck->nex == maxex) {
+				maxex = 2*maxex + 4;
+				grown = realloc(deck->ex, maxex*sizeof(struct NECSource));
+				if(grown == NULL) return RTN_ERRALLOCATEANT;
+				deck->ex = (struct NECSource *) grown;
+			};
+			deck->ex[deck->nex].seg = NECFindSegment(deck, I[1], I[2]);
+			deck->ex[deck->nex].V = NECc(f[0], f[1]);
+			if(deck->ex[deck->nex].seg < 0) {
+				if(silent != TRUE) printf("ReadNEC: Error source segment not found: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			deck->nex++;
+		}
+		else if(strcmp(card, "LD") == 0) {
+			sscanf(line+2, "%d %d %d %d %lf %lf %lf", &I[0], &I[1], &I[2], &I[3], &f[0], &f[1], &f[2]);
+			if((I[0] < 0) || (I[0] > 5)) {
+				if(silent != TRUE) printf("ReadNEC: Error unsupported load: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			if(deck->nld == maxld) {
+				maxld = 2*maxld + 4;
+				grown = realloc(deck->ld, maxld*sizeof(struct NECLoad));
+				if(grown == NULL) return RTN_ERRALLOCATEANT;
+				deck->ld = (struct NECLoad *) grown;
+			};
+			deck->ld[deck->nld].type = I[0];
+			deck->ld[deck->nld].tag = I[1];
+			deck->ld[deck->nld].m = I[2];
+			deck->ld[deck->nld].n = I[3];
+			deck->ld[deck->nld].f1 = f[0];
+			deck->ld[deck->nld].f2 = f[1];
+			deck->ld[deck->nld].f3 = f[2];
+			deck->nld++;
+		}
+		else if((strcmp(card, "TL") == 0) || (strcmp(card, "NT") == 0)) {
+			sscanf(line+2, "%d %d %d %d %lf %lf %lf %lf %lf %lf", &I[0], &I[1], &I[2], &I[3], &f[0], &f[1], &f[2], &f[3], &f[4], &f[5]);
+			if(deck->nnt == maxnt) {
+				maxnt = 2*maxnt + 4;
+				grown = realloc(deck->nt, maxnt*sizeof(struct NECNetwork));
+				if(grown == NULL) return RTN_ERRALLOCATEANT;
+				deck->nt = (struct NECNetwork *) grown;
+			};
+			deck->nt[deck->nnt].type = (card[0] == 'T') ? 0 : 1;
+			deck->nt[deck->nnt].seg1 = NECFindSegment(deck, I[0], I[1]);
+			deck->nt[deck->nnt].seg2 = NECFindSegment(deck, I[2], I[3]);
+			for(i=0; i<6; i++) deck->nt[deck->nnt].f[i] = f[i];
+			if((deck->nt[deck->nnt].seg1 < 0) || (deck->nt[deck->nnt].seg2 < 0) || (deck->nt[deck->nnt].seg1 == deck->nt[deck->nnt].seg2)) {
+				if(silent != TRUE) printf("ReadNEC: Error network segment not found: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			if((deck->nt[deck->nnt].type == 0) && (f[0] == 0.0)) {
+				if(silent != TRUE) printf("ReadNEC: Error transmission line impedance: %.60s\n", line);
+				return RTN_ERRNECDECK;
+			};
+			deck->nnt++;
+		}
+		else if(strcmp(card, "FR") == 0) {
+			if(frq == FALSE) {
+				sscanf(line+2, "%d %d %d %d %lf %lf", &I[0], &I[1], &I[2], &I[3], &f[0], &f[1]);
+				deck->ifrq = I[0];
+				deck->nfrq = (I[1] < 1) ? 1 : I[1];
+				deck->fmhz = f[0];
+				deck->delfrq = f[1];
+				frq = TRUE;
+			};
+		}
+		else {
+			// Anything else changes the geometry, the excitation or the ground in a way that is not modelled.
+			if(silent != TRUE) printf("ReadNEC: Error unsupported card: %.60s\n", line);
+			return RTN_ERRNECDECK;
+		};
+	};
+
+	if((deck->nseg == 0) || (deck->nex == 0) || (frq == FALSE) || (deck->fmhz <= 0.0) || (ge == FALSE)) {
+		if(silent != TRUE) printf("ReadNEC: Error the deck needs wires, GE, EX and FR cards\n");
+		return RTN_ERRNECDECK;
+	};
+
+	if((deck->ifrq == 1) && (deck->delfrq <= 0.0)) {
+		return RTN_ERRNECDECK;
+	};
+
+	return RTN_READANTENNAPATTERNSOK;
+
+};
+
+int NECFindSegment(struct NECDeck *deck, int tag, int m) {
+
+	/*
+	  NECFindSegment() - Returns the index of segment m of the wire tag. When the tag is 0 m is the
+			absolute segment number. Returns -1 if there is no such segment.
+	*/
+
+	int i;
+
+	if(tag == 0) {
+		return ((m >= 1) && (m <= deck->nseg)) ? m - 1 : -1;
+	};
+
+	for(i=0; i<deck->nseg; i++) {
+		if((deck->seg[i].tag == tag) && (deck->seg[i].seg == m)) return i;
+	};
+
+	return -1;
+
+};
+
+int NECConnect(struct NECDeck *deck) {
+
+	/*
+	  NECConnect() - Finds the nodes where segment ends meet and makes the basis functions. A node that
+			joins k segments has k-1 basis functions, each carrying current from the first segment into
+			another. A node on a ground has a basis function for each segment which continues into the image.
+			Free wire ends have none so the current is zero there.
+	*/
+
+	struct NECSegment *s;
+	struct NECPiece *pc;
+
+	double (*node)[3];		// Node locations
+	double end[3];			// Segment end
+	double *p;
+	double tol;				// Distance within which segment ends are joined
+	double dx, dy, dz;
+
+	int *count;				// Number of segments at each node
+	int *first;				// First segment end at each node
+	int nnode;
+	int i, j, e, n;
+	int se, k;
+	int s1, e1;				// First segment end at a node
+	int ground;				// Node is on the ground
+
+	node = (double (*)[3]) malloc(2*deck->nseg*sizeof(double[3]));
+	count = (int *) calloc(2*deck->nseg, sizeof(int));
+	first = (int *) malloc(2*deck->nseg*sizeof(int));
+	if((node == NULL) || (count == NULL) || (first == NULL)) {
+		free(node); free(count); free(first);
+		return RTN_ERRALLOCATEANT;
+	};
+
+	tol = deck->seg[0].L;
+	for(i=1; i<deck->nseg; i++) {
+		if(deck->seg[i].L < tol) tol = deck->seg[i].L;
+	};
+	tol *= 1.0e-3;
+
+	// Join the segment ends.
+	nnode = 0;
+	for(i=0; i<deck->nseg; i++) {
+		s = &deck->seg[i];
+		for(e=0; e<2; e++) {
+			for(j=0; j<3; j++) end[j] = s->r0[j] + e*s->L*s->u[j];
+			if((deck->ground != NECFREESPACE) && (end[2] < -tol)) {
+				free(node); free(count); free(first);
+				return RTN_ERRNECDECK; // Below ground
+			};
+			for(n=nnode-1; n>=0; n--) {
+				p = node[n];
+				dx = p[0] - end[0]; dy = p[1] - end[1]; dz = p[2] - end[2];
+				if((fabs(dx) < tol) && (fabs(dy) < tol) && (fabs(dz) < tol)) break;
+			};
+			if(n < 0) {
+				n = nnode++;
+				for(j=0; j<3; j++) node[n][j] = end[j];
+				first[n] = 2*i + e;
+			};
+			s->node[e] = n;
+			count[n]++;
+		};
+	};
+
+	// A segment end is in one basis function unless it is the first at a node, when it is in
+	// all of them. So there are at most two pieces per segment end.
+	deck->piece = (struct NECPiece *) malloc(4*deck->nseg*sizeof(struct NECPiece));
+	if(deck->piece == NULL) {
+		free(node); free(count); free(first);
+		return RTN_ERRALLOCATEANT;
+	};
+
+	// Count the pieces on each segment on the first pass and place them on the second.
+	for(i=0; i<deck->nseg; i++) deck->seg[i].pn = 0;
+	for(k=0; k<2; k++) {
+		if(k == 1) {
+			n = 0;
+			for(i=0; i<deck->nseg; i++) {
+				deck->seg[i].pstart = n;
+				n += deck->seg[i].pn;
+				deck->seg[i].pn = 0;
+			};
+		};
+		deck->nbasis = 0;
+		deck->npiece = 0;
+		for(se=0; se<2*deck->nseg; se++) {
+			i = se/2;
+			e = se%2;
+			n = deck->seg[i].node[e];
+			ground = (deck->ground != NECFREESPACE) && (fabs(node[n][2]) < tol);
+			if((ground == FALSE) && ((count[n] < 2) || (se == first[n]))) continue;
+			// Current flows out of the node along segment i
+			if(k == 1) {
+				pc = &deck->piece[deck->seg[i].pstart + deck->seg[i].pn];
+				pc->basis = deck->nbasis;
+				pc->v0 = (e == 0) ? 1.0 : 0.0;
+				pc->v1 = (e == 0) ? 0.0 : -1.0;
+			};
+			deck->seg[i].pn++;
+			deck->npiece++;
+			if(ground == FALSE) {
+				// and into the node along the first segment.
+				s1 = first[n]/2;
+				e1 = first[n]%2;
+				if(k == 1) {
+					pc = &deck->piece[deck->seg[s1].pstart + deck->seg[s1].pn];
+					pc->basis = deck->nbasis;
+					pc->v0 = (e1 == 0) ? -1.0 : 0.0;
+					pc->v1 = (e1 == 0) ? 0.0 : 1.0;
+				};
+				deck->seg[s1].pn++;
+				deck->npiece++;
+			};
+			deck->nbasis++;
+		};
+	};
+
+	free(node);
+	free(count);
+	free(first);
+
+	if(deck->nbasis == 0) return RTN_ERRNECDECK;
+
+	return RTN_READANTENNAPATTERNSOK;
+
+};
+
+int NECSolve(struct NECDeck *deck, double freq, int silent) {
+
+	/*
+	  NECSolve() - Finds the currents on the segments at the frequency freq (MHz). Networks add the
+			voltages at their ports as unknowns. A source on a network port fixes the port voltage.
+	*/
+
+	struct NECSegment *s, *t;
+	struct NECPiece *p, *q;
+	struct NECComplex *A, *b;		// The system of equations A x = b
+	struct NECComplex *Y;			// Network admittance matrix between the ports
+	struct NECComplex D[4], G[4];	// Direct and image moments
+	struct NECComplex z, Zs, y11, y12, y22, Vp;
+	struct NECComplex Isrc;
+
+	double w = 2.0*PI*freq*1.0e6;	// Angular frequency
+	double k = w/VofL;				// Wave number
+	double jwmu = w*NECMU0/(4.0*PI);
+	double dotD, dotG;
+	double mu[3], mq0[3];			// Image direction and start
+	double ffD_re, ffD_im, ffG_re, ffG_im;
+	double a0, a1, b0, b1, dp, dq;
+	double dist, len, cp, cq, beta, sn, cs;
+	double Pin;
+
+	int *port;						// Port number of each segment (-1 for none)
+	int *psrc;						// Source for each port (-1 for none)
+	int *pseg;						// Segment of each port
+	int *col;						// Column of the unknown voltage at each port (-1 for a source port)
+	int nport, n, nb;
+	int i, j, m, e;
+
+	nb = deck->nbasis;
+
+	// Find the network ports.
+	port = (int *) malloc(deck->nseg*sizeof(int));
+	psrc = (int *) malloc((2*deck->nnt + 1)*sizeof(int));
+	pseg = (int *) malloc((2*deck->nnt + 1)*sizeof(int));
+	col = (int *) malloc((2*deck->nnt + 1)*sizeof(int));
+	if((port == NULL) || (psrc == NULL) || (pseg == NULL) || (col == NULL)) {
+		free(port); free(psrc); free(pseg); free(col);
+		return RTN_ERRALLOCATEANT;
+	};
+	for(i=0; i<deck->nseg; i++) port[i] = -1;
+	nport = 0;
+	for(i=0; i<deck->nnt; i++) {
+		for(e=0; e<2; e++) {
+			j = (e == 0) ? deck->nt[i].seg1 : deck->nt[i].seg2;
+			if(port[j] < 0) {
+				port[j] = nport;
+				pseg[nport] = j;
+				psrc[nport] = -1;
+				nport++;
+			};
+		};
+	};
+	for(i=0; i<deck->nex; i++) {
+		if(port[deck->ex[i].seg] >= 0) psrc[port[deck->ex[i].seg]] = i;
+	};
+	n = nb;
+	for(i=0; i<nport; i++) {
+		col[i] = (psrc[i] < 0) ? n++ : -1;
+	};
+
+	if(n > NECMAXUNKNOWNS) {
+		if(silent != TRUE) printf("ReadNEC: Error %d unknowns is more than the limit of %d\n", n, NECMAXUNKNOWNS);
+		free(port); free(psrc); free(pseg); free(col);
+		return RTN_ERRNECSOLVE;
+	};
+
+	A = (struct NECComplex *) calloc((size_t)n*n, sizeof(struct NECComplex));
+	b = (struct NECComplex *) calloc(n, sizeof(struct NECComplex));
+	Y = (struct NECComplex *) calloc((size_t)nport*nport + 1, sizeof(struct NECComplex));
+	if((A == NULL) || (b == NULL) || (Y == NULL)) {
+		free(port); free(psrc); free(pseg); free(col);
+		free(A); free(b); free(Y);
+		return RTN_ERRALLOCATEANT;
+	};
+
+	// Loads
+	for(i=0; i<deck->nseg; i++) {
+		deck->seg[i].ZL = NECc(0.0, 0.0);
+		deck->seg[i].sigma = 0.0;
+	};
+	for(m=0; m<deck->nld; m++) {
+		struct NECLoad *ld = &deck->ld[m];
+		for(i=0; i<deck->nseg; i++) {
+			s = &deck->seg[i];
+			if(ld->tag == 0) {
+				if((ld->m != 0) && ((i+1 < ld->m) || (i+1 > ld->n))) continue;
+			}
+			else {
+				if(s->tag != ld->tag) continue;
+				if((ld->m != 0) && ((s->seg < ld->m) || (s->seg > ld->n))) continue;
+			};
+			switch(ld->type) {
+				case 0: // Series RLC
+				case 2: // Series RLC per meter
+					z = NECc(ld->f1, w*ld->f2 - ((ld->f3 != 0.0) ? 1.0/(w*ld->f3) : 0.0));
+					if(ld->type == 2) { z.re *= s->L; z.im *= s->L; };
+					s->ZL.re += z.re; s->ZL.im += z.im;
+					break;
+				case 1: // Parallel RLC
+				case 3: // Parallel RLC per meter
+					y11 = NECc(((ld->f1 != 0.0) ? 1.0/ld->f1 : 0.0), w*ld->f3 - ((ld->f2 != 0.0) ? 1.0/(w*ld->f2) : 0.0));
+					z = NECcdiv(NECc(1.0, 0.0), y11);
+					if(ld->type == 3) { z.re *= s->L; z.im *= s->L; };
+					s->ZL.re += z.re; s->ZL.im += z.im;
+					break;
+				case 4: // Impedance
+					s->ZL.re += ld->f1; s->ZL.im += ld->f2;
+					break;
+				case 5: // Wire conductivity
+					s->sigma = ld->f1;
+					break;
+			};
+		};
+	};
+
+	// Impedance matrix. Each pair of segments is visited once, the matrix is symmetric.
+	for(i=0; i<deck->nseg; i++) {
+		s = &deck->seg[i];
+		if(s->pn == 0) continue;
+		for(j=i; j<deck->nseg; j++) {
+			t = &deck->seg[j];
+			if(t->pn == 0) continue;
+
+			NECMoments(s->r0, s->u, s->L, t->r0, t->u, t->L, 0.5*(s->a + t->a), k, D);
+			dotD = s->u[0]*t->u[0] + s->u[1]*t->u[1] + s->u[2]*t->u[2];
+			if(deck->ground != NECFREESPACE) {
+				// The image of a perfect ground reverses the horizontal current
+				mq0[0] = t->r0[0]; mq0[1] = t->r0[1]; mq0[2] = -t->r0[2];
+				mu[0] = t->u[0]; mu[1] = t->u[1]; mu[2] = -t->u[2];
+				NECMoments(s->r0, s->u, s->L, mq0, mu, t->L, 0.5*(s->a + t->a), k, G);
+				dotG = s->u[0]*mu[0] + s->u[1]*mu[1] + s->u[2]*mu[2];
+			}
+			else {
+				memset(G, 0, sizeof(G));
+				dotG = 0.0;
+			};
+
+			for(p = &deck->piece[s->pstart]; p < &deck->piece[s->pstart + s->pn]; p++) {
+				a0 = p->v0; a1 = p->v1 - p->v0;
+				dp = a1/s->L;
+				for(q = &deck->piece[t->pstart]; q < &deck->piece[t->pstart + t->pn]; q++) {
+					b0 = q->v0; b1 = q->v1 - q->v0;
+					dq = b1/t->L;
+					ffD_re = a0*b0*D[0].re + a1*b0*D[1].re + a0*b1*D[2].re + a1*b1*D[3].re;
+					ffD_im = a0*b0*D[0].im + a1*b0*D[1].im + a0*b1*D[2].im + a1*b1*D[3].im;
+					ffG_re = a0*b0*G[0].re + a1*b0*G[1].re + a0*b1*G[2].re + a1*b1*G[3].re;
+					ffG_im = a0*b0*G[0].im + a1*b0*G[1].im + a0*b1*G[2].im + a1*b1*G[3].im;
+					// z = (dot ff - dp dq M0/k^2) for the direct and minus that for the image
+					z.re = dotD*ffD_re - dp*dq*D[0].re/(k*k) - (dotG*ffG_re - dp*dq*G[0].re/(k*k));
+					z.im = dotD*ffD_im - dp*dq*D[0].im/(k*k) - (dotG*ffG_im - dp*dq*G[0].im/(k*k));
+					// times j w mu / 4 pi
+					Vp.re = -jwmu*z.im;
+					Vp.im = jwmu*z.re;
+					A[(size_t)p->basis*n + q->basis].re += Vp.re;
+					A[(size_t)p->basis*n + q->basis].im += Vp.im;
+					if(i != j) {
+						A[(size_t)q->basis*n + p->basis].re += Vp.re;
+						A[(size_t)q->basis*n + p->basis].im += Vp.im;
+					};
+				};
+			};
+		};
+
+		// Loads on the segment
+		if(s->sigma > 0.0) {
+			// Skin effect impedance per meter
+			Zs.re = sqrt(w*NECMU0/(2.0*s->sigma))/(2.0*PI*s->a);
+			Zs.im = Zs.re;
+		}
+		else {
+			Zs = NECc(0.0, 0.0);
+		};
+		for(p = &deck->piece[s->pstart]; p < &deck->piece[s->pstart + s->pn]; p++) {
+			cp = 0.5*(p->v0 + p->v1);
+			for(q = &deck->piece[s->pstart]; q < &deck->piece[s->pstart + s->pn]; q++) {
+				cq = 0.5*(q->v0 + q->v1);
+				len = s->L*(p->v0*q->v0/3.0 + (p->v0*q->v1 + p->v1*q->v0)/6.0 + p->v1*q->v1/3.0);
+				A[(size_t)p->basis*n + q->basis].re += Zs.re*len + s->ZL.re*cp*cq;
+				A[(size_t)p->basis*n + q->basis].im += Zs.im*len + s->ZL.im*cp*cq;
+			};
+		};
+	};
+
+	// Sources
+	for(m=0; m<deck->nex; m++) {
+		s = &deck->seg[deck->ex[m].seg];
+		for(p = &deck->piece[s->pstart]; p < &deck->piece[s->pstart + s->pn]; p++) {
+			cp = 0.5*(p->v0 + p->v1);
+			b[p->basis].re += deck->ex[m].V.re*cp;
+			b[p->basis].im += deck->ex[m].V.im*cp;
+		};
+	};
+
+	// Networks
+	for(m=0; m<deck->nnt; m++) {
+		struct NECNetwork *nt = &deck->nt[m];
+		if(nt->type == 0) {
+			// Transmission line. A negative impedance is a crossed line.
+			len = nt->f[1];
+			if(len == 0.0) {
+				dist = 0.0;
+				for(j=0; j<3; j++) dist += pow(deck->seg[nt->seg1].c[j] - deck->seg[nt->seg2].c[j], 2);
+				len = sqrt(dist);
+			};
+			beta = k*len;
+			sn = sin(beta);
+			cs = cos(beta);
+			if(fabs(sn) < 1.0e-9) {
+				if(silent != TRUE) printf("ReadNEC: Error transmission line is a multiple of a half wavelength\n");
+				free(port); free(psrc); free(pseg); free(col); free(A); free(b); free(Y);
+				return RTN_ERRNECSOLVE;
+			};
+			y11 = NECc(nt->f[2], -cs/(sn*fabs(nt->f[0])) + nt->f[3]);
+			y22 = NECc(nt->f[4], -cs/(sn*fabs(nt->f[0])) + nt->f[5]);
+			y12 = NECc(0.0, 1.0/(sn*fabs(nt->f[0])));
+			if(nt->f[0] < 0.0) y12.im = -y12.im;
+		}
+		else {
+			y11 = NECc(nt->f[0], nt->f[1]);
+			y12 = NECc(nt->f[2], nt->f[3]);
+			y22 = NECc(nt->f[4], nt->f[5]);
+		};
+		i = port[nt->seg1];
+		j = port[nt->seg2];
+		Y[i*nport + i].re += y11.re; Y[i*nport + i].im += y11.im;
+		Y[j*nport + j].re += y22.re; Y[j*nport + j].im += y22.im;
+		Y[i*nport + j].re += y12.re; Y[i*nport + j].im += y12.im;
+		Y[j*nport + i].re += y12.re; Y[j*nport + i].im += y12.im;
+	};
+
+	for(i=0; i<nport; i++) {
+		if(col[i] < 0) continue;
+		// The port voltage is the gap voltage of the segment: Z I - P v = V
+		// and the segment current flows out of the network: P^T I + Y v = 0
+		s = &deck->seg[pseg[i]];
+		for(p = &deck->piece[s->pstart]; p < &deck->piece[s->pstart + s->pn]; p++) {
+			cp = 0.5*(p->v0 + p->v1);
+			A[(size_t)p->basis*n + col[i]].re -= cp;
+			A[(size_t)col[i]*n + p->basis].re += cp;
+		};
+		for(j=0; j<nport; j++) {
+			if(col[j] >= 0) {
+				A[(size_t)col[i]*n + col[j]].re += Y[i*nport + j].re;
+				A[(size_t)col[i]*n + col[j]].im += Y[i*nport + j].im;
+			}
+			else {
+				z = NECcmul(Y[i*nport + j], deck->ex[psrc[j]].V);
+				b[col[i]].re -= z.re;
+				b[col[i]].im -= z.im;
+			};
+		};
+	};
+
+	if(NECGaussSolve(A, b, n) != TRUE) {
+		if(silent != TRUE) printf("ReadNEC: Error the moment matrix is singular at %.3lf MHz\n", freq);
+		free(port); free(psrc); free(pseg); free(col); free(A); free(b); free(Y);
+		return RTN_ERRNECSOLVE;
+	};
+
+	// Current at the ends of each segment
+	for(i=0; i<deck->nseg; i++) {
+		s = &deck->seg[i];
+		s->I0 = NECc(0.0, 0.0);
+		s->I1 = NECc(0.0, 0.0);
+		for(p = &deck->piece[s->pstart]; p < &deck->piece[s->pstart + s->pn]; p++) {
+			s->I0.re += b[p->basis].re*p->v0; s->I0.im += b[p->basis].im*p->v0;
+			s->I1.re += b[p->basis].re*p->v1; s->I1.im += b[p->basis].im*p->v1;
+		};
+	};
+
+	// Input power. A source on a network port also drives the network.
+	Pin = 0.0;
+	for(m=0; m<deck->nex; m++) {
+		s = &deck->seg[deck->ex[m].seg];
+		Isrc.re = 0.5*(s->I0.re + s->I1.re);
+		Isrc.im = 0.5*(s->I0.im + s->I1.im);
+		i = port[deck->ex[m].seg];
+		if(i >= 0) {
+			for(j=0; j<nport; j++) {
+				Vp = (col[j] >= 0) ? b[col[j]] : deck->ex[psrc[j]].V;
+				z = NECcmul(Y[i*nport + j], Vp);
+				Isrc.re += z.re;
+				Isrc.im += z.im;
+			};
+		};
+		Pin += 0.5*(deck->ex[m].V.re*Isrc.re + deck->ex[m].V.im*Isrc.im);
+	};
+
+	free(port); free(psrc); free(pseg); free(col); free(A); free(b); free(Y);
+
+	if(Pin <= 0.0) {
+		if(silent != TRUE) printf("ReadNEC: Error no power into the antenna at %.3lf MHz\n", freq);
+		return RTN_ERRNECSOLVE;
+	};
+
+	deck->Pin = Pin;
+
+	return RTN_READANTENNAPATTERNSOK;
+
+};
+
+void NECPattern(struct NECDeck *deck, double freq, double **pattern) {
+
+	/*
+	  NECPattern() - Finds the far field gain (dBi) of the currents from NECSolve() at 1 degree steps.
+			The pattern is in the order of a type 13 file, pattern[azimuth][elevation], with the azimuth
+			measured clockwise from the +x axis which is the main beam direction of the antenna.
+			The far field of each segment is integrated in closed form for the linear current on it.
+	*/
+
+	struct NECSegment *s;
+	struct NECComplex Nd[3], Ni[3];	// Direct and image radiation vectors
+	struct NECComplex Im, Id;		// Mean and difference of the current on a segment
+	struct NECComplex ph, S, sv, sh, ec, root, Nt, Np;
+
+	double k = 2.0*PI*freq*1.0e6/VofL;
+	double theta, phi;
+	double st, ct, sp, cp;
+	double h, x, sx, cx, sinc, g;
+	double ur, hr, a;
+	double U;
+	double lambda = VofL/(freq*1.0e6);
+
+	int az, el, i, j, img;
+
+	// Complex permittivity of the ground
+	ec = NECc(deck->epsr, -60.0*lambda*deck->sig);
+
+	for(az=0; az<360; az++) {
+		phi = -az*D2R;
+		sp = sin(phi);
+		cp = cos(phi);
+		for(el=0; el<91; el++) {
+			theta = (90 - el)*D2R;
+			st = sin(theta);
+			ct = cos(theta);
+
+			for(j=0; j<3; j++) {
+				Nd[j] = NECc(0.0, 0.0);
+				Ni[j] = NECc(0.0, 0.0);
+			};
+
+			for(i=0; i<deck->nseg; i++) {
+				s = &deck->seg[i];
+				Im.re = 0.5*(s->I0.re + s->I1.re);
+				Im.im = 0.5*(s->I0.im + s->I1.im);
+				Id.re = s->I1.re - s->I0.re;
+				Id.im = s->I1.im - s->I0.im;
+				h = 0.5*s->L;
+				hr = st*(s->c[0]*cp + s->c[1]*sp);
+				ur = st*(s->u[0]*cp + s->u[1]*sp);
+				for(img=0; img<((deck->ground == NECFREESPACE) ? 1 : 2); img++) {
+					// The image of a perfect ground has (x, y, -z) and the horizontal current reversed.
+					a = (img == 0) ? 1.0 : -1.0;
+					x = k*h*(a*ur + s->u[2]*ct);
+					sx = sin(x);
+					cx = cos(x);
+					if(fabs(x) < 1.0e-3) {
+						sinc = 1.0 - x*x/6.0;
+						g = x/3.0;
+					}
+					else {
+						sinc = sx/x;
+						g = (sx - x*cx)/(x*x);
+					};
+					// S = exp(j k r.c) (Im L sinc + j h g Id)
+					ph.re = cos(k*(hr + a*s->c[2]*ct));
+					ph.im = sin(k*(hr + a*s->c[2]*ct));
+					S.re = Im.re*s->L*sinc - h*g*Id.im;
+					S.im = Im.im*s->L*sinc + h*g*Id.re;
+					S = NECcmul(ph, S);
+					if(img == 0) {
+						for(j=0; j<3; j++) {
+							Nd[j].re += s->u[j]*S.re;
+							Nd[j].im += s->u[j]*S.im;
+						};
+					}
+					else {
+						for(j=0; j<3; j++) {
+							Ni[j].re += ((j == 2) ? 1.0 : -1.0)*s->u[j]*S.re;
+							Ni[j].im += ((j == 2) ? 1.0 : -1.0)*s->u[j]*S.im;
+						};
+					};
+				};
+			};
+
+			// Reflection of the image field by the ground
+			if(deck->ground == NECFINITE) {
+				// root = sqrt(ec - cos^2(psi)), psi is the elevation
+				root = NECc(ec.re - st*st, ec.im);
+				a = sqrt(root.re*root.re + root.im*root.im);
+				h = sqrt(0.5*(a + root.re));
+				root = NECc(h, (h > 0.0) ? root.im/(2.0*h) : sqrt(0.5*(a - root.re)));
+				// Vertical reflection coefficient
+				Nt = NECc(ec.re*ct - root.re, ec.im*ct - root.im);
+				Np = NECc(ec.re*ct + root.re, ec.im*ct + root.im);
+				sv = NECcdiv(Nt, Np);
+				// minus the horizontal reflection coefficient
+				Nt = NECc(root.re - ct, root.im);
+				Np = NECc(ct + root.re, root.im);
+				sh = NECcdiv(Nt, Np);
+			}
+			else {
+				sv = NECc(1.0, 0.0);
+				sh = NECc(1.0, 0.0);
+			};
+
+			// theta and phi components
+			Nt.re = ct*cp*Nd[0].re + ct*sp*Nd[1].re - st*Nd[2].re;
+			Nt.im = ct*cp*Nd[0].im + ct*sp*Nd[1].im - st*Nd[2].im;
+			Np.re = -sp*Nd[0].re + cp*Nd[1].re;
+			Np.im = -sp*Nd[0].im + cp*Nd[1].im;
+			if(deck->ground != NECFREESPACE) {
+				S.re = ct*cp*Ni[0].re + ct*sp*Ni[1].re - st*Ni[2].re;
+				S.im = ct*cp*Ni[0].im + ct*sp*Ni[1].im - st*Ni[2].im;
+				S = NECcmul(sv, S);
+				Nt.re += S.re; Nt.im += S.im;
+				S.re = -sp*Ni[0].re + cp*Ni[1].re;
+				S.im = -sp*Ni[0].im + cp*Ni[1].im;
+				S = NECcmul(sh, S);
+				Np.re += S.re; Np.im += S.im;
+			};
+
+			// Gain = 4 pi U / Pin where U = eta k^2 |N|^2 / (32 pi^2)
+			U = NECETA0*k*k*(Nt.re*Nt.re + Nt.im*Nt.im + Np.re*Np.re + Np.im*Np.im)/(8.0*PI*deck->Pin);
+			if(U > 0.0) {
+				pattern[az][el] = 10.0*log10(U);
+				if(pattern[az][el] < NECMINGAIN) pattern[az][el] = NECMINGAIN;
+			}
+			else {
+				pattern[az][el] = NECMINGAIN;
+			};
+		};
+	};
+
+	return;
+
+};
+
+void NECMoments(const double p0[3], const double pu[3], double Lp, const double q0[3], const double qu[3], double Lq, double a, double k, struct NECComplex M[4]) {
+
+	/*
+	  NECMoments() - Integrates the reduced kernel exp(-jkR)/R, R = sqrt(|P - Q|^2 + a^2), over the segments
+			P = p0 + l pu and Q = q0 + l' qu. With x = l/Lp and x' = l'/Lq the moments are
+				M[0] = Int K, M[1] = Int x K, M[2] = Int x' K, M[3] = Int x x' K
+			For close segments 1/R is integrated over Q in closed form and the rest by quadrature.
+	*/
+
+	static const double x8[8] = {-0.9602898564975363, -0.7966664774136267, -0.5255324099163290, -0.1834346424956498,
+								  0.1834346424956498,  0.5255324099163290,  0.7966664774136267,  0.9602898564975363};
+	static const double w8[8] = {0.1012285362903763, 0.2223810344533745, 0.3137066458778873, 0.3626837833783620,
+								 0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763};
+	static const double x4[4] = {-0.8611363115940526, -0.3399810435848563, 0.3399810435848563, 0.8611363115940526};
+	static const double w4[4] = {0.3478548451374538, 0.6521451548625461, 0.6521451548625461, 0.3478548451374538};
+	static const double x2[2] = {-0.5773502691896257, 0.5773502691896257};
+	static const double w2[2] = {1.0, 1.0};
+
+	const double *xq, *wq;
+
+	double P[3], d[3];
+	double dc;					// Distance between the centres
+	double xi, xj, wi, wj;
+	double t0, rho2, R, Rs, Re;
+	double I0, I1;
+	double J0re, J0im, J1re, J1im;
+	double kr, gre, gim;
+
+	int i, j, m, nq;
+
+	for(m=0; m<4; m++) M[m] = NECc(0.0, 0.0);
+
+	for(m=0; m<3; m++) d[m] = (p0[m] + 0.5*Lp*pu[m]) - (q0[m] + 0.5*Lq*qu[m]);
+	dc = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+
+	if(dc < Lp + Lq) {
+		for(i=0; i<8; i++) {
+			xi = 0.5*(1.0 + x8[i]);
+			wi = 0.5*w8[i]*Lp;
+			for(m=0; m<3; m++) {
+				P[m] = p0[m] + xi*Lp*pu[m];
+				d[m] = P[m] - q0[m];
+			};
+			// 1/R in closed form. t0 is the position of P along Q.
+			t0 = d[0]*qu[0] + d[1]*qu[1] + d[2]*qu[2];
+			rho2 = d[0]*d[0] + d[1]*d[1] + d[2]*d[2] - t0*t0;
+			if(rho2 < 0.0) rho2 = 0.0;
+			rho2 += a*a;
+			Rs = sqrt(t0*t0 + rho2);
+			Re = sqrt((Lq - t0)*(Lq - t0) + rho2);
+			I0 = asinh((Lq - t0)/sqrt(rho2)) + asinh(t0/sqrt(rho2));
+			I1 = (Re - Rs + t0*I0)/Lq;
+			J0re = I0; J0im = 0.0;
+			J1re = I1; J1im = 0.0;
+			// (exp(-jkR) - 1)/R by quadrature
+			for(j=0; j<8; j++) {
+				xj = 0.5*(1.0 + x8[j]);
+				wj = 0.5*w8[j]*Lq;
+				for(m=0; m<3; m++) d[m] = P[m] - q0[m] - xj*Lq*qu[m];
+				R = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2] + a*a);
+				kr = 0.5*k*R;
+				gre = -2.0*sin(kr)*sin(kr)/R;
+				gim = -sin(k*R)/R;
+				J0re += wj*gre; J0im += wj*gim;
+				J1re += wj*xj*gre; J1im += wj*xj*gim;
+			};
+			M[0].re += wi*J0re; M[0].im += wi*J0im;
+			M[1].re += wi*xi*J0re; M[1].im += wi*xi*J0im;
+			M[2].re += wi*J1re; M[2].im += wi*J1im;
+			M[3].re += wi*xi*J1re; M[3].im += wi*xi*J1im;
+		};
+		return;
+	};
+
+	if(dc < 4.0*(Lp + Lq)) {
+		nq = 4; xq = x4; wq = w4;
+	}
+	else {
+		nq = 2; xq = x2; wq = w2;
+	};
+
+	for(i=0; i<nq; i++) {
+		xi = 0.5*(1.0 + xq[i]);
+		wi = 0.5*wq[i]*Lp;
+		for(m=0; m<3; m++) P[m] = p0[m] + xi*Lp*pu[m];
+		for(j=0; j<nq; j++) {
+			xj = 0.5*(1.0 + xq[j]);
+			wj = 0.5*wq[j]*Lq*wi;
+			for(m=0; m<3; m++) d[m] = P[m] - q0[m] - xj*Lq*qu[m];
+			R = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2] + a*a);
+			gre = wj*cos(k*R)/R;
+			gim = -wj*sin(k*R)/R;
+			M[0].re += gre; M[0].im += gim;
+			M[1].re += xi*gre; M[1].im += xi*gim;
+			M[2].re += xj*gre; M[2].im += xj*gim;
+			M[3].re += xi*xj*gre; M[3].im += xi*xj*gim;
+		};
+	};
+
+	return;
+
+};
+
+int NECGaussSolve(struct NECComplex *A, struct NECComplex *b, int n) {
+
+	/*
+	  NECGaussSolve() - Solves A x = b by Gaussian elimination with partial pivoting. A is n x n by rows.
+			A is destroyed and x is returned in b. Returns FALSE if A is singular.
+	*/
+
+	struct NECComplex f, t;
+	struct NECComplex *Ak, *Ai;
+
+	double big, mag;
+
+	int i, j, k, piv;
+
+	for(k=0; k<n; k++) {
+		Ak = &A[(size_t)k*n];
+
+		piv = k;
+		big = 0.0;
+		for(i=k; i<n; i++) {
+			mag = fabs(A[(size_t)i*n + k].re) + fabs(A[(size_t)i*n + k].im);
+			if(mag > big) {
+				big = mag;
+				piv = i;
+			};
+		};
+		if(big == 0.0) return FALSE;
+
+		if(piv != k) {
+			Ai = &A[(size_t)piv*n];
+			for(j=k; j<n; j++) {
+				t = Ak[j]; Ak[j] = Ai[j]; Ai[j] = t;
+			};
+			t = b[k]; b[k] = b[piv]; b[piv] = t;
+		};
+
+		for(i=k+1; i<n; i++) {
+			Ai = &A[(size_t)i*n];
+			if((Ai[k].re == 0.0) && (Ai[k].im == 0.0)) continue;
+			f = NECcdiv(Ai[k], Ak[k]);
+			for(j=k+1; j<n; j++) {
+				Ai[j].re -= f.re*Ak[j].re - f.im*Ak[j].im;
+				Ai[j].im -= f.re*Ak[j].im + f.im*Ak[j].re;
+			};
+			b[i].re -= f.re*b[k].re - f.im*b[k].im;
+			b[i].im -= f.re*b[k].im + f.im*b[k].re;
+		};
+	};
+
+	for(k=n-1; k>=0; k--) {
+		Ak = &A[(size_t)k*n];
+		t = b[k];
+		for(j=k+1; j<n; j++) {
+			t.re -= Ak[j].re*b[j].re - Ak[j].im*b[j].im;
+			t.im -= Ak[j].re*b[j].im + Ak[j].im*b[j].re;
+		};
+		b[k] = NECcdiv(t, Ak[k]);
+	};
+
+	return TRUE;
+
+};
+
+void NECFree(struct NECDeck *deck) {
+
+	/*
+	  NECFree() - Frees the memory of an NECDeck.
+	*/
+
+	free(deck->seg);
+	free(deck->piece);
+	free(deck->ld);
+	free(deck->ex);
+	free(deck->nt);
+
+	return;
+
+};
+
+unsigned long long NECHash(const char *buf) {
+
+	/*
+	  NECHash() - Returns the 64-bit FNV-1a hash of the solver version and the deck. This is the cache key.
+	*/
+
+	const char *c;
+
+	unsigned long long hash = 0xcbf29ce484222325ULL;
+
+	for(c = NECVERSION; *c != '\0'; c++) {
+		hash = (hash ^ (unsigned char)*c)*0x100000001b3ULL;
+	};
+	for(c = buf; *c != '\0'; c++) {
+		hash = (hash ^ (unsigned char)*c)*0x100000001b3ULL;
+	};
+
+	return hash;
+
+};
+
+struct NECComplex NECc(double re, double im) {
+
+	struct NECComplex c;
+
+	c.re = re;
+	c.im = im;
+
+	return c;
+
+};
+
+struct NECComplex NECcmul(struct NECComplex a, struct NECComplex b) {
+
+	return NECc(a.re*b.re - a.im*b.im, a.re*b.im + a.im*b.re);
+
+};
+
+struct NECComplex NECcdiv(struct NECComplex a, struct NECComplex b) {
+
+	double d = b.re*b.re + b.im*b.im;
+
+	return NECc((a.re*b.re + a.im*b.im)/d, (a.im*b.re - a.re*b.im)/d);
+
+};
@@ -44,6 +44,29 @@ DLLEXPORT void SetAntennaPatternVal(struct PathData * path, int TXorRX, int azim
 	}
 };
 
+DLLEXPORT void SetAntennaBearing(struct PathData * path, int TXorRX, double bearing) {
+	/*
+	SetAntennaBearing() - Sets the direction of the main beam of an antenna. The pattern 
+		is stored relative to the main beam so the antenna can be re-pointed without 
+		reloading it. The bearing is applied when the gain is found in AntennaGain().
+
+	INPUT
+		struct PathData
+		int TXorRX
+		double bearing (radians)
+
+	*/
+
+	//If TXorRX == 0 set the transmitter's antenna bearing.
+	if (TXorRX == 0){
+		path->A_tx.bearing = bearing;
+	}
+	//At the moment anything but 0 is the RX.
+	else {
+		path->A_rx.bearing = bearing;
+	}
+};
+
 int ReadType11(struct Antenna *Ant, FILE *fp, int silent) {
 	char line[256];			// Read input line
 	char instr[256];		// String temp
@@ -146,8 +169,6 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 
 	int i, j;					// Loop counters
 	int freqn, azin, elen;		// Number of freqs, elevations and azimuths
-	int iazi;					// Offset azimuth counter
-	int iMBOS;				// Integer offset of the main beam azimuth
 	int iI = 0;				// Temp
 
 	double MaxG = 0.0;	// Maximum gain
@@ -158,12 +179,11 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 
 	AllocateAntennaMemory(Ant, freqn, azin, elen);
 
-	// Determine the azimuth direction that the antenna is pointing to find the index offset.
-	// Ideally the antenna pattern could be rotated to any position and then every gain value in the
-	// pattern would be interpolated. In this implementation the pattern will be rotated to the nearest
-	// integer azimuth degree. This approximate method was chosen because of the error of having the
-	// pattern off by maximally +- 1/2 degree is considered to be minimal.
-	iMBOS = (int)(bearing*R2D);
+	// The pattern is stored as it is in the file, relative to the main beam of the antenna. 
+	// The direction that the antenna is pointing is kept with the pattern and applied in 
+	// AntennaGain() so that fractional bearings are not rounded and the antenna can be 
+	// re-pointed without reading the file again.
+	Ant->bearing = bearing;
 
 	// Read a VOACAP antenna pattern Type 13 file
 	/*
@@ -221,21 +241,18 @@ int ReadType13(struct Antenna *Ant, FILE * fp, double bearing, int silent) {
 	 */
 
 	for(i=0; i<azin; i++) {
-		// Advance to the next azimuth and roll it over if necessary.
-		iazi = (iMBOS+i)%360;
-
 		fgets(line, sizeof(line), fp);
 		sscanf(line, " %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
-			&iI, &Ant->pattern[0][iazi][0], &Ant->pattern[0][iazi][1], &Ant->pattern[0][iazi][2], &Ant->pattern[0][iazi][3], &Ant->pattern[0][iazi][4],
-			     &Ant->pattern[0][iazi][5], &Ant->pattern[0][iazi][6], &Ant->pattern[0][iazi][7], &Ant->pattern[0][iazi][8], &Ant->pattern[0][iazi][9]);
+			&iI, &Ant->pattern[0][i][0], &Ant->pattern[0][i][1], &Ant->pattern[0][i][2], &Ant->pattern[0][i][3], &Ant->pattern[0][i][4],
+			     &Ant->pattern[0][i][5], &Ant->pattern[0][i][6], &Ant->pattern[0][i][7], &Ant->pattern[0][i][8], &Ant->pattern[0][i][9]);
 		for(j=10; j<90; j += 10) {
 			fgets(line, sizeof(line), fp);
 			sscanf(line, " %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
-				&Ant->pattern[0][iazi][j],   &Ant->pattern[0][iazi][j+1], &Ant->pattern[0][iazi][j+2], &Ant->pattern[0][iazi][j+3], &Ant->pattern[0][iazi][j+4],
-				&Ant->pattern[0][iazi][j+5], &Ant->pattern[0][iazi][j+6], &Ant->pattern[0][iazi][j+7], &Ant->pattern[0][iazi][j+8], &Ant->pattern[0][iazi][j+9]);
+				&Ant->pattern[0][i][j],   &Ant->pattern[0][i][j+1], &Ant->pattern[0][i][j+2], &Ant->pattern[0][i][j+3], &Ant->pattern[0][i][j+4],
+				&Ant->pattern[0][i][j+5], &Ant->pattern[0][i][j+6], &Ant->pattern[0][i][j+7], &Ant->pattern[0][i][j+8], &Ant->pattern[0][i][j+9]);
 		};
 		fgets(line, sizeof(line), fp);
-		sscanf(line, " %lf\n", &Ant->pattern[0][iazi][90]);
+		sscanf(line, " %lf\n", &Ant->pattern[0][i][90]);
 	};
 
 	return RTN_READANTENNAPATTERNSOK;